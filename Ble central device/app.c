@@ -31,6 +31,21 @@
 #include "app_assert.h"
 #include "sl_bluetooth.h"
 #include "app.h"
+#include "host_ctrl.h"
+#include "state_journal.h"
+#include "nvm3_profile.h"
+#include "sli_cryptoacc_driver_trng.h"
+#include "sli_cryptoacc_transparent_functions.h"
+#include "sl_iostream_handles.h"
+#include "sl_iostream_mux.h"
+#include "sl_iostream_mux_instances.h"
+#include "app_log.h"
+#include "secure_payload.h"
+#include "fast_boot.h"
+#include "buffer_pool.h"
+#include "sl_power_manager_config.h"
+#include "sl_power_manager_profile.h"
+#include "sl_sleeptimer.h"
 #include <stdio.h>
 
 
@@ -48,6 +63,9 @@ static sl_status_t sc;
 static uint8_t live_connections = 0;
 connection_info_t conn[MAX_CONNECTION];
 
+// Opens the values sealed by each server
+static secure_payload_context_t payload_context[MAX_CONNECTION];
+
 //Target service UUID
 static const uint8_t service_uuid[2] = {0xFF, 0x00};
 
@@ -57,7 +75,15 @@ static uint16_t characteristic_handle[2];
 bool check_characteristic = true;
 
 static void print_bluetooth_address(void);
+static void load_server_states(void);
+static void save_server_state(uint8_t server);
 static bd_addr *read_and_cache_bluetooth_address(uint8_t *address_type_out);
+static void init_payload_context(uint8_t server, const bd_addr *address);
+static sl_status_t open_server_value(uint8_t connection, uint16_t characteristic, uint8array *value);
+
+#if SL_POWER_MANAGER_PROFILE
+static void print_power_manager_profile(void);
+#endif
 
 void sl_update_advertising_data();
 void sl_start_advertising();
@@ -72,6 +98,19 @@ SL_WEAK void app_init(void)
   // Put your additional application init code here!                         //
   // This is called once during start-up.                                    //
   /////////////////////////////////////////////////////////////////////////////
+  // Log, trace and control channels multiplexed over VCOM
+  sc = sl_iostream_mux_init_instances();
+  app_assert_status(sc);
+  // app_log_iostream_set() only accepts the generated instances
+  app_log_iostream = sl_iostream_mux_log_handle;
+  sl_iostream_set_default(sl_iostream_mux_log_handle);
+
+  host_ctrl_init(sl_iostream_mux_control_handle);
+
+  // Last known server states, shown until the servers are read again
+  sc = state_journal_init(APP_NVM3_KEY_STATE_JOURNAL);
+  app_assert_status(sc);
+  load_server_states();
 }
 
 /**************************************************************************//**
@@ -84,6 +123,46 @@ SL_WEAK void app_process_action(void)
   // This is called infinitely.                                              //
   // Do not call blocking functions from here!                               //
   /////////////////////////////////////////////////////////////////////////////
+  fast_boot_process_action();
+  host_ctrl_process_action();
+  sl_iostream_mux_process_action(&sl_iostream_mux_vcom);
+  nvm3_idleRepackProcessAction();
+  sli_cryptoacc_trng_pool_process_action();
+  sli_cryptoacc_ecc_keypair_cache_process_action();
+  state_journal_process_action();
+}
+
+/**************************************************************************//**
+ * Power manager hook, repacks NVM3 and refills the random pool and the
+ * keypair cache when the system is idle, saves the state journal on a
+ * power-fail hint, and keeps the system awake until the boot completes.
+ *****************************************************************************/
+bool app_is_ok_to_sleep(void)
+{
+  bool ok_to_sleep = nvm3_idleRepackIsOkToSleep();
+
+  if (sli_cryptoacc_trng_pool_is_ok_to_sleep() == false) {
+    ok_to_sleep = false;
+  }
+  if (sli_cryptoacc_ecc_keypair_cache_is_ok_to_sleep() == false) {
+    ok_to_sleep = false;
+  }
+  if (state_journal_is_ok_to_sleep() == false) {
+    ok_to_sleep = false;
+  }
+  if (fast_boot_is_ok_to_sleep() == false) {
+    ok_to_sleep = false;
+  }
+  return ok_to_sleep;
+}
+
+/**************************************************************************//**
+ * Allow NVM3 repacks only while no connection is open or being opened, a
+ * page erase stalls the CPU for longer than a connection interval.
+ *****************************************************************************/
+bool nvm3_idleRepackIsAllowed(void)
+{
+  return state == scanning && live_connections == 0;
 }
 
 /**************************************************************************//**
@@ -94,6 +173,9 @@ SL_WEAK void app_process_action(void)
  *****************************************************************************/
 void sl_bt_on_event(sl_bt_msg_t *evt)
 {
+  // Trace the header of every stack event
+  sl_iostream_write(sl_iostream_mux_trace_handle, &evt->header, sizeof(evt->header));
+
   switch (SL_BT_MSG_ID(evt->header)) {
     // -------------------------------
     // This event indicates the device has started and the radio is ready.
@@ -152,6 +234,7 @@ void sl_bt_on_event(sl_bt_msg_t *evt)
                                   evt->data.evt_scanner_legacy_advertisement_report.address_type,
                                   sl_bt_gap_phy_1m,
                                   &conn[0].handle);
+            state = opening;
             break;
           } else if (strcmp(name, TARGET_NAME_2) == 0) {
               app_log("Found server 2, connecting..\n");
@@ -161,6 +244,7 @@ void sl_bt_on_event(sl_bt_msg_t *evt)
                                     evt->data.evt_scanner_legacy_advertisement_report.address_type,
                                     sl_bt_gap_phy_1m,
                                     &conn[1].handle);
+              state = opening;
             break;
           } else if (strcmp(name, TARGET_NAME_3) == 0) {
               app_log("Found server 3, connecting..\n");
@@ -170,6 +254,7 @@ void sl_bt_on_event(sl_bt_msg_t *evt)
                                     evt->data.evt_scanner_legacy_advertisement_report.address_type,
                                     sl_bt_gap_phy_1m,
                                     &conn[2].handle);
+              state = opening;
             break;
           }
           else {
@@ -188,14 +273,23 @@ void sl_bt_on_event(sl_bt_msg_t *evt)
 
       if (current_connection == conn[0].handle) {
           app_log("Connected to server 1\n");
+          conn[0].connected_ok = true;
+          init_payload_context(1, &evt->data.evt_connection_opened.address);
+          host_ctrl_notify_state(1);
           live_connections++;
       }
       if (current_connection == conn[1].handle) {
           app_log("Connected to server 2\n");
+          conn[1].connected_ok = true;
+          init_payload_context(2, &evt->data.evt_connection_opened.address);
+          host_ctrl_notify_state(2);
           live_connections++;
       }
       if (current_connection == conn[2].handle) {
           app_log("Connected to server 3\n");
+          conn[2].connected_ok = true;
+          init_payload_context(3, &evt->data.evt_connection_opened.address);
+          host_ctrl_notify_state(3);
           live_connections++;
       }
       state = connecting;
@@ -323,13 +417,22 @@ void sl_bt_on_event(sl_bt_msg_t *evt)
       if (evt->data.evt_connection_closed.connection == conn[0].handle) {
         app_log("Connection 1 closed, restarting scan...\n");
         conn[0].connected_ok = false;
+        host_ctrl_notify_state(1);
+        secure_payload_deinit(&payload_context[0]);
       } else if (evt->data.evt_connection_closed.connection == conn[1].handle) {
         app_log("Connection 2 closed, restarting scan...\n");
         conn[1].connected_ok = false;
+        host_ctrl_notify_state(2);
+        secure_payload_deinit(&payload_context[1]);
       } else if (evt->data.evt_connection_closed.connection == conn[2].handle) {
         app_log("Connection 3 closed, restarting scan...\n");
-        conn[1].connected_ok = false;
+        conn[2].connected_ok = false;
+        host_ctrl_notify_state(3);
+        secure_payload_deinit(&payload_context[2]);
       }
+#if SL_POWER_MANAGER_PROFILE
+      print_power_manager_profile();
+#endif
       // Update connection count
       if (live_connections > 0) {
         live_connections--;
@@ -351,6 +454,10 @@ void sl_bt_on_event(sl_bt_msg_t *evt)
     default:
       break;
   }
+
+  // Once the application has handled the event
+  fast_boot_on_event(evt);
+  buffer_pool_on_event(evt);
 }
 
 /**************************************************************************//**
@@ -473,25 +580,225 @@ void sl_read_data(uint8_t connection) {
 }
 
 void sl_recieved_data(uint8_t connection, uint16_t characteristic, uint8array *received_value) {
+  // The servers seal their values, decrypt them in place first
+  if (open_server_value(connection, characteristic, received_value) != SL_STATUS_OK) {
+    app_log_warning("Rejected value of characteristic %d\n", characteristic);
+    return;
+  }
   if (connection == conn[0].handle && characteristic == characteristic_handle[0]) {
-      app_log("LED state received value by server 1: %d\n", received_value->data[0]);
-      led_state_1 = received_value->data[0];
+      app_log("LED state received value by server 1: %d\n", received_value->data[SECURE_PAYLOAD_HEADER_SIZE]);
+      led_state_1 = received_value->data[SECURE_PAYLOAD_HEADER_SIZE];
+      host_ctrl_notify_state(1);
+      save_server_state(1);
   } else if (connection == conn[0].handle && characteristic == characteristic_handle[1]) {
-      app_log("FAN state received value by server 1: %d\n", received_value->data[0]);
-      fan_state_1 = received_value->data[0];
+      app_log("FAN state received value by server 1: %d\n", received_value->data[SECURE_PAYLOAD_HEADER_SIZE]);
+      fan_state_1 = received_value->data[SECURE_PAYLOAD_HEADER_SIZE];
+      host_ctrl_notify_state(1);
+      save_server_state(1);
   } else if (connection == conn[1].handle && characteristic == characteristic_handle[0]) {
-      app_log("LED state received value by server 2: %d\n", received_value->data[0]);
-      led_state_2 = received_value->data[0];
+      app_log("LED state received value by server 2: %d\n", received_value->data[SECURE_PAYLOAD_HEADER_SIZE]);
+      led_state_2 = received_value->data[SECURE_PAYLOAD_HEADER_SIZE];
+      host_ctrl_notify_state(2);
+      save_server_state(2);
   } else if (connection == conn[1].handle && characteristic == characteristic_handle[1]) {
-      app_log("FAN state received value by server 2: %d\n", received_value->data[0]);
-      fan_state_2 = received_value->data[0];
+      app_log("FAN state received value by server 2: %d\n", received_value->data[SECURE_PAYLOAD_HEADER_SIZE]);
+      fan_state_2 = received_value->data[SECURE_PAYLOAD_HEADER_SIZE];
+      host_ctrl_notify_state(2);
+      save_server_state(2);
   } else if (connection == conn[2].handle && characteristic == characteristic_handle[0]) {
-      app_log("LED state received value by server 3: %d\n", received_value->data[0]);
-      led_state_3 = received_value->data[0];
+      app_log("LED state received value by server 3: %d\n", received_value->data[SECURE_PAYLOAD_HEADER_SIZE]);
+      led_state_3 = received_value->data[SECURE_PAYLOAD_HEADER_SIZE];
+      host_ctrl_notify_state(3);
+      save_server_state(3);
   } else if (connection == conn[2].handle && characteristic == characteristic_handle[1]) {
-      app_log("FAN state received value by server 3: %d\n", received_value->data[0]);
-      fan_state_3 = received_value->data[0];
+      app_log("FAN state received value by server 3: %d\n", received_value->data[SECURE_PAYLOAD_HEADER_SIZE]);
+      fan_state_3 = received_value->data[SECURE_PAYLOAD_HEADER_SIZE];
+      host_ctrl_notify_state(3);
+      save_server_state(3);
   } else {
       app_log("Received unknown characteristic value\n");
   }
 }
+
+void app_get_server_state(uint8_t server, uint8_t *connected, uint8_t *led, uint8_t *fan) {
+  *connected = 0;
+  *led = 0;
+  *fan = 0;
+
+  if (server == 0 || server > MAX_CONNECTION) {
+    return;
+  }
+  *connected = conn[server - 1].connected_ok ? 1 : 0;
+
+  switch (server) {
+    case 1:
+      *led = led_state_1;
+      *fan = fan_state_1;
+      break;
+    case 2:
+      *led = led_state_2;
+      *fan = fan_state_2;
+      break;
+    case 3:
+      *led = led_state_3;
+      *fan = fan_state_3;
+      break;
+  }
+}
+
+sl_status_t app_set_server_output(uint8_t server, uint8_t output, uint8_t value) {
+  uint16_t sent_len;
+
+  if (server == 0 || server > MAX_CONNECTION || output > FAN_CONTROL) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  if (!conn[server - 1].connected_ok) {
+    return SL_STATUS_INVALID_STATE;
+  }
+
+  return sl_bt_gatt_write_characteristic_value_without_response(conn[server - 1].handle,
+                                                                characteristic_handle[output],
+                                                                1,
+                                                                &value,
+                                                                &sent_len);
+}
+
+static void load_server_states(void) {
+  device_data_t data;
+
+  if (state_journal_read(1, &data, sizeof(data)) == SL_STATUS_OK) {
+    led_state_1 = data.led_status;
+    fan_state_1 = data.fan_status;
+  }
+  if (state_journal_read(2, &data, sizeof(data)) == SL_STATUS_OK) {
+    led_state_2 = data.led_status;
+    fan_state_2 = data.fan_status;
+  }
+  if (state_journal_read(3, &data, sizeof(data)) == SL_STATUS_OK) {
+    led_state_3 = data.led_status;
+    fan_state_3 = data.fan_status;
+  }
+}
+
+static void save_server_state(uint8_t server) {
+  device_data_t data;
+  uint8_t connected;
+
+  app_get_server_state(server, &connected, &data.led_status, &data.fan_status);
+  // Record id is the server number
+  state_journal_write(server, &data, sizeof(data));
+}
+
+/**************************************************************************//**
+ * Load the payload key of a server and restore its counter.
+ *
+ * The counters are kept per server address, whichever connection slot the
+ * server comes back on. Without a provisioned key the values of the server
+ * are rejected.
+ *
+ * @param[in] server   Server number, starting from 1.
+ * @param[in] address  Address of the server, the first bytes of its payload
+ *                     id.
+ *****************************************************************************/
+static void init_payload_context(uint8_t server, const bd_addr *address) {
+  uint8_t payload_id[SECURE_PAYLOAD_ID_SIZE] = { 0 };
+  nvm3_ObjectKey_t counter_key;
+
+  memcpy(payload_id, address->addr, sizeof(address->addr));
+  payload_id[sizeof(address->addr)] = APP_SECURE_PAYLOAD_TO_CENTRAL;
+  // The context of the slot is closed, only the other servers hold keys
+  sc = secure_payload_find_counter(payload_id, APP_NVM3_KEY_SECURE_PAYLOAD,
+                                   APP_SECURE_PAYLOAD_PEERS, payload_context,
+                                   MAX_CONNECTION, &counter_key);
+  app_assert_status(sc);
+  sc = secure_payload_init(&payload_context[server - 1], APP_NVM3_KEY_SECURE_PAYLOAD_KEY,
+                           payload_id, false, counter_key);
+  if (sc == SL_STATUS_NOT_INITIALIZED) {
+    app_log_warning("No payload key provisioned, values of server %d are rejected\n", server);
+  } else {
+    app_assert_status(sc);
+  }
+}
+
+/**************************************************************************//**
+ * Authenticate and decrypt a value read from a server, in place.
+ *
+ * @param[in] connection      Connection handle of the server.
+ * @param[in] characteristic  Characteristic read.
+ * @param[in,out] value       Sealed value, receives the payload at
+ *                            SECURE_PAYLOAD_HEADER_SIZE.
+ *
+ * @return Status of secure_payload_open(), SL_STATUS_NOT_FOUND for an
+ *         unknown server or characteristic.
+ *****************************************************************************/
+static sl_status_t open_server_value(uint8_t connection, uint16_t characteristic, uint8array *value) {
+  uint8_t ad[2];
+  uint16_t uuid;
+  size_t payload_len;
+  sl_status_t status;
+
+  if (characteristic == characteristic_handle[LED_CONTROL]) {
+    uuid = LED_CONTROL_UUID;
+  } else if (characteristic == characteristic_handle[FAN_CONTROL]) {
+    uuid = FAN_CONTROL_UUID;
+  } else {
+    return SL_STATUS_NOT_FOUND;
+  }
+  ad[0] = (uint8_t)uuid;
+  ad[1] = (uint8_t)(uuid >> 8);
+
+  for (int i = 0; i < MAX_CONNECTION; i++) {
+    if (conn[i].connected_ok && connection == conn[i].handle) {
+      status = secure_payload_open(&payload_context[i], ad, sizeof(ad),
+                                   value->data, value->len, &payload_len);
+      if (status == SL_STATUS_OK && payload_len == 0) {
+        status = SL_STATUS_INVALID_PARAMETER;
+      }
+      return status;
+    }
+  }
+  return SL_STATUS_NOT_FOUND;
+}
+
+#if SL_POWER_MANAGER_PROFILE
+/**************************************************************************//**
+ * Print the energy mode profile accumulated since the boot.
+ *****************************************************************************/
+static void print_power_manager_profile(void)
+{
+  static const char *source_names[SL_POWER_MANAGER_WAKEUP_SOURCE_COUNT] = {
+    "Sleeptimer", "Radio", "UART", "Other"
+  };
+  sl_power_manager_profile_t profile;
+  uint64_t ms;
+  uint32_t permille;
+
+  sl_power_manager_profile_get(&profile);
+
+  sl_sleeptimer_tick64_to_ms(profile.duration_tick, &ms);
+  app_log("Energy mode profile over %lu ms\n", (unsigned long)ms);
+  for (uint32_t i = 0; i < SL_POWER_MANAGER_PROFILE_EM_COUNT; i++) {
+    sl_sleeptimer_tick64_to_ms(profile.residency_tick[i], &ms);
+    permille = (profile.duration_tick != 0)
+               ? (uint32_t)((profile.residency_tick[i] * 1000u) / profile.duration_tick) : 0;
+    app_log("  EM%lu: %10lu ms %3lu.%lu%% %8lu entries\n",
+            (unsigned long)i,
+            (unsigned long)ms,
+            (unsigned long)(permille / 10),
+            (unsigned long)(permille % 10),
+            (unsigned long)profile.transition_count[i]);
+  }
+  app_log("Wakeups by source\n");
+  for (uint32_t i = 0; i < SL_POWER_MANAGER_WAKEUP_SOURCE_COUNT; i++) {
+    app_log("  %-10s %8lu\n", source_names[i], (unsigned long)profile.wakeup_count[i]);
+  }
+  app_log("Active time from wakeup to sleep, in ticks\n");
+  for (uint32_t i = 0; i < SL_POWER_MANAGER_PROFILE_ACTIVE_TIME_BINS; i++) {
+    if (profile.active_time_histogram[i] != 0) {
+      app_log("  >= %-8lu %8lu\n",
+              (unsigned long)(i == 0 ? 0 : (1ul << i)),
+              (unsigned long)profile.active_time_histogram[i]);
+    }
+  }
+}
+#endif
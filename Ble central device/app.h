@@ -57,6 +57,18 @@
 
 #define MAX_CONNECTION                3
 
+// NVM3 key of the server state journal, in the application key range
+#define APP_NVM3_KEY_STATE_JOURNAL    0x00001
+// NVM3 key of the key of the application payloads exchanged between the
+// central and its servers, provisioned per product, see secure_payload.h
+#define APP_NVM3_KEY_SECURE_PAYLOAD_KEY 0x00002
+// NVM3 keys of the payload counters of the servers, one per server address
+#define APP_NVM3_KEY_SECURE_PAYLOAD   0x00010
+// Servers whose payload counters are kept
+#define APP_SECURE_PAYLOAD_PEERS      16
+// Direction byte of the payload id, after the sender address
+#define APP_SECURE_PAYLOAD_TO_CENTRAL 0x01
+
 
 typedef enum {
   scanning,
@@ -95,4 +107,25 @@ void app_init(void);
  *****************************************************************************/
 void app_process_action(void);
 
+/**************************************************************************//**
+ * Get the last known state of a server.
+ *
+ * @param[in] server       Server number, starting from 1.
+ * @param[out] connected   1 if the server is connected, 0 otherwise.
+ * @param[out] led         LED state.
+ * @param[out] fan         FAN state.
+ *****************************************************************************/
+void app_get_server_state(uint8_t server, uint8_t *connected, uint8_t *led, uint8_t *fan);
+
+/**************************************************************************//**
+ * Write an output characteristic of a connected server.
+ *
+ * @param[in] server   Server number, starting from 1.
+ * @param[in] output   LED_CONTROL or FAN_CONTROL.
+ * @param[in] value    Value to write.
+ *
+ * @return Status of the GATT write.
+ *****************************************************************************/
+sl_status_t app_set_server_output(uint8_t server, uint8_t output, uint8_t value);
+
 #endif // APP_H
@@ -0,0 +1,17 @@
+/***************************************************************************//**
+ * @file
+ * @brief Bluetooth stack features left out of sl_bt_stack_init.c
+ *******************************************************************************
+ * Generated by bt_feature_trim.py from the sl_bt_* commands and events the
+ * project compiles in, run it again after using a new class of the API or
+ * changing a build option. Included by sl_bt_stack_init.c when
+ * SL_BT_CONFIG_FEATURE_TRIM is set.
+ ******************************************************************************/
+
+#ifndef SL_BT_FEATURE_TRIM_H
+#define SL_BT_FEATURE_TRIM_H
+
+// legacy_advertiser: no sl_bt_legacy_advertiser_* command or event, about 80 bytes of flash and 0 of RAM
+#undef SL_CATALOG_BLUETOOTH_FEATURE_LEGACY_ADVERTISER_PRESENT
+
+#endif // SL_BT_FEATURE_TRIM_H
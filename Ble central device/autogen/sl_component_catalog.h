@@ -16,6 +16,7 @@
 #define SL_CATALOG_BLUETOOTH_FEATURE_GATT_SERVER_PRESENT
 #define SL_CATALOG_BLUETOOTH_FEATURE_LEGACY_ADVERTISER_PRESENT
 #define SL_CATALOG_BLUETOOTH_FEATURE_LEGACY_SCANNER_PRESENT
+#define SL_CATALOG_BLUETOOTH_FEATURE_RESOURCE_REPORT_PRESENT
 #define SL_CATALOG_BLUETOOTH_FEATURE_SCANNER_PRESENT
 #define SL_CATALOG_BLUETOOTH_FEATURE_SM_PRESENT
 #define SL_CATALOG_BLUETOOTH_FEATURE_SYSTEM_PRESENT
@@ -9,6 +9,14 @@
   #define MBEDTLS_RSA_NO_CRT
 #endif
 
+#if SL_MBEDTLS_CT_WORD_ACCESS
+  #define MBEDTLS_CT_WORD_ACCESS
+#endif
+
+#if SL_MBEDTLS_PSA_CRYPTO_LAZY_INIT
+  #define MBEDTLS_PSA_CRYPTO_LAZY_INIT
+#endif
+
 // Allow undefining the specified cipher suites
 #if defined(SLI_MBEDTLS_AUTODETECT_CIPHERSUITES)
   #undef MBEDTLS_SSL_CIPHERSUITES
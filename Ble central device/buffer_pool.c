@@ -0,0 +1,319 @@
+/***************************************************************************//**
+ * @file
+ * @brief Bluetooth stack buffer pool usage and sizing.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "app_log.h"
+#include "buffer_pool.h"
+
+static buffer_pool_report_t pool;
+static uint16_t rx_queued[BUFFER_POOL_MAX_CONNECTIONS];
+static uint8_t open_count = 0;
+static bool booted = false;
+#if BUFFER_POOL_SIZING
+static uint32_t armed_low = 0;
+#endif
+
+static buffer_pool_connection_t *find_connection(uint8_t connection);
+static void note_used(uint32_t used);
+static void sample(void);
+static void count_rx(uint8_t connection);
+static void log_connection(const buffer_pool_connection_t *entry, uint16_t reason);
+#if BUFFER_POOL_SIZING
+static void arm_threshold(void);
+static uint32_t recommend(void);
+#endif
+
+/***************************************************************************//**
+ * Bluetooth stack event handler.
+ ******************************************************************************/
+void buffer_pool_on_event(sl_bt_msg_t *evt)
+{
+  buffer_pool_connection_t *entry;
+
+  switch (SL_BT_MSG_ID(evt->header)) {
+    case sl_bt_evt_system_boot_id:
+      // Applies to the connections opened from now on
+      sl_bt_resource_enable_connection_tx_report(BUFFER_POOL_TX_REPORT_PACKETS);
+      memset(&pool, 0, sizeof(pool));
+      memset(rx_queued, 0, sizeof(rx_queued));
+      pool.configured = SL_BT_CONFIG_BUFFER_SIZE;
+      open_count = 0;
+      booted = true;
+      break;
+
+    case sl_bt_evt_connection_opened_id:
+      entry = find_connection(0);
+      if (entry != NULL) {
+        memset(entry, 0, sizeof(*entry));
+        entry->connection = evt->data.evt_connection_opened.connection;
+        rx_queued[entry - pool.connections] = 0;
+        open_count++;
+      }
+      break;
+
+    case sl_bt_evt_connection_closed_id:
+      entry = find_connection(evt->data.evt_connection_closed.connection);
+      if (entry != NULL) {
+        sample();
+        log_connection(entry, evt->data.evt_connection_closed.reason);
+        entry->connection = 0;
+        open_count--;
+      }
+      break;
+
+    case sl_bt_evt_system_resource_exhausted_id:
+      pool.buffers_discarded += evt->data.evt_system_resource_exhausted.num_buffers_discarded;
+      pool.buffer_allocation_failures += evt->data.evt_system_resource_exhausted.num_buffer_allocation_failures;
+      pool.heap_allocation_failures += evt->data.evt_system_resource_exhausted.num_heap_allocation_failures;
+      break;
+
+#if BUFFER_POOL_SIZING
+    case sl_bt_evt_resource_status_id:
+      // The free space crossed the armed threshold
+      if (pool.total >= evt->data.evt_resource_status.free_bytes) {
+        note_used(pool.total - evt->data.evt_resource_status.free_bytes);
+      }
+      break;
+#endif
+
+#if BUFFER_POOL_GATT_CLIENT
+    case sl_bt_evt_gatt_characteristic_value_id:
+      count_rx(evt->data.evt_gatt_characteristic_value.connection);
+      break;
+#endif
+
+    case sl_bt_evt_gatt_server_attribute_value_id:
+      count_rx(evt->data.evt_gatt_server_attribute_value.connection);
+      break;
+
+    case sl_bt_evt_gatt_server_user_write_request_id:
+      count_rx(evt->data.evt_gatt_server_user_write_request.connection);
+      break;
+
+    default:
+      break;
+  }
+
+  if (!sl_bt_event_pending()) {
+    // The queue drained, the next data events start a new backlog
+    memset(rx_queued, 0, sizeof(rx_queued));
+  }
+
+  if (booted) {
+    sample();
+  }
+}
+
+/***************************************************************************//**
+ * Get the usage of the pool and of the open connections.
+ ******************************************************************************/
+void buffer_pool_get_report(buffer_pool_report_t *report)
+{
+  if (booted) {
+    sample();
+  }
+  *report = pool;
+#if BUFFER_POOL_SIZING
+  report->recommended = recommend();
+#endif
+}
+
+/***************************************************************************//**
+ * Restart the peaks and the failure counts from the current usage.
+ ******************************************************************************/
+void buffer_pool_reset(void)
+{
+  pool.peak = pool.used;
+  pool.link_peak = 0;
+  if (open_count == 0) {
+    pool.idle_peak = pool.used;
+  }
+  pool.buffers_discarded = 0;
+  pool.buffer_allocation_failures = 0;
+  pool.heap_allocation_failures = 0;
+  for (uint8_t i = 0; i < BUFFER_POOL_MAX_CONNECTIONS; i++) {
+    pool.connections[i].tx_flags = 0;
+    pool.connections[i].tx_peak_packets = pool.connections[i].tx_packets;
+    pool.connections[i].tx_peak_bytes = pool.connections[i].tx_bytes;
+    pool.connections[i].rx_peak_events = 0;
+  }
+#if BUFFER_POOL_SIZING
+  armed_low = 0;
+  arm_threshold();
+#endif
+}
+
+/***************************************************************************//**
+ * Find the entry of a connection, or a free entry for connection 0.
+ ******************************************************************************/
+static buffer_pool_connection_t *find_connection(uint8_t connection)
+{
+  for (uint8_t i = 0; i < BUFFER_POOL_MAX_CONNECTIONS; i++) {
+    if (pool.connections[i].connection == connection) {
+      return &pool.connections[i];
+    }
+  }
+  return NULL;
+}
+
+/***************************************************************************//**
+ * Update the peaks with the bytes in use.
+ ******************************************************************************/
+static void note_used(uint32_t used)
+{
+  if (used > pool.peak) {
+    pool.peak = used;
+  }
+  if (open_count == 0) {
+    if (used > pool.idle_peak) {
+      pool.idle_peak = used;
+    }
+  } else if (used > pool.idle_peak) {
+    uint32_t per_link = (used - pool.idle_peak + open_count - 1) / open_count;
+
+    if (per_link > pool.link_peak) {
+      pool.link_peak = per_link;
+    }
+  }
+#if BUFFER_POOL_SIZING
+  arm_threshold();
+#endif
+}
+
+/***************************************************************************//**
+ * Read the usage of the pool and the TX queue of each open connection.
+ ******************************************************************************/
+static void sample(void)
+{
+  uint32_t total;
+  uint32_t free_bytes;
+
+  if (sl_bt_resource_get_status(&total, &free_bytes) == SL_STATUS_OK && total >= free_bytes) {
+    pool.total = total;
+    pool.used = total - free_bytes;
+    note_used(pool.used);
+  }
+
+  for (uint8_t i = 0; i < BUFFER_POOL_MAX_CONNECTIONS; i++) {
+    buffer_pool_connection_t *entry = &pool.connections[i];
+    uint16_t flags;
+    uint16_t packets;
+    uint32_t bytes;
+
+    if (entry->connection == 0
+        || sl_bt_resource_get_connection_tx_status(entry->connection, &flags,
+                                                   &packets, &bytes) != SL_STATUS_OK) {
+      continue;
+    }
+    entry->tx_flags |= flags;
+    entry->tx_packets = packets;
+    entry->tx_bytes = bytes;
+    if (packets > entry->tx_peak_packets) {
+      entry->tx_peak_packets = packets;
+    }
+    if (bytes > entry->tx_peak_bytes) {
+      entry->tx_peak_bytes = bytes;
+    }
+  }
+}
+
+/***************************************************************************//**
+ * Count a data event of a connection in the current backlog.
+ ******************************************************************************/
+static void count_rx(uint8_t connection)
+{
+  buffer_pool_connection_t *entry;
+  uint8_t i;
+
+  // Connection 0 would find a free entry
+  entry = (connection != 0) ? find_connection(connection) : NULL;
+  if (entry == NULL) {
+    return;
+  }
+  i = (uint8_t)(entry - pool.connections);
+  rx_queued[i]++;
+  if (rx_queued[i] > entry->rx_peak_events) {
+    entry->rx_peak_events = rx_queued[i];
+  }
+}
+
+/***************************************************************************//**
+ * Log the queues of a closing connection and the usage of the pool.
+ ******************************************************************************/
+static void log_connection(const buffer_pool_connection_t *entry, uint16_t reason)
+{
+  app_log_info("buffer pool: connection %d closed (0x%04x), TX peak %u packets %lu bytes, RX peak %u events\n",
+               entry->connection,
+               reason,
+               entry->tx_peak_packets,
+               (unsigned long)entry->tx_peak_bytes,
+               entry->rx_peak_events);
+  if (entry->tx_flags != 0) {
+    app_log_warning("buffer pool: connection %d TX report flags 0x%04x, TX peak not reliable\n",
+                    entry->connection,
+                    entry->tx_flags);
+  }
+  app_log_info("buffer pool: %lu of %lu bytes used, peak %lu, %lu discarded, %lu allocation failures\n",
+               (unsigned long)pool.used,
+               (unsigned long)pool.total,
+               (unsigned long)pool.peak,
+               (unsigned long)pool.buffers_discarded,
+               (unsigned long)(pool.buffer_allocation_failures + pool.heap_allocation_failures));
+#if BUFFER_POOL_SIZING
+  app_log_info("buffer pool: %lu idle, %lu per connection, SL_BT_CONFIG_BUFFER_SIZE %lu recommended for %d connections\n",
+               (unsigned long)pool.idle_peak,
+               (unsigned long)pool.link_peak,
+               (unsigned long)recommend(),
+               SL_BT_CONFIG_MAX_CONNECTIONS);
+#endif
+}
+
+#if BUFFER_POOL_SIZING
+/***************************************************************************//**
+ * Ask for an event when the free space drops a step below its lowest level.
+ ******************************************************************************/
+static void arm_threshold(void)
+{
+  uint32_t lowest_free = pool.total - pool.peak;
+  uint32_t low = (lowest_free > BUFFER_POOL_SIZING_STEP) ? lowest_free - BUFFER_POOL_SIZING_STEP : 0;
+
+  if (pool.total == 0 || low == armed_low) {
+    return;
+  }
+  // 0 disables the reports, the allocation failures take over from there
+  if (sl_bt_resource_set_report_threshold(low, 0) == SL_STATUS_OK) {
+    armed_low = low;
+  }
+}
+
+/***************************************************************************//**
+ * Pool size for the peaks seen, scaled to all the connections.
+ ******************************************************************************/
+static uint32_t recommend(void)
+{
+  uint32_t need = pool.idle_peak + pool.link_peak * SL_BT_CONFIG_MAX_CONNECTIONS;
+
+  need = need * (100 + BUFFER_POOL_HEADROOM_PERCENT) / 100;
+  // The stack keeps part of the configured size for itself
+  if (pool.configured > pool.total) {
+    need += pool.configured - pool.total;
+  }
+  if (pool.buffers_discarded > 0 || pool.buffer_allocation_failures > 0) {
+    // The peaks were clipped, grow from the current size
+    uint32_t grown = pool.configured * (100 + BUFFER_POOL_HEADROOM_PERCENT) / 100;
+
+    if (grown > need) {
+      need = grown;
+    }
+  }
+  return (need + BUFFER_POOL_SIZING_STEP - 1) / BUFFER_POOL_SIZING_STEP * BUFFER_POOL_SIZING_STEP;
+}
+#endif // BUFFER_POOL_SIZING
@@ -25,7 +25,7 @@
 // <i> gracefully in case an application opens more than its declared amount of
 // <i> keys, thereby precluding the stack from functioning.
 // <i> Default: 4
-#define SL_PSA_KEY_USER_SLOT_COUNT     0
+#define SL_PSA_KEY_USER_SLOT_COUNT     1
 
 // <o SL_PSA_ITS_USER_MAX_FILES> PSA Maximum User Persistent Keys Count <0-1024>
 // <i> Maximum amount of keys (or other files) that can be stored persistently
@@ -86,6 +86,16 @@
 // <i> Default: 1
 #define SL_PSA_ITS_SUPPORT_V3_DRIVER 1
 
+// <o SL_PSA_ITS_SESSION_KEY_CACHE_SIZE> Encrypted ITS Session Key Cache Size <1-16>
+// <i> Number of session keys of encrypted ITS files kept in RAM, so that
+// <i> reading a file does not derive its key again. Applications that access
+// <i> several encrypted files in turn (e.g. bonding keys during reconnects)
+// <i> benefit from one entry per file. Each entry uses 32 bytes of RAM, and
+// <i> the least recently used entry is zeroized when replaced.
+// <i> Only used when ITS encryption is enabled.
+// <i> Default: 4
+#define SL_PSA_ITS_SESSION_KEY_CACHE_SIZE 4
+
 // <o SL_SE_BUILTIN_KEY_AES128_ALG_CONFIG> Built-in AES Key Mode of Operation
 // <PSA_ALG_CTR=> CTR Mode
 // <PSA_ALG_CFB=> CFB Mode
@@ -110,6 +120,61 @@
 
 // </h>
 
+// <h> Hash configuration
+
+// <o SL_CRYPTOACC_HASH_STAGING_BLOCKS> Number of hash blocks staged before processing <1-16>
+// <i> Multipart SHA-1/SHA-224/SHA-256 operations collect input in a staging
+// <i> buffer of this many 64-byte blocks, and only hand it to the CRYPTOACC
+// <i> once it is full. Callers feeding small updates then pay the setup of
+// <i> a hardware transfer once per staging buffer instead of once per block.
+// <i> Updates at least as large as the staging buffer are processed directly.
+// <i> Each block adds 64 bytes to every hash operation context.
+// <i>
+// <i> Default: 4
+#define SL_CRYPTOACC_HASH_STAGING_BLOCKS  (4)
+
+// </h>
+
+// <h> ECC keypair cache configuration
+
+// <o SL_CRYPTOACC_ECC_KEYPAIR_CACHE_SIZE> Number of P-256 keypairs generated ahead <0-4>
+// <i> LE Secure Connections pairing generates a P-256 keypair at connection
+// <i> time. The cache generates the next keypairs in idle time, so that
+// <i> psa_generate_key() and the export of the public key return at once.
+// <i> Keypairs are wiped from the cache when handed out. 0 disables the cache.
+// <i>
+// <i> NOTE: the idle-time generation requires calling
+// <i> sli_cryptoacc_ecc_keypair_cache_is_ok_to_sleep() and
+// <i> sli_cryptoacc_ecc_keypair_cache_process_action() from the application.
+// <i>
+// <i> Default: 1
+#define SL_CRYPTOACC_ECC_KEYPAIR_CACHE_SIZE  (1)
+
+// <o SL_CRYPTOACC_ECC_KEYPAIR_CACHE_MAX_AGE_S> Maximum age of a cached keypair, in seconds <0-86400>
+// <i> Unused keypairs older than this are wiped and generated again, which
+// <i> bounds how long key material waits in RAM. 0 keeps keypairs until used.
+// <i>
+// <i> Default: 900
+#define SL_CRYPTOACC_ECC_KEYPAIR_CACHE_MAX_AGE_S  (900)
+
+// </h>
+
+// <h> AEAD batch configuration
+
+// <q SL_CRYPTOACC_AEAD_BATCH> Chain batches of AES-CTR/CCM messages in one transfer
+// <i> sli_cryptoacc_transparent_aead_batch() links the descriptors of several
+// <i> independent messages into one CRYPTOACC transfer. When disabled, it
+// <i> returns PSA_ERROR_NOT_SUPPORTED.
+// <i>
+// <i> NOTE: not validated on hardware yet. Whether the DMA accepts the
+// <i> descriptors of the next message after the last descriptor of a
+// <i> message is only checked on the host by test/aes_batch.
+// <i>
+// <i> Default: 0
+#define SL_CRYPTOACC_AEAD_BATCH  0
+
+// </h>
+
 // <h> Power optimization configuration
 
 // <e SL_VSE_BUFFER_TRNG_DATA_DURING_SLEEP> Store already-generated random bytes before putting the device to sleep
@@ -144,6 +209,19 @@
 #define SL_VSE_MAX_TRNG_WORDS_BUFFERED_DURING_SLEEP (63)
 // </e>
 
+// <o SL_VSE_TRNG_POOL_WORDS> Number of random words kept ready in RAM <0-64>
+// <i> Requests for random bytes (for example during pairing) are served from
+// <i> a pool in RAM without waiting for the TRNG to start up. The pool is
+// <i> refilled from the TRNG FIFO in idle time and on EM2/EM3 entry. 0
+// <i> disables the pool.
+// <i>
+// <i> NOTE: the idle-time refill requires calling
+// <i> sli_cryptoacc_trng_pool_is_ok_to_sleep() and
+// <i> sli_cryptoacc_trng_pool_process_action() from the application.
+// <i>
+// <i> Default: 16
+#define SL_VSE_TRNG_POOL_WORDS  (16)
+
 // </h>
 
 // <<< end of configuration section >>>
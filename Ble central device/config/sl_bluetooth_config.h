@@ -68,6 +68,13 @@
 // <i> higher data throughput over connections, advertising or scanning long advertisement data.
 #define SL_BT_CONFIG_BUFFER_SIZE    (3150)
 
+// <q SL_BT_CONFIG_FEATURE_TRIM> Leave out the Bluetooth features the application does not use
+// <i> Default: 0
+// <i> sl_bt_stack_init.c includes sl_bt_feature_trim.h, which bt_feature_trim.py generates from
+// <i> the sl_bt_* commands and events of the project. The features it lists are not linked in,
+// <i> run the script again before using a new class of the API.
+#define SL_BT_CONFIG_FEATURE_TRIM    (0)
+
 // </h> End Bluetooth Stack Configuration
 
 // <h> TX Power Levels
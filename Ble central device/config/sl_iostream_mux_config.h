@@ -0,0 +1,57 @@
+/***************************************************************************//**
+ * @file
+ * @brief IOSTREAM_MUX Config.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#ifndef SL_IOSTREAM_MUX_CONFIG_H
+#define SL_IOSTREAM_MUX_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+// <h>I/O Stream multiplexer settings
+
+// <o SL_IOSTREAM_MUX_MAX_FRAME_DATA_SIZE> Maximum data bytes per frame <8-253>
+// <i> Default: 64
+// <i> A higher priority channel can only preempt a lower priority one between
+// <i> frames, smaller frames lower the latency of urgent channels.
+#define SL_IOSTREAM_MUX_MAX_FRAME_DATA_SIZE     64
+
+// <o SL_IOSTREAM_MUX_TX_BUDGET> Maximum data bytes sent per process action <1-4096>
+// <i> Default: 256
+// <i> Bounds the time spent draining channels from the super loop.
+#define SL_IOSTREAM_MUX_TX_BUDGET               256
+
+// </h>
+
+// <h>VCOM channels
+// <i> Channels added to the multiplexer on VCOM by
+// <i> sl_iostream_mux_init_instances(), with their identifier, transmit
+// <i> priority and buffer sizes.
+
+// <o SL_IOSTREAM_MUX_VCOM_LOG_TX_BUFFER_SIZE> Log channel (id 0, priority 0) transmit buffer size <16-4096>
+// <i> Default: 256
+#define SL_IOSTREAM_MUX_VCOM_LOG_TX_BUFFER_SIZE       256
+
+// <o SL_IOSTREAM_MUX_VCOM_TRACE_TX_BUFFER_SIZE> Trace channel (id 1, priority 1) transmit buffer size <16-4096>
+// <i> Default: 64
+#define SL_IOSTREAM_MUX_VCOM_TRACE_TX_BUFFER_SIZE     64
+
+// <o SL_IOSTREAM_MUX_VCOM_CONTROL_TX_BUFFER_SIZE> Control channel (id 2, priority 2) transmit buffer size <16-4096>
+// <i> Default: 160
+#define SL_IOSTREAM_MUX_VCOM_CONTROL_TX_BUFFER_SIZE   160
+
+// <o SL_IOSTREAM_MUX_VCOM_CONTROL_RX_BUFFER_SIZE> Control channel receive buffer size <16-4096>
+// <i> Default: 160
+#define SL_IOSTREAM_MUX_VCOM_CONTROL_RX_BUFFER_SIZE   160
+
+// </h>
+
+// <<< end of configuration section >>>
+
+#endif // SL_IOSTREAM_MUX_CONFIG_H
@@ -87,6 +87,20 @@
 // <i> secure key handling (PSA Crypto).
 #define SL_MBEDTLS_DRIVERS_ENABLED 1
 
+// <q SL_MBEDTLS_CT_WORD_ACCESS> Process whole words in the constant-time buffer functions.
+// <i> Default: 1
+// <i> Compare, select and wipe buffers a word at a time instead of byte by
+// <i> byte in the constant-time helpers (MBEDTLS_CT_WORD_ACCESS).
+#define SL_MBEDTLS_CT_WORD_ACCESS 1
+
+// <q SL_MBEDTLS_PSA_CRYPTO_LAZY_INIT> Initialize PSA Crypto on first use.
+// <i> Default: 0
+// <i> Leave psa_crypto_init() and the RADIOAES mask seeding out of the system
+// <i> init, so that the Bluetooth stack starts advertising earlier. They run
+// <i> in the main loop once the stack has booted, or earlier on the first
+// <i> PSA call that needs them (MBEDTLS_PSA_CRYPTO_LAZY_INIT).
+#define SL_MBEDTLS_PSA_CRYPTO_LAZY_INIT 0
+
 // </h>
 
 // <<< end of configuration section >>>
@@ -47,6 +47,13 @@
 // <i> Default: 0
 #define SL_POWER_MANAGER_CONFIG_VOLTAGE_SCALING_FAST_WAKEUP   0
 
+// <q SL_POWER_MANAGER_ADAPTIVE_RESTORE_OVERHEAD> Enable adaptive restore overhead for schedule wake-up
+// <i> Measure the clock restore time on every early wake-up from EM2/EM3 and use a running
+// <i> estimate of it instead of the configured restore overhead.
+// <i> Can also be changed with sl_power_manager_schedule_wakeup_enable_adaptive_restore_overhead().
+// <i> Default: 0
+#define SL_POWER_MANAGER_ADAPTIVE_RESTORE_OVERHEAD  0
+
 // <e SL_POWER_MANAGER_DEBUG> Enable debugging feature
 // <i> Enable or disable debugging features (trace the different modules that have requirements).
 // <i> Default: 0
@@ -57,6 +64,12 @@
 #define SL_POWER_MANAGER_DEBUG_POOL_SIZE  10
 // </e>
 
+// <q SL_POWER_MANAGER_PROFILE> Enable energy mode profiling
+// <i> Track the time spent in each energy mode, the transitions, the wakeup sources
+// <i> and the active time between wakeup and sleep. See sl_power_manager_profile.h.
+// <i> Default: 0
+#define SL_POWER_MANAGER_PROFILE  0
+
 // </h>
 
 #endif /* SL_POWER_MANAGER_CONFIG_H */
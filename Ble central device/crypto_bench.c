@@ -0,0 +1,607 @@
+/***************************************************************************//**
+ * @file
+ * @brief Micro-benchmarks of the PSA Crypto configuration.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+#include <string.h>
+#include "psa/crypto.h"
+#include "mbedtls/constant_time.h"
+#include "constant_time_internal.h"
+#include "crypto_bench.h"
+
+#if defined(CRYPTO_BENCH_HOST)
+#include <time.h>
+#else
+#include "em_device.h"
+#endif
+
+#if defined(CRYPTOACC_PRESENT) && defined(PSA_WANT_ALG_CCM)
+#include "sli_cryptoacc_transparent_types.h"
+#include "sli_cryptoacc_transparent_functions.h"
+#if SL_CRYPTOACC_AEAD_BATCH
+#define BENCH_AEAD_BATCH
+#endif
+#endif
+
+#if defined(PSA_WANT_ALG_CCM) && !defined(CRYPTO_BENCH_HOST)
+#include "secure_payload.h"
+#define BENCH_SECURE_PAYLOAD
+#endif
+
+#if defined(PSA_WANT_ALG_ECDH) && defined(PSA_WANT_ECC_SECP_R1_256) \
+    && defined(PSA_WANT_KEY_TYPE_ECC_KEY_PAIR_GENERATE)
+#define BENCH_PAIRING
+#if defined(CRYPTOACC_PRESENT)
+#include "sli_cryptoacc_transparent_types.h"
+#include "sli_cryptoacc_transparent_functions.h"
+#define BENCH_PAIRING_CACHED
+#endif
+#endif
+
+#define BENCH_KEY_SIZE      16
+#define BENCH_NONCE_SIZE    13
+#define BENCH_TAG_SIZE      16
+#define BENCH_HASH_SIZE     32
+
+// One PSA call on the bench buffers
+typedef psa_status_t (*bench_call_t)(size_t size);
+
+// Untimed work before each call, standing for the idle time between calls
+static void (*bench_idle)(void);
+
+static mbedtls_svc_key_id_t bench_key;
+// Condition of the next CRYPTO_BENCH_OP_CT_MEMCPY_IF call
+static uint8_t bench_ct_condition;
+
+static uint8_t bench_in[CRYPTO_BENCH_MAX_SIZE];
+static uint8_t bench_out[CRYPTO_BENCH_MAX_SIZE + BENCH_TAG_SIZE];
+// Peer public key or signature, set up before the timed calls
+static uint8_t bench_ref[PSA_EXPORT_PUBLIC_KEY_MAX_SIZE];
+static size_t bench_ref_len;
+
+#if defined(BENCH_SECURE_PAYLOAD)
+static secure_payload_context_t bench_sender;
+static secure_payload_context_t bench_receiver;
+static uint8_t bench_packet[CRYPTO_BENCH_MAX_SIZE + SECURE_PAYLOAD_OVERHEAD];
+static size_t bench_packet_len;
+// Message size of the run, for the untimed seal
+static size_t bench_size;
+#endif
+
+#if defined(BENCH_AEAD_BATCH)
+static sli_cryptoacc_transparent_batch_item_t bench_batch[CRYPTO_BENCH_BATCH_COUNT];
+static uint8_t bench_batch_out[CRYPTO_BENCH_BATCH_COUNT][CRYPTO_BENCH_MAX_SIZE];
+static uint8_t bench_batch_tag[CRYPTO_BENCH_BATCH_COUNT][BENCH_TAG_SIZE];
+#endif
+
+static const uint8_t bench_key_data[BENCH_KEY_SIZE] = {
+  0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+  0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+
+#if defined(PSA_WANT_ALG_CCM)
+static const uint8_t bench_nonce[BENCH_NONCE_SIZE] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+  0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c
+};
+#endif
+
+static void timer_init(void);
+static uint32_t timer_now(void);
+static psa_status_t bench_setup(uint8_t op, bench_call_t *call);
+
+/***************************************************************************//**
+ * Get the frequency of the ticks reported in the results.
+ ******************************************************************************/
+uint32_t crypto_bench_get_tick_frequency(void)
+{
+#if defined(CRYPTO_BENCH_HOST)
+  return 1000000000UL;
+#else
+  return SystemCoreClockGet();
+#endif
+}
+
+/***************************************************************************//**
+ * Run a benchmark.
+ ******************************************************************************/
+sl_status_t crypto_bench_run(uint8_t op,
+                             uint16_t size,
+                             uint16_t iterations,
+                             crypto_bench_result_t *result)
+{
+  bench_call_t call = NULL;
+  psa_status_t status;
+
+  if ((result == NULL) || (op == 0) || (op > CRYPTO_BENCH_OP_COUNT)
+      || (size > CRYPTO_BENCH_MAX_SIZE)
+      || ((op == CRYPTO_BENCH_OP_CIPHER) && ((size % 16) != 0))
+      || (((op == CRYPTO_BENCH_OP_HASH_STREAM) || (op == CRYPTO_BENCH_OP_CT_MEMCMP_DIFF))
+          && (size == 0))) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  memset(result, 0, sizeof(*result));
+  result->min_ticks = UINT32_MAX;
+  bench_idle = NULL;
+
+  status = psa_crypto_init();
+  if (status == PSA_SUCCESS) {
+    bench_key = MBEDTLS_SVC_KEY_ID_INIT;
+    memset(bench_in, 0xa5, sizeof(bench_in));
+    status = bench_setup(op, &call);
+  }
+
+#if defined(BENCH_SECURE_PAYLOAD)
+  bench_size = size;
+#endif
+  timer_init();
+  while ((status == PSA_SUCCESS) && (result->iterations < iterations)) {
+    uint32_t start;
+    uint32_t ticks;
+
+    if (bench_idle != NULL) {
+      bench_idle();
+    }
+    start = timer_now();
+    status = call(size);
+    ticks = timer_now() - start;
+    if (status != PSA_SUCCESS) {
+      break;
+    }
+    result->iterations++;
+    result->total_ticks += ticks;
+    if (ticks < result->min_ticks) {
+      result->min_ticks = ticks;
+    }
+    if (ticks > result->max_ticks) {
+      result->max_ticks = ticks;
+    }
+  }
+
+  if (result->iterations == 0) {
+    result->min_ticks = 0;
+  }
+  result->status = status;
+  psa_destroy_key(bench_key);
+#if defined(BENCH_SECURE_PAYLOAD)
+  if ((op == CRYPTO_BENCH_OP_SECURE_PAYLOAD_SEAL) || (op == CRYPTO_BENCH_OP_SECURE_PAYLOAD_OPEN)) {
+    secure_payload_deinit(&bench_sender);
+    secure_payload_deinit(&bench_receiver);
+    nvm3_deleteObject(nvm3_defaultHandle, CRYPTO_BENCH_NVM3_KEY_SECURE_PAYLOAD_KEY);
+  }
+#endif
+#if defined(BENCH_PAIRING_CACHED)
+  sli_cryptoacc_ecc_keypair_cache_enable(true);
+#endif
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Enable the cycle counter.
+ ******************************************************************************/
+static void timer_init(void)
+{
+#if !defined(CRYPTO_BENCH_HOST)
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+/***************************************************************************//**
+ * Read the tick counter. Wraps around, only differences are meaningful.
+ ******************************************************************************/
+static uint32_t timer_now(void)
+{
+#if defined(CRYPTO_BENCH_HOST)
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+#else
+  return DWT->CYCCNT;
+#endif
+}
+
+#if defined(PSA_WANT_ALG_ECB_NO_PADDING)
+static psa_status_t call_cipher(size_t size)
+{
+  size_t len;
+
+  return psa_cipher_encrypt(bench_key, PSA_ALG_ECB_NO_PADDING, bench_in, size,
+                            bench_out, sizeof(bench_out), &len);
+}
+#endif
+
+#if defined(PSA_WANT_ALG_CCM)
+static psa_status_t call_aead(size_t size)
+{
+  size_t len;
+
+  return psa_aead_encrypt(bench_key, PSA_ALG_CCM, bench_nonce, sizeof(bench_nonce),
+                          NULL, 0, bench_in, size,
+                          bench_out, sizeof(bench_out), &len);
+}
+#endif
+
+#if defined(BENCH_AEAD_BATCH)
+static psa_status_t call_aead_batch(size_t size)
+{
+  for (size_t i = 0; i < CRYPTO_BENCH_BATCH_COUNT; i++) {
+    bench_batch[i].input_length = size;
+  }
+  return sli_cryptoacc_transparent_aead_batch(PSA_ALG_CCM, true,
+                                              bench_batch, CRYPTO_BENCH_BATCH_COUNT);
+}
+#endif
+
+#if defined(BENCH_SECURE_PAYLOAD)
+static psa_status_t call_secure_payload_seal(size_t size)
+{
+  return (secure_payload_seal(&bench_sender, NULL, 0, bench_packet, size,
+                              sizeof(bench_packet), &bench_packet_len) == SL_STATUS_OK)
+         ? PSA_SUCCESS : PSA_ERROR_GENERIC_ERROR;
+}
+
+static psa_status_t call_secure_payload_open(size_t size)
+{
+  size_t len;
+
+  (void)size;
+  return (secure_payload_open(&bench_receiver, NULL, 0, bench_packet,
+                              bench_packet_len, &len) == SL_STATUS_OK)
+         ? PSA_SUCCESS : PSA_ERROR_INVALID_SIGNATURE;
+}
+
+// A fresh packet for each open, as received from the peer
+static void idle_secure_payload_seal(void)
+{
+  memcpy(&bench_packet[SECURE_PAYLOAD_HEADER_SIZE], bench_in, bench_size);
+  call_secure_payload_seal(bench_size);
+}
+#endif
+
+#if defined(PSA_WANT_ALG_SHA_256)
+static psa_status_t call_hash(size_t size)
+{
+  size_t len;
+
+  return psa_hash_compute(PSA_ALG_SHA_256, bench_in, size,
+                          bench_out, BENCH_HASH_SIZE, &len);
+}
+#endif
+
+#if defined(PSA_WANT_ALG_SHA_256)
+static psa_status_t call_hash_stream(size_t size)
+{
+  psa_hash_operation_t operation = PSA_HASH_OPERATION_INIT;
+  psa_status_t status;
+  size_t len;
+
+  status = psa_hash_setup(&operation, PSA_ALG_SHA_256);
+  for (size_t done = 0; (status == PSA_SUCCESS) && (done < CRYPTO_BENCH_STREAM_SIZE); done += len) {
+    len = CRYPTO_BENCH_STREAM_SIZE - done;
+    if (len > size) {
+      len = size;
+    }
+    status = psa_hash_update(&operation, bench_in, len);
+  }
+  if (status == PSA_SUCCESS) {
+    status = psa_hash_finish(&operation, bench_out, BENCH_HASH_SIZE, &len);
+  }
+  psa_hash_abort(&operation);
+  return status;
+}
+#endif
+
+#if defined(PSA_WANT_ALG_CMAC)
+static psa_status_t call_mac(size_t size)
+{
+  size_t len;
+
+  return psa_mac_compute(bench_key, PSA_ALG_CMAC, bench_in, size,
+                         bench_out, BENCH_TAG_SIZE, &len);
+}
+#endif
+
+#if defined(PSA_WANT_ALG_ECDH) && defined(PSA_WANT_ECC_SECP_R1_256) \
+    && defined(PSA_WANT_KEY_TYPE_ECC_KEY_PAIR_GENERATE)
+static psa_status_t call_ecdh(size_t size)
+{
+  size_t len;
+
+  (void)size;
+  return psa_raw_key_agreement(PSA_ALG_ECDH, bench_key, bench_ref, bench_ref_len,
+                               bench_out, sizeof(bench_out), &len);
+}
+#endif
+
+#if defined(BENCH_PAIRING)
+// The key work of one side of LE Secure Connections pairing
+static psa_status_t call_pairing(size_t size)
+{
+  psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
+  mbedtls_svc_key_id_t key;
+  uint8_t pub[PSA_EXPORT_PUBLIC_KEY_MAX_SIZE];
+  psa_status_t status;
+  size_t len;
+
+  (void)size;
+  psa_set_key_type(&attr, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
+  psa_set_key_bits(&attr, 256);
+  psa_set_key_usage_flags(&attr, PSA_KEY_USAGE_DERIVE);
+  psa_set_key_algorithm(&attr, PSA_ALG_ECDH);
+  status = psa_generate_key(&attr, &key);
+  if (status != PSA_SUCCESS) {
+    return status;
+  }
+  status = psa_export_public_key(key, pub, sizeof(pub), &len);
+  if (status == PSA_SUCCESS) {
+    status = psa_raw_key_agreement(PSA_ALG_ECDH, key, bench_ref, bench_ref_len,
+                                   bench_out, sizeof(bench_out), &len);
+  }
+  psa_destroy_key(key);
+  return status;
+}
+#endif
+
+#if defined(BENCH_PAIRING_CACHED)
+// Idle time refill, as done from the power manager hooks
+static void idle_keypair_cache(void)
+{
+  while (!sli_cryptoacc_ecc_keypair_cache_is_ok_to_sleep()) {
+    sli_cryptoacc_ecc_keypair_cache_process_action();
+  }
+}
+#endif
+
+#if defined(PSA_WANT_ALG_ECDSA) && defined(PSA_WANT_ALG_SHA_256) \
+    && defined(PSA_WANT_ECC_SECP_R1_256) && defined(PSA_WANT_KEY_TYPE_ECC_KEY_PAIR_GENERATE)
+static psa_status_t call_ecdsa_sign(size_t size)
+{
+  size_t len;
+
+  (void)size;
+  return psa_sign_hash(bench_key, PSA_ALG_ECDSA(PSA_ALG_SHA_256),
+                       bench_in, BENCH_HASH_SIZE,
+                       bench_out, sizeof(bench_out), &len);
+}
+
+static psa_status_t call_ecdsa_verify(size_t size)
+{
+  (void)size;
+  return psa_verify_hash(bench_key, PSA_ALG_ECDSA(PSA_ALG_SHA_256),
+                         bench_in, BENCH_HASH_SIZE,
+                         bench_ref, bench_ref_len);
+}
+#endif
+
+#if defined(PSA_WANT_KEY_TYPE_ECC_KEY_PAIR_GENERATE) && defined(PSA_WANT_ECC_SECP_R1_256)
+static psa_status_t call_ecc_generate(size_t size)
+{
+  psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
+  mbedtls_svc_key_id_t key;
+  psa_status_t status;
+
+  (void)size;
+  psa_set_key_type(&attr, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
+  psa_set_key_bits(&attr, 256);
+  psa_set_key_usage_flags(&attr, PSA_KEY_USAGE_DERIVE);
+  psa_set_key_algorithm(&attr, PSA_ALG_ECDH);
+  status = psa_generate_key(&attr, &key);
+  if (status == PSA_SUCCESS) {
+    status = psa_destroy_key(key);
+  }
+  return status;
+}
+#endif
+
+// The constant-time helpers of Mbed TLS, see MBEDTLS_CT_WORD_ACCESS
+static psa_status_t call_ct_memcmp(size_t size)
+{
+  return (mbedtls_ct_memcmp(bench_in, bench_out, size) == 0)
+         ? PSA_SUCCESS : PSA_ERROR_CORRUPTION_DETECTED;
+}
+
+static psa_status_t call_ct_memcmp_diff(size_t size)
+{
+  return (mbedtls_ct_memcmp(bench_in, bench_out, size) != 0)
+         ? PSA_SUCCESS : PSA_ERROR_CORRUPTION_DETECTED;
+}
+
+static psa_status_t call_ct_memcpy_if(size_t size)
+{
+  bench_ct_condition ^= 1;
+  mbedtls_ct_memcpy_if(mbedtls_ct_bool(bench_ct_condition), bench_out, bench_in, NULL, size);
+  return PSA_SUCCESS;
+}
+
+/***************************************************************************//**
+ * Create the key of an operation and anything its calls depend on.
+ * Operations the PSA configuration lacks are not supported.
+ ******************************************************************************/
+static psa_status_t bench_setup(uint8_t op, bench_call_t *call)
+{
+  psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
+  psa_status_t status;
+
+  switch (op) {
+#if defined(PSA_WANT_ALG_ECB_NO_PADDING) || defined(PSA_WANT_ALG_CCM) || defined(PSA_WANT_ALG_CMAC)
+    case CRYPTO_BENCH_OP_CIPHER:
+    case CRYPTO_BENCH_OP_AEAD:
+    case CRYPTO_BENCH_OP_MAC:
+      psa_set_key_type(&attr, PSA_KEY_TYPE_AES);
+      psa_set_key_bits(&attr, 128);
+      if (op == CRYPTO_BENCH_OP_CIPHER) {
+#if defined(PSA_WANT_ALG_ECB_NO_PADDING)
+        psa_set_key_usage_flags(&attr, PSA_KEY_USAGE_ENCRYPT);
+        psa_set_key_algorithm(&attr, PSA_ALG_ECB_NO_PADDING);
+        *call = call_cipher;
+#endif
+      } else if (op == CRYPTO_BENCH_OP_AEAD) {
+#if defined(PSA_WANT_ALG_CCM)
+        psa_set_key_usage_flags(&attr, PSA_KEY_USAGE_ENCRYPT);
+        psa_set_key_algorithm(&attr, PSA_ALG_CCM);
+        *call = call_aead;
+#endif
+      } else {
+#if defined(PSA_WANT_ALG_CMAC)
+        psa_set_key_usage_flags(&attr, PSA_KEY_USAGE_SIGN_MESSAGE);
+        psa_set_key_algorithm(&attr, PSA_ALG_CMAC);
+        *call = call_mac;
+#endif
+      }
+      if (*call == NULL) {
+        return PSA_ERROR_NOT_SUPPORTED;
+      }
+      return psa_import_key(&attr, bench_key_data, sizeof(bench_key_data), &bench_key);
+#endif
+
+#if defined(BENCH_AEAD_BATCH)
+    case CRYPTO_BENCH_OP_AEAD_BATCH:
+      // Raw keys, the batch goes straight to the driver
+      for (size_t i = 0; i < CRYPTO_BENCH_BATCH_COUNT; i++) {
+        bench_batch[i] = (sli_cryptoacc_transparent_batch_item_t) {
+          .key = bench_key_data,
+          .key_length = sizeof(bench_key_data),
+          .nonce = bench_nonce,
+          .nonce_length = sizeof(bench_nonce),
+          .input = bench_in,
+          .output = bench_batch_out[i],
+          .tag = bench_batch_tag[i],
+          .tag_length = BENCH_TAG_SIZE,
+        };
+      }
+      *call = call_aead_batch;
+      return PSA_SUCCESS;
+#endif
+
+#if defined(PSA_WANT_ALG_SHA_256)
+    case CRYPTO_BENCH_OP_HASH:
+      *call = call_hash;
+      return PSA_SUCCESS;
+
+    case CRYPTO_BENCH_OP_HASH_STREAM:
+      *call = call_hash_stream;
+      return PSA_SUCCESS;
+#endif
+
+#if defined(PSA_WANT_ALG_ECDH) && defined(PSA_WANT_ECC_SECP_R1_256) \
+    && defined(PSA_WANT_KEY_TYPE_ECC_KEY_PAIR_GENERATE)
+    case CRYPTO_BENCH_OP_ECDH:
+      // The own public key serves as the peer key, so one slot is enough
+      psa_set_key_type(&attr, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
+      psa_set_key_bits(&attr, 256);
+      psa_set_key_usage_flags(&attr, PSA_KEY_USAGE_DERIVE);
+      psa_set_key_algorithm(&attr, PSA_ALG_ECDH);
+      status = psa_generate_key(&attr, &bench_key);
+      if (status == PSA_SUCCESS) {
+        status = psa_export_public_key(bench_key, bench_ref, sizeof(bench_ref), &bench_ref_len);
+      }
+      *call = call_ecdh;
+      return status;
+#endif
+
+#if defined(PSA_WANT_ALG_ECDSA) && defined(PSA_WANT_ALG_SHA_256) \
+    && defined(PSA_WANT_ECC_SECP_R1_256) && defined(PSA_WANT_KEY_TYPE_ECC_KEY_PAIR_GENERATE)
+    case CRYPTO_BENCH_OP_ECDSA_SIGN:
+    case CRYPTO_BENCH_OP_ECDSA_VERIFY:
+      psa_set_key_type(&attr, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
+      psa_set_key_bits(&attr, 256);
+      psa_set_key_usage_flags(&attr, PSA_KEY_USAGE_SIGN_HASH | PSA_KEY_USAGE_VERIFY_HASH);
+      psa_set_key_algorithm(&attr, PSA_ALG_ECDSA(PSA_ALG_SHA_256));
+      status = psa_generate_key(&attr, &bench_key);
+      if ((status == PSA_SUCCESS) && (op == CRYPTO_BENCH_OP_ECDSA_VERIFY)) {
+        status = psa_sign_hash(bench_key, PSA_ALG_ECDSA(PSA_ALG_SHA_256),
+                               bench_in, BENCH_HASH_SIZE,
+                               bench_ref, sizeof(bench_ref), &bench_ref_len);
+      }
+      *call = (op == CRYPTO_BENCH_OP_ECDSA_SIGN) ? call_ecdsa_sign : call_ecdsa_verify;
+      return status;
+#endif
+
+#if defined(BENCH_PAIRING)
+    case CRYPTO_BENCH_OP_PAIRING:
+    case CRYPTO_BENCH_OP_PAIRING_CACHED:
+#if defined(BENCH_PAIRING_CACHED)
+      sli_cryptoacc_ecc_keypair_cache_enable(op == CRYPTO_BENCH_OP_PAIRING_CACHED);
+      if (op == CRYPTO_BENCH_OP_PAIRING_CACHED) {
+        bench_idle = idle_keypair_cache;
+      }
+#else
+      if (op == CRYPTO_BENCH_OP_PAIRING_CACHED) {
+        return PSA_ERROR_NOT_SUPPORTED;
+      }
+#endif
+      // Peer public key. The key is destroyed so that the calls have the
+      // slot to themselves.
+      psa_set_key_type(&attr, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
+      psa_set_key_bits(&attr, 256);
+      psa_set_key_usage_flags(&attr, PSA_KEY_USAGE_DERIVE);
+      psa_set_key_algorithm(&attr, PSA_ALG_ECDH);
+      status = psa_generate_key(&attr, &bench_key);
+      if (status == PSA_SUCCESS) {
+        status = psa_export_public_key(bench_key, bench_ref, sizeof(bench_ref), &bench_ref_len);
+      }
+      psa_destroy_key(bench_key);
+      bench_key = MBEDTLS_SVC_KEY_ID_INIT;
+      *call = call_pairing;
+      return status;
+#endif
+
+#if defined(PSA_WANT_KEY_TYPE_ECC_KEY_PAIR_GENERATE) && defined(PSA_WANT_ECC_SECP_R1_256)
+    case CRYPTO_BENCH_OP_ECC_GENERATE:
+      *call = call_ecc_generate;
+      return PSA_SUCCESS;
+#endif
+
+#if defined(BENCH_SECURE_PAYLOAD)
+    case CRYPTO_BENCH_OP_SECURE_PAYLOAD_SEAL:
+    case CRYPTO_BENCH_OP_SECURE_PAYLOAD_OPEN:
+      // Both ends of one link, the counters reserved in NVM3 as on a link,
+      // with the bench key provisioned in its own NVM3 object.
+      memset(bench_ref, 0x5a, SECURE_PAYLOAD_ID_SIZE);
+      if (nvm3_writeData(nvm3_defaultHandle, CRYPTO_BENCH_NVM3_KEY_SECURE_PAYLOAD_KEY,
+                         bench_key_data, sizeof(bench_key_data)) != ECODE_NVM3_OK) {
+        return PSA_ERROR_STORAGE_FAILURE;
+      }
+      if ((secure_payload_init(&bench_sender, CRYPTO_BENCH_NVM3_KEY_SECURE_PAYLOAD_KEY,
+                               bench_ref, true, CRYPTO_BENCH_NVM3_KEY_SECURE_PAYLOAD) != SL_STATUS_OK)
+          || (secure_payload_init(&bench_receiver, CRYPTO_BENCH_NVM3_KEY_SECURE_PAYLOAD_KEY,
+                                  bench_ref, false, CRYPTO_BENCH_NVM3_KEY_SECURE_PAYLOAD + 1) != SL_STATUS_OK)) {
+        return PSA_ERROR_BAD_STATE;
+      }
+      // Packets of earlier runs are older than any packet of this one
+      bench_receiver.counter = bench_sender.counter;
+      if (op == CRYPTO_BENCH_OP_SECURE_PAYLOAD_OPEN) {
+        bench_idle = idle_secure_payload_seal;
+        *call = call_secure_payload_open;
+      } else {
+        *call = call_secure_payload_seal;
+      }
+      return PSA_SUCCESS;
+#endif
+
+    case CRYPTO_BENCH_OP_CT_MEMCMP:
+    case CRYPTO_BENCH_OP_CT_MEMCMP_DIFF:
+    case CRYPTO_BENCH_OP_CT_MEMCPY_IF:
+      memcpy(bench_out, bench_in, CRYPTO_BENCH_MAX_SIZE);
+      if (op == CRYPTO_BENCH_OP_CT_MEMCMP_DIFF) {
+        bench_out[0] ^= 0xff;
+      }
+      bench_ct_condition = 0;
+      *call = (op == CRYPTO_BENCH_OP_CT_MEMCMP) ? call_ct_memcmp
+              : (op == CRYPTO_BENCH_OP_CT_MEMCMP_DIFF) ? call_ct_memcmp_diff
+              : call_ct_memcpy_if;
+      return PSA_SUCCESS;
+
+    default:
+      return PSA_ERROR_NOT_SUPPORTED;
+  }
+}
@@ -0,0 +1,107 @@
+/***************************************************************************//**
+ * @file
+ * @brief Micro-benchmarks of the PSA Crypto configuration.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#ifndef CRYPTO_BENCH_H
+#define CRYPTO_BENCH_H
+
+#include <stdint.h>
+#include "sl_status.h"
+
+/***************************************************************************//**
+ * Each benchmark runs one PSA call in a loop on a volatile key created for
+ * the run, and times every call. On target the calls go through the driver
+ * selected by the PSA configuration (the CRYPTOACC on this device), on a
+ * host built with CRYPTO_BENCH_HOST they run the software drivers.
+ *
+ * Operations not enabled by the PSA configuration report
+ * PSA_ERROR_NOT_SUPPORTED, so a sweep over all of them shows what the
+ * configuration provides and at which cost. The run blocks the caller.
+ *
+ * A run needs one key slot, see SL_PSA_KEY_USER_SLOT_COUNT.
+ ******************************************************************************/
+
+// Largest message size, bytes
+#ifndef CRYPTO_BENCH_MAX_SIZE
+#define CRYPTO_BENCH_MAX_SIZE       512
+#endif
+
+// Operations. The message size is ignored by the ECC operations.
+#define CRYPTO_BENCH_OP_CIPHER      0x01 // psa_cipher_encrypt, AES-128-ECB, size multiple of 16
+#define CRYPTO_BENCH_OP_AEAD        0x02 // psa_aead_encrypt, AES-128-CCM, 16-byte tag
+#define CRYPTO_BENCH_OP_HASH        0x03 // psa_hash_compute, SHA-256
+#define CRYPTO_BENCH_OP_MAC         0x04 // psa_mac_compute, AES-128-CMAC
+#define CRYPTO_BENCH_OP_ECDH        0x05 // psa_raw_key_agreement, P-256
+#define CRYPTO_BENCH_OP_ECDSA_SIGN  0x06 // psa_sign_hash, P-256, SHA-256 hash
+#define CRYPTO_BENCH_OP_ECDSA_VERIFY 0x07 // psa_verify_hash, P-256, SHA-256 hash
+#define CRYPTO_BENCH_OP_ECC_GENERATE 0x08 // psa_generate_key and psa_destroy_key, P-256
+#define CRYPTO_BENCH_OP_AEAD_BATCH  0x09 // CRYPTO_BENCH_BATCH_COUNT AES-128-CCM messages chained in one CRYPTOACC transfer, needs SL_CRYPTOACC_AEAD_BATCH
+#define CRYPTO_BENCH_OP_HASH_STREAM 0x0A // psa_hash_setup, update and finish, SHA-256, CRYPTO_BENCH_STREAM_SIZE bytes in size-byte updates
+#define CRYPTO_BENCH_OP_PAIRING     0x0B // LE Secure Connections keys: P-256 psa_generate_key, psa_export_public_key and psa_raw_key_agreement, keypair cache off
+#define CRYPTO_BENCH_OP_PAIRING_CACHED 0x0C // Same with the keypair cache on, refilled between the timed calls
+#define CRYPTO_BENCH_OP_CT_MEMCMP   0x0D // mbedtls_ct_memcmp of equal buffers
+#define CRYPTO_BENCH_OP_CT_MEMCMP_DIFF 0x0E // Same with the first bytes differing, size not 0. Timings must match CRYPTO_BENCH_OP_CT_MEMCMP.
+#define CRYPTO_BENCH_OP_CT_MEMCPY_IF 0x0F // mbedtls_ct_memcpy_if, condition alternating between calls
+#define CRYPTO_BENCH_OP_SECURE_PAYLOAD_SEAL 0x10 // secure_payload_seal, compare with CRYPTO_BENCH_OP_AEAD at the same size
+#define CRYPTO_BENCH_OP_SECURE_PAYLOAD_OPEN 0x11 // secure_payload_open of a packet sealed between the timed calls
+#define CRYPTO_BENCH_OP_COUNT       0x11
+
+// Messages per call of CRYPTO_BENCH_OP_AEAD_BATCH, compare with as many
+// CRYPTO_BENCH_OP_AEAD calls
+#define CRYPTO_BENCH_BATCH_COUNT    8
+
+// Bytes hashed per call of CRYPTO_BENCH_OP_HASH_STREAM
+#define CRYPTO_BENCH_STREAM_SIZE    4096
+
+// NVM3 keys of the payload counters of the CRYPTO_BENCH_OP_SECURE_PAYLOAD_*
+// runs, this key and the next one
+#ifndef CRYPTO_BENCH_NVM3_KEY_SECURE_PAYLOAD
+#define CRYPTO_BENCH_NVM3_KEY_SECURE_PAYLOAD 0x00100
+#endif
+
+// NVM3 key of the payload key of the CRYPTO_BENCH_OP_SECURE_PAYLOAD_* runs,
+// written before and deleted after each run
+#ifndef CRYPTO_BENCH_NVM3_KEY_SECURE_PAYLOAD_KEY
+#define CRYPTO_BENCH_NVM3_KEY_SECURE_PAYLOAD_KEY 0x00102
+#endif
+
+typedef struct {
+  int32_t status;           // psa_status_t of the first failed call, or of the key setup
+  uint32_t iterations;      // Calls completed
+  uint32_t min_ticks;       // Fastest call
+  uint32_t max_ticks;       // Slowest call
+  uint64_t total_ticks;     // All calls
+} crypto_bench_result_t;
+
+/***************************************************************************//**
+ * Get the frequency of the ticks reported in the results.
+ *
+ * @return Ticks per second: the core clock on target, 1 GHz on a host.
+ ******************************************************************************/
+uint32_t crypto_bench_get_tick_frequency(void);
+
+/***************************************************************************//**
+ * Run a benchmark.
+ *
+ * @param[in] op          CRYPTO_BENCH_OP_* operation.
+ * @param[in] size        Message size in bytes, up to CRYPTO_BENCH_MAX_SIZE.
+ * @param[in] iterations  Number of calls to time.
+ * @param[out] result     Timing and PSA status of the run.
+ *
+ * @return SL_STATUS_OK if the run was attempted, the PSA status is in the
+ *         result. SL_STATUS_INVALID_PARAMETER for an unknown operation or an
+ *         invalid size.
+ ******************************************************************************/
+sl_status_t crypto_bench_run(uint8_t op,
+                             uint16_t size,
+                             uint16_t iterations,
+                             crypto_bench_result_t *result);
+
+#endif // CRYPTO_BENCH_H
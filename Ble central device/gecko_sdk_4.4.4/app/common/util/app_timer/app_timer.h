@@ -60,12 +60,14 @@ struct app_timer {
   sl_sleeptimer_timer_handle_t sleeptimer_handle;
   app_timer_callback_t callback;
   void *callback_data;
-  app_timer_t *next;
+  app_timer_t *next;        // Next timer in the triggered queue
   bool triggered;
   bool periodic;
   uint32_t timeout_ms;
+  uint32_t slack_ms;
   uint16_t overflow_counter;
   uint16_t overflow_max;
+  uint16_t option_flags;    // Sleeptimer option flags, the slack of the timer
 };
 
 /***************************************************************************//**
@@ -85,6 +87,30 @@ sl_status_t app_timer_start(app_timer_t *timer,
                             void *callback_data,
                             bool is_periodic);
 
+/***************************************************************************//**
+ * Start timer with a slack or restart if it is running already.
+ *
+ * @param[in] timer Pointer to the timer.
+ * @param[in] timeout_ms Timer timeout, in milliseconds.
+ * @param[in] slack_ms Delay the timer tolerates, in milliseconds.
+ * @param[in] callback Callback function that is called when timeout expires.
+ * @param[in] callback_data Pointer to user data that will be passed to callback.
+ * @param[in] is_periodic Reload timer when it expires if true.
+ *
+ * @return Status of the operation.
+ *
+ * @note The timer can expire up to slack_ms late, so that its expiration
+ *       shares a wakeup with other timers. See
+ *       sl_sleeptimer_slack_to_option_flags(). For periodic timers, the slack
+ *       must be smaller than the period.
+ ******************************************************************************/
+sl_status_t app_timer_start_with_slack(app_timer_t *timer,
+                                       uint32_t timeout_ms,
+                                       uint32_t slack_ms,
+                                       app_timer_callback_t callback,
+                                       void *callback_data,
+                                       bool is_periodic);
+
 /***************************************************************************//**
  * Stop running timer.
  *
@@ -0,0 +1,171 @@
+/***************************************************************************//**
+ * @file
+ * @brief NVM3 instrumentation and idle-time repack
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#ifndef NVM3_PROFILE_H
+#define NVM3_PROFILE_H
+
+#include "nvm3_generic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @addtogroup nvm3
+ * @{
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @addtogroup nvm3profile NVM3 Profile
+ * @brief NVM3 instrumentation and idle-time repack
+ * @{
+ * @details
+ * ## Instrumentation
+ *
+ *   nvm3_halProfileHandle wraps the flash HAL and measures every flash write
+ *   and page erase, whichever module requested them, including precompiled
+ *   stacks. The default instance uses it when NVM3_DEFAULT_PROFILE is 1.
+ *   Page erases outside of an idle-time repack step are counted separately:
+ *   they are repacks forced by a write.
+ *
+ *   nvm3_profileReadData() and nvm3_profileWriteData() have the same behavior
+ *   as nvm3_readData() and nvm3_writeData(), and also track the worst-case
+ *   latency and whether the object location was found in the NVM3 cache. A
+ *   miss on an instance with an overflowed cache costs a search through the
+ *   NVM.
+ *
+ * ## Idle-time repack
+ *
+ *   The scheduler runs nvm3_repack() on the default instance one step at a
+ *   time, only when the system has nothing else to do, so the repack does not
+ *   happen in the middle of a write later. Each step blocks for at most one
+ *   page erase or the write of the largest object. To enable it:
+ *   - call nvm3_idleRepackIsOkToSleep() from the app_is_ok_to_sleep() power
+ *     manager hook,
+ *   - call nvm3_idleRepackProcessAction() from the super loop,
+ *   - optionally implement nvm3_idleRepackIsAllowed() to defer repacks during
+ *     radio activity.
+ *
+ *   A step runs once the user repack threshold is reached, so a non-zero
+ *   NVM3_DEFAULT_REPACK_HEADROOM lets repacks start before a write forces one.
+ ******************************************************************************/
+
+/******************************************************************************
+ ******************************   TYPEDEFS   **********************************
+ *****************************************************************************/
+
+/// @brief NVM3 counters and worst-case latencies.
+typedef struct {
+  uint32_t readCnt;               ///< nvm3_profileReadData() calls.
+  uint32_t writeCnt;              ///< nvm3_profileWriteData() calls.
+  uint32_t cacheHitCnt;           ///< Object locations found in the cache.
+  uint32_t cacheMissCnt;          ///< Object locations not found in the cache.
+  uint32_t readTimeMaxUs;         ///< Longest nvm3_profileReadData(), in us.
+  uint32_t writeTimeMaxUs;        ///< Longest nvm3_profileWriteData(), in us.
+  uint32_t halWriteCnt;           ///< Flash writes.
+  uint32_t halWriteTimeMaxUs;     ///< Longest flash write, in us.
+  uint32_t pageEraseCnt;          ///< Page erases.
+  uint32_t pageEraseTimeMaxUs;    ///< Longest page erase, in us.
+  uint32_t forcedEraseCnt;        ///< Page erases outside of idle-time repack steps.
+  uint32_t idleRepackCnt;         ///< Idle-time repack steps.
+  uint32_t idleRepackTimeMaxUs;   ///< Longest idle-time repack step, in us.
+  size_t cacheEntryCount;         ///< Cache size, in entries.
+  size_t cacheUsedCount;          ///< Cache entries in use.
+  bool cacheOverflow;             ///< More objects than cache entries.
+} nvm3_ProfileStats_t;
+
+/*******************************************************************************
+ ***************************   GLOBAL VARIABLES   ******************************
+ ******************************************************************************/
+
+extern const nvm3_HalHandle_t nvm3_halProfileHandle;    ///< The HAL flash handle, instrumented.
+
+/*******************************************************************************
+ *****************************   PROTOTYPES   **********************************
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @brief
+ *   Read the data of an object, and track the latency and the cache hits.
+ *
+ * @details
+ *   See @ref nvm3_readData().
+ ******************************************************************************/
+Ecode_t nvm3_profileReadData(nvm3_Handle_t *h, nvm3_ObjectKey_t key, void *value, size_t len);
+
+/***************************************************************************//**
+ * @brief
+ *   Write the data of an object, and track the latency and the cache hits.
+ *
+ * @details
+ *   See @ref nvm3_writeData().
+ ******************************************************************************/
+Ecode_t nvm3_profileWriteData(nvm3_Handle_t *h, nvm3_ObjectKey_t key, const void *value, size_t len);
+
+/***************************************************************************//**
+ * @brief
+ *   Get the counters, the worst-case latencies and the cache usage.
+ *
+ * @param[in] h
+ *   A pointer to an NVM3 driver handle, for the cache usage.
+ * @param[out] stats
+ *   A pointer to the structure that receives the counters.
+ ******************************************************************************/
+void nvm3_profileGetStats(nvm3_Handle_t *h, nvm3_ProfileStats_t *stats);
+
+/***************************************************************************//**
+ * @brief
+ *   Reset the counters and the worst-case latencies.
+ ******************************************************************************/
+void nvm3_profileResetStats(void);
+
+/***************************************************************************//**
+ * @brief
+ *   Power manager hook of the idle-time repack.
+ *
+ * @details
+ *   Call from app_is_ok_to_sleep(). Keeps the system awake for one more pass
+ *   of the super loop when a repack step is due.
+ *
+ * @return
+ *   true if the system can go to sleep.
+ *
+ * @note
+ *   Called with the interrupts disabled.
+ ******************************************************************************/
+bool nvm3_idleRepackIsOkToSleep(void);
+
+/***************************************************************************//**
+ * @brief
+ *   Run one repack step of the default instance, if a repack is needed and
+ *   the previous pass of the super loop ended idle.
+ ******************************************************************************/
+void nvm3_idleRepackProcessAction(void);
+
+/***************************************************************************//**
+ * @brief
+ *   Check if an idle-time repack step can run now. The default implementation
+ *   always allows it, the application can override it to avoid radio
+ *   activity.
+ *
+ * @return
+ *   true if a repack step can run.
+ ******************************************************************************/
+bool nvm3_idleRepackIsAllowed(void);
+
+/** @} (end addtogroup nvm3profile) */
+/** @} (end addtogroup nvm3) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NVM3_PROFILE_H */
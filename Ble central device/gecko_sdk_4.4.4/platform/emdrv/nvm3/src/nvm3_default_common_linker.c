@@ -31,6 +31,9 @@
 #include "nvm3.h"
 #include "nvm3_hal_flash.h"
 #include "nvm3_default_config.h"
+#if (NVM3_DEFAULT_PROFILE == 1)
+#include "nvm3_profile.h"
+#endif
 
 #if defined(NVM3_BASE)
 /* Manually control the NVM3 address and size */
@@ -70,7 +73,11 @@ nvm3_Init_t nvm3_defaultInitData =
   NVM3_DEFAULT_CACHE_SIZE,
   NVM3_DEFAULT_MAX_OBJECT_SIZE,
   NVM3_DEFAULT_REPACK_HEADROOM,
+#if (NVM3_DEFAULT_PROFILE == 1)
+  &nvm3_halProfileHandle,
+#else
   &nvm3_halFlashHandle,
+#endif
 };
 
 nvm3_Init_t *nvm3_defaultInit = &nvm3_defaultInitData;
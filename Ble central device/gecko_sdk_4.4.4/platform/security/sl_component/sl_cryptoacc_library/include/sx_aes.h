@@ -12,6 +12,7 @@
 #include "compiler_extentions.h"
 #include "cryptolib_types.h"
 #include "sx_blk_cipher_common.h"
+#include "sx_dma.h"
 
 /** @brief Size for IV in all modes except GCM */
 #define AES_IV_SIZE (BLK_CIPHER_IV_SIZE)
@@ -1330,6 +1331,101 @@ uint32_t sx_aes_cmac_generate_verify_final(
       const block_t *ctx_in,
       const block_t *mac);
 
+/** @brief Fetch descriptors needed by one item of an AES batch */
+#define AES_BATCH_FETCH_DESCS 6
+/** @brief Push descriptors needed by one item of an AES batch */
+#define AES_BATCH_PUSH_DESCS 5
+/** @brief Size of the CCM header block, excluding the aad */
+#define AES_CCM_HEADER_SIZE 22
+
+/** @brief Operation applied to all the items of an AES batch */
+enum sx_aes_batch_mode {
+   SX_AES_BATCH_CTR_ENCRYPT = 0, /**< AES-CTR encryption */
+   SX_AES_BATCH_CTR_DECRYPT,     /**< AES-CTR decryption */
+   SX_AES_BATCH_CCM_ENCRYPT,     /**< AES-CCM encryption and authentication */
+   SX_AES_BATCH_CCM_DECRYPT,     /**< AES-CCM decryption and verification */
+};
+
+/**
+ * @brief One independent message of an AES batch
+ *
+ * Each item has its own key and IV or nonce. The fields after \c status are
+ * the workspace holding the item's descriptors, they are filled by
+ * ::sx_aes_batch_prepare and must stay valid until the transfer is done.
+ */
+struct sx_aes_batch_item {
+   block_t key;      /**< key, 128, 192 or 256 bits */
+   block_t iv;       /**< CTR: 16-byte counter block, CCM: 7 to 13-byte nonce */
+   block_t aad;      /**< CCM: additional authenticated data, can be empty */
+   block_t datain;   /**< input data */
+   block_t dataout;  /**< output data, same length as \c datain */
+   block_t mac;      /**< CCM: output MAC when encrypting, reference MAC
+                          when decrypting. 4 to 16 bytes, even */
+   uint32_t status;  /**< result of the item, set by ::sx_aes_batch_finish */
+
+   uint32_t config;                                      /**< engine configuration word */
+   uint8_t header[AES_CCM_HEADER_SIZE];                  /**< CCM header block */
+   uint8_t mac_computed[AES_MAC_SIZE];                   /**< recomputed MAC when decrypting */
+   struct dma_sg_descr_s fetch[AES_BATCH_FETCH_DESCS];   /**< fetch descriptors */
+   struct dma_sg_descr_s push[AES_BATCH_PUSH_DESCS];     /**< push descriptors */
+};
+
+/** Build the descriptors of a batch of independent AES-CTR or AES-CCM items
+ *
+ * The descriptor lists of all items are chained, so the whole batch runs as
+ * one DMA transfer starting from \c items[0].fetch and \c items[0].push.
+ * It can be run with ::cryptodma_run_sg or queued as an asynchronous job,
+ * followed by ::sx_aes_batch_finish.
+ *
+ * @param mode is the operation applied to all items
+ * @param items is the array of items
+ * @param count is the number of items, at least 1
+ * @return ::CRYPTOLIB_SUCCESS if the descriptors were built
+ *         ::CRYPTOLIB_INVALID_PARAM if an item has invalid lengths
+ *         ::CRYPTOLIB_UNSUPPORTED_ERR if the mode or a key length is not
+ *         supported
+ */
+uint32_t sx_aes_batch_prepare(
+      enum sx_aes_batch_mode mode,
+      struct sx_aes_batch_item *items,
+      uint32_t count);
+
+/** Finish a batch once its transfer is done
+ *
+ * Sets the status of every item. For CCM decryption, compares the recomputed
+ * MAC of each item with its reference MAC.
+ *
+ * @param mode is the operation given to ::sx_aes_batch_prepare
+ * @param items is the array of items
+ * @param count is the number of items
+ * @return ::CRYPTOLIB_SUCCESS if all items succeeded
+ *         ::CRYPTOLIB_INVALID_SIGN_ERR if the MAC of an item does not match
+ */
+uint32_t sx_aes_batch_finish(
+      enum sx_aes_batch_mode mode,
+      struct sx_aes_batch_item *items,
+      uint32_t count);
+
+/** Process a batch of independent AES-CTR or AES-CCM items in one transfer
+ *
+ * Equivalent to ::sx_aes_batch_prepare, ::cryptodma_run_sg and
+ * ::sx_aes_batch_finish. The per-message setup of the single-shot functions
+ * (building and starting a transfer) is paid once for the whole batch.
+ *
+ * @param mode is the operation applied to all items
+ * @param items is the array of items
+ * @param count is the number of items, at least 1
+ * @return ::CRYPTOLIB_SUCCESS if all items succeeded
+ *         ::CRYPTOLIB_INVALID_SIGN_ERR if the MAC of an item does not match
+ *         ::CRYPTOLIB_INVALID_PARAM if an item has invalid lengths
+ *         ::CRYPTOLIB_UNSUPPORTED_ERR if the mode or a key length is not
+ *         supported
+ */
+uint32_t sx_aes_batch(
+      enum sx_aes_batch_mode mode,
+      struct sx_aes_batch_item *items,
+      uint32_t count);
+
 /**
  * @brief Reload random used in the AES counter-measures.
  *
@@ -143,9 +143,21 @@ void unmap_descriptors(struct dma_sg_descr_s *out_descs)
 }
 #endif
 
+static cryptodma_sg_runner_t sg_runner = NULL;
+
+void cryptodma_set_sg_runner(cryptodma_sg_runner_t runner)
+{
+   sg_runner = runner;
+}
+
 void cryptodma_run_sg(struct dma_sg_descr_s * first_fetch_descriptor, struct dma_sg_descr_s * first_push_descriptor)
 {
    struct dma_sg_descr_s *mapped_in, *mapped_out;
+
+   if (sg_runner != NULL) {
+      sg_runner(first_fetch_descriptor, first_push_descriptor);
+      return;
+   }
    #if DMA_SG_DEBUG
       debug_print_sg(first_fetch_descriptor);
       debug_print_sg(first_push_descriptor);
@@ -159,6 +171,40 @@ void cryptodma_run_sg(struct dma_sg_descr_s * first_fetch_descriptor, struct dma
    unmap_descriptors(first_push_descriptor);
 }
 
+void cryptodma_start_sg(struct dma_sg_descr_s * first_fetch_descriptor, struct dma_sg_descr_s * first_push_descriptor)
+{
+   struct dma_sg_descr_s *mapped_in, *mapped_out;
+   #if DMA_SG_DEBUG
+      debug_print_sg(first_fetch_descriptor);
+      debug_print_sg(first_push_descriptor);
+   #endif
+
+   map_descriptors(first_fetch_descriptor, first_push_descriptor, &mapped_in, &mapped_out);
+   cryptodma_config_sg(mapped_in, mapped_out);
+   // Bus errors must raise the interrupt too, the pusher may never stop after one
+   WR_REG32(ADDR_DMA_INT_STAT_CLR, DMA_AXI_INTENSETREG_ALL_EN);
+   WR_REG32(ADDR_DMA_INT_EN,       DMA_AXI_INTENSETREG_PUSHER_STOPPED_EN
+                                   | DMA_AXI_INTENSETREG_FETCHER_ERROR_EN
+                                   | DMA_AXI_INTENSETREG_PUSHER_ERROR_EN);
+   WR_REG32(ADDR_DMA_START,        DMA_AXI_STARTREG_FETCH | DMA_AXI_STARTREG_PUSH);
+}
+
+uint32_t cryptodma_finish_sg(struct dma_sg_descr_s * first_push_descriptor)
+{
+   uint32_t status = cryptodma_check_bus_error();
+
+   if (status == CRYPTOLIB_SUCCESS) {
+      status = cryptodma_check_fifo_empty();
+   }
+   WR_REG32(ADDR_DMA_INT_EN,       0);
+   WR_REG32(ADDR_DMA_INT_STAT_CLR, DMA_AXI_INTENSETREG_ALL_EN);
+   if (status != CRYPTOLIB_SUCCESS) {
+      cryptodma_reset();
+   }
+   unmap_descriptors(first_push_descriptor);
+   return status;
+}
+
 struct dma_sg_descr_s* write_desc_always(
       struct dma_sg_descr_s *descr,
       volatile void *addr,
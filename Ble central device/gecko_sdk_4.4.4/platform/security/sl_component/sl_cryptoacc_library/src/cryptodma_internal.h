@@ -105,6 +105,49 @@ uint32_t cryptodma_check_bus_error(void);
  */
 void cryptodma_run_sg(struct dma_sg_descr_s * first_fetch_descriptor, struct dma_sg_descr_s * first_push_descriptor);
 
+/**
+ * @brief Starts an internal DMA transfer in indirect mode without waiting
+ *
+ * Like ::cryptodma_run_sg, but returns once the transfer is started. The
+ * DMA interrupt is raised when the pusher stops or on a bus error, after
+ * which ::cryptodma_finish_sg must be called. The descriptors and the
+ * buffers they point to must stay valid until then.
+ *
+ * @param first_fetch_descriptor list of descriptors to fetch from
+ * @param first_push_descriptor  list of descriptors to push to
+ */
+void cryptodma_start_sg(struct dma_sg_descr_s * first_fetch_descriptor, struct dma_sg_descr_s * first_push_descriptor);
+
+/**
+ * @brief Completes a transfer started by ::cryptodma_start_sg
+ *
+ * Checks the status of the transfer, clears the DMA interrupt and unmaps
+ * the descriptors. The DMA is reset after an error instead of triggering a
+ * hard fault, so the caller can report it.
+ *
+ * @param first_push_descriptor list of descriptors given to ::cryptodma_start_sg
+ * @return CRYPTOLIB_SUCCESS, or CRYPTOLIB_DMA_ERR on a bus or fifo error
+ */
+uint32_t cryptodma_finish_sg(struct dma_sg_descr_s * first_push_descriptor);
+
+/**
+ * @brief Function running an indirect transfer in place of ::cryptodma_run_sg
+ *
+ * Must return once the transfer is complete, and handle bus errors as
+ * ::cryptodma_run_sg does.
+ */
+typedef void (*cryptodma_sg_runner_t)(struct dma_sg_descr_s * first_fetch_descriptor, struct dma_sg_descr_s * first_push_descriptor);
+
+/**
+ * @brief Set the function used by ::cryptodma_run_sg to run the transfers
+ *
+ * Lets the platform wait for the DMA interrupt, e.g. asleep, instead of
+ * polling the DMA status.
+ *
+ * @param runner function running the transfers, NULL to poll again
+ */
+void cryptodma_set_sg_runner(cryptodma_sg_runner_t runner);
+
 
 /**
  * @brief Map software descriptors and buffers to the hardware
@@ -826,6 +826,53 @@ uint32_t sx_aes_ccm_decrypt_verify(
          plaintext, nonce, mac, aad);
 }
 
+uint32_t sx_aes_batch_prepare(
+      enum sx_aes_batch_mode mode,
+      struct sx_aes_batch_item *items,
+      uint32_t count)
+{
+   bool is_ccm = (mode == SX_AES_BATCH_CCM_ENCRYPT) || (mode == SX_AES_BATCH_CCM_DECRYPT);
+   bool is_decrypt = (mode == SX_AES_BATCH_CTR_DECRYPT) || (mode == SX_AES_BATCH_CCM_DECRYPT);
+
+   if (is_ccm ? !AES_HW_CFG_CCM_SUPPORTED : !AES_HW_CFG_CTR_SUPPORTED)
+      return CRYPTOLIB_UNSUPPORTED_ERR;
+   return sx_blk_cipher_batch_prepare(SX_BLK_CIPHER_AES,
+         is_decrypt ? SX_BLK_CIPHER_DECRYPT : SX_BLK_CIPHER_ENCRYPT,
+         is_ccm ? SX_BLK_CIPHER_MODE_CCM : SX_BLK_CIPHER_MODE_CTR,
+         items, count);
+}
+
+uint32_t sx_aes_batch_finish(
+      enum sx_aes_batch_mode mode,
+      struct sx_aes_batch_item *items,
+      uint32_t count)
+{
+   uint32_t status = CRYPTOLIB_SUCCESS;
+
+   for (uint32_t i = 0; i < count; i++) {
+      items[i].status = CRYPTOLIB_SUCCESS;
+      if ((mode == SX_AES_BATCH_CCM_DECRYPT)
+            && memcmp_time_cst(items[i].mac.addr, items[i].mac_computed, items[i].mac.len)) {
+         items[i].status = CRYPTOLIB_INVALID_SIGN_ERR;
+         status = CRYPTOLIB_INVALID_SIGN_ERR;
+      }
+   }
+   return status;
+}
+
+uint32_t sx_aes_batch(
+      enum sx_aes_batch_mode mode,
+      struct sx_aes_batch_item *items,
+      uint32_t count)
+{
+   uint32_t status = sx_aes_batch_prepare(mode, items, count);
+   if (status)
+      return status;
+
+   cryptodma_run_sg(items[0].fetch, items[0].push);
+   return sx_aes_batch_finish(mode, items, count);
+}
+
 uint32_t sx_aes_ccm_encrypt_init(
       const block_t *key,
       const block_t *plaintext,
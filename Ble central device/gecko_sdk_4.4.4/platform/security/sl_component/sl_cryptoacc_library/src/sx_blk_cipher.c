@@ -1385,3 +1385,126 @@ static uint32_t sx_blk_cipher_build_descr(
 
    return CRYPTOLIB_SUCCESS;
 }
+
+/* Reference MAC sent when decrypting CCM, see sx_blk_cipher_ccm_decrypt */
+static uint8_t batch_zeroes[BLK_CIPHER_MAC_SIZE];
+
+/**
+ * @brief Chain the last descriptor of an item to the next item
+ *
+ * Only the final descriptor of the whole chain is tagged as last, the other
+ * items are only realigned at their end.
+ *
+ * @param d last descriptor of the item
+ * @param next first descriptor of the next item, NULL for the last item
+ */
+static void chain_last_desc(struct dma_sg_descr_s *d, struct dma_sg_descr_s *next)
+{
+   if (!next) {
+      set_last_desc(d);
+      return;
+   }
+   d->next_descr = next;
+   d->tag &= ~DMA_SG_TAG_ISLAST;
+   d->length_irq |= DMA_AXI_DESCR_REALIGN;
+}
+
+uint32_t sx_blk_cipher_batch_prepare(
+      enum sx_blk_cipher_engine_select engine,
+      enum sx_blk_cipher_operation operation,
+      enum sx_blk_cipher_mode_select mode,
+      struct sx_aes_batch_item *items,
+      uint32_t count)
+{
+   CRYPTOLIB_ASSERT(engine < SX_NUM_BLK_CIPHER_ENGINES, "Invalid engine");
+   CRYPTOLIB_ASSERT_NM(operation < SX_NUM_BLK_CIPHER_OPERATIONS);
+   if (!count || ((mode != SX_BLK_CIPHER_MODE_CTR) && (mode != SX_BLK_CIPHER_MODE_CCM)))
+      return CRYPTOLIB_INVALID_PARAM;
+
+   for (uint32_t i = 0; i < count; i++) {
+      struct sx_aes_batch_item *item = &items[i];
+      bool is_last = (i == count - 1);
+      block_t keyb = item->key;
+      block_t config = block_t_convert(&item->config, sizeof(item->config));
+      block_t header = block_t_convert(item->header, sizeof(item->header));
+      block_t iv = NULL_blk;
+      block_t aad = NULL_blk;
+      block_t extrain = NULL_blk;
+      block_t tag_out = NULL_blk;
+      struct dma_sg_descr_s *d;
+      uint32_t status;
+
+      if (item->dataout.len != item->datain.len)
+         return CRYPTOLIB_INVALID_PARAM;
+
+      item->config = operation_select[operation] | mode_select[mode];
+      if (mode == SX_BLK_CIPHER_MODE_CCM) {
+         status = generate_ccm_header(item->iv, item->aad.len, item->datain.len,
+               item->mac.len, &header);
+         if (status)
+            return status;
+         aad = item->aad;
+         if (operation == SX_BLK_CIPHER_DECRYPT) {
+            extrain = block_t_convert(batch_zeroes, item->mac.len);
+            tag_out = block_t_convert(item->mac_computed, item->mac.len);
+         } else {
+            tag_out = item->mac;
+         }
+      } else {
+         if (!item->datain.len || (item->iv.len != BLK_CIPHER_IV_SIZE))
+            return CRYPTOLIB_INVALID_PARAM;
+         iv = item->iv;
+         header.len = 0;
+      }
+
+      status = sx_aes_set_hw_config_for_key(&keyb, &item->config);
+      if (status)
+         return status;
+
+      uint32_t aad_zeropad_len      = get_pad_len(header.len + aad.len);
+      uint32_t datain_zeropad_len   = get_pad_len(item->datain.len);
+      uint32_t extrain_zeropad_len  = get_pad_len(extrain.len);
+      block_t aads_discard          = block_t_convert(NULL, header.len + aad.len + aad_zeropad_len);
+      block_t dataout_discard       = block_t_convert(NULL, get_pad_len(item->dataout.len));
+      block_t tagout_discard        = block_t_convert(NULL, get_pad_len(tag_out.len));
+
+      // fetcher descriptors, same layout as sx_blk_cipher_build_descr
+      d = item->fetch;
+      d = write_desc_blk(d, &config, DMA_AXI_DESCR_REALIGN,
+            engine_select[engine] | DMA_SG_TAG_ISCONFIG |
+            DMA_SG_TAG_SETCFGOFFSET(SX_BLK_CIPHER_OFFSET_CFG));
+      d = write_desc_blk(d, &keyb, DMA_AXI_DESCR_REALIGN,
+            engine_select[engine] | DMA_SG_TAG_ISCONFIG |
+            DMA_SG_TAG_SETCFGOFFSET(SX_BLK_CIPHER_OFFSET_KEY));
+      d = write_desc_blk(d, &iv, DMA_AXI_DESCR_REALIGN,
+            engine_select[engine] | DMA_SG_TAG_ISCONFIG |
+            DMA_SG_TAG_SETCFGOFFSET(SX_BLK_CIPHER_OFFSET_IV));
+      d = write_desc_blk(d, &header, 0,
+            engine_select[engine] | DMA_SG_TAG_ISDATA |
+            DMA_SG_TAG_DATATYPE_BLK_CIPHER_HEADER);
+      d = write_desc_blk(d, &aad, DMA_AXI_DESCR_REALIGN,
+            engine_select[engine] | DMA_SG_TAG_ISDATA |
+            DMA_SG_TAG_DATATYPE_BLK_CIPHER_HEADER |
+            DMA_SG_TAG_SETINVALIDBYTES(aad_zeropad_len));
+      d = write_desc_blk(d, &item->datain, DMA_AXI_DESCR_REALIGN,
+            engine_select[engine] | DMA_SG_TAG_ISDATA |
+            DMA_SG_TAG_DATATYPE_BLK_CIPHER_PAYLOAD |
+            DMA_SG_TAG_SETINVALIDBYTES(datain_zeropad_len));
+      d = write_desc_blk(d, &extrain, DMA_AXI_DESCR_REALIGN,
+            engine_select[engine] | DMA_SG_TAG_ISDATA |
+            DMA_SG_TAG_DATATYPE_BLK_CIPHER_PAYLOAD |
+            DMA_SG_TAG_SETINVALIDBYTES(extrain_zeropad_len));
+      chain_last_desc(d - 1, is_last ? NULL : items[i + 1].fetch);
+
+      // pusher descriptors
+      d = item->push;
+      d = write_desc_blk(d, &aads_discard, 0, 0);
+      d = write_desc_blk(d, &item->dataout, 0, 0);
+      d = write_desc_blk(d, &dataout_discard, 0, 0);
+      d = write_desc_blk(d, &tag_out, 0, 0);
+      d = write_desc_blk(d, &tagout_discard, 0, 0);
+      chain_last_desc(d - 1, is_last ? NULL : items[i + 1].push);
+   }
+
+   return CRYPTOLIB_SUCCESS;
+}
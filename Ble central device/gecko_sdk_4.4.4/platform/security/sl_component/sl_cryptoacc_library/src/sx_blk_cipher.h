@@ -14,6 +14,8 @@
 #include "cryptolib_types.h"
 #include "cryptodma_internal.h"
 
+struct sx_aes_batch_item;
+
 enum sx_blk_cipher_engine_select
 {
    SX_BLK_CIPHER_AES,  /**< block cipher AES */
@@ -868,4 +870,22 @@ uint32_t sx_blk_cipher_cmac_generate_verify_final(
       const block_t *message,
       const block_t *ctx_in,
       const block_t *mac);
+
+/** Build the chained descriptors of a batch of CTR or CCM operations
+ *
+ * @param engine is the engine used
+ * @param operation holds engine operation: encrypt or decrypt
+ * @param mode is ::SX_BLK_CIPHER_MODE_CTR or ::SX_BLK_CIPHER_MODE_CCM
+ * @param items is the array of items, see ::sx_aes_batch_item
+ * @param count is the number of items, at least 1
+ * @return ::CRYPTOLIB_SUCCESS if the descriptors were built
+ *         ::CRYPTOLIB_INVALID_PARAM if an item has invalid lengths
+ *         ::CRYPTOLIB_UNSUPPORTED_ERR if a key length is not supported
+ */
+uint32_t sx_blk_cipher_batch_prepare(
+      enum sx_blk_cipher_engine_select engine,
+      enum sx_blk_cipher_operation operation,
+      enum sx_blk_cipher_mode_select mode,
+      struct sx_aes_batch_item *items,
+      uint32_t count);
 #endif
@@ -51,7 +51,43 @@
 
 #if defined(SLI_MBEDTLS_DEVICE_VSE)
 
+#include <stdbool.h>
+
 #include "psa/crypto.h"
+#include "sx_dma.h"
+
+//------------------------------------------------------------------------------
+// Type Definitions
+
+struct cryptoacc_job;
+
+/**
+ * \brief Completion callback of an asynchronous CRYPTOACC job
+ *
+ * Called from the CRYPTOACC interrupt handler once the output of the job has
+ * been pushed. The job and its buffers can be reused from the callback.
+ *
+ * \param job     The completed job.
+ * \param status  PSA_SUCCESS, or PSA_ERROR_HARDWARE_FAILURE on a DMA error.
+ */
+typedef void (*cryptoacc_job_callback_t)(struct cryptoacc_job *job,
+                                         psa_status_t status);
+
+/**
+ * \brief Asynchronous CRYPTOACC job
+ *
+ * A job is a pair of scatter-gather descriptor lists built with the
+ * cryptoacc library, e.g. the configuration, key and data descriptors of an
+ * AES operation. The job, the descriptors and the buffers they point to are
+ * owned by the caller and must stay valid until the callback is called.
+ */
+typedef struct cryptoacc_job {
+  struct dma_sg_descr_s *fetch;       ///< First fetch descriptor
+  struct dma_sg_descr_s *push;        ///< First push descriptor
+  cryptoacc_job_callback_t callback;  ///< Completion callback
+  void *user_data;                    ///< For use by the callback
+  struct cryptoacc_job *next;         ///< Internal, queue link
+} cryptoacc_job_t;
 
 //------------------------------------------------------------------------------
 // Function Declarations
@@ -63,17 +99,52 @@ extern "C" {
 /**
  * \brief Get ownership of the crypto device
  *
- * \return PSA_SUCCESS if successful, PSA_ERROR_HARDWARE_FAILURE on error
+ * \details Ownership is granted in turn with the asynchronous jobs: the
+ *          caller waits for the job in progress, if any, and jobs submitted
+ *          meanwhile run after the device is released. Must not be called
+ *          with interrupts masked while a job is in progress.
+ *
+ *          The DMA transfers of the owner run as jobs ahead of the queue,
+ *          and the owner sleeps in EM1 until each one is complete. From an
+ *          interrupt, or with interrupts masked, the owner polls instead.
+ *
+ * \return PSA_SUCCESS if successful, PSA_ERROR_HARDWARE_FAILURE on error,
+ *         PSA_ERROR_BAD_STATE if called from an interrupt while a job is in
+ *         progress
  */
 psa_status_t cryptoacc_management_acquire(void);
 
 /**
  * \brief Release ownership of the crypto device
  *
+ * \details Starts the next queued job, if any.
+ *
  * \return PSA_SUCCESS if successful, PSA_ERROR_HARDWARE_FAILURE on error
  */
 psa_status_t cryptoacc_management_release(void);
 
+/**
+ * \brief Queue an asynchronous job on the crypto device
+ *
+ * \details Returns without waiting. The job is started right away if the
+ *          device is free, else when the jobs queued before it and the
+ *          current owner are done. Can be called from interrupts, including
+ *          completion callbacks.
+ *
+ * \param[in] job  Job to run. The callback is mandatory.
+ *
+ * \return PSA_SUCCESS if the job was queued, PSA_ERROR_INVALID_ARGUMENT
+ *         if the job is incomplete
+ */
+psa_status_t cryptoacc_management_submit(cryptoacc_job_t *job);
+
+/**
+ * \brief Check whether asynchronous jobs are queued or in progress
+ *
+ * \return true if the device is busy with jobs
+ */
+bool cryptoacc_management_jobs_pending(void);
+
 /**
  * \brief Set up hardware SCA countermeasures
  *
@@ -34,11 +34,39 @@
 #include "psa/crypto.h"
 
 #include "stddef.h"
+#include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+//------------------------------------------------------------------------------
+// Defines
+
+// Size of the pool of random words served without waiting for the TRNG, 0 to
+// disable the pool.
+#ifndef SL_VSE_TRNG_POOL_WORDS
+  #define SL_VSE_TRNG_POOL_WORDS (0)
+#endif
+
+//------------------------------------------------------------------------------
+// Type Definitions
+
+/*
+ * \brief
+ *   Counters of the random pool.
+ */
+typedef struct {
+  uint32_t size;       // Pool size, bytes
+  uint32_t level;      // Bytes currently in the pool
+  uint32_t min_level;  // Lowest level since the counters were reset
+  uint32_t hits;       // Requests served from the pool only
+  uint32_t misses;     // Requests that waited for the TRNG
+  uint32_t refills;    // Refills from idle time
+  uint32_t drains;     // Refills from the TRNG FIFO on EM2/EM3 entry
+} sli_cryptoacc_trng_pool_stats_t;
+
 //------------------------------------------------------------------------------
 // Global Variable Declarations
 
@@ -80,6 +108,48 @@ extern const struct sx_rng sli_cryptoacc_trng_wrapper;
  */
 psa_status_t sli_cryptoacc_trng_get_random(unsigned char *output, size_t len);
 
+/*
+ * \brief
+ *   Check whether the random pool needs a refill before sleeping.
+ *
+ * \details
+ *   Call from the app_is_ok_to_sleep() power manager hook, together with
+ *   sli_cryptoacc_trng_pool_process_action() from the super loop. When the
+ *   pool is half empty, the system stays awake for one more pass of the super
+ *   loop, which then moves the words left in the TRNG FIFO by the last
+ *   request to the pool, so that the next requests do not wait for the TRNG.
+ *
+ * \note
+ *   Called with the interrupts disabled.
+ *
+ * \return
+ *   false if the pool is to be refilled first, true otherwise.
+ */
+bool sli_cryptoacc_trng_pool_is_ok_to_sleep(void);
+
+/*
+ * \brief
+ *   Refill the random pool, if sli_cryptoacc_trng_pool_is_ok_to_sleep() asked
+ *   for it.
+ *
+ * \note
+ *   Does not block: only the words already in the TRNG FIFO are moved, the
+ *   TRNG is not started. It is stopped afterwards.
+ */
+void sli_cryptoacc_trng_pool_process_action(void);
+
+/*
+ * \brief
+ *   Get the counters of the random pool. All zero if the pool is disabled.
+ */
+void sli_cryptoacc_trng_get_pool_stats(sli_cryptoacc_trng_pool_stats_t *stats);
+
+/*
+ * \brief
+ *   Reset the counters of the random pool.
+ */
+void sli_cryptoacc_trng_reset_pool_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
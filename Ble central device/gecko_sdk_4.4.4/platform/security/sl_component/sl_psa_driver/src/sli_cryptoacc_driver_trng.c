@@ -47,6 +47,9 @@
 
 #include "sl_assert.h"
 #include "em_device.h"
+#include "em_core.h"
+
+#include <string.h>
 
 #if (SL_VSE_BUFFER_TRNG_DATA_DURING_SLEEP)
   #include "sl_component_catalog.h"
@@ -57,6 +60,14 @@
   #endif // SL_CATALOG_POWER_MANAGER_PRESENT
 #endif // SL_VSE_BUFFER_TRNG_DATA_DURING_SLEEP
 
+#if (SL_VSE_TRNG_POOL_WORDS > 0)
+  #include "sl_component_catalog.h"
+  #if defined(SL_CATALOG_POWER_MANAGER_PRESENT)
+    #include "sl_power_manager.h"
+    #define TRNG_POOL_DRAIN_ON_SLEEP
+  #endif // SL_CATALOG_POWER_MANAGER_PRESENT
+#endif // SL_VSE_TRNG_POOL_WORDS
+
 //------------------------------------------------------------------------------
 // Defines
 
@@ -71,6 +82,15 @@
 // check to make sure that the data actually has been retained during sleep.
 #define BUFFERED_RANDOMNESS_MAGIC_WORD (0xF55E0830)
 
+#if (SL_VSE_TRNG_POOL_WORDS > 0)
+
+#define TRNG_POOL_SIZE (SL_VSE_TRNG_POOL_WORDS * sizeof(uint32_t))
+
+// The pool is refilled from idle time once it is down to this many bytes.
+#define TRNG_POOL_LOW_LEVEL (TRNG_POOL_SIZE / 2)
+
+#endif // SL_VSE_TRNG_POOL_WORDS
+
 //------------------------------------------------------------------------------
 // Forward Declarations
 
@@ -84,6 +104,13 @@ static void store_trng_fifo_data(sl_power_manager_em_t from,
 
 #endif // SL_VSE_BUFFER_TRNG_DATA_DURING_SLEEP
 
+#if defined(TRNG_POOL_DRAIN_ON_SLEEP)
+
+static void drain_trng_fifo_to_pool(sl_power_manager_em_t from,
+                                    sl_power_manager_em_t to);
+
+#endif // TRNG_POOL_DRAIN_ON_SLEEP
+
 //------------------------------------------------------------------------------
 // Static Constants
 
@@ -103,6 +130,16 @@ static const sl_power_manager_em_transition_event_info_t buffer_trng_data_event
 
 #endif // SL_VSE_BUFFER_TRNG_DATA_DURING_SLEEP
 
+#if defined(TRNG_POOL_DRAIN_ON_SLEEP)
+
+static const sl_power_manager_em_transition_event_info_t trng_pool_drain_event = {
+  .event_mask = SL_POWER_MANAGER_EVENT_TRANSITION_ENTERING_EM2
+                | SL_POWER_MANAGER_EVENT_TRANSITION_ENTERING_EM3,
+  .on_event = drain_trng_fifo_to_pool,
+};
+
+#endif // TRNG_POOL_DRAIN_ON_SLEEP
+
 //------------------------------------------------------------------------------
 // Global Constants
 
@@ -128,6 +165,34 @@ static size_t n_buffered_random_bytes = 0;
 
 #endif // SL_VSE_BUFFER_TRNG_DATA_DURING_SLEEP
 
+#if (SL_VSE_TRNG_POOL_WORDS > 0)
+
+// Random bytes ready to be served without waiting for the TRNG. The first
+// trng_pool_level bytes are valid, and are consumed from the end. Kept in
+// .bss for the same reason as the sleep buffer above, so that the pool is
+// retained in EM2/EM3.
+static uint32_t trng_pool[SL_VSE_TRNG_POOL_WORDS] = { 0 };
+static size_t trng_pool_level = 0;
+
+// Set when the pool asked to stay awake for a refill, cleared by the refill.
+static bool trng_pool_refill_pending = false;
+
+// Set when a refill failed or found the TRNG FIFO empty, no new refill is
+// requested until the pool is used again.
+static bool trng_pool_refill_failed = false;
+
+// The lowest level starts at the pool size, the first level seen lowers it.
+static sli_cryptoacc_trng_pool_stats_t trng_pool_stats = {
+  .min_level = TRNG_POOL_SIZE,
+};
+
+#if defined(TRNG_POOL_DRAIN_ON_SLEEP)
+static sl_power_manager_em_transition_event_handle_t trng_pool_drain_handle = { 0 };
+static bool trng_pool_drain_subscribed = false;
+#endif // TRNG_POOL_DRAIN_ON_SLEEP
+
+#endif // SL_VSE_TRNG_POOL_WORDS
+
 //------------------------------------------------------------------------------
 // Static Function Definitions
 
@@ -189,6 +254,132 @@ static void store_trng_fifo_data(sl_power_manager_em_t from,
 
 #endif // SL_VSE_BUFFER_TRNG_DATA_DURING_SLEEP
 
+#if (SL_VSE_TRNG_POOL_WORDS > 0)
+
+/*
+ * \brief
+ *   Set the number of valid bytes in the pool, and track the lowest one.
+ *
+ * \note
+ *   Called with the interrupts disabled.
+ */
+static void trng_pool_set_level(size_t level)
+{
+  trng_pool_level = level;
+  if (level < trng_pool_stats.min_level) {
+    trng_pool_stats.min_level = level;
+  }
+}
+
+/*
+ * \brief
+ *   Serve as much as possible of a request from the pool.
+ *
+ * \details
+ *   Served bytes are wiped from the pool. A request that is not served in
+ *   full counts as a miss.
+ *
+ * \return
+ *   Number of bytes written to the output.
+ */
+static size_t trng_pool_take(uint8_t *output, size_t len)
+{
+  size_t n_taken;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+
+  n_taken = SX_MIN(len, trng_pool_level);
+  trng_pool_set_level(trng_pool_level - n_taken);
+  memcpy(output, (uint8_t *)trng_pool + trng_pool_level, n_taken);
+  memset((uint8_t *)trng_pool + trng_pool_level, 0, n_taken);
+
+  if (n_taken == len) {
+    trng_pool_stats.hits++;
+  } else {
+    trng_pool_stats.misses++;
+  }
+  trng_pool_refill_failed = false;
+
+  CORE_EXIT_CRITICAL();
+
+  return n_taken;
+}
+
+/*
+ * \brief
+ *   Move the words already in the TRNG FIFO to the pool.
+ *
+ * \details
+ *   Does not start the TRNG nor wait for it, so at most the FIFO content is
+ *   copied. Whatever is left of a partly consumed word of the pool is
+ *   dropped, so that whole words are appended. Must be called with the
+ *   CRYPTOACC acquired.
+ *
+ * \return
+ *   Number of bytes moved to the pool.
+ */
+static size_t trng_pool_move_fifo(void)
+{
+  size_t n_moved = 0;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+
+  size_t level = trng_pool_level & ~(sizeof(uint32_t) - 1u);
+  if ((level < TRNG_POOL_SIZE)
+      && ((ba431_read_controlreg() & BA431_CTRL_NDRNG_ENABLE) != 0u)) {
+    memset((uint8_t *)trng_pool + level, 0, trng_pool_level - level);
+    block_t pool_block =
+      block_t_convert((uint8_t *)trng_pool + level,
+                      SX_MIN(sizeof(uint32_t) * ba431_read_fifolevel(),
+                             TRNG_POOL_SIZE - level));
+    memcpy_blk(pool_block, trng_fifo_block, pool_block.len);
+    trng_pool_set_level(level + pool_block.len);
+    n_moved = pool_block.len;
+  }
+
+  CORE_EXIT_CRITICAL();
+
+  return n_moved;
+}
+
+#if defined(TRNG_POOL_DRAIN_ON_SLEEP)
+
+/*
+ * \brief
+ *   Callback function for moving the words already in the TRNG FIFO to the
+ *   pool.
+ *
+ * \details
+ *   Will be called by the Power Manager on EM2/EM3 entry, where the FIFO
+ *   content would otherwise be lost. Does not start the TRNG.
+ */
+static void drain_trng_fifo_to_pool(sl_power_manager_em_t from,
+                                    sl_power_manager_em_t to)
+{
+  (void)to;
+  (void)from;
+
+  if ((trng_pool_level & ~(sizeof(uint32_t) - 1u)) == TRNG_POOL_SIZE) {
+    return;
+  }
+
+  if (cryptoacc_management_acquire() != PSA_SUCCESS) {
+    return;
+  }
+
+  if (trng_pool_move_fifo() > 0u) {
+    trng_pool_stats.drains++;
+  }
+
+  (void)cryptoacc_management_release();
+}
+
+#endif // TRNG_POOL_DRAIN_ON_SLEEP
+
+#endif // SL_VSE_TRNG_POOL_WORDS
+
 static psa_status_t wait_until_trng_is_ready_for_sleep(void)
 {
   // We do not want to risk clocking down the CRYPTOACC while the ring
@@ -354,6 +545,16 @@ static psa_status_t cryptoacc_trng_get_random(block_t output)
     sl_power_manager_subscribe_em_transition_event(&buffer_trng_handle,
                                                    &buffer_trng_data_event);
     #endif // SL_VSE_BUFFER_TRNG_DATA_DURING_SLEEP
+
+    #if defined(TRNG_POOL_DRAIN_ON_SLEEP)
+    // The FIFO content is moved to the pool on every EM2/EM3 entry from now
+    // on.
+    if (!trng_pool_drain_subscribed) {
+      sl_power_manager_subscribe_em_transition_event(&trng_pool_drain_handle,
+                                                     &trng_pool_drain_event);
+      trng_pool_drain_subscribed = true;
+    }
+    #endif // TRNG_POOL_DRAIN_ON_SLEEP
   }
 
   size_t n_bytes_generated = 0;
@@ -405,6 +606,15 @@ static void cryptoacc_trng_get_random_wrapper(void *unused_state,
 {
   (void)unused_state;
 
+  #if (SL_VSE_TRNG_POOL_WORDS > 0)
+  size_t n_taken = trng_pool_take(output.addr, output.len);
+  if (n_taken == output.len) {
+    return;
+  }
+  output.addr += n_taken;
+  output.len -= n_taken;
+  #endif // SL_VSE_TRNG_POOL_WORDS
+
   if (cryptoacc_trng_get_random(output) != PSA_SUCCESS) {
     EFM_ASSERT(false);
     sx_trng_apply_soft_reset();
@@ -414,6 +624,16 @@ static void cryptoacc_trng_get_random_wrapper(void *unused_state,
 
 psa_status_t sli_cryptoacc_trng_get_random(unsigned char *output, size_t len)
 {
+  #if (SL_VSE_TRNG_POOL_WORDS > 0)
+  // Requests served from the pool do not need the CRYPTOACC at all.
+  size_t n_taken = trng_pool_take(output, len);
+  if (n_taken == len) {
+    return PSA_SUCCESS;
+  }
+  output += n_taken;
+  len -= n_taken;
+  #endif // SL_VSE_TRNG_POOL_WORDS
+
   psa_status_t status = cryptoacc_management_acquire();
   if (status != PSA_SUCCESS) {
     return status;
@@ -431,4 +651,75 @@ psa_status_t sli_cryptoacc_trng_get_random(unsigned char *output, size_t len)
   return cryptoacc_management_release();
 }
 
+bool sli_cryptoacc_trng_pool_is_ok_to_sleep(void)
+{
+  #if (SL_VSE_TRNG_POOL_WORDS > 0)
+  if (!trng_pool_refill_failed && (trng_pool_level <= TRNG_POOL_LOW_LEVEL)) {
+    trng_pool_refill_pending = true;
+    return false;
+  }
+  #endif // SL_VSE_TRNG_POOL_WORDS
+
+  return true;
+}
+
+void sli_cryptoacc_trng_pool_process_action(void)
+{
+  #if (SL_VSE_TRNG_POOL_WORDS > 0)
+  if (!trng_pool_refill_pending) {
+    return;
+  }
+  trng_pool_refill_pending = false;
+
+  if (cryptoacc_management_acquire() != PSA_SUCCESS) {
+    trng_pool_refill_failed = true;
+    return;
+  }
+
+  // Only take what the TRNG FIFO already holds, starting the TRNG or waiting
+  // for new words would block the super loop. The FIFO is full after every
+  // request that used the TRNG.
+  size_t n_moved = trng_pool_move_fifo();
+
+  // The TRNG would run to fill its FIFO again, with the CRYPTOACC clock gated
+  // its ring oscillators would keep running until the next EM2 entry. Stop
+  // it instead, as EM2 would, the next request that misses the pool starts
+  // it again.
+  if ((ba431_read_controlreg() & BA431_CTRL_NDRNG_ENABLE) != 0u) {
+    ba431_disable_ndrng();
+  }
+
+  if ((cryptoacc_management_release() != PSA_SUCCESS) || (n_moved == 0u)) {
+    trng_pool_refill_failed = true;
+  } else {
+    trng_pool_stats.refills++;
+  }
+  #endif // SL_VSE_TRNG_POOL_WORDS
+}
+
+void sli_cryptoacc_trng_get_pool_stats(sli_cryptoacc_trng_pool_stats_t *stats)
+{
+  #if (SL_VSE_TRNG_POOL_WORDS > 0)
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  *stats = trng_pool_stats;
+  stats->size = TRNG_POOL_SIZE;
+  stats->level = trng_pool_level;
+  CORE_EXIT_CRITICAL();
+  #else
+  memset(stats, 0, sizeof(*stats));
+  #endif // SL_VSE_TRNG_POOL_WORDS
+}
+
+void sli_cryptoacc_trng_reset_pool_stats(void)
+{
+  #if (SL_VSE_TRNG_POOL_WORDS > 0)
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_CRITICAL();
+  memset(&trng_pool_stats, 0, sizeof(trng_pool_stats));
+  trng_pool_stats.min_level = trng_pool_level;
+  CORE_EXIT_CRITICAL();
+  #endif // SL_VSE_TRNG_POOL_WORDS
+}
+
 #endif // SLI_MBEDTLS_DEVICE_VSE
@@ -0,0 +1,166 @@
+/***************************************************************************//**
+ * @file
+ * @brief IO Stream Multiplexer Component.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#ifndef SL_IOSTREAM_MUX_H
+#define SL_IOSTREAM_MUX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sl_status.h"
+#include "sl_iostream.h"
+#include "sl_iostream_mux_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @addtogroup iostream
+ * @{
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @addtogroup iostream_mux I/O Stream Multiplexer
+ * @brief I/O Stream Multiplexer
+ * @details
+ * ## Overview
+ *
+ *   The multiplexer carries several logical streams (channels) over a single
+ *   physical stream. Each channel is a regular sl_iostream_t and can be used
+ *   with all I/O Stream APIs, for example as the app_log stream.
+ *
+ *   On the physical stream, each frame is COBS encoded and terminated by a
+ *   0x00 delimiter. The decoded frame holds the channel identifier followed by
+ *   up to SL_IOSTREAM_MUX_MAX_FRAME_DATA_SIZE data bytes.
+ *
+ * ## Scheduling
+ *
+ *   Writes are buffered per channel. sl_iostream_mux_process_action() sends
+ *   one frame at a time, always from the highest priority channel with pending
+ *   data, so urgent traffic preempts bulk traffic between two frames. When a
+ *   channel buffer is full, the write drains the multiplexer until the data
+ *   fits, so no data is lost.
+ *
+ *   Received frames are dispatched to the receive buffer of their channel.
+ *   Data for an unknown channel, or not fitting in the channel buffer, is
+ *   dropped and counted.
+ *
+ * @note  The multiplexer is not thread safe and must not be used from ISRs.
+ * @{
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+/// @brief Byte FIFO used for channel buffers.
+typedef struct {
+  uint8_t *buffer;        ///< Storage
+  size_t size;            ///< Storage size
+  size_t head;            ///< Index of the oldest byte
+  size_t count;           ///< Number of bytes stored
+} sl_iostream_mux_fifo_t;
+
+struct sl_iostream_mux;
+
+/// @brief I/O Stream multiplexer channel
+typedef struct sl_iostream_mux_channel {
+  sl_iostream_t stream;                     ///< Channel stream
+  struct sl_iostream_mux *mux;              ///< Multiplexer carrying the channel
+  struct sl_iostream_mux_channel *next;     ///< Next channel, by decreasing priority
+  uint8_t id;                               ///< Channel identifier on the physical stream
+  uint8_t priority;                         ///< Transmit priority, higher is more urgent
+  sl_iostream_mux_fifo_t tx;                ///< Transmit buffer
+  sl_iostream_mux_fifo_t rx;                ///< Receive buffer
+  uint32_t rx_dropped;                      ///< Received bytes dropped because the buffer was full
+} sl_iostream_mux_channel_t;
+
+/// @brief I/O Stream multiplexer
+typedef struct sl_iostream_mux {
+  sl_iostream_t *physical;                  ///< Physical stream
+  sl_iostream_mux_channel_t *channels;      ///< Channels, by decreasing priority
+  uint8_t rx_frame[SL_IOSTREAM_MUX_MAX_FRAME_DATA_SIZE + 3];  ///< Encoded frame being received
+  size_t rx_frame_len;                      ///< Encoded frame length
+  bool rx_frame_overflow;                   ///< Encoded frame too long, dropped
+  uint32_t rx_dropped_frames;               ///< Frames dropped: malformed or unknown channel
+} sl_iostream_mux_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************//**
+ * Initialize a multiplexer.
+ *
+ * @param[in] mux       Multiplexer.
+ *
+ * @param[in] physical  Physical stream carrying the channels.
+ *
+ * @return  Status result
+ ******************************************************************************/
+sl_status_t sl_iostream_mux_init(sl_iostream_mux_t *mux,
+                                 sl_iostream_t *physical);
+
+/***************************************************************************//**
+ * Add a channel to a multiplexer.
+ *
+ * @param[in] mux           Multiplexer.
+ *
+ * @param[in] channel       Channel object, must stay valid while in use.
+ *
+ * @param[in] id            Channel identifier, unique on the multiplexer.
+ *
+ * @param[in] priority      Transmit priority, higher is more urgent.
+ *
+ * @param[in] tx_buffer     Transmit buffer.
+ *
+ * @param[in] tx_size       Transmit buffer size.
+ *
+ * @param[in] rx_buffer     Receive buffer. Can be NULL for output only channels.
+ *
+ * @param[in] rx_size       Receive buffer size.
+ *
+ * @return  Status result
+ ******************************************************************************/
+sl_status_t sl_iostream_mux_add_channel(sl_iostream_mux_t *mux,
+                                        sl_iostream_mux_channel_t *channel,
+                                        uint8_t id,
+                                        uint8_t priority,
+                                        uint8_t *tx_buffer,
+                                        size_t tx_size,
+                                        uint8_t *rx_buffer,
+                                        size_t rx_size);
+
+/***************************************************************************//**
+ * Receive pending frames and send buffered data by priority.
+ * Must be called from the super loop.
+ *
+ * @param[in] mux  Multiplexer.
+ ******************************************************************************/
+void sl_iostream_mux_process_action(sl_iostream_mux_t *mux);
+
+/***************************************************************************//**
+ * Send all buffered data, by priority.
+ *
+ * @param[in] mux  Multiplexer.
+ *
+ * @return  Status result
+ ******************************************************************************/
+sl_status_t sl_iostream_mux_flush(sl_iostream_mux_t *mux);
+
+/** @} (end addtogroup iostream_mux) */
+/** @} (end addtogroup iostream) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_IOSTREAM_MUX_H
@@ -0,0 +1,49 @@
+/***************************************************************************//**
+ * @file
+ * @brief IO Stream Multiplexer instances carried by VCOM.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#ifndef SL_IOSTREAM_MUX_INSTANCES_H
+#define SL_IOSTREAM_MUX_INSTANCES_H
+
+#include "sl_iostream.h"
+#include "sl_iostream_mux.h"
+#include "sl_status.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Channel identifiers on the physical stream
+#define SL_IOSTREAM_MUX_VCOM_LOG_ID       0
+#define SL_IOSTREAM_MUX_VCOM_TRACE_ID     1
+#define SL_IOSTREAM_MUX_VCOM_CONTROL_ID   2
+
+extern sl_iostream_mux_t sl_iostream_mux_vcom;
+
+extern sl_iostream_t *sl_iostream_mux_log_handle;
+extern sl_iostream_t *sl_iostream_mux_trace_handle;
+extern sl_iostream_t *sl_iostream_mux_control_handle;
+
+/***************************************************************************//**
+ * Start the multiplexer on VCOM and add the log, trace and control channels.
+ *
+ * @note Call it once the VCOM instance is initialized, from app_init().
+ *       The channels are not listed in the generated
+ *       sl_iostream_instances_info, so they are not found by name.
+ *
+ * @return Status of the multiplexer or of the first channel that failed.
+ ******************************************************************************/
+sl_status_t sl_iostream_mux_init_instances(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_IOSTREAM_MUX_INSTANCES_H
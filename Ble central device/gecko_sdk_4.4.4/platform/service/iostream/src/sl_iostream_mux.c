@@ -0,0 +1,478 @@
+/***************************************************************************//**
+ * @file
+ * @brief IO Stream Multiplexer Component.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#include "sl_iostream.h"
+#include "sl_iostream_mux.h"
+#include "sl_status.h"
+#include "sl_common.h"
+
+#include <string.h>
+
+/*******************************************************************************
+ *******************************   DEFINES   ***********************************
+ ******************************************************************************/
+
+// Channel identifier followed by the data
+#define FRAME_PAYLOAD_SIZE    (SL_IOSTREAM_MUX_MAX_FRAME_DATA_SIZE + 1)
+
+// COBS code byte, payload and delimiter
+#define FRAME_ENCODED_SIZE    (FRAME_PAYLOAD_SIZE + 2)
+
+#if (SL_IOSTREAM_MUX_MAX_FRAME_DATA_SIZE > 253)
+#error "SL_IOSTREAM_MUX_MAX_FRAME_DATA_SIZE must fit in a single COBS block"
+#endif
+
+/*******************************************************************************
+ *********************   LOCAL FUNCTION PROTOTYPES   ***************************
+ ******************************************************************************/
+
+static sl_status_t channel_write(void *context,
+                                 const void *buffer,
+                                 size_t buffer_length);
+
+static sl_status_t channel_read(void *context,
+                                void *buffer,
+                                size_t buffer_length,
+                                size_t *bytes_read);
+
+static sl_status_t channel_peek(void *context,
+                                const void **span,
+                                size_t *span_length);
+
+static sl_status_t channel_commit(void *context,
+                                  size_t length);
+
+static size_t fifo_push(sl_iostream_mux_fifo_t *fifo,
+                        const uint8_t *data,
+                        size_t length);
+
+static size_t fifo_pop(sl_iostream_mux_fifo_t *fifo,
+                       uint8_t *data,
+                       size_t length);
+
+static size_t fifo_contiguous(const sl_iostream_mux_fifo_t *fifo);
+
+static sl_status_t send_next_frame(sl_iostream_mux_t *mux,
+                                   size_t *sent);
+
+static void receive(sl_iostream_mux_t *mux);
+
+static void consume_rx(sl_iostream_mux_t *mux,
+                       const uint8_t *data,
+                       size_t length);
+
+static void dispatch_frame(sl_iostream_mux_t *mux);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * Multiplexer init
+ ******************************************************************************/
+sl_status_t sl_iostream_mux_init(sl_iostream_mux_t *mux,
+                                 sl_iostream_t *physical)
+{
+  if ((mux == NULL) || (physical == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  memset(mux, 0, sizeof(*mux));
+  mux->physical = physical;
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Add a channel, keeping the list sorted by decreasing priority
+ ******************************************************************************/
+sl_status_t sl_iostream_mux_add_channel(sl_iostream_mux_t *mux,
+                                        sl_iostream_mux_channel_t *channel,
+                                        uint8_t id,
+                                        uint8_t priority,
+                                        uint8_t *tx_buffer,
+                                        size_t tx_size,
+                                        uint8_t *rx_buffer,
+                                        size_t rx_size)
+{
+  sl_iostream_mux_channel_t **link;
+
+  if ((mux == NULL) || (channel == NULL) || (tx_buffer == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if ((tx_size == 0) || ((rx_buffer == NULL) && (rx_size != 0))) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  for (sl_iostream_mux_channel_t *it = mux->channels; it != NULL; it = it->next) {
+    if ((it->id == id) || (it == channel)) {
+      return SL_STATUS_ALREADY_EXISTS;
+    }
+  }
+
+  memset(channel, 0, sizeof(*channel));
+  channel->stream.context = channel;
+  channel->stream.write = channel_write;
+  channel->stream.read = channel_read;
+  channel->stream.peek = channel_peek;
+  channel->stream.commit = channel_commit;
+  channel->mux = mux;
+  channel->id = id;
+  channel->priority = priority;
+  channel->tx.buffer = tx_buffer;
+  channel->tx.size = tx_size;
+  channel->rx.buffer = rx_buffer;
+  channel->rx.size = rx_size;
+
+  // Channels with the same priority are served in insertion order
+  link = &mux->channels;
+  while ((*link != NULL) && ((*link)->priority >= priority)) {
+    link = &(*link)->next;
+  }
+  channel->next = *link;
+  *link = channel;
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Multiplexer process action
+ ******************************************************************************/
+void sl_iostream_mux_process_action(sl_iostream_mux_t *mux)
+{
+  size_t budget = SL_IOSTREAM_MUX_TX_BUDGET;
+  size_t sent;
+
+  receive(mux);
+
+  while (budget > 0) {
+    if ((send_next_frame(mux, &sent) != SL_STATUS_OK) || (sent == 0)) {
+      break;
+    }
+    budget = (sent < budget) ? (budget - sent) : 0;
+  }
+}
+
+/***************************************************************************//**
+ * Send all buffered data
+ ******************************************************************************/
+sl_status_t sl_iostream_mux_flush(sl_iostream_mux_t *mux)
+{
+  sl_status_t status;
+  size_t sent;
+
+  do {
+    status = send_next_frame(mux, &sent);
+  } while ((status == SL_STATUS_OK) && (sent > 0));
+
+  return status;
+}
+
+/*******************************************************************************
+ **************************   LOCAL FUNCTIONS   ********************************
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * Channel write implementation
+ ******************************************************************************/
+static sl_status_t channel_write(void *context,
+                                 const void *buffer,
+                                 size_t buffer_length)
+{
+  sl_iostream_mux_channel_t *channel = (sl_iostream_mux_channel_t *)context;
+  const uint8_t *data = (const uint8_t *)buffer;
+  size_t pushed;
+  size_t sent;
+
+  while (buffer_length > 0) {
+    pushed = fifo_push(&channel->tx, data, buffer_length);
+    data += pushed;
+    buffer_length -= pushed;
+
+    if (buffer_length > 0) {
+      // Buffer full, make room by sending frames in priority order
+      sl_status_t status = send_next_frame(channel->mux, &sent);
+      if (status != SL_STATUS_OK) {
+        return status;
+      }
+    }
+  }
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Channel read implementation
+ ******************************************************************************/
+static sl_status_t channel_read(void *context,
+                                void *buffer,
+                                size_t buffer_length,
+                                size_t *bytes_read)
+{
+  sl_iostream_mux_channel_t *channel = (sl_iostream_mux_channel_t *)context;
+
+  *bytes_read = fifo_pop(&channel->rx, (uint8_t *)buffer, buffer_length);
+
+  return (*bytes_read == 0) ? SL_STATUS_EMPTY : SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Channel peek implementation
+ ******************************************************************************/
+static sl_status_t channel_peek(void *context,
+                                const void **span,
+                                size_t *span_length)
+{
+  sl_iostream_mux_channel_t *channel = (sl_iostream_mux_channel_t *)context;
+
+  *span_length = fifo_contiguous(&channel->rx);
+  if (*span_length == 0) {
+    *span = NULL;
+    return SL_STATUS_EMPTY;
+  }
+
+  *span = &channel->rx.buffer[channel->rx.head];
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Channel commit implementation
+ ******************************************************************************/
+static sl_status_t channel_commit(void *context,
+                                  size_t length)
+{
+  sl_iostream_mux_channel_t *channel = (sl_iostream_mux_channel_t *)context;
+
+  if (length > fifo_contiguous(&channel->rx)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  fifo_pop(&channel->rx, NULL, length);
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Push as much data as fits in a FIFO. Returns the number of bytes pushed.
+ ******************************************************************************/
+static size_t fifo_push(sl_iostream_mux_fifo_t *fifo,
+                        const uint8_t *data,
+                        size_t length)
+{
+  size_t tail = (fifo->head + fifo->count) % SL_MAX(fifo->size, (size_t)1);
+  size_t pushed = SL_MIN(length, fifo->size - fifo->count);
+  size_t first = SL_MIN(pushed, fifo->size - tail);
+
+  if (pushed == 0) {
+    return 0;
+  }
+
+  memcpy(&fifo->buffer[tail], data, first);
+  memcpy(fifo->buffer, &data[first], pushed - first);
+  fifo->count += pushed;
+
+  return pushed;
+}
+
+/***************************************************************************//**
+ * Pop up to length bytes from a FIFO. data can be NULL to discard the bytes.
+ * Returns the number of bytes popped.
+ ******************************************************************************/
+static size_t fifo_pop(sl_iostream_mux_fifo_t *fifo,
+                       uint8_t *data,
+                       size_t length)
+{
+  size_t popped = SL_MIN(length, fifo->count);
+  size_t first = SL_MIN(popped, fifo->size - fifo->head);
+
+  if (popped == 0) {
+    return 0;
+  }
+
+  if (data != NULL) {
+    memcpy(data, &fifo->buffer[fifo->head], first);
+    memcpy(&data[first], fifo->buffer, popped - first);
+  }
+  fifo->head = (fifo->head + popped) % fifo->size;
+  fifo->count -= popped;
+
+  // Restart from the beginning when empty to maximize contiguous spans
+  if (fifo->count == 0) {
+    fifo->head = 0;
+  }
+
+  return popped;
+}
+
+/***************************************************************************//**
+ * Number of bytes readable without wrapping around the FIFO.
+ ******************************************************************************/
+static size_t fifo_contiguous(const sl_iostream_mux_fifo_t *fifo)
+{
+  if (fifo->count == 0) {
+    return 0;
+  }
+  return SL_MIN(fifo->count, fifo->size - fifo->head);
+}
+
+/***************************************************************************//**
+ * Send one frame from the highest priority channel with pending data.
+ * sent is set to the number of data bytes sent, 0 when nothing is pending.
+ ******************************************************************************/
+static sl_status_t send_next_frame(sl_iostream_mux_t *mux,
+                                   size_t *sent)
+{
+  uint8_t payload[FRAME_PAYLOAD_SIZE];
+  uint8_t frame[FRAME_ENCODED_SIZE];
+  sl_iostream_mux_channel_t *channel = mux->channels;
+  size_t payload_len;
+  size_t code_index = 0;
+  size_t frame_len = 1;
+  uint8_t code = 1;
+
+  *sent = 0;
+
+  while ((channel != NULL) && (channel->tx.count == 0)) {
+    channel = channel->next;
+  }
+  if (channel == NULL) {
+    return SL_STATUS_OK;
+  }
+
+  payload[0] = channel->id;
+  payload_len = 1 + fifo_pop(&channel->tx, &payload[1], SL_IOSTREAM_MUX_MAX_FRAME_DATA_SIZE);
+
+  // COBS encode, the payload always fits in a single block
+  for (size_t i = 0; i < payload_len; i++) {
+    if (payload[i] == 0) {
+      frame[code_index] = code;
+      code_index = frame_len++;
+      code = 1;
+    } else {
+      frame[frame_len++] = payload[i];
+      code++;
+    }
+  }
+  frame[code_index] = code;
+  frame[frame_len++] = 0x00;
+
+  *sent = payload_len - 1;
+  return sl_iostream_write(mux->physical, frame, frame_len);
+}
+
+/***************************************************************************//**
+ * Receive pending data from the physical stream.
+ ******************************************************************************/
+static void receive(sl_iostream_mux_t *mux)
+{
+  const void *span;
+  size_t span_len;
+  sl_status_t status;
+
+  // Parse received bytes in place when the physical stream supports it
+  while ((status = sl_iostream_peek(mux->physical, &span, &span_len)) == SL_STATUS_OK) {
+    consume_rx(mux, (const uint8_t *)span, span_len);
+    sl_iostream_commit(mux->physical, span_len);
+  }
+
+  if (status == SL_STATUS_NOT_SUPPORTED) {
+    uint8_t buffer[32];
+    size_t bytes_read = 0;
+
+    while ((sl_iostream_read(mux->physical, buffer, sizeof(buffer), &bytes_read) == SL_STATUS_OK)
+           && (bytes_read > 0)) {
+      consume_rx(mux, buffer, bytes_read);
+    }
+  }
+}
+
+/***************************************************************************//**
+ * Accumulate received bytes and dispatch each delimited frame.
+ ******************************************************************************/
+static void consume_rx(sl_iostream_mux_t *mux,
+                       const uint8_t *data,
+                       size_t length)
+{
+  while (length > 0) {
+    const uint8_t *delimiter = memchr(data, 0x00, length);
+    size_t chunk = (delimiter != NULL) ? (size_t)(delimiter - data) : length;
+
+    if (!mux->rx_frame_overflow) {
+      if (chunk > (sizeof(mux->rx_frame) - mux->rx_frame_len)) {
+        // Frame too long, drop everything up to the next delimiter
+        mux->rx_frame_overflow = true;
+        mux->rx_dropped_frames++;
+      } else {
+        memcpy(&mux->rx_frame[mux->rx_frame_len], data, chunk);
+        mux->rx_frame_len += chunk;
+      }
+    }
+
+    if (delimiter == NULL) {
+      return;
+    }
+
+    if (!mux->rx_frame_overflow && (mux->rx_frame_len > 0)) {
+      dispatch_frame(mux);
+    }
+    mux->rx_frame_len = 0;
+    mux->rx_frame_overflow = false;
+
+    data += chunk + 1;
+    length -= chunk + 1;
+  }
+}
+
+/***************************************************************************//**
+ * Decode a received frame in place and hand its data to the channel.
+ ******************************************************************************/
+static void dispatch_frame(sl_iostream_mux_t *mux)
+{
+  uint8_t *frame = mux->rx_frame;
+  size_t read = 0;
+  size_t write = 0;
+  size_t pushed;
+  sl_iostream_mux_channel_t *channel;
+
+  // COBS decode
+  while (read < mux->rx_frame_len) {
+    uint8_t code = frame[read++];
+
+    if ((code == 0) || ((read + code - 1) > mux->rx_frame_len)) {
+      mux->rx_dropped_frames++;
+      return;
+    }
+    for (uint8_t i = 1; i < code; i++) {
+      frame[write++] = frame[read++];
+    }
+    if ((code != 0xFF) && (read < mux->rx_frame_len)) {
+      frame[write++] = 0;
+    }
+  }
+
+  if (write == 0) {
+    mux->rx_dropped_frames++;
+    return;
+  }
+
+  for (channel = mux->channels; channel != NULL; channel = channel->next) {
+    if (channel->id == frame[0]) {
+      break;
+    }
+  }
+  if (channel == NULL) {
+    mux->rx_dropped_frames++;
+    return;
+  }
+
+  pushed = fifo_push(&channel->rx, &frame[1], write - 1);
+  channel->rx_dropped += (uint32_t)((write - 1) - pushed);
+}
@@ -0,0 +1,69 @@
+/***************************************************************************//**
+ * @file
+ * @brief IO Stream Multiplexer instances carried by VCOM.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#include "sl_iostream.h"
+#include "sl_iostream_mux.h"
+#include "sl_iostream_mux_config.h"
+#include "sl_iostream_init_usart_instances.h"
+#include "sl_iostream_mux_instances.h"
+
+// Multiplexer carried by VCOM
+sl_iostream_mux_t sl_iostream_mux_vcom;
+
+// Channels, their handles and buffers
+
+static sl_iostream_mux_channel_t sl_iostream_mux_log;
+sl_iostream_t *sl_iostream_mux_log_handle = &sl_iostream_mux_log.stream;
+static uint8_t tx_buffer_mux_log[SL_IOSTREAM_MUX_VCOM_LOG_TX_BUFFER_SIZE];
+
+static sl_iostream_mux_channel_t sl_iostream_mux_trace;
+sl_iostream_t *sl_iostream_mux_trace_handle = &sl_iostream_mux_trace.stream;
+static uint8_t tx_buffer_mux_trace[SL_IOSTREAM_MUX_VCOM_TRACE_TX_BUFFER_SIZE];
+
+static sl_iostream_mux_channel_t sl_iostream_mux_control;
+sl_iostream_t *sl_iostream_mux_control_handle = &sl_iostream_mux_control.stream;
+static uint8_t tx_buffer_mux_control[SL_IOSTREAM_MUX_VCOM_CONTROL_TX_BUFFER_SIZE];
+static uint8_t rx_buffer_mux_control[SL_IOSTREAM_MUX_VCOM_CONTROL_RX_BUFFER_SIZE];
+
+/***************************************************************************//**
+ * Start the multiplexer on VCOM and add the log, trace and control channels.
+ ******************************************************************************/
+sl_status_t sl_iostream_mux_init_instances(void)
+{
+  sl_status_t status;
+
+  status = sl_iostream_mux_init(&sl_iostream_mux_vcom, sl_iostream_vcom_handle);
+  if (status != SL_STATUS_OK) {
+    return status;
+  }
+
+  // Priority follows the identifier, the control channel is the most urgent
+  status = sl_iostream_mux_add_channel(&sl_iostream_mux_vcom, &sl_iostream_mux_log,
+                                       SL_IOSTREAM_MUX_VCOM_LOG_ID, 0,
+                                       tx_buffer_mux_log, sizeof(tx_buffer_mux_log),
+                                       NULL, 0);
+  if (status != SL_STATUS_OK) {
+    return status;
+  }
+
+  status = sl_iostream_mux_add_channel(&sl_iostream_mux_vcom, &sl_iostream_mux_trace,
+                                       SL_IOSTREAM_MUX_VCOM_TRACE_ID, 1,
+                                       tx_buffer_mux_trace, sizeof(tx_buffer_mux_trace),
+                                       NULL, 0);
+  if (status != SL_STATUS_OK) {
+    return status;
+  }
+
+  return sl_iostream_mux_add_channel(&sl_iostream_mux_vcom, &sl_iostream_mux_control,
+                                     SL_IOSTREAM_MUX_VCOM_CONTROL_ID, 2,
+                                     tx_buffer_mux_control, sizeof(tx_buffer_mux_control),
+                                     rx_buffer_mux_control, sizeof(rx_buffer_mux_control));
+}
@@ -39,6 +39,7 @@
 #include "sl_iostream_uart.h"
 #include "sli_iostream_uart.h"
 #include "sl_atomic.h"
+#include "sl_common.h"
 #include "sl_string.h"
 
 #if (defined(SL_CATALOG_KERNEL_PRESENT))
@@ -77,6 +78,13 @@ static sl_status_t uart_read(void *context,
                              size_t buffer_length,
                              size_t *bytes_read);
 
+static sl_status_t uart_peek(void *context,
+                             const void **span,
+                             size_t *span_length);
+
+static sl_status_t uart_commit(void *context,
+                               size_t length);
+
 static void set_auto_cr_lf(void *context,
                            bool on);
 
@@ -118,6 +126,12 @@ static size_t read_rx_buffer(sl_iostream_uart_context_t * uart_context,
                              uint8_t * buffer,
                              size_t buffer_len);
 
+static size_t get_rx_span_length(sl_iostream_uart_context_t * uart_context);
+
+static void start_rx_transfer(sl_iostream_uart_context_t * uart_context,
+                              uint8_t *write_ptr,
+                              size_t length);
+
 /*******************************************************************************
  **************************   GLOBAL FUNCTIONS   *******************************
  ******************************************************************************/
@@ -163,6 +177,8 @@ sl_status_t sli_iostream_uart_context_init(sl_iostream_uart_t *uart,
 
   uart->stream.write = uart_write;
   uart->stream.read = uart_read;
+  uart->stream.peek = uart_peek;
+  uart->stream.commit = uart_commit;
   uart->set_auto_cr_lf = set_auto_cr_lf;
   uart->get_auto_cr_lf = get_auto_cr_lf;
   uart->deinit = uart_deinit;
@@ -225,13 +241,14 @@ sl_status_t sli_iostream_uart_context_init(sl_iostream_uart_t *uart,
   NVIC_EnableIRQ(config->tx_irq_number);
 #endif // SL_CATALOG_POWER_MANAGER_PRESENT
 
-  // Start the (L)DMA to handle RXDATAV
+  // Start the (L)DMA to handle RXDATAV. Ring buffers larger than a single
+  // (L)DMA transfer are filled in several transfers by dma_irq_handler().
   ecode = DMADRV_PeripheralMemory(context->dma.channel,
                                   context->dma.cfg.peripheral_signal,
                                   context->rx_buffer,
                                   context->dma.cfg.src,
                                   true,
-                                  context->rx_buffer_len,
+                                  SL_MIN(context->rx_buffer_len, (size_t)DMADRV_MAX_XFER_COUNT),
                                   dmadrvDataSize1,
                                   dma_irq_handler,
                                   context);
@@ -485,6 +502,8 @@ static sl_status_t uart_deinit(void *stream)
   uart->stream.context = NULL;
   uart->stream.write = NULL;
   uart->stream.read = NULL;
+  uart->stream.peek = NULL;
+  uart->stream.commit = NULL;
   uart->set_auto_cr_lf = NULL;
   uart->get_auto_cr_lf = NULL;
 
@@ -679,6 +698,86 @@ static sl_status_t uart_read(void *context,
   }
 }
 
+/***************************************************************************//**
+ * Internal stream peek implementation
+ ******************************************************************************/
+static sl_status_t uart_peek(void *context,
+                             const void **span,
+                             size_t *span_length)
+{
+  CORE_DECLARE_IRQ_STATE;
+  sl_iostream_uart_context_t *uart_context = (sl_iostream_uart_context_t *)context;
+  size_t length = 0;
+
+  *span = NULL;
+  *span_length = 0;
+
+  // Control characters are stripped from the data returned to the user,
+  // which cannot be done without copying.
+  if (uart_context->sw_flow_control == true) {
+    return SL_STATUS_NOT_SUPPORTED;
+  }
+
+  CORE_ENTER_ATOMIC();
+  if (uart_context->rx_data_available == true) {
+    length = get_rx_span_length(uart_context);
+    *span = uart_context->rx_read_ptr;
+  }
+  CORE_EXIT_ATOMIC();
+
+  if (length == 0) {
+    return SL_STATUS_EMPTY;
+  }
+
+  *span_length = length;
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Internal stream commit implementation
+ ******************************************************************************/
+static sl_status_t uart_commit(void *context,
+                               size_t length)
+{
+  CORE_DECLARE_IRQ_STATE;
+  sl_iostream_uart_context_t *uart_context = (sl_iostream_uart_context_t *)context;
+  sl_status_t status = SL_STATUS_OK;
+
+  if (uart_context->sw_flow_control == true) {
+    return SL_STATUS_NOT_SUPPORTED;
+  }
+
+  if (length == 0) {
+    return SL_STATUS_OK;
+  }
+
+  CORE_ENTER_ATOMIC();
+  if ((uart_context->rx_data_available == false)
+      || (length > get_rx_span_length(uart_context))) {
+    status = SL_STATUS_INVALID_PARAMETER;
+  } else {
+    uart_context->rx_read_ptr += length;
+
+    // Wrap rx_read_ptr around
+    if (uart_context->rx_read_ptr == (uart_context->rx_buffer + uart_context->rx_buffer_len)) {
+      uart_context->rx_read_ptr = uart_context->rx_buffer;
+    }
+
+    // Update the ring buffer after read
+    update_ring_buffer(uart_context);
+  }
+  CORE_EXIT_ATOMIC();
+
+  #if defined(SL_CATALOG_KERNEL_PRESENT)
+  // The whole buffer was consumed, make sure the next blocking read waits for new data
+  if ((status == SL_STATUS_OK) && (uart_context->block) && (uart_context->rx_data_available == false)) {
+    (void)osSemaphoreAcquire(uart_context->read_signal, 0u);
+  }
+  #endif
+
+  return status;
+}
+
 /***************************************************************************//**
  * Updates the (L)DMA to re-use whatever space is in the ring buffer.
  * Always returns false (no loop, check DMADRV IRQ callbacks documentation
@@ -686,10 +785,10 @@ static sl_status_t uart_read(void *context,
  ******************************************************************************/
 static bool dma_irq_handler(unsigned int chan, unsigned int seq, void* user_param)
 {
+  (void) chan;
   (void) seq;
   sl_iostream_uart_context_t *uart_context = (sl_iostream_uart_context_t *)user_param;
   uint8_t *write_ptr;
-  Ecode_t ecode;
   size_t available_space;
 
   // Compute next write position
@@ -708,16 +807,7 @@ static bool dma_irq_handler(unsigned int chan, unsigned int seq, void* user_para
   // Space available in the RX buffer
   if (available_space > 0) {
     // Start the DMA transfer
-    ecode = DMADRV_PeripheralMemory(chan,
-                                    uart_context->dma.cfg.peripheral_signal,
-                                    write_ptr,
-                                    uart_context->dma.cfg.src,
-                                    true,
-                                    available_space,
-                                    dmadrvDataSize1,
-                                    dma_irq_handler,
-                                    uart_context);
-    EFM_ASSERT(ecode == ECODE_OK);
+    start_rx_transfer(uart_context, write_ptr, available_space);
   }
   // RX buffer is full
   else {
@@ -768,6 +858,64 @@ __STATIC_INLINE uint8_t* get_write_ptr(const sl_iostream_uart_context_t * uart_c
   return dst;
 }
 
+/***************************************************************************//**
+ * Start a (L)DMA transfer into the RX buffer.
+ * Transfers are capped to the (L)DMA maximum transfer count, the remaining space
+ * is filled by the next transfer started from dma_irq_handler().
+ ******************************************************************************/
+static void start_rx_transfer(sl_iostream_uart_context_t * uart_context,
+                              uint8_t *write_ptr,
+                              size_t length)
+{
+  Ecode_t ecode;
+
+  ecode = DMADRV_PeripheralMemory(uart_context->dma.channel,
+                                  uart_context->dma.cfg.peripheral_signal,
+                                  write_ptr,
+                                  uart_context->dma.cfg.src,
+                                  true,
+                                  SL_MIN(length, (size_t)DMADRV_MAX_XFER_COUNT),
+                                  dmadrvDataSize1,
+                                  dma_irq_handler,
+                                  uart_context);
+  EFM_ASSERT(ecode == ECODE_OK);
+}
+
+/***************************************************************************//**
+ * Get the number of contiguous bytes readable from rx_read_ptr.
+ * Must be called with data available and from an atomic section.
+ ******************************************************************************/
+static size_t get_rx_span_length(sl_iostream_uart_context_t * uart_context)
+{
+  uint8_t *write_ptr;
+
+  #if defined(DMA_PRESENT)
+  Ecode_t ecode;
+  ecode = DMADRV_PauseTransfer(uart_context->dma.channel);
+  EFM_ASSERT(ecode == ECODE_OK);
+  #endif // DMA_PRESENT
+
+  write_ptr = get_write_ptr(uart_context);
+
+  #if defined(DMA_PRESENT)
+  ecode = DMADRV_ResumeTransfer(uart_context->dma.channel);
+  EFM_ASSERT(ecode == ECODE_OK);
+  #endif // DMA_PRESENT
+
+  if (write_ptr == uart_context->rx_read_ptr) {
+    // (L)DMA is wrapped over rx_read_ptr, make sure it is stopped
+    EFM_ASSERT(uart_context->rx_buffer_full == true);
+  }
+
+  // (L)DMA ahead of read ptr, data in between the (L)DMA and the read ptr
+  if (write_ptr > uart_context->rx_read_ptr) {
+    return (size_t)(write_ptr - uart_context->rx_read_ptr);
+  }
+
+  // (L)DMA wrapped around RX buffer, data between read ptr and end of RX buffer
+  return (size_t)((uart_context->rx_buffer + uart_context->rx_buffer_len) - uart_context->rx_read_ptr);
+}
+
 /***************************************************************************//**
  * Update ring buffer pointers and DMA descriptor.
  ******************************************************************************/
@@ -801,16 +949,7 @@ static void update_ring_buffer(sl_iostream_uart_context_t * uart_context)
     uart_context->set_next_byte_detect(uart_context);
 
     // Start new transfer for all rx_buffer
-    ecode = DMADRV_PeripheralMemory(uart_context->dma.channel,
-                                    uart_context->dma.cfg.peripheral_signal,
-                                    write_ptr,
-                                    uart_context->dma.cfg.src,
-                                    true,
-                                    uart_context->rx_buffer_len,
-                                    dmadrvDataSize1,
-                                    dma_irq_handler,
-                                    uart_context);
-    EFM_ASSERT(ecode == ECODE_OK);
+    start_rx_transfer(uart_context, write_ptr, uart_context->rx_buffer_len);
   }
   // Data still available in buffer
   else {
@@ -871,38 +1010,12 @@ static size_t read_rx_buffer(sl_iostream_uart_context_t * uart_context,
   }
   CORE_DECLARE_IRQ_STATE;
 
-  uint8_t *write_ptr;     // Pointer to the next byte to be written by the (L)DMA
   size_t read_size = 0;     // Number of bytes processed from the Rx Buffer
   size_t ret_val = 0;     // Number of bytes written to the user buffer
 
   // Compute the read_size
   {
-    #if defined(DMA_PRESENT)
-    Ecode_t ecode;
-    ecode = DMADRV_PauseTransfer(uart_context->dma.channel);
-    EFM_ASSERT(ecode == ECODE_OK);
-    #endif // DMA_PRESENT
-
-    write_ptr = get_write_ptr(uart_context);
-
-    #if defined(DMA_PRESENT)
-    ecode = DMADRV_ResumeTransfer(uart_context->dma.channel);
-    EFM_ASSERT(ecode == ECODE_OK);
-    #endif // DMA_PRESENT
-
-    if (write_ptr == uart_context->rx_read_ptr) {
-      // (L)DMA is wrapped over rx_read_ptr, make sure it is stopped
-      EFM_ASSERT(uart_context->rx_buffer_full == true);
-    }
-
-    // (L)DMA ahead of read ptr, read data in between the (L)DMA and the read ptr
-    if (write_ptr > uart_context->rx_read_ptr) {
-      read_size = write_ptr - uart_context->rx_read_ptr;
-    }
-    // (L)DMA wrapped around RX buffer, read data between read ptr and end of RX buffer
-    else {
-      read_size = (uart_context->rx_buffer + uart_context->rx_buffer_len) - uart_context->rx_read_ptr;
-    }
+    read_size = get_rx_span_length(uart_context);
 
     // read the smallest amount between the data available and the size of the user buffer
     read_size = buffer_len < read_size ? buffer_len : read_size;
@@ -271,6 +271,17 @@ typedef struct {
   sl_power_manager_em_transition_event_info_t *info;  ///< Handle event info.
 } sl_power_manager_em_transition_event_handle_t;
 
+/// @brief Statistics of the wake-up restore time measured in adaptive mode
+typedef struct {
+  uint32_t sample_count;          ///< Number of restores measured
+  uint32_t late_count;            ///< Restores completed after the timer they were started for
+  uint32_t last_restore_tick;     ///< Last measured restore time, from the early wake-up to the clock restore completion
+  uint32_t min_restore_tick;      ///< Shortest measured restore time
+  uint32_t max_restore_tick;      ///< Longest measured restore time
+  uint32_t estimate_tick;         ///< Running estimate of the restore time, including a margin for its variation
+  int32_t overhead_tick;          ///< Restore overhead applied in adaptive mode
+} sl_power_manager_restore_stats_t;
+
 /// On ISR Exit Hook answer
 SL_ENUM(sl_power_manager_on_isr_exit_t) {
   SL_POWER_MANAGER_IGNORE = (1UL << 0UL),     ///< The module did not trigger an ISR and it doesn't want to contribute to the decision
@@ -499,6 +510,35 @@ uint32_t sl_power_manager_schedule_wakeup_get_minimum_offtime_tick(void);
  ******************************************************************************/
 void sl_power_manager_schedule_wakeup_set_minimum_offtime_tick(uint32_t minimum_offtime_tick);
 
+/***************************************************************************//**
+ * Enable or disable the adaptive restore overhead for schedule wake-up.
+ *
+ * @param enable  True to compute the restore overhead from the measured
+ *                restore times, false to use the configured overhead.
+ *
+ * @note  In adaptive mode, the time from each early wake-up to the completion
+ *        of the clock restore is measured. The restore overhead then follows a
+ *        running estimate of the restore time, its average plus four times its
+ *        average deviation, instead of the value set with
+ *        sl_power_manager_schedule_wakeup_set_restore_overhead_tick(). The
+ *        decision to go to EM2/EM3 before a scheduled wake-up uses the same
+ *        estimate.
+ *
+ * @note This function will do nothing when a project contains the
+ *       power_manager_no_deepsleep component, which configures the
+ *       lowest energy mode as EM1.
+ ******************************************************************************/
+void sl_power_manager_schedule_wakeup_enable_adaptive_restore_overhead(bool enable);
+
+/***************************************************************************//**
+ * Get the statistics of the measured wake-up restore times.
+ *
+ * @param stats  Pointer to the statistics to fill.
+ *
+ * @note Restore times are measured in adaptive mode only.
+ ******************************************************************************/
+void sl_power_manager_schedule_wakeup_get_restore_stats(sl_power_manager_restore_stats_t *stats);
+
 /***************************************************************************//**
  * Enable or disable fast wake-up in EM2 and EM3
  *
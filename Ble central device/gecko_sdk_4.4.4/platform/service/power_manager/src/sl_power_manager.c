@@ -53,6 +53,13 @@
 // functionality.
 #define SCHEDULE_WAKEUP_DEFAULT_RESTORE_TIME_OVERHEAD_TICK  0
 
+#if !defined(SL_POWER_MANAGER_ADAPTIVE_RESTORE_OVERHEAD)
+#define SL_POWER_MANAGER_ADAPTIVE_RESTORE_OVERHEAD  0
+#endif
+
+// Number of restore times measured before the adaptive restore overhead is applied
+#define ADAPTIVE_RESTORE_MIN_SAMPLE_COUNT  4
+
 // Determine if the device supports EM1P
 #if !defined(SLI_DEVICE_SUPPORTS_EM1P) && defined(_SILICON_LABS_32B_SERIES_2_CONFIG) && _SILICON_LABS_32B_SERIES_2_CONFIG >= 2
 #define SLI_DEVICE_SUPPORTS_EM1P
@@ -116,6 +123,22 @@ uint32_t high_frequency_min_offtime_tick = 0;
 // Store the configuration overhead value in sleeptimer tick to add/remove to the wake-up time.
 int32_t wakeup_time_config_overhead_tick = 0;
 
+// Compute the restore overhead from the measured restore times
+static bool is_adaptive_restore_overhead_enabled = (SL_POWER_MANAGER_ADAPTIVE_RESTORE_OVERHEAD == 1);
+
+// Flag indicating if the restore started by the early wake-up timer is being measured
+static bool is_restore_measured = false;
+
+// Ticks at which the early wake-up timer and the timer requiring the restore expire
+static uint32_t restore_start_tick;
+static uint32_t restore_target_tick;
+
+// Running average of the restore time, scaled by 8, and of its deviation, scaled by 4
+static int32_t restore_average_x8;
+static int32_t restore_deviation_x4;
+
+static sl_power_manager_restore_stats_t restore_stats;
+
 static bool is_hf_x_oscillator_not_preserved;
 
 // Store if we are currently waiting for HF clock restoration to finish
@@ -173,6 +196,10 @@ static void on_clock_wakeup_timeout(sl_sleeptimer_timer_handle_t *handle,
 static void clock_restore_and_wait(void);
 
 static void clock_restore(void);
+
+static int32_t get_restore_overhead_tick(void);
+
+static void measure_restore_time(void);
 #endif
 
 static void power_manager_notify_em_transition(sl_power_manager_em_t from,
@@ -215,6 +242,9 @@ sl_status_t sl_power_manager_init(void)
     sli_power_manager_debug_init();
   #endif
     sl_slist_init(&power_manager_em_transition_event_list);
+  #if (SL_POWER_MANAGER_PROFILE == 1)
+    sli_power_manager_profile_init();
+  #endif
 
 #if !defined(SL_CATALOG_POWER_MANAGER_NO_DEEPSLEEP_PRESENT)
     // If lowest energy mode is not restricted to EM1, determine and set lowest energy mode
@@ -313,7 +343,13 @@ void sl_power_manager_sleep(void)
     }
 
     // Apply lowest reachable energy mode
+#if (SL_POWER_MANAGER_PROFILE == 1)
+    sli_power_manager_profile_on_sleep(current_em);
+#endif
     sli_power_manager_apply_em(current_em);
+#if (SL_POWER_MANAGER_PROFILE == 1)
+    sli_power_manager_profile_on_wakeup();
+#endif
 
     // In case we are waiting for the restore from an early wake-up,
     // we put back the current EM to the one before the early wake-up to do the next notification correctly.
@@ -355,11 +391,18 @@ void sl_power_manager_sleep(void)
     }
     // If possible, go back to sleep in EM1 while waiting for HF accuracy restore
     while (!sli_power_manager_is_high_freq_accuracy_clk_ready(false)) {
+#if (SL_POWER_MANAGER_PROFILE == 1)
+      sli_power_manager_profile_on_sleep(SL_POWER_MANAGER_EM1);
+#endif
       sli_power_manager_apply_em(SL_POWER_MANAGER_EM1);
+#if (SL_POWER_MANAGER_PROFILE == 1)
+      sli_power_manager_profile_on_wakeup();
+#endif
       exit_critical_with_primask(primask_state);
       primask_state = enter_critical_with_primask();
     }
     sli_power_manager_restore_states();
+    measure_restore_time();
     is_states_saved = false;
   }
 
@@ -371,7 +414,13 @@ void sl_power_manager_sleep(void)
   power_manager_notify_em_transition(SL_POWER_MANAGER_EM0, SL_POWER_MANAGER_EM1);
   do {
     // Apply EM1 energy mode
+#if (SL_POWER_MANAGER_PROFILE == 1)
+    sli_power_manager_profile_on_sleep(SL_POWER_MANAGER_EM1);
+#endif
     sli_power_manager_apply_em(SL_POWER_MANAGER_EM1);
+#if (SL_POWER_MANAGER_PROFILE == 1)
+    sli_power_manager_profile_on_wakeup();
+#endif
 
     exit_critical_with_primask(primask_state);
     primask_state = enter_critical_with_primask();
@@ -533,7 +582,7 @@ uint32_t sli_power_manager_get_restore_delay(void)
   }
 
   // Get the clock restore delay
-  wakeup_delay = sl_power_manager_schedule_wakeup_get_restore_overhead_tick();
+  wakeup_delay = get_restore_overhead_tick();
   wakeup_delay += sli_power_manager_get_wakeup_process_time_overhead();
 
   CORE_EXIT_CRITICAL();
@@ -704,6 +753,46 @@ void sl_power_manager_schedule_wakeup_set_minimum_offtime_tick(uint32_t minimum_
 #endif
 }
 
+/***************************************************************************//**
+ * Enable or disable the adaptive restore overhead for schedule wake-up.
+ ******************************************************************************/
+void sl_power_manager_schedule_wakeup_enable_adaptive_restore_overhead(bool enable)
+{
+#if !defined(SL_CATALOG_POWER_MANAGER_NO_DEEPSLEEP_PRESENT)
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  is_adaptive_restore_overhead_enabled = enable;
+  if (!enable) {
+    is_restore_measured = false;
+  }
+  CORE_EXIT_CRITICAL();
+#else
+  (void)enable;
+#endif
+}
+
+/***************************************************************************//**
+ * Get the statistics of the measured wake-up restore times.
+ ******************************************************************************/
+void sl_power_manager_schedule_wakeup_get_restore_stats(sl_power_manager_restore_stats_t *stats)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  if (stats == NULL) {
+    return;
+  }
+
+#if !defined(SL_CATALOG_POWER_MANAGER_NO_DEEPSLEEP_PRESENT)
+  CORE_ENTER_CRITICAL();
+  *stats = restore_stats;
+  CORE_EXIT_CRITICAL();
+#else
+  (void)irqState;
+  memset(stats, 0, sizeof(*stats));
+#endif
+}
+
 #if !defined(SL_CATALOG_POWER_MANAGER_NO_DEEPSLEEP_PRESENT)
 /*******************************************************************************
  * Converts microseconds time in sleeptimer ticks.
@@ -919,8 +1008,13 @@ static void evaluate_wakeup(sl_power_manager_em_t to)
 
     case SL_POWER_MANAGER_EM2:
     case SL_POWER_MANAGER_EM3:
-      // Get the time remaining until the next sleeptimer requiring early wake-up
-      status = sl_sleeptimer_get_remaining_time_of_first_timer(0, &tick_remaining);
+      // The early wake-up timer of the last sleep holds the comparator and
+      // would hide the coalescing of the timers after it. It is restarted below.
+      (void)sl_sleeptimer_stop_timer(&clock_wakeup_timer_handle);
+      // Get the time remaining until the compare match expiring the next
+      // sleeptimer requiring early wake-up, which coalescing can delay
+      // within the slack of the timers.
+      status = sli_sleeptimer_get_remaining_time_of_first_wakeup(0, &tick_remaining);
       if (status == SL_STATUS_OK) {
         if (tick_remaining <= high_frequency_min_offtime_tick) {
           // Add EM1 requirement if time remaining is to short to be energy efficient
@@ -929,11 +1023,9 @@ static void evaluate_wakeup(sl_power_manager_em_t to)
           requirement_on_em1_added = true;
         } else {
           int32_t wakeup_delay = 0;
-          int32_t cfg_overhead_tick = 0;
 
           // Calculate overall wake-up delay.
-          sl_atomic_load(cfg_overhead_tick, wakeup_time_config_overhead_tick);
-          wakeup_delay += cfg_overhead_tick;
+          wakeup_delay += get_restore_overhead_tick();
           wakeup_delay += sli_power_manager_get_wakeup_process_time_overhead();
           EFM_ASSERT(wakeup_delay >= 0);
           if (tick_remaining <= (uint32_t)wakeup_delay) {
@@ -945,6 +1037,12 @@ static void evaluate_wakeup(sl_power_manager_em_t to)
             if (sli_power_manager_is_high_freq_accuracy_clk_used()) {
               hf_accuracy_clk_flag = SLI_SLEEPTIMER_POWER_MANAGER_HF_ACCURACY_CLK_FLAG;
             }
+            // Remember when the restore must start and complete, to measure it.
+            is_restore_measured = false;
+            if (is_adaptive_restore_overhead_enabled) {
+              restore_target_tick = sl_sleeptimer_get_tick_count() + tick_remaining;
+              restore_start_tick = restore_target_tick - (uint32_t)wakeup_delay;
+            }
             // Start internal sleeptimer to do the early wake-up.
             sl_sleeptimer_restart_timer(&clock_wakeup_timer_handle,
                                         (tick_remaining - (uint32_t)wakeup_delay),
@@ -1010,6 +1108,80 @@ static void update_em1_requirement(bool add)
 }
 #endif
 
+#if !defined(SL_CATALOG_POWER_MANAGER_NO_DEEPSLEEP_PRESENT)
+/***************************************************************************//**
+ * Get the restore overhead used for the early wake-up.
+ *
+ * @return  Estimated overhead in adaptive mode, once enough restores are
+ *          measured, configured overhead otherwise.
+ ******************************************************************************/
+static int32_t get_restore_overhead_tick(void)
+{
+  int32_t overhead_tick;
+
+  if (is_adaptive_restore_overhead_enabled
+      && (restore_stats.sample_count >= ADAPTIVE_RESTORE_MIN_SAMPLE_COUNT)) {
+    return restore_stats.overhead_tick;
+  }
+
+  sl_atomic_load(overhead_tick, wakeup_time_config_overhead_tick);
+  return overhead_tick;
+}
+
+/***************************************************************************//**
+ * Measure the restore started by the early wake-up, once completed, and
+ * update the restore time estimate.
+ *
+ * @note Need to be call inside a critical section.
+ ******************************************************************************/
+static void measure_restore_time(void)
+{
+  uint32_t now;
+  uint32_t sample;
+  int32_t delta;
+  int32_t estimate;
+
+  if (!is_restore_measured) {
+    return;
+  }
+  is_restore_measured = false;
+
+  now = sl_sleeptimer_get_tick_count();
+  sample = now - restore_start_tick;
+  // Discard restores delayed by something else than the clocks, such as a debugger halt.
+  if (sample > sleeptimer_frequency) {
+    return;
+  }
+
+  if ((int32_t)(now - restore_target_tick) > 0) {
+    restore_stats.late_count++;
+  }
+
+  // Running average and average deviation, as for a round-trip time estimate.
+  if (restore_stats.sample_count == 0) {
+    restore_average_x8 = (int32_t)sample << 3;
+    restore_deviation_x4 = (int32_t)sample << 1;
+    restore_stats.min_restore_tick = sample;
+    restore_stats.max_restore_tick = sample;
+  } else {
+    delta = (int32_t)sample - (restore_average_x8 >> 3);
+    restore_average_x8 += delta;
+    if (delta < 0) {
+      delta = -delta;
+    }
+    restore_deviation_x4 += delta - (restore_deviation_x4 >> 2);
+    restore_stats.min_restore_tick = SL_MIN(restore_stats.min_restore_tick, sample);
+    restore_stats.max_restore_tick = SL_MAX(restore_stats.max_restore_tick, sample);
+  }
+
+  estimate = (restore_average_x8 >> 3) + restore_deviation_x4;
+  restore_stats.sample_count++;
+  restore_stats.last_restore_tick = sample;
+  restore_stats.estimate_tick = (uint32_t)estimate;
+  restore_stats.overhead_tick = estimate - (int32_t)sli_power_manager_get_wakeup_process_time_overhead();
+}
+#endif
+
 #if !defined(SL_CATALOG_POWER_MANAGER_NO_DEEPSLEEP_PRESENT)
 /***************************************************************************//**
  * Do clock restore process and wait for it to be completed.
@@ -1038,6 +1210,7 @@ static void clock_restore_and_wait(void)
     CORE_ENTER_CRITICAL();
     if (is_actively_waiting_for_clock_restore) {
       sli_power_manager_restore_states();
+      measure_restore_time();
       is_actively_waiting_for_clock_restore = false;
     }
 
@@ -1064,6 +1237,7 @@ static void clock_restore(void)
     if (sli_power_manager_is_high_freq_accuracy_clk_ready(false)) {
       // Do the clock restore if the HF oscillator is already ready
       sli_power_manager_restore_states();
+      measure_restore_time();
       is_states_saved = false;
 
       // We do the notification only when the restore is completed.
@@ -1110,6 +1284,9 @@ static void on_clock_wakeup_timeout(sl_sleeptimer_timer_handle_t *handle,
     return;
   }
 
+  // Measure the restore started by the early wake-up
+  is_restore_measured = is_adaptive_restore_overhead_enabled;
+
   // If needed start the clock restore process
   clock_restore();
 
@@ -1130,6 +1307,7 @@ void sli_hfxo_manager_notify_ready_for_power_manager(void)
   if (current_em != SL_POWER_MANAGER_EM0
       && (is_sleeping_waiting_for_clock_restore == true)) {
     sli_power_manager_restore_states();
+    measure_restore_time();
     is_sleeping_waiting_for_clock_restore = false;
     is_states_saved = false;
     is_restored_from_hfxo_isr = true;
@@ -0,0 +1,318 @@
+/***************************************************************************//**
+ * @file
+ * @brief Power Manager energy mode profiling implementation.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#include "sl_power_manager.h"
+#include "sl_power_manager_config.h"
+#include "sl_power_manager_profile.h"
+#include "sli_power_manager_private.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if (SL_POWER_MANAGER_PROFILE == 1)
+#include "sl_sleeptimer.h"
+#include "sli_sleeptimer.h"
+#include "em_core.h"
+#include "em_device.h"
+
+/*******************************************************************************
+ *********************************   DEFINES   *********************************
+ ******************************************************************************/
+
+#define EM_EVENT_MASK_ENTERING  (SL_POWER_MANAGER_EVENT_TRANSITION_ENTERING_EM0   \
+                                 | SL_POWER_MANAGER_EVENT_TRANSITION_ENTERING_EM1 \
+                                 | SL_POWER_MANAGER_EVENT_TRANSITION_ENTERING_EM2 \
+                                 | SL_POWER_MANAGER_EVENT_TRANSITION_ENTERING_EM3)
+
+// Interrupt of the sleeptimer peripheral
+#if (SL_SLEEPTIMER_PERIPHERAL == SL_SLEEPTIMER_PERIPHERAL_RTCC)
+#define SLEEPTIMER_IRQn  RTCC_IRQn
+#elif (SL_SLEEPTIMER_PERIPHERAL == SL_SLEEPTIMER_PERIPHERAL_SYSRTC)
+#define SLEEPTIMER_IRQn  SYSRTC_APP_IRQn
+#elif (SL_SLEEPTIMER_PERIPHERAL == SL_SLEEPTIMER_PERIPHERAL_BURTC)
+#define SLEEPTIMER_IRQn  BURTC_IRQn
+#elif (SL_SLEEPTIMER_PERIPHERAL == SL_SLEEPTIMER_PERIPHERAL_PRORTC)
+#define SLEEPTIMER_IRQn  PRORTC_IRQn
+#elif (SL_SLEEPTIMER_PERIPHERAL == SL_SLEEPTIMER_PERIPHERAL_RTC)
+#define SLEEPTIMER_IRQn  RTC_IRQn
+#endif
+
+/*******************************************************************************
+ ***************************  LOCAL VARIABLES   ********************************
+ ******************************************************************************/
+
+#if defined(_SILICON_LABS_32B_SERIES_2)
+// Radio interrupts, only serviced in EM0 and EM1
+static const IRQn_Type radio_irq_table[] = {
+  AGC_IRQn,
+  BUFC_IRQn,
+  FRC_PRI_IRQn,
+  FRC_IRQn,
+  MODEM_IRQn,
+  PROTIMER_IRQn,
+  RAC_RSM_IRQn,
+  RAC_SEQ_IRQn,
+  SYNTH_IRQn,
+};
+
+#if (defined(_SILICON_LABS_32B_SERIES_2_CONFIG_1) || defined(_SILICON_LABS_32B_SERIES_2_CONFIG_2)) \
+  && (SL_SLEEPTIMER_PERIPHERAL != SL_SLEEPTIMER_PERIPHERAL_PRORTC)
+// Radio interrupts that can also wake up from EM2, the protocol RTC runs on
+// the low frequency clock
+static const IRQn_Type radio_em2_irq_table[] = {
+  PRORTC_IRQn,
+};
+#endif
+#endif
+
+#if defined(USART_PRESENT)
+// UART receive interrupts, the USART is not clocked in EM2 and EM3
+static const IRQn_Type uart_irq_table[] = {
+  USART0_RX_IRQn,
+#if (USART_COUNT > 1)
+  USART1_RX_IRQn,
+#endif
+};
+#endif
+
+#if defined(EUART_PRESENT) || defined(EUSART_PRESENT)
+// UART receive interrupts that can also wake up from EM2, when the EUART or
+// EUSART runs on a low frequency clock
+static const IRQn_Type uart_em2_irq_table[] = {
+#if defined(EUART_PRESENT)
+  EUART0_RX_IRQn,
+#endif
+#if defined(EUSART_PRESENT)
+  EUSART0_RX_IRQn,
+#if (EUSART_COUNT > 1)
+  EUSART1_RX_IRQn,
+#endif
+#endif
+};
+#endif
+
+static sl_power_manager_profile_t profile;
+
+// Energy mode in which the time is currently accounted
+static sl_power_manager_em_t profile_em = SL_POWER_MANAGER_EM0;
+
+// Tick of the last accounting
+static uint64_t last_tick;
+
+// Tick of the start of the profile
+static uint64_t start_tick;
+
+// Tick of the last wakeup
+static uint64_t wakeup_tick;
+
+static sl_power_manager_em_transition_event_handle_t transition_event_handle;
+
+static void on_em_transition(sl_power_manager_em_t from,
+                             sl_power_manager_em_t to);
+
+static const sl_power_manager_em_transition_event_info_t transition_event_info = {
+  .event_mask = EM_EVENT_MASK_ENTERING,
+  .on_event = on_em_transition,
+};
+
+/*******************************************************************************
+ **************************   LOCAL FUNCTIONS   ********************************
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * Check if any interrupt of a table is pending.
+ ******************************************************************************/
+static bool is_irq_pending(const IRQn_Type *table, size_t count)
+{
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    if (NVIC_GetPendingIRQ(table[i]) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/***************************************************************************//**
+ * Get the source of the wakeup from the pending interrupts.
+ *
+ * @param em  Energy mode the core woke up from.
+ *
+ * @note Must be called before the interrupts are enabled after the wakeup.
+ *
+ * @note Only the interrupts that can wake up the core from the energy mode it
+ *       left are classified, an interrupt of another peripheral that is
+ *       pending was raised after the wakeup and is counted as other.
+ ******************************************************************************/
+static sl_power_manager_wakeup_source_t get_wakeup_source(sl_power_manager_em_t em)
+{
+#if defined(_SILICON_LABS_32B_SERIES_2)
+  if ((em <= SL_POWER_MANAGER_EM1)
+      && is_irq_pending(radio_irq_table, sizeof(radio_irq_table) / sizeof(radio_irq_table[0]))) {
+    return SL_POWER_MANAGER_WAKEUP_SOURCE_RADIO;
+  }
+#if (defined(_SILICON_LABS_32B_SERIES_2_CONFIG_1) || defined(_SILICON_LABS_32B_SERIES_2_CONFIG_2)) \
+  && (SL_SLEEPTIMER_PERIPHERAL != SL_SLEEPTIMER_PERIPHERAL_PRORTC)
+  if ((em <= SL_POWER_MANAGER_EM2)
+      && is_irq_pending(radio_em2_irq_table, sizeof(radio_em2_irq_table) / sizeof(radio_em2_irq_table[0]))) {
+    return SL_POWER_MANAGER_WAKEUP_SOURCE_RADIO;
+  }
+#endif
+#endif
+#if defined(USART_PRESENT)
+  if ((em <= SL_POWER_MANAGER_EM1)
+      && is_irq_pending(uart_irq_table, sizeof(uart_irq_table) / sizeof(uart_irq_table[0]))) {
+    return SL_POWER_MANAGER_WAKEUP_SOURCE_UART;
+  }
+#endif
+#if defined(EUART_PRESENT) || defined(EUSART_PRESENT)
+  if ((em <= SL_POWER_MANAGER_EM2)
+      && is_irq_pending(uart_em2_irq_table, sizeof(uart_em2_irq_table) / sizeof(uart_em2_irq_table[0]))) {
+    return SL_POWER_MANAGER_WAKEUP_SOURCE_UART;
+  }
+#endif
+#if defined(SLEEPTIMER_IRQn)
+  if (NVIC_GetPendingIRQ(SLEEPTIMER_IRQn) != 0) {
+    return SL_POWER_MANAGER_WAKEUP_SOURCE_SLEEPTIMER;
+  }
+#endif
+  return SL_POWER_MANAGER_WAKEUP_SOURCE_OTHER;
+}
+
+/***************************************************************************//**
+ * Account the time elapsed in the current energy mode.
+ *
+ * @return Current tick.
+ ******************************************************************************/
+static uint64_t account_residency(void)
+{
+  uint64_t now = sl_sleeptimer_get_tick_count64();
+
+  profile.residency_tick[profile_em] += now - last_tick;
+  last_tick = now;
+
+  return now;
+}
+
+/***************************************************************************//**
+ * Count energy mode transitions.
+ ******************************************************************************/
+static void on_em_transition(sl_power_manager_em_t from,
+                             sl_power_manager_em_t to)
+{
+  (void)from;
+
+  if (to < SL_POWER_MANAGER_PROFILE_EM_COUNT) {
+    profile.transition_count[to]++;
+  }
+}
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * Initialize energy mode profiling.
+ ******************************************************************************/
+void sli_power_manager_profile_init(void)
+{
+  memset(&profile, 0, sizeof(profile));
+  profile_em = SL_POWER_MANAGER_EM0;
+  last_tick = sl_sleeptimer_get_tick_count64();
+  start_tick = last_tick;
+  wakeup_tick = last_tick;
+
+  sl_power_manager_subscribe_em_transition_event(&transition_event_handle, &transition_event_info);
+}
+
+/***************************************************************************//**
+ * Account the end of an active period, before going to sleep.
+ *
+ * @param em  Energy mode about to be applied.
+ *
+ * @note Must be called inside a critical section.
+ ******************************************************************************/
+void sli_power_manager_profile_on_sleep(sl_power_manager_em_t em)
+{
+  uint64_t active_tick;
+  uint32_t bin = 0;
+
+  active_tick = account_residency() - wakeup_tick;
+  while ((active_tick > 1u) && (bin < (SL_POWER_MANAGER_PROFILE_ACTIVE_TIME_BINS - 1))) {
+    active_tick >>= 1;
+    bin++;
+  }
+  profile.active_time_histogram[bin]++;
+
+  profile_em = em;
+}
+
+/***************************************************************************//**
+ * Account the end of a sleep period, right after the wakeup.
+ *
+ * @note Must be called inside a critical section, before the interrupt that
+ *       woke up the core is serviced.
+ ******************************************************************************/
+void sli_power_manager_profile_on_wakeup(void)
+{
+  wakeup_tick = account_residency();
+  profile.wakeup_count[get_wakeup_source(profile_em)]++;
+
+  profile_em = SL_POWER_MANAGER_EM0;
+}
+
+/***************************************************************************//**
+ * Get the energy mode profile.
+ ******************************************************************************/
+void sl_power_manager_profile_get(sl_power_manager_profile_t *p_profile)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  if (p_profile == NULL) {
+    return;
+  }
+
+  CORE_ENTER_CRITICAL();
+  account_residency();
+  *p_profile = profile;
+  p_profile->duration_tick = last_tick - start_tick;
+  CORE_EXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * Reset the energy mode profile.
+ ******************************************************************************/
+void sl_power_manager_profile_reset(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  memset(&profile, 0, sizeof(profile));
+  last_tick = sl_sleeptimer_get_tick_count64();
+  start_tick = last_tick;
+  wakeup_tick = last_tick;
+  CORE_EXIT_CRITICAL();
+}
+
+#else // SL_POWER_MANAGER_PROFILE
+
+void sl_power_manager_profile_get(sl_power_manager_profile_t *p_profile)
+{
+  if (p_profile != NULL) {
+    memset(p_profile, 0, sizeof(*p_profile));
+  }
+}
+
+void sl_power_manager_profile_reset(void)
+{
+}
+#endif // SL_POWER_MANAGER_PROFILE
@@ -45,11 +45,18 @@
 /// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
 #define SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG (0x01)
 #define SL_SLEEPTIMER_ANY_FLAG                                  (0xFF)
+#define SL_SLEEPTIMER_SLACK_SHIFT                               (8)
+#define SL_SLEEPTIMER_SLACK_MASK                                (0x1F00)
 
 #define SLEEPTIMER_ENUM(name) typedef uint8_t name; enum name##_enum
 
 /// @endcond
 
+/// Option flags letting a timer expire up to 2^n - 1 ticks late, so that its
+/// expiration can be coalesced with the ones of other timers. n must be 31
+/// or less.
+#define SL_SLEEPTIMER_SLACK_FLAGS(n)  ((uint16_t)(((uint16_t)(n) << SL_SLEEPTIMER_SLACK_SHIFT) & SL_SLEEPTIMER_SLACK_MASK))
+
 /// Timestamp, wall clock time in seconds.
 typedef uint32_t sl_sleeptimer_timestamp_t;
 
@@ -126,6 +133,13 @@ typedef  struct  time_date {
   sl_sleeptimer_time_zone_offset_t time_zone; ///< Offset, in seconds, from UTC
 } sl_sleeptimer_date_t;
 
+/// @brief Timer wakeup statistics.
+typedef struct {
+  uint32_t wakeups;                           ///< Compare match interrupts that expired at least one timer
+  uint32_t expirations;                       ///< Timers expired
+  uint32_t wakeups_avoided;                   ///< Wakeups avoided by coalescing timers with slack
+} sl_sleeptimer_wakeup_stats_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -150,6 +164,7 @@ sl_status_t sl_sleeptimer_init(void);
  * @param option_flags Bit array of option flags for the timer.
  *        Valid bit-wise OR of one or more of the following:
  *          - SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG
+ *          - SL_SLEEPTIMER_SLACK_FLAGS()
  *        or 0 for not flags.
  *
  * @return 0 if successful. Error code otherwise.
@@ -174,6 +189,7 @@ sl_status_t sl_sleeptimer_start_timer(sl_sleeptimer_timer_handle_t *handle,
  * @param option_flags Bit array of option flags for the timer.
  *        Valid bit-wise OR of one or more of the following:
  *          - SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG
+ *          - SL_SLEEPTIMER_SLACK_FLAGS()
  *        or 0 for not flags.
  *
  * @return 0 if successful. Error code otherwise.
@@ -198,6 +214,7 @@ sl_status_t sl_sleeptimer_restart_timer(sl_sleeptimer_timer_handle_t *handle,
  * @param option_flags Bit array of option flags for the timer.
  *        Valid bit-wise OR of one or more of the following:
  *          - SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG
+ *          - SL_SLEEPTIMER_SLACK_FLAGS()
  *        or 0 for not flags.
  *
  * @return 0 if successful. Error code otherwise.
@@ -222,6 +239,7 @@ sl_status_t sl_sleeptimer_start_periodic_timer(sl_sleeptimer_timer_handle_t *han
  * @param option_flags Bit array of option flags for the timer.
  *        Valid bit-wise OR of one or more of the following:
  *          - SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG
+ *          - SL_SLEEPTIMER_SLACK_FLAGS()
  *        or 0 for not flags.
  *
  * @return 0 if successful. Error code otherwise.
@@ -281,6 +299,32 @@ sl_status_t sl_sleeptimer_get_timer_time_remaining(sl_sleeptimer_timer_handle_t
 sl_status_t sl_sleeptimer_get_remaining_time_of_first_timer(uint16_t option_flags,
                                                             uint32_t *time_remaining);
 
+/***************************************************************************//**
+ * Converts a slack to the option flags allowing a timer to expire late.
+ *
+ * @param slack Maximum delay the timer can tolerate, in timer ticks.
+ *
+ * @return Option flags to OR with the other option flags of the timer.
+ *
+ * @note The slack is rounded down to 2^n - 1 ticks. With slack, the timer
+ *       expiration can be delayed so that it happens during the same wakeup
+ *       as the expiration of other timers. For periodic timers, the slack
+ *       must be smaller than the period.
+ ******************************************************************************/
+uint16_t sl_sleeptimer_slack_to_option_flags(uint32_t slack);
+
+/***************************************************************************//**
+ * Gets the timer wakeup statistics.
+ *
+ * @param stats Pointer to the statistics structure to fill.
+ ******************************************************************************/
+void sl_sleeptimer_get_wakeup_stats(sl_sleeptimer_wakeup_stats_t *stats);
+
+/***************************************************************************//**
+ * Resets the timer wakeup statistics.
+ ******************************************************************************/
+void sl_sleeptimer_reset_wakeup_stats(void);
+
 /***************************************************************************//**
  * Gets current 32 bits global tick count.
  *
@@ -730,6 +774,7 @@ bool sl_sleeptimer_is_power_manager_early_restore_timer_latest_to_expire(void);
  * @param option_flags Bit array of option flags for the timer.
  *        Valid bit-wise OR of one or more of the following:
  *          - SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG
+ *          - SL_SLEEPTIMER_SLACK_FLAGS()
  *        or 0 for not flags.
  *
  * @return 0 if successful. Error code otherwise.
@@ -773,6 +818,7 @@ __STATIC_INLINE sl_status_t sl_sleeptimer_start_timer_ms(sl_sleeptimer_timer_han
  * @param option_flags Bit array of option flags for the timer.
  *        Valid bit-wise OR of one or more of the following:
  *          - SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG
+ *          - SL_SLEEPTIMER_SLACK_FLAGS()
  *        or 0 for not flags.
  *
  * @return 0 if successful. Error code otherwise.
@@ -816,6 +862,7 @@ __STATIC_INLINE sl_status_t sl_sleeptimer_restart_timer_ms(sl_sleeptimer_timer_h
  * @param option_flags Bit array of option flags for the timer.
  *        Valid bit-wise OR of one or more of the following:
  *          - SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG
+ *          - SL_SLEEPTIMER_SLACK_FLAGS()
  *        or 0 for not flags.
  *
  * @return 0 if successful. Error code otherwise.
@@ -848,6 +895,7 @@ sl_status_t sl_sleeptimer_start_periodic_timer_ms(sl_sleeptimer_timer_handle_t *
  * @param option_flags Bit array of option flags for the timer.
  *        Valid bit-wise OR of one or more of the following:
  *          - SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG
+ *          - SL_SLEEPTIMER_SLACK_FLAGS()
  *        or 0 for not flags.
  *
  * @return 0 if successful. Error code otherwise.
@@ -35,6 +35,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include "em_device.h"
+#include "sl_status.h"
 #include "sl_sleeptimer_config.h"
 
 #define SLEEPTIMER_EVENT_OF (0x01)
@@ -97,6 +98,23 @@ bool sli_sleeptimer_hal_is_int_status_set(uint8_t local_flag);
  *****************************************************************************/
 bool sli_sleeptimer_is_power_manager_timer_next_to_expire(void);
 
+/***************************************************************************//**
+ * Gets the time remaining until the compare match that expires the first
+ * timer with the matching set of flags.
+ *
+ * @param option_flags Set of flags of the timer to look for, or
+ *        SL_SLEEPTIMER_ANY_FLAG.
+ * @param time_remaining Time left in timer ticks.
+ *
+ * @return 0 if successful. Error code otherwise.
+ *
+ * @note Unlike sl_sleeptimer_get_remaining_time_of_first_timer(), the time
+ *       includes the delay of the compare match by timer coalescing, so the
+ *       timer is expected to expire at that time, not at its own expiration.
+ ******************************************************************************/
+sl_status_t sli_sleeptimer_get_remaining_time_of_first_wakeup(uint16_t option_flags,
+                                                              uint32_t *time_remaining);
+
 /***************************************************************************//**
  * Set lowest energy mode based on a project's configurations and clock source
  *
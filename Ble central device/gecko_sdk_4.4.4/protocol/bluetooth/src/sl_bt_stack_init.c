@@ -42,6 +42,12 @@
 #include "sli_bt_gattdb_def.h"
 #include "sli_bt_config_defs.h"
 
+// Leave out the features the application does not use, before anything below
+// looks at the catalog
+#if defined(SL_BT_CONFIG_FEATURE_TRIM) && SL_BT_CONFIG_FEATURE_TRIM
+#include "sl_bt_feature_trim.h"
+#endif
+
 #ifdef SL_CATALOG_GATT_CONFIGURATION_PRESENT
 extern const sli_bt_gattdb_t gattdb;
 #else
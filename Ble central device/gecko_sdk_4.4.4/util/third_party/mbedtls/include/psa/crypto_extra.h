@@ -250,6 +250,14 @@ typedef struct mbedtls_psa_stats_s {
     psa_key_id_t MBEDTLS_PRIVATE(max_open_internal_key_id);
     /** Largest key id value among open keys in secure elements. */
     psa_key_id_t MBEDTLS_PRIVATE(max_open_external_key_id);
+    /** Number of look-ups of persistent or built-in keys that found the key
+     * already in a slot. */
+    size_t MBEDTLS_PRIVATE(persistent_key_hits);
+    /** Number of persistent or built-in keys loaded into a slot. */
+    size_t MBEDTLS_PRIVATE(persistent_key_loads);
+    /** Number of persistent keys removed from a slot to make room for
+     * another key. */
+    size_t MBEDTLS_PRIVATE(persistent_key_evictions);
 } mbedtls_psa_stats_t;
 
 /** \brief Get statistics about
@@ -37,13 +37,89 @@
 #include "mbedtls/threading.h"
 #include "mbedtls/platform.h"
 
+/* Slot number plus one, 0 meaning no slot, so that the all-zero initial
+ * state of the index is the empty index. */
+#if MBEDTLS_PSA_KEY_SLOT_COUNT < UINT8_MAX
+typedef uint8_t psa_key_slot_ref_t;
+#else
+typedef uint16_t psa_key_slot_ref_t;
+#endif
+
 typedef struct {
     psa_key_slot_t key_slots[MBEDTLS_PSA_KEY_SLOT_COUNT];
     uint8_t key_slots_initialized;
+    /* Index of the slots holding a persistent or built-in key: a hash table
+     * of slot chains with one bucket per slot. For each slot, next slot in
+     * the chain and bucket of the chain plus one, 0 if not indexed. */
+    psa_key_slot_ref_t key_index_heads[MBEDTLS_PSA_KEY_SLOT_COUNT];
+    psa_key_slot_ref_t key_index_next[MBEDTLS_PSA_KEY_SLOT_COUNT];
+    psa_key_slot_ref_t key_index_bucket[MBEDTLS_PSA_KEY_SLOT_COUNT];
+    /* Value of use_count at the last use of each slot, to evict the least
+     * recently used persistent key when a slot is needed. */
+    uint32_t key_slots_last_use[MBEDTLS_PSA_KEY_SLOT_COUNT];
+    uint32_t use_count;
+    uint32_t persistent_key_hits;
+    uint32_t persistent_key_loads;
+    uint32_t persistent_key_evictions;
 } psa_global_data_t;
 
 static psa_global_data_t global_data;
 
+static size_t psa_key_index_bucket(mbedtls_svc_key_id_t key)
+{
+    uint32_t hash = (uint32_t) MBEDTLS_SVC_KEY_ID_GET_KEY_ID(key) * 0x9E3779B1u;
+
+    /* Scale the hash to the bucket count without a division */
+    return (size_t) (((uint64_t) hash * MBEDTLS_PSA_KEY_SLOT_COUNT) >> 32);
+}
+
+static void psa_key_slot_touch(psa_key_slot_t *slot)
+{
+    global_data.key_slots_last_use[slot - global_data.key_slots] =
+        ++global_data.use_count;
+}
+
+void psa_key_slot_index_add(psa_key_slot_t *slot)
+{
+    size_t slot_idx = (size_t) (slot - global_data.key_slots);
+    size_t bucket;
+
+    if (psa_key_id_is_volatile(MBEDTLS_SVC_KEY_ID_GET_KEY_ID(slot->attr.id))) {
+        return;
+    }
+
+    psa_key_slot_index_remove(slot);
+
+    bucket = psa_key_index_bucket(slot->attr.id);
+    global_data.key_index_next[slot_idx] = global_data.key_index_heads[bucket];
+    global_data.key_index_heads[bucket] = (psa_key_slot_ref_t) (slot_idx + 1);
+    global_data.key_index_bucket[slot_idx] = (psa_key_slot_ref_t) (bucket + 1);
+    psa_key_slot_touch(slot);
+}
+
+void psa_key_slot_index_remove(psa_key_slot_t *slot)
+{
+    size_t slot_idx = (size_t) (slot - global_data.key_slots);
+    psa_key_slot_ref_t *ref;
+
+    if (global_data.key_index_bucket[slot_idx] == 0) {
+        return;
+    }
+
+    /* The bucket recorded at insertion is used, in case the key identifier
+     * in the slot was changed since. */
+    ref = &global_data.key_index_heads[global_data.key_index_bucket[slot_idx] - 1];
+    while (*ref != 0) {
+        if (*ref == slot_idx + 1) {
+            *ref = global_data.key_index_next[slot_idx];
+            break;
+        }
+        ref = &global_data.key_index_next[*ref - 1];
+    }
+    global_data.key_index_next[slot_idx] = 0;
+    global_data.key_index_bucket[slot_idx] = 0;
+}
+
 int psa_is_valid_key_id(mbedtls_svc_key_id_t key, int vendor_ok)
 {
     psa_key_id_t key_id = MBEDTLS_SVC_KEY_ID_GET_KEY_ID(key);
@@ -169,7 +245,7 @@ static psa_status_t psa_get_key_slot(
 {
     psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
     psa_key_id_t key_id = MBEDTLS_SVC_KEY_ID_GET_KEY_ID(key);
-    size_t slot_idx;
+    psa_key_slot_ref_t ref;
     psa_key_slot_t *slot = NULL;
 
     if (psa_key_id_is_volatile(key_id)) {
@@ -190,14 +266,14 @@ static psa_status_t psa_get_key_slot(
             return PSA_ERROR_INVALID_HANDLE;
         }
 
-        for (slot_idx = 0; slot_idx < MBEDTLS_PSA_KEY_SLOT_COUNT; slot_idx++) {
-            slot = &global_data.key_slots[slot_idx];
+        for (ref = global_data.key_index_heads[psa_key_index_bucket(key)];
+             ref != 0; ref = global_data.key_index_next[ref - 1]) {
+            slot = &global_data.key_slots[ref - 1];
             if (mbedtls_svc_key_id_equal(key, slot->attr.id)) {
                 break;
             }
         }
-        status = (slot_idx < MBEDTLS_PSA_KEY_SLOT_COUNT) ?
-                 PSA_SUCCESS : PSA_ERROR_DOES_NOT_EXIST;
+        status = (ref != 0) ? PSA_SUCCESS : PSA_ERROR_DOES_NOT_EXIST;
     }
 
     if( status != PSA_SUCCESS )
@@ -259,16 +335,21 @@ psa_status_t psa_get_empty_key_slot(psa_key_id_t *volatile_key_id,
             break;
         }
 
-        if( ( unlocked_persistent_key_slot == NULL ) &&
-                ( ! PSA_KEY_LIFETIME_IS_VOLATILE( slot->attr.lifetime ) ) &&
-                ( slot->state == PSA_STATE_UNUSED ) )
+        if( ( ! PSA_KEY_LIFETIME_IS_VOLATILE( slot->attr.lifetime ) ) &&
+            ( slot->state == PSA_STATE_UNUSED ) &&
+            ( ( unlocked_persistent_key_slot == NULL ) ||
+              ( (uint32_t) ( global_data.use_count -
+                             global_data.key_slots_last_use[ slot_idx ] ) >
+                (uint32_t) ( global_data.use_count -
+                             global_data.key_slots_last_use[
+                                 unlocked_persistent_key_slot - global_data.key_slots ] ) ) ) )
                     unlocked_persistent_key_slot = slot;
     }
 
     /*
      * If there is no unused key slot and there is at least one unlocked key
-     * slot containing the description of a persistent key, recycle the first
-     * such key slot we encountered. If we later need to operate on the
+     * slot containing the description of a persistent key, recycle the least
+     * recently used such key slot. If we later need to operate on the
      * persistent key we are evicting now, we will reload its description from
      * storage.
      */
@@ -280,6 +361,7 @@ psa_status_t psa_get_empty_key_slot(psa_key_id_t *volatile_key_id,
             return( status );
 
         psa_wipe_key_slot( selected_slot );
+        ++global_data.persistent_key_evictions;
     }
 
     if( selected_slot != NULL )
@@ -426,6 +508,14 @@ psa_status_t psa_get_and_lock_key_slot( mbedtls_svc_key_id_t key,
                                         psa_slot_locking_intent_t intent )
 {
     psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
+
+#if defined(MBEDTLS_PSA_CRYPTO_LAZY_INIT)
+    /* Initialize on first use before taking the mutex, see
+     * psa_start_key_creation(). */
+    if( !global_data.key_slots_initialized )
+        (void) psa_crypto_init( );
+#endif
+
     MBEDTLS_MUTEX_LOCK_CHECK( &mbedtls_psa_slots_mutex );
 
     *p_slot = NULL;
@@ -441,6 +531,11 @@ psa_status_t psa_get_and_lock_key_slot( mbedtls_svc_key_id_t key,
      */
     if( ( status = psa_get_key_slot( key, p_slot ) ) == PSA_SUCCESS )
     {
+        if( ! psa_key_id_is_volatile( MBEDTLS_SVC_KEY_ID_GET_KEY_ID( key ) ) )
+        {
+            ++global_data.persistent_key_hits;
+            psa_key_slot_touch( *p_slot );
+        }
         if( intent == PSA_INTENT_READ )
             status = psa_slot_add_reader( *p_slot );
         else if( intent == PSA_INTENT_DESTROY )
@@ -471,6 +566,7 @@ psa_status_t psa_get_and_lock_key_slot( mbedtls_svc_key_id_t key,
 
     (*p_slot)->attr.id = key;
     (*p_slot)->attr.lifetime = PSA_KEY_LIFETIME_PERSISTENT;
+    psa_key_slot_index_add( *p_slot );
 
     status = PSA_ERROR_DOES_NOT_EXIST;
 #if defined(MBEDTLS_PSA_CRYPTO_BUILTIN_KEYS)
@@ -493,6 +589,7 @@ psa_status_t psa_get_and_lock_key_slot( mbedtls_svc_key_id_t key,
     }
     else
     {
+        ++global_data.persistent_key_loads;
         /* Add implicit usage flags. */
         psa_extend_key_usage_flags( &(*p_slot)->attr.policy.usage );
         if( intent == PSA_INTENT_READ )
@@ -698,6 +795,9 @@ void mbedtls_psa_get_stats(mbedtls_psa_stats_t *stats)
     size_t slot_idx;
 
     memset(stats, 0, sizeof(*stats));
+    stats->persistent_key_hits = global_data.persistent_key_hits;
+    stats->persistent_key_loads = global_data.persistent_key_loads;
+    stats->persistent_key_evictions = global_data.persistent_key_evictions;
 
     for( slot_idx = 0; slot_idx < MBEDTLS_PSA_KEY_SLOT_COUNT; slot_idx++ )
     {
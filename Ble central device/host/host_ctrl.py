@@ -0,0 +1,499 @@
+#!/usr/bin/env python3
+"""Host-side client for the central's framed binary host-control protocol.
+
+Frames are COBS encoded and delimited by 0x00. The decoded payload is
+type (1) | seq (1) | records | crc16 (2, little endian), with CRC-16/CCITT-FALSE
+over everything before the CRC. See host_ctrl.h for the record layout.
+
+Example:
+    with HostCtrlClient("/dev/ttyACM0") as client:
+        print(client.get_state())
+        with client.batch() as batch:
+            batch.set_led(1, 3, 1)
+            batch.set_fan(2, 2, 0)
+        print(batch.results)
+        print(client.crypto_bench(BENCH_OP_CIPHER, 64, 100))
+        print(client.buffer_pool())
+"""
+import argparse
+import contextlib
+import json
+import queue
+import struct
+import threading
+
+FRAME_REQUEST = 0x01
+FRAME_RESPONSE = 0x02
+FRAME_EVENT = 0x03
+
+CMD_PING = 0x01
+CMD_GET_STATE = 0x02
+CMD_SET_LED = 0x03
+CMD_SET_FAN = 0x04
+CMD_SUBSCRIBE = 0x05
+CMD_CRYPTO_BENCH = 0x06
+CMD_BUFFER_POOL = 0x07
+
+EVT_STATE = 0x81
+
+STATUS_OK = 0x00
+STATUS_NAMES = {
+    0x00: "ok",
+    0x01: "unknown command",
+    0x02: "invalid parameter",
+    0x03: "failed",
+}
+
+MAX_PAYLOAD_SIZE = 128
+
+# Crypto benchmark operations, see crypto_bench.h
+BENCH_OP_CIPHER = 0x01
+BENCH_OP_AEAD = 0x02
+BENCH_OP_HASH = 0x03
+BENCH_OP_MAC = 0x04
+BENCH_OP_ECDH = 0x05
+BENCH_OP_ECDSA_SIGN = 0x06
+BENCH_OP_ECDSA_VERIFY = 0x07
+BENCH_OP_ECC_GENERATE = 0x08
+BENCH_OP_AEAD_BATCH = 0x09
+BENCH_OP_HASH_STREAM = 0x0A
+BENCH_OP_PAIRING = 0x0B
+BENCH_OP_PAIRING_CACHED = 0x0C
+BENCH_OP_CT_MEMCMP = 0x0D
+BENCH_OP_CT_MEMCMP_DIFF = 0x0E
+BENCH_OP_CT_MEMCPY_IF = 0x0F
+BENCH_OP_SECURE_PAYLOAD_SEAL = 0x10
+BENCH_OP_SECURE_PAYLOAD_OPEN = 0x11
+BENCH_OPS = {
+    "cipher": BENCH_OP_CIPHER,
+    "aead": BENCH_OP_AEAD,
+    "hash": BENCH_OP_HASH,
+    "mac": BENCH_OP_MAC,
+    "ecdh": BENCH_OP_ECDH,
+    "ecdsa-sign": BENCH_OP_ECDSA_SIGN,
+    "ecdsa-verify": BENCH_OP_ECDSA_VERIFY,
+    "ecc-generate": BENCH_OP_ECC_GENERATE,
+    "aead-batch": BENCH_OP_AEAD_BATCH,
+    "hash-stream": BENCH_OP_HASH_STREAM,
+    "pairing": BENCH_OP_PAIRING,
+    "pairing-cached": BENCH_OP_PAIRING_CACHED,
+    "ct-memcmp": BENCH_OP_CT_MEMCMP,
+    "ct-memcmp-diff": BENCH_OP_CT_MEMCMP_DIFF,
+    "ct-memcpy-if": BENCH_OP_CT_MEMCPY_IF,
+    "secure-payload-seal": BENCH_OP_SECURE_PAYLOAD_SEAL,
+    "secure-payload-open": BENCH_OP_SECURE_PAYLOAD_OPEN,
+}
+# Operations whose cost does not depend on the message size
+BENCH_FIXED_SIZE_OPS = (BENCH_OP_ECDH, BENCH_OP_ECDSA_SIGN, BENCH_OP_ECDSA_VERIFY,
+                        BENCH_OP_ECC_GENERATE, BENCH_OP_PAIRING, BENCH_OP_PAIRING_CACHED)
+BENCH_MAX_SIZE = 512
+# Messages per call of BENCH_OP_AEAD_BATCH, CRYPTO_BENCH_BATCH_COUNT
+BENCH_BATCH_COUNT = 8
+# Bytes hashed per call of BENCH_OP_HASH_STREAM, in size-byte updates,
+# CRYPTO_BENCH_STREAM_SIZE
+BENCH_STREAM_SIZE = 4096
+PSA_ERROR_NOT_SUPPORTED = -134
+
+
+class HostCtrlError(Exception):
+    pass
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_index = 0
+    code = 1
+    for byte in data:
+        if byte == 0:
+            out[code_index] = code
+            code_index = len(out)
+            out.append(0)
+            code = 1
+        else:
+            out.append(byte)
+            code += 1
+            if code == 0xFF:
+                out[code_index] = code
+                code_index = len(out)
+                out.append(0)
+                code = 1
+    out[code_index] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    index = 0
+    while index < len(data):
+        code = data[index]
+        index += 1
+        if code == 0 or index + code - 1 > len(data):
+            raise HostCtrlError("invalid COBS frame")
+        out += data[index:index + code - 1]
+        index += code - 1
+        if code != 0xFF and index < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def build_frame(frame_type, seq, records):
+    payload = bytearray([frame_type, seq])
+    for opcode, data in records:
+        payload += bytes([opcode, len(data)]) + bytes(data)
+    crc = crc16(payload)
+    payload += bytes([crc & 0xFF, crc >> 8])
+    if len(payload) > MAX_PAYLOAD_SIZE:
+        raise HostCtrlError("frame exceeds %d bytes" % MAX_PAYLOAD_SIZE)
+    # A leading delimiter terminates any partial data the device has buffered
+    return b"\x00" + cobs_encode(payload) + b"\x00"
+
+
+def parse_frame(encoded):
+    """Return (type, seq, [(opcode, data), ...]) or None if the frame is invalid."""
+    try:
+        payload = cobs_decode(encoded)
+    except HostCtrlError:
+        return None
+    if len(payload) < 4:
+        return None
+    body, crc = payload[:-2], payload[-2] | (payload[-1] << 8)
+    if crc16(body) != crc:
+        return None
+    records = []
+    offset = 2
+    while offset + 2 <= len(body):
+        opcode, length = body[offset], body[offset + 1]
+        records.append((opcode, bytes(body[offset + 2:offset + 2 + length])))
+        offset += 2 + length
+    return body[0], body[1], records
+
+
+def parse_crypto_bench(data):
+    status, iterations, frequency, min_ticks, max_ticks, total_ticks = struct.unpack("<iIIIIQ", data)
+    return {
+        "psa_status": status,
+        "iterations": iterations,
+        "tick_hz": frequency,
+        "min_ticks": min_ticks,
+        "max_ticks": max_ticks,
+        "total_ticks": total_ticks,
+    }
+
+
+def parse_buffer_pool(data):
+    fields = struct.unpack_from("<10I", data)
+    report = dict(zip(("configured", "total", "used", "peak", "idle_peak", "link_peak",
+                       "discarded", "buffer_failures", "heap_failures", "recommended"), fields))
+    report["connections"] = [
+        dict(zip(("connection", "tx_packets", "tx_peak_packets", "tx_peak_bytes", "rx_peak_events"),
+                 struct.unpack_from("<BHHIH", data, offset)))
+        for offset in range(40, len(data) - 10, 11)
+    ]
+    return report
+
+
+def parse_server_states(data):
+    return [
+        {"server": data[i], "connected": bool(data[i + 1]), "led": data[i + 2], "fan": data[i + 3]}
+        for i in range(0, len(data) - 3, 4)
+    ]
+
+
+class Batch:
+    """Collects command records to send them in as few frames as possible."""
+
+    def __init__(self, client):
+        self._client = client
+        self.records = []
+        self.results = []
+
+    def ping(self):
+        self.records.append((CMD_PING, b""))
+
+    def get_state(self):
+        self.records.append((CMD_GET_STATE, b""))
+
+    def set_led(self, first, last, value):
+        self.records.append((CMD_SET_LED, bytes([first, last, value])))
+
+    def set_fan(self, first, last, value):
+        self.records.append((CMD_SET_FAN, bytes([first, last, value])))
+
+    def subscribe(self, enable=True):
+        self.records.append((CMD_SUBSCRIBE, bytes([1 if enable else 0])))
+
+    def crypto_bench(self, op, size, iterations):
+        self.records.append((CMD_CRYPTO_BENCH, struct.pack("<BHH", op, size, iterations)))
+
+    def buffer_pool(self, reset=False):
+        self.records.append((CMD_BUFFER_POOL, bytes([1 if reset else 0])))
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc, tb):
+        if exc_type is None:
+            self.results = self._client.execute(self.records)
+
+
+class HostCtrlClient:
+    """Talks to the central over a serial port.
+
+    Log text sharing the port is discarded, since it never forms a frame with a
+    valid CRC. Events are queued and can be consumed with events().
+    When the central multiplexes its VCOM, pass the control channel of an
+    iostream_mux.MuxPort as transport instead of a port name.
+    """
+
+    def __init__(self, port=None, baudrate=115200, timeout=1.0, on_event=None, transport=None):
+        if transport is None:
+            import serial  # pyserial
+            transport = serial.Serial(port, baudrate, timeout=0.1, rtscts=True)
+        self._serial = transport
+        self._timeout = timeout
+        self._on_event = on_event
+        self._seq = 0
+        self._responses = queue.Queue()
+        self._events = queue.Queue()
+        self._running = True
+        self._reader = threading.Thread(target=self._read_loop, daemon=True)
+        self._reader.start()
+
+    def close(self):
+        self._running = False
+        self._reader.join()
+        self._serial.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc, tb):
+        self.close()
+
+    def batch(self):
+        return Batch(self)
+
+    def execute(self, records, timeout=None):
+        """Send command records and return [(opcode, status, data), ...] in order.
+
+        timeout overrides the response timeout given to the constructor.
+        """
+        results = []
+        max_records = MAX_PAYLOAD_SIZE - 4
+        chunk = []
+        size = 0
+        for record in records:
+            record_size = 2 + len(record[1])
+            if chunk and size + record_size > max_records:
+                results += self._transact(chunk, timeout)
+                chunk, size = [], 0
+            chunk.append(record)
+            size += record_size
+        if chunk:
+            results += self._transact(chunk, timeout)
+        return results
+
+    def ping(self):
+        self._check(self.execute([(CMD_PING, b"")]))
+
+    def get_state(self):
+        return parse_server_states(self._check(self.execute([(CMD_GET_STATE, b"")]))[0])
+
+    def set_led(self, first, last, value):
+        self._check(self.execute([(CMD_SET_LED, bytes([first, last, value]))]))
+
+    def set_fan(self, first, last, value):
+        self._check(self.execute([(CMD_SET_FAN, bytes([first, last, value]))]))
+
+    def subscribe(self, enable=True):
+        self._check(self.execute([(CMD_SUBSCRIBE, bytes([1 if enable else 0]))]))
+
+    def crypto_bench(self, op, size, iterations, timeout=30.0):
+        """Time iterations calls of a crypto operation on the central.
+
+        The central does nothing else while the benchmark runs. psa_status in
+        the result is PSA_ERROR_NOT_SUPPORTED for operations its PSA
+        configuration lacks.
+        """
+        record = (CMD_CRYPTO_BENCH, struct.pack("<BHH", op, size, iterations))
+        return parse_crypto_bench(self._check(self.execute([record], timeout))[0])
+
+    def buffer_pool(self, reset=False):
+        """Get the usage of the Bluetooth buffer pool and of the open connections.
+
+        reset restarts the peaks and failure counts once read. recommended is
+        0 unless the central is built with BUFFER_POOL_SIZING.
+        """
+        record = (CMD_BUFFER_POOL, bytes([1 if reset else 0]))
+        return parse_buffer_pool(self._check(self.execute([record]))[0])
+
+    def events(self, timeout=None):
+        """Yield server state dictionaries as they are streamed by the central."""
+        while True:
+            try:
+                yield self._events.get(timeout=timeout)
+            except queue.Empty:
+                return
+
+    def _check(self, results):
+        data = []
+        for opcode, status, payload in results:
+            if status != STATUS_OK:
+                raise HostCtrlError("command 0x%02x: %s" % (opcode, STATUS_NAMES.get(status, status)))
+            data.append(payload)
+        return data
+
+    def _transact(self, records, timeout=None):
+        self._seq = (self._seq + 1) & 0xFF
+        seq = self._seq
+        self._serial.write(build_frame(FRAME_REQUEST, seq, records))
+        results = []
+        while len(results) < len(records):
+            try:
+                rsp_seq, rsp_records = self._responses.get(
+                    timeout=self._timeout if timeout is None else timeout)
+            except queue.Empty:
+                raise HostCtrlError("timeout waiting for response to seq %d" % seq)
+            if rsp_seq != seq:
+                continue
+            for opcode, data in rsp_records:
+                status = data[0] if data else 0x02
+                results.append((opcode, status, data[1:]))
+        return results
+
+    def _read_loop(self):
+        buffer = bytearray()
+        while self._running:
+            chunk = self._serial.read(256)
+            if not chunk:
+                continue
+            buffer += chunk
+            while True:
+                end = buffer.find(b"\x00")
+                if end < 0:
+                    break
+                frame = parse_frame(bytes(buffer[:end]))
+                del buffer[:end + 1]
+                if frame is None:
+                    continue
+                frame_type, seq, records = frame
+                if frame_type == FRAME_RESPONSE:
+                    self._responses.put((seq, records))
+                elif frame_type == FRAME_EVENT:
+                    for opcode, data in records:
+                        if opcode == EVT_STATE:
+                            for state in parse_server_states(data):
+                                self._events.put(state)
+                                if self._on_event:
+                                    self._on_event(state)
+
+
+def run_benchmarks(client, ops, sizes, iterations):
+    """Sweep operations and sizes, printing one JSON object per run."""
+    # Mean time of ct-memcmp per size, ct-memcmp-diff must take as long
+    ct_equal_mean = {}
+    # Mean time of aead per size, against which the secure payload runs
+    # show the cost of the packet handling around CCM
+    aead_mean = {}
+    for name in ops:
+        op = BENCH_OPS[name]
+        for size in (sizes[:1] if op in BENCH_FIXED_SIZE_OPS else sizes):
+            if size > BENCH_MAX_SIZE:
+                continue
+            result = client.crypto_bench(op, size, iterations)
+            result.update(op=name, size=size)
+            count = result["iterations"]
+            if count:
+                mean_s = result["total_ticks"] / count / result["tick_hz"]
+                result["mean_us"] = round(mean_s * 1e6, 3)
+                result["min_us"] = round(result["min_ticks"] * 1e6 / result["tick_hz"], 3)
+                result["max_us"] = round(result["max_ticks"] * 1e6 / result["tick_hz"], 3)
+                result["ops_per_s"] = round(1 / mean_s, 1)
+                messages = BENCH_BATCH_COUNT if op == BENCH_OP_AEAD_BATCH else 1
+                if op in (BENCH_OP_AEAD, BENCH_OP_AEAD_BATCH):
+                    result["messages_per_s"] = round(messages / mean_s, 1)
+                if op == BENCH_OP_HASH_STREAM:
+                    result["bytes_per_s"] = round(BENCH_STREAM_SIZE / mean_s)
+                elif op not in BENCH_FIXED_SIZE_OPS:
+                    result["bytes_per_s"] = round(messages * size / mean_s)
+                if op == BENCH_OP_CT_MEMCMP:
+                    ct_equal_mean[size] = mean_s
+                elif op == BENCH_OP_CT_MEMCMP_DIFF and size in ct_equal_mean:
+                    result["vs_equal"] = round(mean_s / ct_equal_mean[size], 3)
+                elif op == BENCH_OP_AEAD:
+                    aead_mean[size] = mean_s
+                elif (op in (BENCH_OP_SECURE_PAYLOAD_SEAL, BENCH_OP_SECURE_PAYLOAD_OPEN)
+                      and size in aead_mean):
+                    result["vs_aead"] = round(mean_s / aead_mean[size], 3)
+            elif result["psa_status"] == PSA_ERROR_NOT_SUPPORTED:
+                result["note"] = "not enabled in the PSA configuration"
+            print(json.dumps(result), flush=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Central host-control client")
+    parser.add_argument("port")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--mux", action="store_true",
+                        help="use the control channel of the VCOM multiplexer")
+    sub = parser.add_subparsers(dest="command", required=True)
+    sub.add_parser("ping")
+    sub.add_parser("state")
+    for name in ("led", "fan"):
+        cmd = sub.add_parser(name)
+        cmd.add_argument("first", type=int)
+        cmd.add_argument("last", type=int)
+        cmd.add_argument("value", type=int)
+    sub.add_parser("monitor")
+    pool = sub.add_parser("buffer-pool", help="report the usage of the Bluetooth buffer pool")
+    pool.add_argument("--reset", action="store_true", help="restart the peaks once read")
+    bench = sub.add_parser("bench", help="run crypto benchmarks, one JSON object per line")
+    bench.add_argument("--ops", default=",".join(BENCH_OPS),
+                       help="comma-separated operations (default: all)")
+    bench.add_argument("--sizes", default="16,64,256,512",
+                       help="comma-separated message sizes in bytes")
+    bench.add_argument("--iterations", type=int, default=100)
+    args = parser.parse_args()
+
+    with contextlib.ExitStack() as stack:
+        if args.mux:
+            from iostream_mux import CHANNEL_CONTROL, MuxPort
+            mux = stack.enter_context(MuxPort(args.port, args.baudrate))
+            client = HostCtrlClient(transport=mux.channel(CHANNEL_CONTROL))
+        else:
+            client = HostCtrlClient(args.port, args.baudrate)
+        stack.enter_context(client)
+        if args.command == "ping":
+            client.ping()
+            print("ok")
+        elif args.command == "state":
+            for state in client.get_state():
+                print(state)
+        elif args.command == "led":
+            client.set_led(args.first, args.last, args.value)
+        elif args.command == "fan":
+            client.set_fan(args.first, args.last, args.value)
+        elif args.command == "monitor":
+            client.subscribe(True)
+            with contextlib.suppress(KeyboardInterrupt):
+                for state in client.events():
+                    print(state)
+        elif args.command == "buffer-pool":
+            print(json.dumps(client.buffer_pool(args.reset)))
+        elif args.command == "bench":
+            run_benchmarks(client, args.ops.split(","),
+                           [int(size) for size in args.sizes.split(",")], args.iterations)
+
+
+if __name__ == "__main__":
+    main()
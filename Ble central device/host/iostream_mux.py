@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""Host-side demultiplexer for the central's VCOM I/O Stream multiplexer.
+
+Each frame is COBS encoded and delimited by 0x00. The decoded frame is
+channel id (1) | data (up to MAX_FRAME_DATA_SIZE). See sl_iostream_mux.h.
+Bytes that do not form a valid frame, such as log text printed before the
+multiplexer is started, are reported on the log channel.
+
+Example:
+    with MuxPort("/dev/ttyACM0") as mux:
+        mux.on_data(CHANNEL_LOG, lambda data: print(data.decode(), end=""))
+        control = mux.channel(CHANNEL_CONTROL)
+        control.write(b"...")
+"""
+import argparse
+import contextlib
+import queue
+import sys
+import threading
+
+from host_ctrl import HostCtrlError, cobs_decode, cobs_encode
+
+CHANNEL_LOG = 0
+CHANNEL_TRACE = 1
+CHANNEL_CONTROL = 2
+
+CHANNEL_NAMES = {
+    CHANNEL_LOG: "log",
+    CHANNEL_TRACE: "trace",
+    CHANNEL_CONTROL: "control",
+}
+
+# Must match SL_IOSTREAM_MUX_MAX_FRAME_DATA_SIZE
+MAX_FRAME_DATA_SIZE = 64
+
+
+def build_mux_frame(channel, data):
+    return cobs_encode(bytes([channel]) + bytes(data)) + b"\x00"
+
+
+class MuxChannel:
+    """Serial-like view of one channel: read() returns received bytes."""
+
+    def __init__(self, mux, channel):
+        self._mux = mux
+        self._channel = channel
+        self._rx = queue.Queue()
+        self._pending = bytearray()
+
+    def write(self, data):
+        self._mux.write(self._channel, data)
+
+    def read(self, size=1, timeout=0.1):
+        if not self._pending:
+            try:
+                self._pending += self._rx.get(timeout=timeout)
+            except queue.Empty:
+                return b""
+        while not self._rx.empty() and len(self._pending) < size:
+            self._pending += self._rx.get_nowait()
+        data = bytes(self._pending[:size])
+        del self._pending[:size]
+        return data
+
+    def close(self):
+        pass
+
+    def _put(self, data):
+        self._rx.put(data)
+
+
+class MuxPort:
+    """Demultiplexes the channels carried by one serial port."""
+
+    def __init__(self, port, baudrate=115200):
+        import serial  # pyserial
+        self._serial = serial.Serial(port, baudrate, timeout=0.1, rtscts=True)
+        self._lock = threading.Lock()
+        self._channels = {}
+        self._callbacks = {}
+        self.dropped_frames = 0
+        self._running = True
+        self._reader = threading.Thread(target=self._read_loop, daemon=True)
+        self._reader.start()
+
+    def close(self):
+        self._running = False
+        self._reader.join()
+        self._serial.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc, tb):
+        self.close()
+
+    def channel(self, channel):
+        """Return the serial-like MuxChannel receiving data of a channel."""
+        with self._lock:
+            if channel not in self._channels:
+                self._channels[channel] = MuxChannel(self, channel)
+            return self._channels[channel]
+
+    def on_data(self, channel, callback):
+        """Call callback(data) from the reader thread for each received chunk."""
+        with self._lock:
+            self._callbacks[channel] = callback
+
+    def write(self, channel, data):
+        data = bytes(data)
+        frames = bytearray()
+        for start in range(0, len(data), MAX_FRAME_DATA_SIZE):
+            frames += build_mux_frame(channel, data[start:start + MAX_FRAME_DATA_SIZE])
+        self._serial.write(frames)
+
+    def _dispatch(self, channel, data):
+        with self._lock:
+            callback = self._callbacks.get(channel)
+            target = self._channels.get(channel)
+        if callback:
+            callback(data)
+        if target:
+            target._put(data)
+
+    def _read_loop(self):
+        buffer = bytearray()
+        while self._running:
+            chunk = self._serial.read(256)
+            if not chunk:
+                continue
+            buffer += chunk
+            while True:
+                end = buffer.find(b"\x00")
+                if end < 0:
+                    break
+                encoded = bytes(buffer[:end])
+                del buffer[:end + 1]
+                if not encoded:
+                    continue
+                try:
+                    frame = cobs_decode(encoded)
+                except HostCtrlError:
+                    frame = b""
+                if not frame or frame[0] not in CHANNEL_NAMES:
+                    # Unframed text, report it as log output
+                    self.dropped_frames += 1
+                    self._dispatch(CHANNEL_LOG, encoded)
+                    continue
+                self._dispatch(frame[0], frame[1:])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Central VCOM demultiplexer")
+    parser.add_argument("port")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--trace", action="store_true", help="show trace channel data")
+    args = parser.parse_args()
+
+    def show_log(data):
+        sys.stdout.write(data.decode(errors="replace"))
+        sys.stdout.flush()
+
+    def show_trace(data):
+        sys.stdout.write("[trace] %s\n" % data.hex())
+        sys.stdout.flush()
+
+    with MuxPort(args.port, args.baudrate) as mux:
+        mux.on_data(CHANNEL_LOG, show_log)
+        if args.trace:
+            mux.on_data(CHANNEL_TRACE, show_trace)
+        with contextlib.suppress(KeyboardInterrupt):
+            threading.Event().wait()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,521 @@
+/***************************************************************************//**
+ * @file
+ * @brief Framed binary host-control protocol.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+#include <string.h>
+#include "sl_common.h"
+#include "app.h"
+#include "crypto_bench.h"
+#include "buffer_pool.h"
+#include "host_ctrl.h"
+
+// Type and seq bytes
+#define FRAME_HEADER_SIZE             2
+#define FRAME_CRC_SIZE                2
+// Opcode, length and status bytes
+#define RESPONSE_RECORD_HEADER_SIZE   3
+#define EVENT_RECORD_SIZE             6
+#define SERVER_STATE_SIZE             4
+// Op, size and iterations, little endian
+#define CRYPTO_BENCH_REQUEST_SIZE     5
+// Psa status, iterations, tick frequency, min, max and total ticks, little endian
+#define CRYPTO_BENCH_RESPONSE_SIZE    28
+// Configured, total, used, peak, idle peak, link peak, discarded, buffer and
+// heap failures and recommended size, little endian
+#define BUFFER_POOL_RESPONSE_SIZE     40
+// Connection, TX packets, TX peak packets, TX peak bytes and RX peak
+#define BUFFER_POOL_CONNECTION_SIZE   11
+
+#if (FRAME_HEADER_SIZE + RESPONSE_RECORD_HEADER_SIZE + BUFFER_POOL_RESPONSE_SIZE \
+     + BUFFER_POOL_MAX_CONNECTIONS * BUFFER_POOL_CONNECTION_SIZE + FRAME_CRC_SIZE) > HOST_CTRL_MAX_PAYLOAD_SIZE
+#error The buffer pool report does not fit in a frame
+#endif
+
+// COBS adds one byte every 254 bytes, plus the leading code and the delimiter
+#define ENCODED_FRAME_SIZE  (HOST_CTRL_MAX_PAYLOAD_SIZE + (HOST_CTRL_MAX_PAYLOAD_SIZE / 254) + 2)
+
+static sl_iostream_t *host_stream = NULL;
+
+// Receive side, holds the encoded frame until its delimiter is received
+static uint8_t rx_frame[ENCODED_FRAME_SIZE];
+static size_t rx_frame_len = 0;
+static bool rx_frame_overflow = false;
+
+// Transmit side
+static uint8_t tx_payload[HOST_CTRL_MAX_PAYLOAD_SIZE];
+static size_t tx_payload_len = 0;
+static uint8_t tx_encoded[ENCODED_FRAME_SIZE];
+
+static bool events_enabled = false;
+static uint32_t pending_events = 0;
+static uint8_t event_seq = 0;
+
+static void consume_rx(const uint8_t *data, size_t len);
+static void handle_frame(void);
+static void handle_command(uint8_t opcode, const uint8_t *data, uint8_t len);
+static void frame_begin(uint8_t type, uint8_t seq);
+static void frame_send(void);
+static uint8_t *response_reserve(uint8_t opcode, uint8_t status, size_t data_len);
+static void flush_events(void);
+static void crypto_bench(const uint8_t *data, uint8_t len);
+static void buffer_pool(const uint8_t *data, uint8_t len);
+static uint8_t *put_le16(uint8_t *dst, uint16_t value);
+static uint8_t *put_le32(uint8_t *dst, uint32_t value);
+static uint16_t crc16(const uint8_t *data, size_t len);
+static size_t cobs_encode(const uint8_t *src, size_t len, uint8_t *dst);
+static size_t cobs_decode(uint8_t *buf, size_t len);
+
+/***************************************************************************//**
+ * Initialize the host-control protocol on a stream.
+ ******************************************************************************/
+void host_ctrl_init(sl_iostream_t *stream)
+{
+  host_stream = stream;
+  rx_frame_len = 0;
+  rx_frame_overflow = false;
+  events_enabled = false;
+  pending_events = 0;
+}
+
+/***************************************************************************//**
+ * Process received frames and send pending events.
+ ******************************************************************************/
+void host_ctrl_process_action(void)
+{
+  const void *span;
+  size_t span_len;
+  sl_status_t sc;
+
+  if (host_stream == NULL) {
+    return;
+  }
+
+  // Parse received bytes in place when the stream supports it
+  while ((sc = sl_iostream_peek(host_stream, &span, &span_len)) == SL_STATUS_OK) {
+    consume_rx((const uint8_t *)span, span_len);
+    sl_iostream_commit(host_stream, span_len);
+  }
+
+  if (sc == SL_STATUS_NOT_SUPPORTED) {
+    uint8_t buffer[32];
+    size_t bytes_read = 0;
+
+    while ((sl_iostream_read(host_stream, buffer, sizeof(buffer), &bytes_read) == SL_STATUS_OK)
+           && (bytes_read > 0)) {
+      consume_rx(buffer, bytes_read);
+    }
+  }
+
+  flush_events();
+}
+
+/***************************************************************************//**
+ * Signal that the state of a server changed.
+ ******************************************************************************/
+void host_ctrl_notify_state(uint8_t server)
+{
+  if ((server == 0) || (server > MAX_CONNECTION)) {
+    return;
+  }
+  pending_events |= (1UL << (server - 1));
+}
+
+/***************************************************************************//**
+ * Accumulate received bytes and handle each delimited frame.
+ ******************************************************************************/
+static void consume_rx(const uint8_t *data, size_t len)
+{
+  while (len > 0) {
+    const uint8_t *delimiter = memchr(data, 0x00, len);
+    size_t chunk = (delimiter != NULL) ? (size_t)(delimiter - data) : len;
+
+    if (!rx_frame_overflow) {
+      if (chunk > (sizeof(rx_frame) - rx_frame_len)) {
+        // Frame too long, drop everything up to the next delimiter
+        rx_frame_overflow = true;
+      } else {
+        memcpy(&rx_frame[rx_frame_len], data, chunk);
+        rx_frame_len += chunk;
+      }
+    }
+
+    if (delimiter == NULL) {
+      return;
+    }
+
+    if (!rx_frame_overflow && (rx_frame_len > 0)) {
+      handle_frame();
+    }
+    rx_frame_len = 0;
+    rx_frame_overflow = false;
+
+    data += chunk + 1;
+    len -= chunk + 1;
+  }
+}
+
+/***************************************************************************//**
+ * Decode and check a received frame, then run all the commands it carries.
+ ******************************************************************************/
+static void handle_frame(void)
+{
+  size_t len = cobs_decode(rx_frame, rx_frame_len);
+  size_t offset = FRAME_HEADER_SIZE;
+  uint16_t crc;
+
+  // Drop frames that are malformed, corrupted or not a request
+  if (len < (FRAME_HEADER_SIZE + FRAME_CRC_SIZE)) {
+    return;
+  }
+  len -= FRAME_CRC_SIZE;
+  crc = (uint16_t)(rx_frame[len] | (rx_frame[len + 1] << 8));
+  if ((crc != crc16(rx_frame, len)) || (rx_frame[0] != HOST_CTRL_FRAME_REQUEST)) {
+    return;
+  }
+
+  frame_begin(HOST_CTRL_FRAME_RESPONSE, rx_frame[1]);
+
+  while ((offset + 2) <= len) {
+    uint8_t opcode = rx_frame[offset];
+    uint8_t record_len = rx_frame[offset + 1];
+
+    if ((offset + 2 + record_len) > len) {
+      // Truncated record, reject it and stop parsing
+      response_reserve(opcode, HOST_CTRL_STATUS_INVALID_PARAMETER, 0);
+      break;
+    }
+    handle_command(opcode, &rx_frame[offset + 2], record_len);
+    offset += 2 + record_len;
+  }
+
+  frame_send();
+}
+
+/***************************************************************************//**
+ * Run one command record and append its response.
+ ******************************************************************************/
+static void handle_command(uint8_t opcode, const uint8_t *data, uint8_t len)
+{
+  uint8_t *rsp;
+
+  switch (opcode) {
+    case HOST_CTRL_CMD_PING:
+      response_reserve(opcode, HOST_CTRL_STATUS_OK, 0);
+      break;
+
+    case HOST_CTRL_CMD_GET_STATE:
+      rsp = response_reserve(opcode, HOST_CTRL_STATUS_OK,
+                             MAX_CONNECTION * SERVER_STATE_SIZE);
+      for (uint8_t server = 1; server <= MAX_CONNECTION; server++) {
+        rsp[0] = server;
+        app_get_server_state(server, &rsp[1], &rsp[2], &rsp[3]);
+        rsp += SERVER_STATE_SIZE;
+      }
+      break;
+
+    case HOST_CTRL_CMD_SET_LED:
+    case HOST_CTRL_CMD_SET_FAN: {
+      uint8_t status = HOST_CTRL_STATUS_OK;
+
+      if ((len != 3) || (data[0] == 0) || (data[0] > data[1]) || (data[1] > MAX_CONNECTION)) {
+        status = HOST_CTRL_STATUS_INVALID_PARAMETER;
+      } else {
+        for (uint8_t server = data[0]; server <= data[1]; server++) {
+          if (app_set_server_output(server,
+                                    (opcode == HOST_CTRL_CMD_SET_LED) ? LED_CONTROL : FAN_CONTROL,
+                                    data[2]) != SL_STATUS_OK) {
+            status = HOST_CTRL_STATUS_FAILED;
+          }
+        }
+      }
+      response_reserve(opcode, status, 0);
+      break;
+    }
+
+    case HOST_CTRL_CMD_SUBSCRIBE:
+      if (len != 1) {
+        response_reserve(opcode, HOST_CTRL_STATUS_INVALID_PARAMETER, 0);
+        break;
+      }
+      events_enabled = (data[0] != 0);
+      if (events_enabled) {
+        // Start with a snapshot of all servers
+        pending_events = (1UL << MAX_CONNECTION) - 1;
+      }
+      response_reserve(opcode, HOST_CTRL_STATUS_OK, 0);
+      break;
+
+    case HOST_CTRL_CMD_CRYPTO_BENCH:
+      crypto_bench(data, len);
+      break;
+
+    case HOST_CTRL_CMD_BUFFER_POOL:
+      buffer_pool(data, len);
+      break;
+
+    default:
+      response_reserve(opcode, HOST_CTRL_STATUS_UNKNOWN_COMMAND, 0);
+      break;
+  }
+}
+
+/***************************************************************************//**
+ * Run a crypto benchmark and append its results. The run blocks the main
+ * loop, the host has to allow for it in its response timeout.
+ ******************************************************************************/
+static void crypto_bench(const uint8_t *data, uint8_t len)
+{
+  crypto_bench_result_t result;
+  uint8_t *rsp;
+
+  if ((len != CRYPTO_BENCH_REQUEST_SIZE)
+      || (crypto_bench_run(data[0],
+                           (uint16_t)(data[1] | (data[2] << 8)),
+                           (uint16_t)(data[3] | (data[4] << 8)),
+                           &result) != SL_STATUS_OK)) {
+    response_reserve(HOST_CTRL_CMD_CRYPTO_BENCH, HOST_CTRL_STATUS_INVALID_PARAMETER, 0);
+    return;
+  }
+
+  rsp = response_reserve(HOST_CTRL_CMD_CRYPTO_BENCH, HOST_CTRL_STATUS_OK,
+                         CRYPTO_BENCH_RESPONSE_SIZE);
+  rsp = put_le32(rsp, (uint32_t)result.status);
+  rsp = put_le32(rsp, result.iterations);
+  rsp = put_le32(rsp, crypto_bench_get_tick_frequency());
+  rsp = put_le32(rsp, result.min_ticks);
+  rsp = put_le32(rsp, result.max_ticks);
+  rsp = put_le32(rsp, (uint32_t)result.total_ticks);
+  put_le32(rsp, (uint32_t)(result.total_ticks >> 32));
+}
+
+/***************************************************************************//**
+ * Append the usage of the Bluetooth buffer pool and of the open connections,
+ * then restart the peaks if asked to.
+ ******************************************************************************/
+static void buffer_pool(const uint8_t *data, uint8_t len)
+{
+  buffer_pool_report_t report;
+  uint8_t open = 0;
+  uint8_t *rsp;
+
+  if (len != 1) {
+    response_reserve(HOST_CTRL_CMD_BUFFER_POOL, HOST_CTRL_STATUS_INVALID_PARAMETER, 0);
+    return;
+  }
+
+  buffer_pool_get_report(&report);
+  for (uint8_t i = 0; i < BUFFER_POOL_MAX_CONNECTIONS; i++) {
+    if (report.connections[i].connection != 0) {
+      open++;
+    }
+  }
+
+  rsp = response_reserve(HOST_CTRL_CMD_BUFFER_POOL, HOST_CTRL_STATUS_OK,
+                         BUFFER_POOL_RESPONSE_SIZE + open * BUFFER_POOL_CONNECTION_SIZE);
+  rsp = put_le32(rsp, report.configured);
+  rsp = put_le32(rsp, report.total);
+  rsp = put_le32(rsp, report.used);
+  rsp = put_le32(rsp, report.peak);
+  rsp = put_le32(rsp, report.idle_peak);
+  rsp = put_le32(rsp, report.link_peak);
+  rsp = put_le32(rsp, report.buffers_discarded);
+  rsp = put_le32(rsp, report.buffer_allocation_failures);
+  rsp = put_le32(rsp, report.heap_allocation_failures);
+  rsp = put_le32(rsp, report.recommended);
+  for (uint8_t i = 0; i < BUFFER_POOL_MAX_CONNECTIONS; i++) {
+    const buffer_pool_connection_t *entry = &report.connections[i];
+
+    if (entry->connection != 0) {
+      *rsp++ = entry->connection;
+      rsp = put_le16(rsp, entry->tx_packets);
+      rsp = put_le16(rsp, entry->tx_peak_packets);
+      rsp = put_le32(rsp, entry->tx_peak_bytes);
+      rsp = put_le16(rsp, entry->rx_peak_events);
+    }
+  }
+
+  if (data[0] != 0) {
+    buffer_pool_reset();
+  }
+}
+
+/***************************************************************************//**
+ * Store a 16-bit value little endian and return the next byte.
+ ******************************************************************************/
+static uint8_t *put_le16(uint8_t *dst, uint16_t value)
+{
+  dst[0] = (uint8_t)value;
+  dst[1] = (uint8_t)(value >> 8);
+  return &dst[2];
+}
+
+/***************************************************************************//**
+ * Store a 32-bit value little endian and return the next byte.
+ ******************************************************************************/
+static uint8_t *put_le32(uint8_t *dst, uint32_t value)
+{
+  dst[0] = (uint8_t)value;
+  dst[1] = (uint8_t)(value >> 8);
+  dst[2] = (uint8_t)(value >> 16);
+  dst[3] = (uint8_t)(value >> 24);
+  return &dst[4];
+}
+
+/***************************************************************************//**
+ * Start building a new frame in the transmit buffer.
+ ******************************************************************************/
+static void frame_begin(uint8_t type, uint8_t seq)
+{
+  tx_payload[0] = type;
+  tx_payload[1] = seq;
+  tx_payload_len = FRAME_HEADER_SIZE;
+}
+
+/***************************************************************************//**
+ * Append the CRC, encode and send the frame in the transmit buffer.
+ * Frames without any record are not sent.
+ ******************************************************************************/
+static void frame_send(void)
+{
+  uint16_t crc;
+  size_t encoded_len;
+
+  if (tx_payload_len <= FRAME_HEADER_SIZE) {
+    return;
+  }
+
+  crc = crc16(tx_payload, tx_payload_len);
+  tx_payload[tx_payload_len++] = (uint8_t)crc;
+  tx_payload[tx_payload_len++] = (uint8_t)(crc >> 8);
+
+  encoded_len = cobs_encode(tx_payload, tx_payload_len, tx_encoded);
+  tx_encoded[encoded_len++] = 0x00;
+  sl_iostream_write(host_stream, tx_encoded, encoded_len);
+
+  frame_begin(tx_payload[0], tx_payload[1]);
+}
+
+/***************************************************************************//**
+ * Append a response record, sending the current frame first if it is full.
+ * Returns a pointer to the data_len bytes following the status byte.
+ ******************************************************************************/
+static uint8_t *response_reserve(uint8_t opcode, uint8_t status, size_t data_len)
+{
+  uint8_t *record;
+
+  if ((tx_payload_len + RESPONSE_RECORD_HEADER_SIZE + data_len + FRAME_CRC_SIZE)
+      > HOST_CTRL_MAX_PAYLOAD_SIZE) {
+    frame_send();
+  }
+
+  record = &tx_payload[tx_payload_len];
+  record[0] = opcode;
+  record[1] = (uint8_t)(data_len + 1);
+  record[2] = status;
+  tx_payload_len += RESPONSE_RECORD_HEADER_SIZE + data_len;
+
+  return &record[RESPONSE_RECORD_HEADER_SIZE];
+}
+
+/***************************************************************************//**
+ * Send one event frame carrying all servers whose state changed.
+ ******************************************************************************/
+static void flush_events(void)
+{
+  if (!events_enabled || (pending_events == 0)) {
+    return;
+  }
+
+  frame_begin(HOST_CTRL_FRAME_EVENT, event_seq++);
+  for (uint8_t server = 1; server <= MAX_CONNECTION; server++) {
+    if (pending_events & (1UL << (server - 1))) {
+      uint8_t *record = &tx_payload[tx_payload_len];
+
+      record[0] = HOST_CTRL_EVT_STATE;
+      record[1] = SERVER_STATE_SIZE;
+      record[2] = server;
+      app_get_server_state(server, &record[3], &record[4], &record[5]);
+      tx_payload_len += EVENT_RECORD_SIZE;
+    }
+  }
+  pending_events = 0;
+  frame_send();
+}
+
+/***************************************************************************//**
+ * CRC-16/CCITT-FALSE.
+ ******************************************************************************/
+static uint16_t crc16(const uint8_t *data, size_t len)
+{
+  uint16_t crc = 0xFFFF;
+
+  while (len--) {
+    crc ^= (uint16_t)(*data++ << 8);
+    for (uint8_t i = 0; i < 8; i++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+/***************************************************************************//**
+ * COBS encode a buffer. dst must hold at least len + len / 254 + 1 bytes.
+ * Returns the encoded length, without delimiter.
+ ******************************************************************************/
+static size_t cobs_encode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+  size_t code_index = 0;
+  size_t write = 1;
+  uint8_t code = 1;
+
+  for (size_t read = 0; read < len; read++) {
+    if (src[read] == 0) {
+      dst[code_index] = code;
+      code_index = write++;
+      code = 1;
+    } else {
+      dst[write++] = src[read];
+      code++;
+      if (code == 0xFF) {
+        dst[code_index] = code;
+        code_index = write++;
+        code = 1;
+      }
+    }
+  }
+  dst[code_index] = code;
+
+  return write;
+}
+
+/***************************************************************************//**
+ * COBS decode a buffer in place.
+ * Returns the decoded length, or 0 if the buffer is not valid COBS.
+ ******************************************************************************/
+static size_t cobs_decode(uint8_t *buf, size_t len)
+{
+  size_t read = 0;
+  size_t write = 0;
+
+  while (read < len) {
+    uint8_t code = buf[read++];
+
+    if ((code == 0) || ((read + code - 1) > len)) {
+      return 0;
+    }
+    for (uint8_t i = 1; i < code; i++) {
+      buf[write++] = buf[read++];
+    }
+    if ((code != 0xFF) && (read < len)) {
+      buf[write++] = 0;
+    }
+  }
+
+  return write;
+}
@@ -0,0 +1,88 @@
+/***************************************************************************//**
+ * @file
+ * @brief Framed binary host-control protocol.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#ifndef HOST_CTRL_H
+#define HOST_CTRL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sl_status.h"
+#include "sl_iostream.h"
+
+/***************************************************************************//**
+ * Frame layout
+ *
+ *   Each frame is COBS encoded and terminated by a 0x00 delimiter. The decoded
+ *   payload is:
+ *
+ *     | type (1) | seq (1) | record 0 | ... | record n | crc16 (2, LE) |
+ *
+ *   The CRC is CRC-16/CCITT-FALSE computed over type, seq and all records.
+ *   A request frame can carry any number of command records, which lets the
+ *   host batch commands. Each record is:
+ *
+ *     | opcode (1) | len (1) | data (len) |
+ *
+ *   Every command record is answered by a record in a response frame carrying
+ *   the same seq. Response records start with a HOST_CTRL_STATUS_* byte. If
+ *   the answers do not fit in one frame, several response frames are sent.
+ *   State changes are streamed back in event frames once subscribed.
+ ******************************************************************************/
+
+#define HOST_CTRL_MAX_PAYLOAD_SIZE    128
+
+// Frame types
+#define HOST_CTRL_FRAME_REQUEST       0x01
+#define HOST_CTRL_FRAME_RESPONSE      0x02
+#define HOST_CTRL_FRAME_EVENT         0x03
+
+// Command opcodes
+#define HOST_CTRL_CMD_PING            0x01 // req: -                      rsp: status
+#define HOST_CTRL_CMD_GET_STATE       0x02 // req: -                      rsp: status, {server, connected, led, fan} * MAX_CONNECTION
+#define HOST_CTRL_CMD_SET_LED         0x03 // req: first, last, value     rsp: status
+#define HOST_CTRL_CMD_SET_FAN         0x04 // req: first, last, value     rsp: status
+#define HOST_CTRL_CMD_SUBSCRIBE       0x05 // req: enable                 rsp: status
+#define HOST_CTRL_CMD_CRYPTO_BENCH    0x06 // req: op, size, iterations   rsp: status, psa status, iterations, tick freq, min, max, total ticks
+#define HOST_CTRL_CMD_BUFFER_POOL     0x07 // req: reset                  rsp: status, configured, total, used, peak, idle peak, link peak,
+                                           //                                  discarded, buffer failures, heap failures, recommended,
+                                           //                                  {connection, tx packets, tx peak packets, tx peak bytes, rx peak} * open
+
+// Event opcodes
+#define HOST_CTRL_EVT_STATE           0x81 // {server, connected, led, fan}
+
+// Response status codes
+#define HOST_CTRL_STATUS_OK                 0x00
+#define HOST_CTRL_STATUS_UNKNOWN_COMMAND    0x01
+#define HOST_CTRL_STATUS_INVALID_PARAMETER  0x02
+#define HOST_CTRL_STATUS_FAILED             0x03
+
+/***************************************************************************//**
+ * Initialize the host-control protocol on a stream.
+ *
+ * @param[in] stream  I/O Stream used to exchange frames with the host.
+ ******************************************************************************/
+void host_ctrl_init(sl_iostream_t *stream);
+
+/***************************************************************************//**
+ * Process received frames and send pending events.
+ * Must be called from the super loop.
+ ******************************************************************************/
+void host_ctrl_process_action(void);
+
+/***************************************************************************//**
+ * Signal that the state of a server changed.
+ * Events are coalesced and sent from host_ctrl_process_action().
+ *
+ * @param[in] server  Server number, starting from 1.
+ ******************************************************************************/
+void host_ctrl_notify_state(uint8_t server);
+
+#endif // HOST_CTRL_H
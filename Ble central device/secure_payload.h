@@ -0,0 +1,180 @@
+/***************************************************************************//**
+ * @file
+ * @brief Authenticated encryption of application payloads carried in ATT values.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#ifndef SECURE_PAYLOAD_H
+#define SECURE_PAYLOAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "psa/crypto.h"
+#include "sl_status.h"
+#include "nvm3_default.h"
+
+/***************************************************************************//**
+ * Packet layout
+ *
+ *   | counter (4) | ciphertext (payload length) | tag (SECURE_PAYLOAD_TAG_SIZE) |
+ *
+ *   Payloads are encrypted with AES-128-CCM. The 13-byte nonce is the id of
+ *   the context followed by the counter, so one key can serve every link as
+ *   long as each sending side has its own id, for example the identity
+ *   address of the sender followed by a direction byte.
+ *
+ *   The key is provisioned per product as an NVM3 data object of
+ *   SECURE_PAYLOAD_KEY_SIZE bytes. A context loads it for the life of the
+ *   link and hands it with its attributes to the PSA driver for every
+ *   packet, without key slot lookup or operation setup. Packets are sealed and opened in place: the payload
+ *   is written at SECURE_PAYLOAD_HEADER_SIZE in the buffer that is sent.
+ *
+ *   Counters are persisted in NVM3 one block at a time. A sender reserves
+ *   SECURE_PAYLOAD_COUNTER_BLOCK counters with one write and skips what is
+ *   left of the block after a reset, so a nonce is never used twice. A
+ *   receiver saves the lowest counter it accepts once per block and on
+ *   secure_payload_deinit(). After a receiver reset without a deinit, the
+ *   packets accepted since the last save can be replayed once.
+ ******************************************************************************/
+
+#define SECURE_PAYLOAD_KEY_SIZE       16
+#define SECURE_PAYLOAD_ID_SIZE        9
+#define SECURE_PAYLOAD_NONCE_SIZE     (SECURE_PAYLOAD_ID_SIZE + 4)
+#define SECURE_PAYLOAD_HEADER_SIZE    4
+#define SECURE_PAYLOAD_TAG_SIZE       8
+#define SECURE_PAYLOAD_OVERHEAD       (SECURE_PAYLOAD_HEADER_SIZE + SECURE_PAYLOAD_TAG_SIZE)
+
+// Counters reserved, or accepted, per NVM3 write
+#define SECURE_PAYLOAD_COUNTER_BLOCK  256
+
+typedef struct {
+  uint32_t sealed;            // Packets sealed
+  uint32_t opened;            // Packets opened and authenticated
+  uint32_t replayed;          // Packets rejected for an old counter
+  uint32_t forged;            // Packets rejected by the tag check
+  uint32_t nvm3_writes;       // Counter saves
+} secure_payload_stats_t;
+
+typedef struct {
+  psa_key_attributes_t attributes;          // AES-128, CCM with a short tag
+  uint8_t key[SECURE_PAYLOAD_KEY_SIZE];
+  uint8_t nonce[SECURE_PAYLOAD_NONCE_SIZE]; // Id, then the counter of the last packet
+  uint32_t counter;                         // Next counter to send, or lowest counter to accept
+  uint32_t saved;                           // Counter stored in NVM3
+  nvm3_ObjectKey_t nvm3_key;
+  bool sender;
+  bool keyed;                               // Key loaded, until secure_payload_deinit()
+  secure_payload_stats_t stats;
+} secure_payload_context_t;
+
+/***************************************************************************//**
+ * Load the provisioned key of a link and restore its counter from NVM3.
+ *
+ * @param[out] context     Context, kept until secure_payload_deinit().
+ * @param[in] key_object   NVM3 key of the provisioned AES-128 key, shared by
+ *                         both ends of the link.
+ * @param[in] id           Id of the sending side, see the packet layout.
+ * @param[in] sender       true to seal packets, false to open them.
+ * @param[in] nvm3_key     NVM3 key of the counter. The counter restarts from
+ *                         0 when the stored object belongs to another id.
+ *
+ * @return SL_STATUS_OK, also when no counter is stored yet,
+ *         SL_STATUS_NOT_INITIALIZED when no key of SECURE_PAYLOAD_KEY_SIZE
+ *         bytes is provisioned. The context then refuses to seal and open.
+ ******************************************************************************/
+sl_status_t secure_payload_init(secure_payload_context_t *context,
+                                nvm3_ObjectKey_t key_object,
+                                const uint8_t id[SECURE_PAYLOAD_ID_SIZE],
+                                bool sender,
+                                nvm3_ObjectKey_t nvm3_key);
+
+/***************************************************************************//**
+ * Find the NVM3 key of the counter of an id among a range of keys.
+ *
+ *   Receivers of several senders keep one counter per sender id. The key
+ *   holding the counter of the id is returned, else a free key, else the
+ *   key of the lowest counter, whose sender then restarts from 0: the
+ *   packets it sent before can be replayed once. Keys held by the open
+ *   contexts are never returned for another id.
+ *
+ * @param[in] id             Id of the sending side.
+ * @param[in] first          First NVM3 key of the range.
+ * @param[in] count          Number of keys in the range.
+ * @param[in] contexts       Contexts to skip the keys of, may be NULL if
+ *                           context_count is 0.
+ * @param[in] context_count  Number of contexts.
+ * @param[out] nvm3_key      NVM3 key of the counter.
+ *
+ * @return SL_STATUS_FULL if the open contexts hold every key.
+ ******************************************************************************/
+sl_status_t secure_payload_find_counter(const uint8_t id[SECURE_PAYLOAD_ID_SIZE],
+                                        nvm3_ObjectKey_t first,
+                                        size_t count,
+                                        const secure_payload_context_t *contexts,
+                                        size_t context_count,
+                                        nvm3_ObjectKey_t *nvm3_key);
+
+/***************************************************************************//**
+ * Save the counter of a receiving context and wipe the key.
+ *
+ * @param[in] context  Context.
+ ******************************************************************************/
+void secure_payload_deinit(secure_payload_context_t *context);
+
+/***************************************************************************//**
+ * Encrypt a payload in place and add the counter and the tag around it.
+ *
+ * @param[in] context         Sending context.
+ * @param[in] ad              Data authenticated along, such as the attribute
+ *                            handle, may be NULL if ad_length is 0.
+ * @param[in] ad_length       Length of ad.
+ * @param[in,out] packet      Buffer holding the payload at
+ *                            SECURE_PAYLOAD_HEADER_SIZE, receives the packet.
+ * @param[in] payload_length  Payload length.
+ * @param[in] packet_size     Size of the buffer.
+ * @param[out] packet_length  Length of the packet.
+ *
+ * @return SL_STATUS_NOT_INITIALIZED without a provisioned key,
+ *         SL_STATUS_WOULD_OVERFLOW if the buffer cannot hold the packet,
+ *         SL_STATUS_FULL when the counter is exhausted,
+ *         SL_STATUS_FLASH_PROGRAM_FAILED if the next counter block could not
+ *         be reserved.
+ ******************************************************************************/
+sl_status_t secure_payload_seal(secure_payload_context_t *context,
+                                const uint8_t *ad,
+                                size_t ad_length,
+                                uint8_t *packet,
+                                size_t payload_length,
+                                size_t packet_size,
+                                size_t *packet_length);
+
+/***************************************************************************//**
+ * Authenticate and decrypt a packet in place.
+ *
+ * @param[in] context          Receiving context.
+ * @param[in] ad               Data authenticated along, as given to the seal.
+ * @param[in] ad_length        Length of ad.
+ * @param[in,out] packet       Packet, receives the payload at
+ *                             SECURE_PAYLOAD_HEADER_SIZE.
+ * @param[in] packet_length    Length of the packet.
+ * @param[out] payload_length  Length of the payload.
+ *
+ * @return SL_STATUS_NOT_INITIALIZED without a provisioned key,
+ *         SL_STATUS_ALREADY_EXISTS for a counter already accepted,
+ *         SL_STATUS_SECURITY_DECRYPT_ERROR if the tag does not match, in
+ *         which case the payload is wiped.
+ ******************************************************************************/
+sl_status_t secure_payload_open(secure_payload_context_t *context,
+                                const uint8_t *ad,
+                                size_t ad_length,
+                                uint8_t *packet,
+                                size_t packet_length,
+                                size_t *payload_length);
+
+#endif // SECURE_PAYLOAD_H
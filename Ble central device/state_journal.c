@@ -0,0 +1,313 @@
+/***************************************************************************//**
+ * @file
+ * @brief Write-back journal of small state records stored in NVM3.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+#include <string.h>
+#include "sl_common.h"
+#include "sl_sleeptimer.h"
+#include "app_timer.h"
+#include "nvm3_profile.h"
+#include "state_journal.h"
+#if STATE_JOURNAL_FLUSH_ON_BROWNOUT
+#include "em_device.h"
+#include "em_emu.h"
+#endif
+
+// Id and len bytes
+#define RECORD_HEADER_SIZE  2
+
+static nvm3_ObjectKey_t journal_key;
+
+// RAM copy of the NVM3 object
+static uint8_t journal[STATE_JOURNAL_MAX_SIZE];
+static size_t journal_len = 0;
+
+static bool dirty = false;
+// Record writes since the last flush
+static uint32_t pending_writes = 0;
+
+static app_timer_t idle_timer;
+static app_timer_t timeout_timer;
+
+static state_journal_stats_t stats;
+
+// Set by the brown-out interrupt, served from the super loop
+static volatile bool power_fail = false;
+
+static bool is_journal_valid(const uint8_t *data, size_t len);
+static uint8_t *find_record(uint8_t id);
+static void on_idle_timer(app_timer_t *timer, void *data);
+static void on_timeout_timer(app_timer_t *timer, void *data);
+static sl_status_t flush_journal(uint8_t reason);
+#if STATE_JOURNAL_FLUSH_ON_BROWNOUT
+static void arm_brownout(void);
+#endif
+
+/***************************************************************************//**
+ * Initialize the journal and load its records from NVM3.
+ ******************************************************************************/
+sl_status_t state_journal_init(nvm3_ObjectKey_t key)
+{
+  uint32_t type;
+  size_t len;
+
+  journal_key = key;
+  journal_len = 0;
+  dirty = false;
+  pending_writes = 0;
+  power_fail = false;
+  memset(&stats, 0, sizeof(stats));
+
+#if STATE_JOURNAL_FLUSH_ON_BROWNOUT
+  EMU->BOD3SENSE_SET = EMU_BOD3SENSE_AVDDBODEN;
+  EMU_IntDisable(EMU_IEN_AVDDBOD);
+  EMU_IntClear(EMU_IF_AVDDBOD);
+  NVIC_ClearPendingIRQ(EMU_IRQn);
+  NVIC_EnableIRQ(EMU_IRQn);
+#endif
+
+  if (nvm3_getObjectInfo(nvm3_defaultHandle, key, &type, &len) != ECODE_NVM3_OK
+      || type != NVM3_OBJECTTYPE_DATA
+      || len > sizeof(journal)) {
+    return SL_STATUS_OK;
+  }
+  if (nvm3_profileReadData(nvm3_defaultHandle, key, journal, len) != ECODE_NVM3_OK
+      || !is_journal_valid(journal, len)) {
+    // Start over, the object is replaced on the next flush
+    return SL_STATUS_OK;
+  }
+  journal_len = len;
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Read a record.
+ ******************************************************************************/
+sl_status_t state_journal_read(uint8_t id, void *data, size_t len)
+{
+  uint8_t *record = find_record(id);
+
+  if (record == NULL) {
+    return SL_STATUS_NOT_FOUND;
+  }
+  if (record[1] != len) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  memcpy(data, &record[RECORD_HEADER_SIZE], len);
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Write a record in RAM and schedule the write back.
+ ******************************************************************************/
+sl_status_t state_journal_write(uint8_t id, const void *data, size_t len)
+{
+  uint8_t *record;
+  size_t record_size;
+
+  if (data == NULL || len > UINT8_MAX) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  stats.writes++;
+  record = find_record(id);
+
+  if (record != NULL && record[1] == len) {
+    if (memcmp(&record[RECORD_HEADER_SIZE], data, len) == 0) {
+      // Same value, nothing to write back
+      stats.writes_saved++;
+      return SL_STATUS_OK;
+    }
+  } else {
+    if (record != NULL) {
+      // Length changed, remove the record and append it again
+      record_size = RECORD_HEADER_SIZE + record[1];
+      if (journal_len - record_size + RECORD_HEADER_SIZE + len > sizeof(journal)) {
+        return SL_STATUS_NO_MORE_RESOURCE;
+      }
+      memmove(record, record + record_size, (size_t)(&journal[journal_len] - (record + record_size)));
+      journal_len -= record_size;
+    } else if (journal_len + RECORD_HEADER_SIZE + len > sizeof(journal)) {
+      return SL_STATUS_NO_MORE_RESOURCE;
+    }
+    record = &journal[journal_len];
+    record[0] = id;
+    record[1] = (uint8_t)len;
+    journal_len += RECORD_HEADER_SIZE + len;
+  }
+  memcpy(&record[RECORD_HEADER_SIZE], data, len);
+
+  pending_writes++;
+  if (!dirty) {
+    dirty = true;
+#if STATE_JOURNAL_FLUSH_ON_BROWNOUT
+    arm_brownout();
+#endif
+    app_timer_start_with_slack(&timeout_timer, STATE_JOURNAL_MAX_FLUSH_DELAY_MS, STATE_JOURNAL_FLUSH_SLACK_MS,
+                               on_timeout_timer, NULL, false);
+  }
+  // Restarted on every write, expires once the writes settle
+  app_timer_start_with_slack(&idle_timer, STATE_JOURNAL_IDLE_FLUSH_MS, STATE_JOURNAL_FLUSH_SLACK_MS,
+                             on_idle_timer, NULL, false);
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Write back the records now, if any changed.
+ ******************************************************************************/
+sl_status_t state_journal_flush(void)
+{
+  return flush_journal(STATE_JOURNAL_FLUSH_HINT);
+}
+
+/***************************************************************************//**
+ * Flush on a pending power-fail hint.
+ ******************************************************************************/
+void state_journal_process_action(void)
+{
+  if (power_fail) {
+    power_fail = false;
+    (void)state_journal_flush();
+  }
+}
+
+/***************************************************************************//**
+ * Power manager hook, holds the sleep while a power-fail hint is pending.
+ ******************************************************************************/
+bool state_journal_is_ok_to_sleep(void)
+{
+  return !power_fail;
+}
+
+#if STATE_JOURNAL_FLUSH_ON_BROWNOUT
+/***************************************************************************//**
+ * AVDD brown-out interrupt, the supply is dropping.
+ ******************************************************************************/
+void EMU_IRQHandler(void)
+{
+  uint32_t flags = EMU_IntGetEnabled();
+
+  EMU_IntClear(flags);
+  if (flags & EMU_IF_AVDDBOD) {
+    // One hint per unsaved state, the next write after a flush re-arms it
+    EMU_IntDisable(EMU_IEN_AVDDBOD);
+    power_fail = true;
+  }
+}
+#endif
+
+/***************************************************************************//**
+ * Get the journal statistics.
+ ******************************************************************************/
+void state_journal_get_stats(state_journal_stats_t *p_stats)
+{
+  *p_stats = stats;
+}
+
+/***************************************************************************//**
+ * Check that a journal object is a sequence of complete records.
+ ******************************************************************************/
+static bool is_journal_valid(const uint8_t *data, size_t len)
+{
+  size_t offset = 0;
+
+  while (offset < len) {
+    if (len - offset < RECORD_HEADER_SIZE
+        || len - offset - RECORD_HEADER_SIZE < data[offset + 1]) {
+      return false;
+    }
+    offset += RECORD_HEADER_SIZE + data[offset + 1];
+  }
+
+  return true;
+}
+
+/***************************************************************************//**
+ * Find a record in the RAM copy.
+ ******************************************************************************/
+static uint8_t *find_record(uint8_t id)
+{
+  size_t offset = 0;
+
+  while (offset < journal_len) {
+    if (journal[offset] == id) {
+      return &journal[offset];
+    }
+    offset += RECORD_HEADER_SIZE + journal[offset + 1];
+  }
+
+  return NULL;
+}
+
+#if STATE_JOURNAL_FLUSH_ON_BROWNOUT
+/***************************************************************************//**
+ * Report the next supply drop, a stale flag is cleared first.
+ ******************************************************************************/
+static void arm_brownout(void)
+{
+  EMU_IntClear(EMU_IF_AVDDBOD);
+  EMU_IntEnable(EMU_IEN_AVDDBOD);
+}
+#endif
+
+static void on_idle_timer(app_timer_t *timer, void *data)
+{
+  (void)timer;
+  (void)data;
+  flush_journal(STATE_JOURNAL_FLUSH_IDLE);
+}
+
+static void on_timeout_timer(app_timer_t *timer, void *data)
+{
+  (void)timer;
+  (void)data;
+  flush_journal(STATE_JOURNAL_FLUSH_TIMEOUT);
+}
+
+/***************************************************************************//**
+ * Write the RAM copy to NVM3 and account the flash time.
+ ******************************************************************************/
+static sl_status_t flush_journal(uint8_t reason)
+{
+  uint32_t start;
+  uint32_t elapsed_us;
+  Ecode_t ecode;
+
+  if (!dirty) {
+    return SL_STATUS_OK;
+  }
+
+  start = sl_sleeptimer_get_tick_count();
+  ecode = nvm3_profileWriteData(nvm3_defaultHandle, journal_key, journal, journal_len);
+  elapsed_us = (uint32_t)(((uint64_t)(sl_sleeptimer_get_tick_count() - start) * 1000000u)
+                          / sl_sleeptimer_get_timer_frequency());
+
+  stats.flash_time_us += elapsed_us;
+  stats.flash_time_max_us = SL_MAX(stats.flash_time_max_us, elapsed_us);
+
+  if (ecode != ECODE_NVM3_OK) {
+    // Keep the data dirty, the timeout timer retries the write
+    stats.flush_errors++;
+    app_timer_start_with_slack(&timeout_timer, STATE_JOURNAL_MAX_FLUSH_DELAY_MS, STATE_JOURNAL_FLUSH_SLACK_MS,
+                               on_timeout_timer, NULL, false);
+    return SL_STATUS_FLASH_PROGRAM_FAILED;
+  }
+
+  stats.flushes[reason]++;
+  stats.writes_saved += pending_writes - 1;
+  pending_writes = 0;
+  dirty = false;
+  app_timer_stop(&idle_timer);
+  app_timer_stop(&timeout_timer);
+
+  return SL_STATUS_OK;
+}
@@ -0,0 +1,130 @@
+/***************************************************************************//**
+ * @file
+ * @brief Write-back journal of small state records stored in NVM3.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#ifndef STATE_JOURNAL_H
+#define STATE_JOURNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "sl_status.h"
+#include "nvm3_default.h"
+
+/***************************************************************************//**
+ * Journal layout
+ *
+ *   All records are merged in a single NVM3 data object of the default NVM3
+ *   instance, so a flush costs one nvm3_writeData() whatever the number of
+ *   records changed. The object is a sequence of records:
+ *
+ *     | id (1) | len (1) | data (len) |
+ *
+ *   Writes only update the RAM copy of the object. The object is written back
+ *   when no record was written for STATE_JOURNAL_IDLE_FLUSH_MS, or at the
+ *   latest STATE_JOURNAL_MAX_FLUSH_DELAY_MS after the first unsaved write, or
+ *   when state_journal_flush() is called.
+ *
+ *   With STATE_JOURNAL_FLUSH_ON_BROWNOUT, the AVDD brown-out detector of the
+ *   EMU is armed while unsaved writes are pending. Its interrupt only flags
+ *   the power-fail hint, state_journal_process_action() flushes from the
+ *   super loop. The records are only saved if the supply holds up for one
+ *   NVM3 write.
+ *   The flush timers are app_timer instances, so flushes run from the super
+ *   loop and never from an interrupt. They run with a slack of
+ *   STATE_JOURNAL_FLUSH_SLACK_MS, a flush does not need to be on time.
+ ******************************************************************************/
+
+#define STATE_JOURNAL_MAX_SIZE              128
+#define STATE_JOURNAL_IDLE_FLUSH_MS         2000
+#define STATE_JOURNAL_MAX_FLUSH_DELAY_MS    30000
+// Delay the flush timers tolerate, so they expire in the wakeup of another timer
+#define STATE_JOURNAL_FLUSH_SLACK_MS        500
+
+// Set to 0 to leave the EMU brown-out interrupt to the application
+#ifndef STATE_JOURNAL_FLUSH_ON_BROWNOUT
+#define STATE_JOURNAL_FLUSH_ON_BROWNOUT     1
+#endif
+
+// Flush reasons
+#define STATE_JOURNAL_FLUSH_IDLE            0
+#define STATE_JOURNAL_FLUSH_TIMEOUT         1
+#define STATE_JOURNAL_FLUSH_HINT            2
+#define STATE_JOURNAL_FLUSH_REASON_COUNT    3
+
+typedef struct {
+  uint32_t writes;                                    // Record writes requested
+  uint32_t writes_saved;                              // Object writes avoided: unchanged values and writes merged in a flush
+  uint32_t flushes[STATE_JOURNAL_FLUSH_REASON_COUNT]; // Object writes, by reason
+  uint32_t flush_errors;                              // Object writes that failed, the data stays dirty
+  uint32_t flash_time_us;                             // Total time spent in nvm3_writeData()
+  uint32_t flash_time_max_us;                         // Longest nvm3_writeData()
+} state_journal_stats_t;
+
+/***************************************************************************//**
+ * Initialize the journal and load its records from NVM3.
+ *
+ * @param[in] key  NVM3 key of the object holding the records.
+ *
+ * @return SL_STATUS_OK, also when no valid object is stored yet.
+ ******************************************************************************/
+sl_status_t state_journal_init(nvm3_ObjectKey_t key);
+
+/***************************************************************************//**
+ * Read a record.
+ *
+ * @param[in] id     Record identifier.
+ * @param[out] data  Record data.
+ * @param[in] len    Record length, must match the stored length.
+ *
+ * @return SL_STATUS_NOT_FOUND if the record does not exist,
+ *         SL_STATUS_INVALID_PARAMETER if its length differs.
+ ******************************************************************************/
+sl_status_t state_journal_read(uint8_t id, void *data, size_t len);
+
+/***************************************************************************//**
+ * Write a record in RAM and schedule the write back.
+ *
+ * @param[in] id    Record identifier.
+ * @param[in] data  Record data.
+ * @param[in] len   Record length, up to 255 bytes.
+ *
+ * @return SL_STATUS_NO_MORE_RESOURCE if the record does not fit in the journal.
+ ******************************************************************************/
+sl_status_t state_journal_write(uint8_t id, const void *data, size_t len);
+
+/***************************************************************************//**
+ * Write back the records now, if any changed. Called on a power-fail hint,
+ * and intended before a reset.
+ *
+ * @return Status of the NVM3 write.
+ ******************************************************************************/
+sl_status_t state_journal_flush(void);
+
+/***************************************************************************//**
+ * Flush on a pending power-fail hint. Call from the super loop.
+ ******************************************************************************/
+void state_journal_process_action(void);
+
+/***************************************************************************//**
+ * Power manager hook, holds the sleep while a power-fail hint is pending.
+ *
+ * @return false if a power-fail hint is pending.
+ ******************************************************************************/
+bool state_journal_is_ok_to_sleep(void);
+
+/***************************************************************************//**
+ * Get the journal statistics.
+ *
+ * @param[out] stats  Statistics.
+ ******************************************************************************/
+void state_journal_get_stats(state_journal_stats_t *stats);
+
+#endif // STATE_JOURNAL_H
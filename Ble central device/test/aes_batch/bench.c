@@ -0,0 +1,276 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host check of the descriptors of the AES-CTR/CCM batches.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+// Runs the descriptor building of sx_blk_cipher.c, the transfers are
+// recorded by a cryptodma_run_sg() runner instead of running on the DMA.
+//
+//   bench          For CTR and CCM, encryption and decryption, builds a
+//                  batch of BATCH_ITEMS messages and the same messages one
+//                  transfer each. Every item of the batch must have the
+//                  descriptors of its single transfer, the chain must visit
+//                  the items in order, and only the final descriptor of the
+//                  chain may be tagged as last. Then prints the time to
+//                  build the descriptors of a message both ways.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "cryptodma_internal.h"
+#include "sx_aes.h"
+#include "sx_blk_cipher.h"
+#include "sx_errors.h"
+
+#define BATCH_ITEMS   4
+#define MAX_DESCS     (BATCH_ITEMS * (AES_BATCH_FETCH_DESCS + AES_BATCH_PUSH_DESCS))
+#define PAYLOAD_MAX   64
+#define MAC_SIZE      8
+#define SPEED_ROUNDS  200000
+
+typedef struct {
+  const struct dma_sg_descr_s *descr;
+  uint32_t length_irq;
+  uint32_t tag;
+} record_t;
+
+typedef struct {
+  record_t fetch[MAX_DESCS];
+  record_t push[MAX_DESCS];
+  int fetch_count;
+  int push_count;
+  int runs;
+} transfers_t;
+
+static transfers_t *recording;
+static unsigned long errors;
+
+static uint8_t keys[BATCH_ITEMS][16];
+static uint8_t nonces[BATCH_ITEMS][16];
+static uint8_t aads[BATCH_ITEMS][5];
+static uint8_t datain[BATCH_ITEMS][PAYLOAD_MAX];
+static uint8_t dataout[BATCH_ITEMS][PAYLOAD_MAX];
+static uint8_t macs[BATCH_ITEMS][MAC_SIZE];
+static const uint32_t payload_sizes[BATCH_ITEMS] = { 16, 33, 40, 64 };
+static struct sx_aes_batch_item items[BATCH_ITEMS];
+
+// Library stand-ins, the real ones read the hardware configuration or
+// copy through the DMA.
+
+uint32_t sx_aes_set_hw_config_for_key(block_t *key, uint32_t *config)
+{
+  if (key->len != 16) {
+    return CRYPTOLIB_UNSUPPORTED_ERR;
+  }
+  *config |= SX_BLK_CIPHER_MODEID_128;
+  return CRYPTOLIB_SUCCESS;
+}
+
+void memcpy_blkIn(volatile void *dest, block_t src, uint32_t length)
+{
+  memcpy((void *)dest, src.addr, length);
+}
+
+static void record_list(const struct dma_sg_descr_s *d, record_t *records, int *count)
+{
+  while (d != DMA_AXI_DESCR_NEXT_STOP && *count < MAX_DESCS) {
+    records[*count].descr = d;
+    records[*count].length_irq = d->length_irq;
+    records[*count].tag = d->tag;
+    (*count)++;
+    d = d->next_descr;
+  }
+}
+
+static void record_run(struct dma_sg_descr_s *fetch, struct dma_sg_descr_s *push)
+{
+  if (recording != NULL) {
+    record_list(fetch, recording->fetch, &recording->fetch_count);
+    record_list(push, recording->push, &recording->push_count);
+    recording->runs++;
+  }
+}
+
+// Checks
+
+static void check(bool ok, const char *mode, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s: %s\n", mode, what);
+    errors++;
+  }
+}
+
+static void set_items(bool ccm)
+{
+  memset(items, 0, sizeof(items));
+  for (int i = 0; i < BATCH_ITEMS; i++) {
+    items[i].key = block_t_convert(keys[i], sizeof(keys[i]));
+    items[i].iv = block_t_convert(nonces[i], ccm ? 13 : 16);
+    items[i].aad = ccm ? block_t_convert(aads[i], (i == 1) ? 0 : sizeof(aads[i])) : NULL_blk;
+    items[i].datain = block_t_convert(datain[i], payload_sizes[i]);
+    items[i].dataout = block_t_convert(dataout[i], payload_sizes[i]);
+    items[i].mac = ccm ? block_t_convert(macs[i], MAC_SIZE) : NULL_blk;
+  }
+}
+
+static void run_single(bool ccm, enum sx_blk_cipher_operation operation, int i)
+{
+  block_t key = block_t_convert(keys[i], sizeof(keys[i]));
+  block_t in = block_t_convert(datain[i], payload_sizes[i]);
+  block_t out = block_t_convert(dataout[i], payload_sizes[i]);
+  block_t nonce = block_t_convert(nonces[i], ccm ? 13 : 16);
+  block_t aad = block_t_convert(aads[i], (i == 1) ? 0 : sizeof(aads[i]));
+  block_t mac = block_t_convert(macs[i], MAC_SIZE);
+
+  if (!ccm) {
+    sx_blk_cipher_ctr(SX_BLK_CIPHER_AES, operation, &key, &in, &out, &nonce);
+  } else if (operation == SX_BLK_CIPHER_ENCRYPT) {
+    sx_blk_cipher_ccm_encrypt(SX_BLK_CIPHER_AES, operation, &key, &in, &out, &nonce, &mac, &aad);
+  } else {
+    // The MAC does not match, only the descriptors are compared
+    sx_blk_cipher_ccm_decrypt(SX_BLK_CIPHER_AES, operation, &key, &in, &out, &nonce, &mac, &aad);
+  }
+}
+
+// Compare the descriptors of the batch with those of the single transfers,
+// the tag of being last apart.
+static bool same_descriptors(const record_t *batch, const record_t *single, int count)
+{
+  for (int i = 0; i < count; i++) {
+    if (batch[i].length_irq != single[i].length_irq
+        || (batch[i].tag & ~DMA_SG_TAG_ISLAST) != (single[i].tag & ~DMA_SG_TAG_ISLAST)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static int last_tags(const record_t *records, int count)
+{
+  int n = 0;
+
+  for (int i = 0; i < count; i++) {
+    n += (records[i].tag & DMA_SG_TAG_ISLAST) != 0;
+  }
+  return n;
+}
+
+static void check_batch(bool ccm, enum sx_blk_cipher_operation operation)
+{
+  static transfers_t single;
+  static transfers_t batch;
+  const char *mode = ccm
+                     ? ((operation == SX_BLK_CIPHER_ENCRYPT) ? "ccm encrypt" : "ccm decrypt")
+                     : ((operation == SX_BLK_CIPHER_ENCRYPT) ? "ctr encrypt" : "ctr decrypt");
+  int fetch_start = 0;
+  int push_start = 0;
+
+  memset(&single, 0, sizeof(single));
+  recording = &single;
+  for (int i = 0; i < BATCH_ITEMS; i++) {
+    run_single(ccm, operation, i);
+  }
+
+  memset(&batch, 0, sizeof(batch));
+  recording = &batch;
+  set_items(ccm);
+  check(sx_blk_cipher_batch_prepare(SX_BLK_CIPHER_AES, operation,
+                                    ccm ? SX_BLK_CIPHER_MODE_CCM : SX_BLK_CIPHER_MODE_CTR,
+                                    items, BATCH_ITEMS) == CRYPTOLIB_SUCCESS,
+        mode, "batch prepared");
+  cryptodma_run_sg(items[0].fetch, items[0].push);
+  recording = NULL;
+
+  check(single.runs == BATCH_ITEMS && batch.runs == 1, mode, "one transfer for the batch");
+  check(batch.fetch_count == single.fetch_count && batch.push_count == single.push_count,
+        mode, "descriptor count of the batch");
+  check(same_descriptors(batch.fetch, single.fetch, batch.fetch_count), mode, "fetch descriptors");
+  check(same_descriptors(batch.push, single.push, batch.push_count), mode, "push descriptors");
+
+  // The chain visits the items in order
+  for (int i = 0; i < BATCH_ITEMS; i++) {
+    check(batch.fetch[fetch_start].descr == items[i].fetch, mode, "fetch chain order");
+    check(batch.push[push_start].descr == items[i].push, mode, "push chain order");
+    while (fetch_start < batch.fetch_count && batch.fetch[fetch_start].descr >= items[i].fetch
+           && batch.fetch[fetch_start].descr < items[i].fetch + AES_BATCH_FETCH_DESCS) {
+      fetch_start++;
+    }
+    while (push_start < batch.push_count && batch.push[push_start].descr >= items[i].push
+           && batch.push[push_start].descr < items[i].push + AES_BATCH_PUSH_DESCS) {
+      push_start++;
+    }
+  }
+  check(fetch_start == batch.fetch_count && push_start == batch.push_count, mode, "chain ends after the last item");
+
+  // A single transfer per message has one last descriptor, the batch only
+  // one for the whole chain.
+  check(last_tags(single.fetch, single.fetch_count) == BATCH_ITEMS, mode, "last tags of the single transfers");
+  check(last_tags(batch.fetch, batch.fetch_count) == 1
+        && (batch.fetch[batch.fetch_count - 1].tag & DMA_SG_TAG_ISLAST) != 0,
+        mode, "only the final fetch descriptor is last");
+  check(last_tags(batch.push, batch.push_count) == 1
+        && (batch.push[batch.push_count - 1].tag & DMA_SG_TAG_ISLAST) != 0,
+        mode, "only the final push descriptor is last");
+}
+
+// Timing
+
+static double now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void print_speed(bool ccm)
+{
+  double start;
+  double single_ns;
+  double batch_ns;
+
+  start = now_ns();
+  for (int r = 0; r < SPEED_ROUNDS; r++) {
+    for (int i = 0; i < BATCH_ITEMS; i++) {
+      run_single(ccm, SX_BLK_CIPHER_ENCRYPT, i);
+    }
+  }
+  single_ns = (now_ns() - start) / SPEED_ROUNDS / BATCH_ITEMS;
+
+  start = now_ns();
+  for (int r = 0; r < SPEED_ROUNDS; r++) {
+    set_items(ccm);
+    sx_blk_cipher_batch_prepare(SX_BLK_CIPHER_AES, SX_BLK_CIPHER_ENCRYPT,
+                                ccm ? SX_BLK_CIPHER_MODE_CCM : SX_BLK_CIPHER_MODE_CTR,
+                                items, BATCH_ITEMS);
+    cryptodma_run_sg(items[0].fetch, items[0].push);
+  }
+  batch_ns = (now_ns() - start) / SPEED_ROUNDS / BATCH_ITEMS;
+
+  printf("%s  single %7.1f ns/message  batch %7.1f ns/message\n", ccm ? "ccm" : "ctr", single_ns, batch_ns);
+}
+
+int main(void)
+{
+  cryptodma_set_sg_runner(record_run);
+  for (int ccm = 0; ccm < 2; ccm++) {
+    check_batch(ccm, SX_BLK_CIPHER_ENCRYPT);
+    check_batch(ccm, SX_BLK_CIPHER_DECRYPT);
+  }
+  if (errors != 0) {
+    return 1;
+  }
+
+  printf("descriptor building, %d messages of 16 to 64 bytes:\n", BATCH_ITEMS);
+  print_speed(false);
+  print_speed(true);
+  return 0;
+}
@@ -0,0 +1,307 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host benchmark of the app_timer triggered queue.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+// Runs app_timer.c on a stand-in sleeptimer, the expirations are simulated
+// by calling the sleeptimer callbacks.
+//
+//   bench          Checks the queue, then prints the start, stop and
+//                  dispatch cost for 10 to 1000 timers and the 99.9th
+//                  percentile of the atomic sections, an approximation of
+//                  the IRQ latency added by app_timer.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "app_timer.h"
+
+#define TIMER_COUNT       1000
+#define BENCH_ROUNDS      200
+#define CRITICAL_SAMPLES  (1u << 22)
+
+// Atomic section timing
+static int critical_depth;
+static uint64_t critical_start;
+static uint64_t critical_samples[CRITICAL_SAMPLES];
+static uint32_t critical_count;
+
+static app_timer_t timers[TIMER_COUNT];
+static unsigned long calls;
+static unsigned long order_errors;
+static long last_index;
+static unsigned long errors;
+
+static uint32_t max_ms32_conversion = UINT32_MAX;
+
+static uint64_t now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t bench_critical_enter(void)
+{
+  if (critical_depth++ == 0) {
+    critical_start = now_ns();
+  }
+  return 0;
+}
+
+void bench_critical_exit(uint64_t state)
+{
+  (void)state;
+  if (--critical_depth == 0 && critical_count < CRITICAL_SAMPLES) {
+    critical_samples[critical_count++] = now_ns() - critical_start;
+  }
+}
+
+// Sleeptimer stand-in
+
+static sl_status_t start(sl_sleeptimer_timer_handle_t *handle,
+                         sl_sleeptimer_timer_callback_t callback,
+                         void *callback_data,
+                         uint16_t option_flags)
+{
+  handle->callback = callback;
+  handle->callback_data = callback_data;
+  handle->option_flags = option_flags;
+  handle->running = true;
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_sleeptimer_start_timer_ms(sl_sleeptimer_timer_handle_t *handle, uint32_t timeout_ms,
+                                         sl_sleeptimer_timer_callback_t callback, void *callback_data,
+                                         uint8_t priority, uint16_t option_flags)
+{
+  (void)timeout_ms;
+  (void)priority;
+  return start(handle, callback, callback_data, option_flags);
+}
+
+sl_status_t sl_sleeptimer_start_periodic_timer_ms(sl_sleeptimer_timer_handle_t *handle, uint32_t timeout_ms,
+                                                  sl_sleeptimer_timer_callback_t callback, void *callback_data,
+                                                  uint8_t priority, uint16_t option_flags)
+{
+  (void)timeout_ms;
+  (void)priority;
+  return start(handle, callback, callback_data, option_flags);
+}
+
+sl_status_t sl_sleeptimer_start_periodic_timer(sl_sleeptimer_timer_handle_t *handle, uint32_t timeout,
+                                               sl_sleeptimer_timer_callback_t callback, void *callback_data,
+                                               uint8_t priority, uint16_t option_flags)
+{
+  (void)timeout;
+  (void)priority;
+  return start(handle, callback, callback_data, option_flags);
+}
+
+sl_status_t sl_sleeptimer_restart_periodic_timer(sl_sleeptimer_timer_handle_t *handle, uint32_t timeout,
+                                                 sl_sleeptimer_timer_callback_t callback, void *callback_data,
+                                                 uint8_t priority, uint16_t option_flags)
+{
+  (void)timeout;
+  (void)priority;
+  return start(handle, callback, callback_data, option_flags);
+}
+
+sl_status_t sl_sleeptimer_stop_timer(sl_sleeptimer_timer_handle_t *handle)
+{
+  // The real sleeptimer finds the handle in its own list, never through
+  // the handle fields.
+  handle->running = false;
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_sleeptimer_ms32_to_tick(uint32_t time_ms, uint32_t *tick)
+{
+  *tick = (uint32_t)(((uint64_t)time_ms * 32768u + 999u) / 1000u);
+  return SL_STATUS_OK;
+}
+
+uint16_t sl_sleeptimer_slack_to_option_flags(uint32_t slack)
+{
+  uint16_t n = 0;
+
+  while (n < 31 && (slack >> (n + 1)) != 0) {
+    n++;
+  }
+  return (slack == 0) ? 0 : (uint16_t)((n + 1) << 8);
+}
+
+uint32_t sl_sleeptimer_get_max_ms32_conversion(void)
+{
+  return max_ms32_conversion;
+}
+
+uint32_t sl_sleeptimer_get_timer_frequency(void)
+{
+  return 32768;
+}
+
+// Checks
+
+static void check(bool ok, const char *what)
+{
+  if (!ok) {
+    printf("FAIL: %s\n", what);
+    errors++;
+  }
+}
+
+static void on_timer(app_timer_t *timer, void *data)
+{
+  (void)timer;
+  calls++;
+  if ((long)data < last_index) {
+    order_errors++;
+  }
+  last_index = (long)data;
+}
+
+static void fire(app_timer_t *timer)
+{
+  timer->sleeptimer_handle.callback(&timer->sleeptimer_handle,
+                                    timer->sleeptimer_handle.callback_data);
+}
+
+static void dispatch(void)
+{
+  last_index = -1;
+  sli_app_timer_step();
+}
+
+static void run_checks(void)
+{
+  app_timer_t *garbage;
+
+  // A timer that was never started, its memory not zeroed, must start
+  // without touching the queue.
+  garbage = malloc(sizeof(*garbage));
+  memset(garbage, 0xA5, sizeof(*garbage));
+  garbage->next = &timers[0];
+  app_timer_start(&timers[0], 10, on_timer, (void *)0, false);
+  app_timer_start(&timers[1], 10, on_timer, (void *)1, false);
+  fire(&timers[0]);
+  fire(&timers[1]);
+  check(app_timer_start(garbage, 10, on_timer, (void *)2, false) == SL_STATUS_OK,
+        "start of a never started timer");
+  calls = 0;
+  dispatch();
+  check(calls == 2, "queue intact after the start of a never started timer");
+  app_timer_stop(garbage);
+  free(garbage);
+
+  // Stop removes a triggered timer from the head, the middle and the tail.
+  for (int removed = 0; removed < 3; removed++) {
+    for (int i = 0; i < 3; i++) {
+      app_timer_start(&timers[i], 10, on_timer, (void *)(long)i, false);
+      fire(&timers[i]);
+    }
+    app_timer_stop(&timers[removed]);
+    calls = 0;
+    dispatch();
+    check(calls == 2, "stop of a triggered timer");
+    check(sli_app_timer_is_ok_to_sleep(), "queue empty after dispatch");
+    // The tail must be right, the next trigger must be dispatched
+    fire(&timers[(removed + 1) % 3]);
+    calls = 0;
+    dispatch();
+    check(calls == 1, "trigger after the stop of a triggered timer");
+  }
+
+  // A periodic timer triggered twice before a dispatch runs once.
+  app_timer_start(&timers[0], 10, on_timer, (void *)0, true);
+  fire(&timers[0]);
+  fire(&timers[0]);
+  check(sli_app_timer_sleep_on_isr_exit() == SL_POWER_MANAGER_WAKEUP, "wakeup for a trigger");
+  calls = 0;
+  dispatch();
+  check(calls == 1, "periodic timer dispatched once");
+  app_timer_stop(&timers[0]);
+
+  // The slack reaches the sleeptimer, and survives the restart of a long
+  // periodic timer.
+  check(app_timer_start_with_slack(&timers[0], 10, 10, on_timer, NULL, true)
+        == SL_STATUS_INVALID_PARAMETER, "slack of a period");
+  app_timer_start_with_slack(&timers[0], 1000, 100, on_timer, NULL, false);
+  check(timers[0].sleeptimer_handle.option_flags == sl_sleeptimer_slack_to_option_flags(3277),
+        "slack passed to the sleeptimer");
+  max_ms32_conversion = 100;
+  app_timer_start_with_slack(&timers[0], 1000, 100, on_timer, NULL, true);
+  fire(&timers[0]);
+  check(timers[0].sleeptimer_handle.option_flags == sl_sleeptimer_slack_to_option_flags(3277),
+        "slack kept by a long periodic timer");
+  max_ms32_conversion = UINT32_MAX;
+  dispatch();
+  app_timer_stop(&timers[0]);
+  check(order_errors == 0, "dispatch in trigger order");
+}
+
+static int compare_u64(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *)a;
+  uint64_t y = *(const uint64_t *)b;
+
+  return (x < y) ? -1 : (x > y);
+}
+
+int main(void)
+{
+  static const int counts[] = { 10, 50, 100, 250, 1000 };
+
+  run_checks();
+  if (errors != 0) {
+    return 1;
+  }
+
+  printf("%6s %12s %12s %12s %12s\n", "timers", "start ns", "stop ns", "dispatch ns", "p99.9 crit ns");
+  for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+    int n = counts[c];
+    uint64_t start_ns = 0;
+    uint64_t stop_ns = 0;
+    uint64_t dispatch_ns = 0;
+
+    critical_count = 0;
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+      uint64_t t0 = now_ns();
+      uint64_t t1;
+      uint64_t t2;
+
+      for (int i = 0; i < n; i++) {
+        app_timer_start(&timers[i], 100, on_timer, (void *)(long)i, (i & 1) != 0);
+      }
+      start_ns += now_ns() - t0;
+      for (int i = 0; i < n; i++) {
+        fire(&timers[i]);
+      }
+      t1 = now_ns();
+      dispatch();
+      t2 = now_ns();
+      for (int i = 0; i < n; i++) {
+        app_timer_stop(&timers[i]);
+      }
+      dispatch_ns += t2 - t1;
+      stop_ns += now_ns() - t2;
+    }
+    qsort(critical_samples, critical_count, sizeof(critical_samples[0]), compare_u64);
+    printf("%6d %12.1f %12.1f %12.1f %12llu\n",
+           n,
+           (double)start_ns / BENCH_ROUNDS / n,
+           (double)stop_ns / BENCH_ROUNDS / n,
+           (double)dispatch_ns / BENCH_ROUNDS / n,
+           (unsigned long long)critical_samples[critical_count * 999u / 1000u]);
+  }
+
+  return (order_errors == 0) ? 0 : 1;
+}
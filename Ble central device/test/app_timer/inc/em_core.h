@@ -0,0 +1,16 @@
+// Host stand-in for the core header. Atomic sections are timed, their
+// distribution is reported by the benchmark.
+#ifndef EM_CORE_H
+#define EM_CORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+uint64_t bench_critical_enter(void);
+void bench_critical_exit(uint64_t state);
+
+#define CORE_DECLARE_IRQ_STATE  uint64_t irqState
+#define CORE_ENTER_ATOMIC()     irqState = bench_critical_enter()
+#define CORE_EXIT_ATOMIC()      bench_critical_exit(irqState)
+
+#endif // EM_CORE_H
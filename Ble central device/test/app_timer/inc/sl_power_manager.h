@@ -0,0 +1,11 @@
+// Host stand-in, only the type of the ISR exit hook.
+#ifndef SL_POWER_MANAGER_H
+#define SL_POWER_MANAGER_H
+
+typedef enum {
+  SL_POWER_MANAGER_IGNORE = (1UL << 0UL),
+  SL_POWER_MANAGER_SLEEP  = (1UL << 1UL),
+  SL_POWER_MANAGER_WAKEUP = (1UL << 2UL),
+} sl_power_manager_on_isr_exit_t;
+
+#endif // SL_POWER_MANAGER_H
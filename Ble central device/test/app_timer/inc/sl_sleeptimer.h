@@ -0,0 +1,38 @@
+// Host stand-in for the sleeptimer. A timer only records its callback, the
+// benchmark expires it by calling bench_fire().
+#ifndef SL_SLEEPTIMER_H
+#define SL_SLEEPTIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sl_status.h"
+
+typedef struct sl_sleeptimer_timer_handle sl_sleeptimer_timer_handle_t;
+typedef void (*sl_sleeptimer_timer_callback_t)(sl_sleeptimer_timer_handle_t *handle, void *data);
+
+struct sl_sleeptimer_timer_handle {
+  sl_sleeptimer_timer_callback_t callback;
+  void *callback_data;
+  uint16_t option_flags;
+  bool running;
+};
+
+sl_status_t sl_sleeptimer_start_timer_ms(sl_sleeptimer_timer_handle_t *handle, uint32_t timeout_ms,
+                                         sl_sleeptimer_timer_callback_t callback, void *callback_data,
+                                         uint8_t priority, uint16_t option_flags);
+sl_status_t sl_sleeptimer_start_periodic_timer_ms(sl_sleeptimer_timer_handle_t *handle, uint32_t timeout_ms,
+                                                  sl_sleeptimer_timer_callback_t callback, void *callback_data,
+                                                  uint8_t priority, uint16_t option_flags);
+sl_status_t sl_sleeptimer_start_periodic_timer(sl_sleeptimer_timer_handle_t *handle, uint32_t timeout,
+                                               sl_sleeptimer_timer_callback_t callback, void *callback_data,
+                                               uint8_t priority, uint16_t option_flags);
+sl_status_t sl_sleeptimer_restart_periodic_timer(sl_sleeptimer_timer_handle_t *handle, uint32_t timeout,
+                                                 sl_sleeptimer_timer_callback_t callback, void *callback_data,
+                                                 uint8_t priority, uint16_t option_flags);
+sl_status_t sl_sleeptimer_stop_timer(sl_sleeptimer_timer_handle_t *handle);
+sl_status_t sl_sleeptimer_ms32_to_tick(uint32_t time_ms, uint32_t *tick);
+uint16_t sl_sleeptimer_slack_to_option_flags(uint32_t slack);
+uint32_t sl_sleeptimer_get_max_ms32_conversion(void);
+uint32_t sl_sleeptimer_get_timer_frequency(void);
+
+#endif // SL_SLEEPTIMER_H
@@ -0,0 +1,231 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host test of the constant-time buffer functions of Mbed TLS.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+// Runs constant_time.c of the SDK, built byte-wise, with word access, and
+// with word access and SSE2, see the Makefile.
+//
+//   bench          Checks mbedtls_ct_memcmp(), mbedtls_ct_memcpy_if() and
+//                  mbedtls_ct_zeroize_if() against the libc functions for
+//                  all 16x16 offset pairs and lengths 0 to 300. Then times
+//                  mbedtls_ct_memcmp() on equal buffers, on buffers that
+//                  differ in the first byte and in the last byte: the
+//                  median ratio of the time of each differing input to the
+//                  time of the equal one must be within TIMING_TOLERANCE
+//                  of 1. Last, prints the throughput.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "common.h"
+#include "constant_time_internal.h"
+#include "mbedtls/constant_time.h"
+
+#define BUFFER_SIZE       (4096 + 64)
+#define CHECK_MAX_LENGTH  300
+#define TIMING_SAMPLES    3001
+#define TIMING_BYTES      8192
+#define TIMING_TOLERANCE  0.05
+#define SPEED_ROUNDS      50
+#define SPEED_BYTES       2000000
+
+enum {
+  INPUT_EQUAL,
+  INPUT_DIFF_FIRST,
+  INPUT_DIFF_LAST,
+  INPUT_COUNT
+};
+
+static const char *const input_names[INPUT_COUNT] = { "equal", "diff-first", "diff-last" };
+
+static unsigned char a[BUFFER_SIZE] __attribute__((aligned(64)));
+static unsigned char b[INPUT_COUNT][BUFFER_SIZE] __attribute__((aligned(64)));
+static unsigned char dst[BUFFER_SIZE];
+static unsigned char ref[BUFFER_SIZE];
+static double samples[INPUT_COUNT][TIMING_SAMPLES];
+static volatile int sink;
+
+static uint64_t now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static int compare_double(const void *x, const void *y)
+{
+  double u = *(const double *)x;
+  double v = *(const double *)y;
+
+  return (u < v) ? -1 : (u > v);
+}
+
+// Checks
+
+static unsigned long check_results(void)
+{
+  unsigned long errors = 0;
+
+  for (int oa = 0; oa < 16; oa++) {
+    for (int ob = 0; ob < 16; ob++) {
+      for (int n = 0; n <= CHECK_MAX_LENGTH; n++) {
+        unsigned char *x = a + oa;
+        unsigned char *y = b[0] + ob;
+
+        memcpy(y, x, n);
+        if (mbedtls_ct_memcmp(x, y, n) != 0) {
+          errors++;
+        }
+        for (int k = 0; k < n; k += (n > 40) ? 7 : 1) {
+          for (int bit = 0; bit < 8; bit++) {
+            y[k] ^= (unsigned char)(1u << bit);
+            if (mbedtls_ct_memcmp(x, y, n) == 0) {
+              errors++;
+            }
+            y[k] ^= (unsigned char)(1u << bit);
+          }
+        }
+        for (int c = 0; c < 2; c++) {
+          memset(dst, 0x5a, sizeof(dst));
+          memset(ref, 0x5a, sizeof(ref));
+          mbedtls_ct_memcpy_if(mbedtls_ct_bool(c), dst + ob, x, NULL, n);
+          if (c) {
+            memcpy(ref + ob, x, n);
+          }
+          if (memcmp(dst, ref, sizeof(dst)) != 0) {
+            errors++;
+          }
+          memset(dst, 0x5a, sizeof(dst));
+          memset(ref, 0x5a, sizeof(ref));
+          mbedtls_ct_zeroize_if(mbedtls_ct_bool(c), dst + ob, n);
+          if (c) {
+            memset(ref + ob, 0, n);
+          }
+          if (memcmp(dst, ref, sizeof(dst)) != 0) {
+            errors++;
+          }
+        }
+      }
+    }
+  }
+  return errors;
+}
+
+// Timing
+
+static unsigned long check_timing(int n)
+{
+  int iterations = TIMING_BYTES / n + 10;
+  double median[INPUT_COUNT];
+  unsigned long errors = 0;
+
+  for (int v = 0; v < INPUT_COUNT; v++) {
+    memcpy(b[v], a, n);
+  }
+  b[INPUT_DIFF_FIRST][0] ^= 1;
+  b[INPUT_DIFF_LAST][n - 1] ^= 1;
+
+  // Each sample times the three inputs back to back, in a random order, so
+  // that drifts of the clock or of the load cancel out in their ratios.
+  for (int s = 0; s < TIMING_SAMPLES; s++) {
+    int order[INPUT_COUNT] = { INPUT_EQUAL, INPUT_DIFF_FIRST, INPUT_DIFF_LAST };
+    double t[INPUT_COUNT];
+
+    for (int k = INPUT_COUNT - 1; k > 0; k--) {
+      int j = rand() % (k + 1);
+      int v = order[k];
+
+      order[k] = order[j];
+      order[j] = v;
+    }
+    for (int k = 0; k < INPUT_COUNT; k++) {
+      int v = order[k];
+      uint64_t start = now_ns();
+
+      for (int i = 0; i < iterations; i++) {
+        sink += mbedtls_ct_memcmp(a, b[v], n);
+      }
+      t[v] = (double)(now_ns() - start) / iterations;
+    }
+    for (int v = 0; v < INPUT_COUNT; v++) {
+      samples[v][s] = (v == INPUT_EQUAL) ? t[v] : t[v] / t[INPUT_EQUAL];
+    }
+  }
+
+  for (int v = 0; v < INPUT_COUNT; v++) {
+    qsort(samples[v], TIMING_SAMPLES, sizeof(samples[v][0]), compare_double);
+    median[v] = samples[v][TIMING_SAMPLES / 2];
+  }
+  printf("memcmp %5d B  equal %8.2f ns", n, median[INPUT_EQUAL]);
+  for (int v = 1; v < INPUT_COUNT; v++) {
+    printf("  %s %6.3f", input_names[v], median[v]);
+  }
+  for (int v = 1; v < INPUT_COUNT; v++) {
+    if (median[v] > 1 + TIMING_TOLERANCE || median[v] < 1 - TIMING_TOLERANCE) {
+      printf("  FAIL: %s", input_names[v]);
+      errors++;
+    }
+  }
+  printf("\n");
+  return errors;
+}
+
+static void print_speed(int n)
+{
+  int iterations = SPEED_BYTES / n + 10;
+  double memcmp_ns = 1e18;
+  double memcpy_if_ns = 1e18;
+
+  memcpy(b[0], a, n);
+  for (int r = 0; r < SPEED_ROUNDS; r++) {
+    uint64_t start = now_ns();
+    double t;
+
+    for (int i = 0; i < iterations; i++) {
+      sink += mbedtls_ct_memcmp(a, b[0], n);
+    }
+    t = (double)(now_ns() - start) / iterations;
+    memcmp_ns = (t < memcmp_ns) ? t : memcmp_ns;
+
+    start = now_ns();
+    for (int i = 0; i < iterations; i++) {
+      mbedtls_ct_memcpy_if(mbedtls_ct_bool(i & 1), dst, a, NULL, n);
+    }
+    t = (double)(now_ns() - start) / iterations;
+    memcpy_if_ns = (t < memcpy_if_ns) ? t : memcpy_if_ns;
+  }
+  printf("%5d B  memcmp %7.3f GB/s  memcpy_if %7.3f GB/s\n", n, n / memcmp_ns, n / memcpy_if_ns);
+}
+
+int main(void)
+{
+  static const int sizes[] = { 16, 64, 256, 1024, 4096 };
+  unsigned long errors;
+
+  srand(1);
+  for (size_t i = 0; i < sizeof(a); i++) {
+    a[i] = (unsigned char)rand();
+  }
+
+  errors = check_results();
+  if (errors != 0) {
+    printf("FAIL: %lu results differ from libc\n", errors);
+    return 1;
+  }
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    errors += check_timing(sizes[s]);
+  }
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    print_speed(sizes[s]);
+  }
+  return (errors == 0) ? 0 : 1;
+}
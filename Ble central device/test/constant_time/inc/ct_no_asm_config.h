@@ -0,0 +1,3 @@
+// User config of the word access build without assembly, as on the
+// Cortex-M33 of the projects where MBEDTLS_HAVE_ASM is off.
+#undef MBEDTLS_HAVE_ASM
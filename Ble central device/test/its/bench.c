@@ -0,0 +1,264 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host benchmark of the PSA ITS UID lookups.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+// Runs the PSA ITS driver on a RAM key/value stand-in of NVM3, the NVM3
+// core only ships as a Cortex-M33 library. Every object read is counted,
+// each one is a flash access on target.
+//
+//   bench          Random sets, removes and gets of UIDs, checked against a
+//                  reference map. Then the lookups of stored, removed and
+//                  unknown UIDs, with the object reads they need.
+//
+// psa_its_get() only accepts output buffers in the SRAM of the device, so
+// the benchmark maps that address range.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "em_device.h"
+#include "nvm3.h"
+#include "psa/internal_trusted_storage.h"
+
+#define OBJECT_SPACE    0x100000u
+#define OBJECT_MAX_SIZE 256u
+#define UID_COUNT       100
+#define DATA_SIZE       32
+#define RANDOM_OPS      20000
+#define LOOKUP_ROUNDS   10
+
+typedef struct {
+  bool used;
+  bool deleted;
+  size_t len;
+  uint8_t data[OBJECT_MAX_SIZE];
+} object_t;
+
+static object_t *objects;
+static unsigned long reads;
+// Output buffer of psa_its_get(), in the SRAM range of the device
+static uint8_t *sram;
+
+// Reference map of the benchmark UIDs
+static bool stored[UID_COUNT];
+static uint8_t stored_data[UID_COUNT][DATA_SIZE];
+
+nvm3_Handle_t *nvm3_defaultHandle;
+
+static object_t *get_object(nvm3_ObjectKey_t key)
+{
+  return &objects[key & (OBJECT_SPACE - 1)];
+}
+
+// NVM3 stand-in
+
+Ecode_t nvm3_initDefault(void)
+{
+  return ECODE_NVM3_OK;
+}
+
+Ecode_t nvm3_readPartialData(nvm3_Handle_t *h, nvm3_ObjectKey_t key, void *value, size_t ofs, size_t len)
+{
+  object_t *object = get_object(key);
+
+  (void)h;
+  reads++;
+  if (!object->used) {
+    return ECODE_NVM3_ERR_KEY_NOT_FOUND;
+  }
+  if (ofs + len > object->len) {
+    return ECODE_NVM3_ERR_READ_DATA_SIZE;
+  }
+  memcpy(value, &object->data[ofs], len);
+  return ECODE_NVM3_OK;
+}
+
+Ecode_t nvm3_writeData(nvm3_Handle_t *h, nvm3_ObjectKey_t key, const void *value, size_t len)
+{
+  object_t *object = get_object(key);
+
+  (void)h;
+  if (len > OBJECT_MAX_SIZE) {
+    return ECODE_NVM3_ERR_WRITE_DATA_SIZE;
+  }
+  object->used = true;
+  object->deleted = false;
+  object->len = len;
+  memcpy(object->data, value, len);
+  return ECODE_NVM3_OK;
+}
+
+Ecode_t nvm3_deleteObject(nvm3_Handle_t *h, nvm3_ObjectKey_t key)
+{
+  object_t *object = get_object(key);
+
+  (void)h;
+  if (!object->used) {
+    return ECODE_NVM3_ERR_KEY_NOT_FOUND;
+  }
+  object->used = false;
+  object->deleted = true;
+  return ECODE_NVM3_OK;
+}
+
+Ecode_t nvm3_getObjectInfo(nvm3_Handle_t *h, nvm3_ObjectKey_t key, uint32_t *type, size_t *len)
+{
+  object_t *object = get_object(key);
+
+  (void)h;
+  if (!object->used) {
+    return ECODE_NVM3_ERR_KEY_NOT_FOUND;
+  }
+  *type = NVM3_OBJECTTYPE_DATA;
+  *len = object->len;
+  return ECODE_NVM3_OK;
+}
+
+static size_t enum_objects(nvm3_ObjectKey_t *keys, size_t max, nvm3_ObjectKey_t min_key,
+                           nvm3_ObjectKey_t max_key, bool deleted)
+{
+  size_t count = 0;
+
+  for (nvm3_ObjectKey_t key = min_key; key <= max_key; key++) {
+    object_t *object = get_object(key);
+
+    if (deleted ? object->deleted : object->used) {
+      if (keys != NULL && count < max) {
+        keys[count] = key;
+      }
+      count++;
+    }
+  }
+  return (keys != NULL && count > max) ? max : count;
+}
+
+size_t nvm3_enumObjects(nvm3_Handle_t *h, nvm3_ObjectKey_t *keys, size_t max,
+                        nvm3_ObjectKey_t min_key, nvm3_ObjectKey_t max_key)
+{
+  (void)h;
+  return enum_objects(keys, max, min_key, max_key, false);
+}
+
+size_t nvm3_enumDeletedObjects(nvm3_Handle_t *h, nvm3_ObjectKey_t *keys, size_t max,
+                               nvm3_ObjectKey_t min_key, nvm3_ObjectKey_t max_key)
+{
+  (void)h;
+  return enum_objects(keys, max, min_key, max_key, true);
+}
+
+void *sl_calloc(size_t item_count, size_t size)
+{
+  return calloc(item_count, size);
+}
+
+void sl_free(void *ptr)
+{
+  free(ptr);
+}
+
+// Benchmark
+
+static psa_storage_uid_t uid_of(int i)
+{
+  return 0x1000u + (psa_storage_uid_t)i * 7919u;
+}
+
+static int check_get(int i)
+{
+  size_t len = 0;
+  psa_status_t status = psa_its_get(uid_of(i), 0, DATA_SIZE, sram, &len);
+
+  if (stored[i]) {
+    return (status == PSA_SUCCESS && len == DATA_SIZE
+            && memcmp(sram, stored_data[i], DATA_SIZE) == 0) ? 0 : 1;
+  }
+  return (status == PSA_ERROR_DOES_NOT_EXIST) ? 0 : 1;
+}
+
+int main(void)
+{
+  unsigned long errors = 0;
+  size_t len;
+
+  objects = calloc(OBJECT_SPACE, sizeof(*objects));
+  sram = mmap((void *)SRAM_BASE, SRAM_SIZE, PROT_READ | PROT_WRITE,
+              MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+  if (objects == NULL || sram != (uint8_t *)SRAM_BASE) {
+    printf("FAIL: cannot map the SRAM range\n");
+    return 1;
+  }
+  srand(1);
+
+  // Random operations against the reference map
+  for (int op = 0; op < RANDOM_OPS; op++) {
+    int i = rand() % UID_COUNT;
+
+    switch (rand() % 3) {
+      case 0:
+        for (int b = 0; b < DATA_SIZE; b++) {
+          stored_data[i][b] = (uint8_t)rand();
+        }
+        if (psa_its_set(uid_of(i), DATA_SIZE, stored_data[i], 0) != PSA_SUCCESS) {
+          errors++;
+        }
+        stored[i] = true;
+        break;
+      case 1:
+        if (psa_its_remove(uid_of(i)) != (stored[i] ? PSA_SUCCESS : PSA_ERROR_DOES_NOT_EXIST)) {
+          errors++;
+        }
+        stored[i] = false;
+        break;
+      default:
+        errors += (unsigned long)check_get(i);
+        break;
+    }
+  }
+
+  // Steady state: every UID stored, then a third of them removed
+  for (int i = 0; i < UID_COUNT; i++) {
+    memset(stored_data[i], i, DATA_SIZE);
+    if (psa_its_set(uid_of(i), DATA_SIZE, stored_data[i], 0) != PSA_SUCCESS) {
+      errors++;
+    }
+    stored[i] = true;
+  }
+  for (int i = 0; i < UID_COUNT; i += 3) {
+    if (psa_its_remove(uid_of(i)) != PSA_SUCCESS) {
+      errors++;
+    }
+    stored[i] = false;
+  }
+
+  reads = 0;
+  for (int r = 0; r < LOOKUP_ROUNDS; r++) {
+    for (int i = 0; i < UID_COUNT; i++) {
+      errors += (unsigned long)check_get(i);
+    }
+  }
+  printf("%d lookups of stored and removed UIDs: %lu object reads\n",
+         LOOKUP_ROUNDS * UID_COUNT, reads);
+
+  reads = 0;
+  for (int i = 0; i < UID_COUNT; i++) {
+    if (psa_its_get(0x99990000u + (psa_storage_uid_t)i, 0, DATA_SIZE, sram, &len)
+        != PSA_ERROR_DOES_NOT_EXIST) {
+      errors++;
+    }
+  }
+  printf("%d lookups of unknown UIDs: %lu object reads\n", UID_COUNT, reads);
+
+  if (errors != 0) {
+    printf("FAIL: %lu results differ from the reference\n", errors);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,424 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host benchmark of the sleeptimer timer queues.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+// Runs sl_sleeptimer.c on a simulated timer peripheral.
+//
+//   bench          Start, stop and expiry cost for 10 to 500 timers, and the
+//                  longest critical section.
+//   bench trace    Random start/stop/query/advance operations from near the
+//                  counter wraparound. Prints every result and callback, the
+//                  callbacks of a tick sorted by priority and timer, so the
+//                  traces of two queues can be compared with diff.
+//   bench slack    Random one-shot timers with a slack. Checks that none
+//                  expires later than its slack allows, that the first wakeup
+//                  reported to the power manager is the compare match, and
+//                  prints the wakeup statistics.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sl_sleeptimer.h"
+#include "sli_sleeptimer.h"
+#include "sli_sleeptimer_hal.h"
+
+#define TIMER_COUNT       600
+#define TRACE_TIMERS      64
+#define TRACE_OPERATIONS  30000
+#define SLACK_TIMERS      128
+#define SLACK_OPERATIONS  200000
+#define BENCH_ROUNDS      200
+
+// Simulated peripheral
+static uint32_t counter;
+static uint32_t compare;
+static bool compare_enabled;
+static bool compare_pending;
+
+// Critical section timing
+static int critical_depth;
+static uint64_t critical_start;
+static uint64_t critical_max;
+
+static sl_sleeptimer_timer_handle_t timers[TIMER_COUNT];
+static unsigned long fired;
+
+// Trace mode: callbacks of the current tick, printed sorted
+static bool tracing;
+static uint32_t fired_tick;
+static uint32_t fired_count;
+static uint32_t fired_keys[TIMER_COUNT];
+
+// Slack mode: expected expiration of the one-shot timers
+static bool slack_check[TIMER_COUNT];
+static uint32_t slack_expiry[TIMER_COUNT];
+static uint32_t slack_allowed[TIMER_COUNT];
+static unsigned long slack_late;
+static unsigned long wakeup_mismatches;
+
+static uint64_t now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t random_u32(void)
+{
+  static uint64_t x = 88172645463325252ull;
+
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return (uint32_t)x;
+}
+
+uint64_t bench_critical_enter(void)
+{
+  if (critical_depth++ == 0) {
+    critical_start = now_ns();
+  }
+  return 0;
+}
+
+void bench_critical_exit(uint64_t state)
+{
+  (void)state;
+  if (--critical_depth == 0) {
+    uint64_t duration = now_ns() - critical_start;
+
+    if (duration > critical_max) {
+      critical_max = duration;
+    }
+  }
+}
+
+// Timer HAL on the simulated peripheral
+
+void sleeptimer_hal_init_timer(void)
+{
+}
+
+uint32_t sleeptimer_hal_get_counter(void)
+{
+  return counter;
+}
+
+uint32_t sleeptimer_hal_get_compare(void)
+{
+  return compare;
+}
+
+void sleeptimer_hal_set_compare(uint32_t value)
+{
+  compare = value;
+  if (value == counter) {
+    compare_pending = true;
+  }
+}
+
+void sleeptimer_hal_set_compare_prs_hfxo_startup(int32_t value)
+{
+  (void)value;
+}
+
+uint32_t sleeptimer_hal_get_timer_frequency(void)
+{
+  return 32768;
+}
+
+void sleeptimer_hal_enable_int(uint8_t local_flag)
+{
+  if (local_flag & SLEEPTIMER_EVENT_COMP) {
+    compare_enabled = true;
+  }
+}
+
+void sleeptimer_hal_disable_int(uint8_t local_flag)
+{
+  if (local_flag & SLEEPTIMER_EVENT_COMP) {
+    compare_enabled = false;
+  }
+}
+
+void sleeptimer_hal_set_int(uint8_t local_flag)
+{
+  if (local_flag & SLEEPTIMER_EVENT_COMP) {
+    compare_pending = true;
+  }
+}
+
+bool sli_sleeptimer_hal_is_int_status_set(uint8_t local_flag)
+{
+  return ((local_flag & SLEEPTIMER_EVENT_COMP) != 0) && compare_pending;
+}
+
+uint16_t sleeptimer_hal_get_clock_accuracy(void)
+{
+  return 0;
+}
+
+void sleeptimer_hal_disable_prs_compare_and_capture_channel(void)
+{
+}
+
+uint32_t sleeptimer_hal_get_capture(void)
+{
+  return 0;
+}
+
+void sleeptimer_hal_reset_prs_signal(void)
+{
+}
+
+static int compare_keys(const void *a, const void *b)
+{
+  uint32_t ka = *(const uint32_t *)a;
+  uint32_t kb = *(const uint32_t *)b;
+
+  return (ka > kb) - (ka < kb);
+}
+
+// Print the callbacks of the last tick, sorted by priority and timer
+static void flush_fired(void)
+{
+  qsort(fired_keys, fired_count, sizeof(fired_keys[0]), compare_keys);
+  for (uint32_t i = 0; i < fired_count; i++) {
+    printf("F %u %u %u\n", fired_tick, fired_keys[i] >> 16, fired_keys[i] & 0xFFFFu);
+  }
+  fired_count = 0;
+}
+
+static void on_timeout(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+  long index = handle - timers;
+
+  (void)data;
+  fired++;
+
+  if (slack_check[index]) {
+    uint32_t late = counter - slack_expiry[index];
+
+    if (late > slack_allowed[index]) {
+      slack_late++;
+      printf("timer %ld late by %u ticks, slack %u\n", index, late, slack_allowed[index]);
+    }
+    slack_check[index] = false;
+  }
+
+  if (tracing) {
+    if ((fired_count > 0) && (fired_tick != counter)) {
+      flush_fired();
+    }
+    fired_tick = counter;
+    fired_keys[fired_count++] = ((uint32_t)handle->priority << 16) | (uint32_t)index;
+  }
+}
+
+static void service_interrupts(void)
+{
+  while (compare_enabled && compare_pending) {
+    compare_pending = false;
+    process_timer_irq(SLEEPTIMER_EVENT_COMP);
+  }
+}
+
+// Advance the counter, stopping at every compare match and overflow
+static void advance(uint32_t ticks)
+{
+  while (ticks > 0) {
+    uint32_t step = ticks;
+    uint32_t to_overflow = 0u - counter;
+
+    service_interrupts();
+    if (compare_enabled) {
+      uint32_t to_compare = compare - counter;
+
+      if ((to_compare != 0) && (to_compare < step)) {
+        step = to_compare;
+      }
+    }
+    if ((to_overflow != 0) && (to_overflow < step)) {
+      step = to_overflow;
+    }
+
+    counter += step;
+    ticks -= step;
+    if (counter == 0) {
+      process_timer_irq(SLEEPTIMER_EVENT_OF);
+    }
+    if (compare_enabled && (counter == compare)) {
+      compare_pending = true;
+    }
+    service_interrupts();
+  }
+}
+
+static void run_trace(void)
+{
+  tracing = true;
+  counter = 0xFFFF0000u;
+
+  for (int i = 0; i < TRACE_OPERATIONS; i++) {
+    int index = (int)(random_u32() % TRACE_TIMERS);
+    uint32_t op = random_u32() % 100;
+    uint32_t timeout;
+    uint32_t remaining = 0;
+    sl_status_t status;
+    bool running;
+
+    if (op < 5) {
+      timeout = random_u32();
+    } else if (op < 10) {
+      timeout = random_u32() % 3;
+    } else {
+      timeout = random_u32() % 70000;
+    }
+    sl_sleeptimer_is_timer_running(&timers[index], &running);
+
+    if (op < 40) {
+      if (!running) {
+        sl_sleeptimer_start_timer(&timers[index], timeout, on_timeout, NULL,
+                                  (uint8_t)(random_u32() % 4), 0);
+      }
+    } else if (op < 50) {
+      if (!running) {
+        sl_sleeptimer_start_periodic_timer(&timers[index], timeout % 5000 + 500,
+                                           on_timeout, NULL,
+                                           (uint8_t)(random_u32() % 4), 0);
+      }
+    } else if (op < 75) {
+      sl_sleeptimer_stop_timer(&timers[index]);
+    } else if (op < 80) {
+      status = sl_sleeptimer_get_timer_time_remaining(&timers[index], &remaining);
+      flush_fired();
+      printf("R %d %u %u\n", index, (unsigned)status, (status == SL_STATUS_OK) ? remaining : 0);
+    } else if (op < 82) {
+      status = sl_sleeptimer_get_remaining_time_of_first_timer((op & 1) ? 0 : SL_SLEEPTIMER_ANY_FLAG,
+                                                               &remaining);
+      flush_fired();
+      printf("Q %u %u\n", (unsigned)status, remaining);
+    } else {
+      advance(random_u32() % ((op < 99) ? 3000 : 2000000));
+    }
+  }
+  flush_fired();
+}
+
+// The power manager must wake up for the compare match, not for the first
+// timer the compare match was delayed past.
+static void check_first_wakeup(void)
+{
+  uint32_t remaining;
+
+  if (compare_enabled && !compare_pending
+      && (sli_sleeptimer_get_remaining_time_of_first_wakeup(SL_SLEEPTIMER_ANY_FLAG, &remaining) == SL_STATUS_OK)
+      && (remaining != compare - counter)) {
+    wakeup_mismatches++;
+    printf("first wakeup in %u ticks, compare match in %u\n", remaining, compare - counter);
+  }
+}
+
+static int run_slack(void)
+{
+  sl_sleeptimer_wakeup_stats_t stats;
+
+  sl_sleeptimer_reset_wakeup_stats();
+  for (int i = 0; i < SLACK_OPERATIONS; i++) {
+    int index = (int)(random_u32() % SLACK_TIMERS);
+    uint32_t op = random_u32() % 100;
+    bool running;
+
+    sl_sleeptimer_is_timer_running(&timers[index], &running);
+    if (op < 50) {
+      if (!running) {
+        uint32_t timeout = random_u32() % 70000;
+        uint32_t slack = (index % 3 == 0) ? 0 : random_u32() % 4000;
+        uint16_t flags = sl_sleeptimer_slack_to_option_flags(slack);
+
+        // The slack is rounded down to 2^n - 1 ticks
+        slack_allowed[index] = (1u << ((flags & SL_SLEEPTIMER_SLACK_MASK) >> SL_SLEEPTIMER_SLACK_SHIFT)) - 1u;
+        slack_expiry[index] = counter + timeout;
+        slack_check[index] = true;
+        sl_sleeptimer_start_timer(&timers[index], timeout, on_timeout, NULL,
+                                  (uint8_t)(random_u32() % 4), flags);
+      }
+    } else if (op < 60) {
+      sl_sleeptimer_stop_timer(&timers[index]);
+      slack_check[index] = false;
+    } else {
+      advance(random_u32() % 3000);
+    }
+    check_first_wakeup();
+  }
+
+  sl_sleeptimer_get_wakeup_stats(&stats);
+  printf("fired %lu, late %lu, wakeup mismatches %lu, wakeups %lu, expirations %lu, wakeups avoided %lu\n",
+         fired, slack_late, wakeup_mismatches,
+         (unsigned long)stats.wakeups,
+         (unsigned long)stats.expirations,
+         (unsigned long)stats.wakeups_avoided);
+  return ((slack_late == 0) && (wakeup_mismatches == 0)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static void run_bench(void)
+{
+  static const int counts[] = { 10, 50, 100, 250, 500 };
+
+  printf("%6s %12s %12s %12s %14s\n", "timers", "start ns", "stop ns", "expire ns", "max crit ns");
+  for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+    int n = counts[c];
+    uint64_t start_ns = 0;
+    uint64_t stop_ns = 0;
+    uint64_t expire_ns = 0;
+
+    critical_max = 0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+      uint64_t t0 = now_ns();
+      uint64_t t1;
+      uint64_t t2;
+
+      for (int i = 0; i < n; i++) {
+        sl_sleeptimer_start_timer(&timers[i], 1000 + random_u32() % 327680, on_timeout, NULL, 0, 0);
+      }
+      t1 = now_ns();
+      for (int i = 0; i < n; i += 2) {
+        sl_sleeptimer_stop_timer(&timers[i]);
+      }
+      t2 = now_ns();
+      advance(400000);
+      start_ns += t1 - t0;
+      stop_ns += t2 - t1;
+      expire_ns += now_ns() - t2;
+    }
+    printf("%6d %12.1f %12.1f %12.1f %14llu\n", n,
+           (double)start_ns / BENCH_ROUNDS / n,
+           (double)stop_ns / BENCH_ROUNDS / (n / 2),
+           (double)expire_ns / BENCH_ROUNDS / (n - n / 2),
+           (unsigned long long)critical_max);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  sl_sleeptimer_init();
+
+  if ((argc > 1) && (strcmp(argv[1], "trace") == 0)) {
+    run_trace();
+    return EXIT_SUCCESS;
+  }
+  if ((argc > 1) && (strcmp(argv[1], "slack") == 0)) {
+    return run_slack();
+  }
+  run_bench();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,17 @@
+// Host stand-in for the core header. Critical sections are timed, the
+// longest one is reported by the benchmark.
+#ifndef EM_CORE_GENERIC_H
+#define EM_CORE_GENERIC_H
+
+#include <stdint.h>
+
+uint64_t bench_critical_enter(void);
+void bench_critical_exit(uint64_t state);
+
+#define CORE_DECLARE_IRQ_STATE  uint64_t irqState
+#define CORE_ENTER_ATOMIC()     irqState = bench_critical_enter()
+#define CORE_EXIT_ATOMIC()      bench_critical_exit(irqState)
+#define CORE_ENTER_CRITICAL()   CORE_ENTER_ATOMIC()
+#define CORE_EXIT_CRITICAL()    CORE_EXIT_ATOMIC()
+
+#endif // EM_CORE_GENERIC_H
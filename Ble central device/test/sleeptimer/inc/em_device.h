@@ -0,0 +1,22 @@
+// Host stand-in for the device header, only what sleeptimer uses.
+#ifndef EM_DEVICE_H
+#define EM_DEVICE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define __STATIC_INLINE static inline
+#define __WEAK __attribute__((weak))
+#define __CLZ(x) ((uint32_t)((x) == 0u ? 32 : __builtin_clz(x)))
+
+static inline uint32_t __RBIT(uint32_t value)
+{
+  uint32_t result = 0u;
+
+  for (uint32_t i = 0u; i < 32u; i++) {
+    result = (result << 1) | ((value >> i) & 1u);
+  }
+  return result;
+}
+
+#endif // EM_DEVICE_H
@@ -0,0 +1,7 @@
+// Host stand-in, the benchmark is single threaded.
+#ifndef SL_ATOMIC_H
+#define SL_ATOMIC_H
+
+#define sl_atomic_load(dest, src)   ((dest) = (src))
+
+#endif // SL_ATOMIC_H
@@ -0,0 +1,18 @@
+// Host configuration of sleeptimer. The queue and the wheel geometry are
+// chosen on the compiler command line, see the Makefile.
+#ifndef SL_SLEEPTIMER_CONFIG_H
+#define SL_SLEEPTIMER_CONFIG_H
+
+#define SL_SLEEPTIMER_PERIPHERAL_DEFAULT      0
+#define SL_SLEEPTIMER_PERIPHERAL_SYSRTC       4
+#define SL_SLEEPTIMER_PERIPHERAL              SL_SLEEPTIMER_PERIPHERAL_DEFAULT
+#define SL_SLEEPTIMER_WALLCLOCK_CONFIG        0
+#define SL_SLEEPTIMER_FREQ_DIVIDER            1
+
+#define SL_SLEEPTIMER_TIMER_QUEUE_DELTA_LIST  0
+#define SL_SLEEPTIMER_TIMER_QUEUE_WHEEL       1
+#ifndef SL_SLEEPTIMER_TIMER_QUEUE
+#define SL_SLEEPTIMER_TIMER_QUEUE             SL_SLEEPTIMER_TIMER_QUEUE_DELTA_LIST
+#endif
+
+#endif // SL_SLEEPTIMER_CONFIG_H
@@ -0,0 +1,196 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host benchmark of the PSA key slots with many persistent keys.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+// Runs the PSA key slot management alone, the key storage is a stand-in
+// that counts the loads, each one is an ITS read on target.
+//
+//   bench          Two slots are held by volatile keys, the others serve
+//                  look-ups of persistent keys where 90% of the look-ups go
+//                  to 12 keys. Every look-up must return the slot of its
+//                  key. Prints the time per look-up, the storage loads and
+//                  the slot statistics for several numbers of keys, then
+//                  checks purge, reload and missing keys.
+
+#define MBEDTLS_ALLOW_PRIVATE_ACCESS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "psa/crypto.h"
+#include "psa_crypto_core.h"
+#include "psa_crypto_slot_management.h"
+
+#define VOLATILE_KEYS   2
+#define HOT_KEYS        12
+#define LOOKUPS         2000000
+#define MISSING_KEY_ID  200000
+
+static unsigned long storage_loads;
+static uint8_t key_data[16];
+
+// Key storage and slot stand-ins
+
+psa_status_t psa_load_persistent_key(psa_core_key_attributes_t *attr,
+                                     uint8_t **data,
+                                     size_t *data_length)
+{
+  storage_loads++;
+  if (MBEDTLS_SVC_KEY_ID_GET_KEY_ID(attr->id) >= MISSING_KEY_ID) {
+    return PSA_ERROR_DOES_NOT_EXIST;
+  }
+  attr->type = PSA_KEY_TYPE_AES;
+  attr->bits = 128;
+  attr->lifetime = PSA_KEY_LIFETIME_PERSISTENT;
+  *data = key_data;
+  *data_length = sizeof(key_data);
+  return PSA_SUCCESS;
+}
+
+void psa_free_persistent_key_data(uint8_t *key_data, size_t key_data_length)
+{
+  (void)key_data;
+  (void)key_data_length;
+}
+
+psa_status_t psa_copy_key_material_into_slot(psa_key_slot_t *slot,
+                                             const uint8_t *data,
+                                             size_t data_length)
+{
+  (void)data;
+  slot->key.bytes = data_length;
+  return PSA_SUCCESS;
+}
+
+psa_status_t psa_wipe_key_slot(psa_key_slot_t *slot)
+{
+  psa_key_slot_index_remove(slot);
+  memset(slot, 0, sizeof(*slot));
+  return PSA_SUCCESS;
+}
+
+psa_status_t psa_finish_key_destruction(psa_key_slot_t *slot)
+{
+  return psa_wipe_key_slot(slot);
+}
+
+// Benchmark
+
+static double now_s(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static mbedtls_svc_key_id_t key_id_of(int i)
+{
+  return mbedtls_svc_key_id_make(0, (psa_key_id_t)(100 + i * 37));
+}
+
+static unsigned long run(int key_count)
+{
+  unsigned long errors = 0;
+  mbedtls_psa_stats_t before;
+  mbedtls_psa_stats_t after;
+  double start;
+
+  psa_wipe_all_key_slots();
+  psa_initialize_key_slots();
+  for (int i = 0; i < VOLATILE_KEYS; i++) {
+    psa_key_id_t volatile_id;
+    psa_key_slot_t *slot;
+
+    if (psa_get_empty_key_slot(&volatile_id, &slot) != PSA_SUCCESS) {
+      return 1;
+    }
+    slot->attr.id = mbedtls_svc_key_id_make(0, volatile_id);
+    psa_slot_change_state(slot, PSA_STATE_UNUSED);
+  }
+
+  // The slot statistics are cumulative
+  mbedtls_psa_get_stats(&before);
+  storage_loads = 0;
+  srand(1);
+  start = now_s();
+  for (int n = 0; n < LOOKUPS; n++) {
+    int i = (rand() % 10 < 9) ? rand() % HOT_KEYS : rand() % key_count;
+    mbedtls_svc_key_id_t id = key_id_of(i);
+    psa_key_slot_t *slot;
+
+    if (psa_get_and_lock_key_slot(id, &slot, PSA_INTENT_READ) != PSA_SUCCESS) {
+      errors++;
+      continue;
+    }
+    if (!mbedtls_svc_key_id_equal(id, slot->attr.id)) {
+      errors++;
+    }
+    psa_unlock_key_slot(slot);
+  }
+
+  mbedtls_psa_get_stats(&after);
+  printf("%6d %12.1f %14lu %12zu %12zu %12zu\n",
+         key_count,
+         (now_s() - start) * 1e9 / LOOKUPS,
+         storage_loads,
+         after.persistent_key_hits - before.persistent_key_hits,
+         after.persistent_key_loads - before.persistent_key_loads,
+         after.persistent_key_evictions - before.persistent_key_evictions);
+  return errors;
+}
+
+static unsigned long check_purge(void)
+{
+  unsigned long errors = 0;
+  psa_key_slot_t *slot;
+
+  // Purge only applies to a key held in a slot
+  if (psa_get_and_lock_key_slot(key_id_of(1), &slot, PSA_INTENT_READ) != PSA_SUCCESS) {
+    errors++;
+  } else {
+    psa_unlock_key_slot(slot);
+  }
+  if (psa_purge_key(key_id_of(1)) != PSA_SUCCESS) {
+    errors++;
+  }
+  if (psa_get_and_lock_key_slot(key_id_of(1), &slot, PSA_INTENT_READ) != PSA_SUCCESS) {
+    errors++;
+  } else {
+    psa_unlock_key_slot(slot);
+  }
+  // A key missing from the storage is reported as an invalid handle
+  if (psa_get_and_lock_key_slot(mbedtls_svc_key_id_make(0, MISSING_KEY_ID), &slot, PSA_INTENT_READ)
+      != PSA_ERROR_INVALID_HANDLE) {
+    errors++;
+  }
+  return errors;
+}
+
+int main(void)
+{
+  static const int key_counts[] = { 16, 64, 256 };
+  unsigned long errors = 0;
+
+  printf("%d key slots\n", MBEDTLS_PSA_KEY_SLOT_COUNT);
+  printf("%6s %12s %14s %12s %12s %12s\n",
+         "keys", "lookup ns", "storage loads", "hits", "loads", "evictions");
+  for (size_t i = 0; i < sizeof(key_counts) / sizeof(key_counts[0]); i++) {
+    errors += run(key_counts[i]);
+  }
+  errors += check_purge();
+
+  if (errors != 0) {
+    printf("FAIL: %lu look-ups returned another key or status\n", errors);
+    return 1;
+  }
+  return 0;
+}
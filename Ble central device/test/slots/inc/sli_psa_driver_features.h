@@ -0,0 +1 @@
+// Host stand-in, no driver of the device is built.
@@ -32,6 +32,14 @@
 #include "sl_bluetooth.h"
 #include "app.h"
 #include "gatt_db.h"
+#include "sli_cryptoacc_driver_trng.h"
+#include "sli_cryptoacc_transparent_functions.h"
+#include "secure_payload.h"
+#include "fast_boot.h"
+#include "buffer_pool.h"
+#include "sl_power_manager_config.h"
+#include "sl_power_manager_profile.h"
+#include "sl_sleeptimer.h"
 
 // The advertising set handle allocated from Bluetooth stack.
 static uint8_t advertising_set_handle = 0xff;
@@ -39,6 +47,18 @@ bd_addr address;                           // Bluetooth device address
 uint8_t address_type;                      // Address type
 uint8_t handle;                            // Connection handle
 
+// Seals the values read by the central
+static secure_payload_context_t payload_context;
+
+static sl_status_t send_sealed_read_response(uint8_t connection,
+                                             uint16_t attribute,
+                                             uint16_t uuid,
+                                             uint8_t value);
+
+#if SL_POWER_MANAGER_PROFILE
+static void print_power_manager_profile(void);
+#endif
+
 uint8_t adv_data[] = {
     0x02, 0x01, 0x06,
     0x08, 0x08, 'S', 'e', 'r', 'v', 'e', 'r', '3',
@@ -65,6 +85,26 @@ SL_WEAK void app_process_action(void)
   // This is called infinitely.                                              //
   // Do not call blocking functions from here!                               //
   /////////////////////////////////////////////////////////////////////////////
+  fast_boot_process_action();
+  sli_cryptoacc_trng_pool_process_action();
+  sli_cryptoacc_ecc_keypair_cache_process_action();
+}
+
+/**************************************************************************//**
+ * Power manager hook, refills the random pool and the keypair cache when the
+ * system is idle, and keeps the system awake until the boot completes.
+ *****************************************************************************/
+bool app_is_ok_to_sleep(void)
+{
+  bool ok_to_sleep = sli_cryptoacc_trng_pool_is_ok_to_sleep();
+
+  if (sli_cryptoacc_ecc_keypair_cache_is_ok_to_sleep() == false) {
+    ok_to_sleep = false;
+  }
+  if (fast_boot_is_ok_to_sleep() == false) {
+    ok_to_sleep = false;
+  }
+  return ok_to_sleep;
 }
 
 /**************************************************************************//**
@@ -81,7 +121,25 @@ void sl_bt_on_event(sl_bt_msg_t *evt)
     // -------------------------------
     // This event indicates the device has started and the radio is ready.
     // Do not call any stack command before receiving this boot event!
-    case sl_bt_evt_system_boot_id:
+    case sl_bt_evt_system_boot_id: {
+      // The values are sealed under the identity address of the server
+      uint8_t payload_id[SECURE_PAYLOAD_ID_SIZE] = { 0 };
+      bd_addr identity;
+      uint8_t identity_type;
+
+      sc = sl_bt_system_get_identity_address(&identity, &identity_type);
+      app_assert_status(sc);
+      memcpy(payload_id, identity.addr, sizeof(identity.addr));
+      payload_id[sizeof(identity.addr)] = APP_SECURE_PAYLOAD_TO_CENTRAL;
+      sc = secure_payload_init(&payload_context, APP_NVM3_KEY_SECURE_PAYLOAD_KEY,
+                               payload_id, true, APP_NVM3_KEY_SECURE_PAYLOAD);
+      if (sc == SL_STATUS_NOT_INITIALIZED) {
+        // The reads of the values are then answered with an error
+        app_log_warning("No payload key provisioned, values are not sent\n");
+      } else {
+        app_assert_status(sc);
+      }
+
       // Create an advertising set.
       sc = sl_bt_advertiser_create_set(&advertising_set_handle);
       app_assert_status(sc);
@@ -107,6 +165,7 @@ void sl_bt_on_event(sl_bt_msg_t *evt)
       app_log("Start advertising\n");
       app_assert_status(sc);
       break;
+    }
 
     // -------------------------------
     // This event indicates that a new connection was opened.
@@ -129,6 +188,9 @@ void sl_bt_on_event(sl_bt_msg_t *evt)
       uint8_t connection = evt->data.evt_connection_closed.connection;
       // Generate data for advertising
       app_log( "Device has connection %d disconnected\n", connection);
+#if SL_POWER_MANAGER_PROFILE
+      print_power_manager_profile();
+#endif
 
       sc = sl_bt_legacy_advertiser_set_data(advertising_set_handle,
                                             0,
@@ -148,31 +210,27 @@ void sl_bt_on_event(sl_bt_msg_t *evt)
     case sl_bt_evt_gatt_server_user_read_request_id: {
       uint16_t attribute = evt->data.evt_gatt_server_user_read_request.characteristic;
       uint8_t connection = evt->data.evt_gatt_server_user_read_request.connection;
-      uint16_t sent_len = 0;
 
       if (attribute == gattdb_led_control) {
         uint8_t data = 1;
-        uint16_t sent_len = 0;
-
-        sc = sl_bt_gatt_server_send_user_read_response(connection,
-                                                       attribute,
-                                                       0,
-                                                       1,
-                                                       &data,
-                                                       &sent_len);
-        app_assert_status(sc);
-        app_log("Data LED send %d\n", data);
+
+        sc = send_sealed_read_response(connection, attribute, LED_CONTROL_UUID, data);
+        if (sc == SL_STATUS_NOT_INITIALIZED) {
+          app_log_warning("Data LED not sent, no payload key\n");
+        } else {
+          app_assert_status(sc);
+          app_log("Data LED send %d\n", data);
+        }
       }
       else if (attribute == gattdb_fan_control) {
         uint8_t data = 2;
-        sc = sl_bt_gatt_server_send_user_read_response(connection,
-                                                       attribute,
-                                                       0,
-                                                       1,
-                                                       &data,
-                                                       &sent_len);
-        app_assert_status(sc);
-        app_log("Data FAN send %d\n", data);
+        sc = send_sealed_read_response(connection, attribute, FAN_CONTROL_UUID, data);
+        if (sc == SL_STATUS_NOT_INITIALIZED) {
+          app_log_warning("Data FAN not sent, no payload key\n");
+        } else {
+          app_assert_status(sc);
+          app_log("Data FAN send %d\n", data);
+        }
       }
       else {
         app_log("Unknown characteristic read request\n");
@@ -186,4 +244,95 @@ void sl_bt_on_event(sl_bt_msg_t *evt)
     default:
       break;
   }
+
+  // Once the application has handled the event
+  fast_boot_on_event(evt);
+  buffer_pool_on_event(evt);
+}
+
+/**************************************************************************//**
+ * Answer a read with a value sealed in place in the response buffer.
+ *
+ * @param[in] connection  Connection handle.
+ * @param[in] attribute   Attribute read.
+ * @param[in] uuid        UUID of the characteristic, authenticated with the
+ *                        value so that values cannot be swapped.
+ * @param[in] value       Value.
+ *
+ * @return Status of the seal or of the response. A read that cannot be
+ *         sealed is answered with an ATT error.
+ *****************************************************************************/
+static sl_status_t send_sealed_read_response(uint8_t connection,
+                                             uint16_t attribute,
+                                             uint16_t uuid,
+                                             uint8_t value)
+{
+  uint8_t packet[SECURE_PAYLOAD_OVERHEAD + sizeof(value)];
+  const uint8_t ad[] = { (uint8_t)uuid, (uint8_t)(uuid >> 8) };
+  size_t packet_len;
+  uint16_t sent_len;
+  sl_status_t sc;
+
+  packet[SECURE_PAYLOAD_HEADER_SIZE] = value;
+  sc = secure_payload_seal(&payload_context, ad, sizeof(ad), packet, sizeof(value),
+                           sizeof(packet), &packet_len);
+  if (sc != SL_STATUS_OK) {
+    // Do not leave the read pending
+    sl_bt_gatt_server_send_user_read_response(connection,
+                                              attribute,
+                                              APP_ATT_ERRCODE_UNLIKELY,
+                                              0,
+                                              NULL,
+                                              &sent_len);
+    return sc;
+  }
+  return sl_bt_gatt_server_send_user_read_response(connection,
+                                                   attribute,
+                                                   0,
+                                                   packet_len,
+                                                   packet,
+                                                   &sent_len);
+}
+
+#if SL_POWER_MANAGER_PROFILE
+/**************************************************************************//**
+ * Print the energy mode profile accumulated since the boot.
+ *****************************************************************************/
+static void print_power_manager_profile(void)
+{
+  static const char *source_names[SL_POWER_MANAGER_WAKEUP_SOURCE_COUNT] = {
+    "Sleeptimer", "Radio", "UART", "Other"
+  };
+  sl_power_manager_profile_t profile;
+  uint64_t ms;
+  uint32_t permille;
+
+  sl_power_manager_profile_get(&profile);
+
+  sl_sleeptimer_tick64_to_ms(profile.duration_tick, &ms);
+  app_log("Energy mode profile over %lu ms\n", (unsigned long)ms);
+  for (uint32_t i = 0; i < SL_POWER_MANAGER_PROFILE_EM_COUNT; i++) {
+    sl_sleeptimer_tick64_to_ms(profile.residency_tick[i], &ms);
+    permille = (profile.duration_tick != 0)
+               ? (uint32_t)((profile.residency_tick[i] * 1000u) / profile.duration_tick) : 0;
+    app_log("  EM%lu: %10lu ms %3lu.%lu%% %8lu entries\n",
+            (unsigned long)i,
+            (unsigned long)ms,
+            (unsigned long)(permille / 10),
+            (unsigned long)(permille % 10),
+            (unsigned long)profile.transition_count[i]);
+  }
+  app_log("Wakeups by source\n");
+  for (uint32_t i = 0; i < SL_POWER_MANAGER_WAKEUP_SOURCE_COUNT; i++) {
+    app_log("  %-10s %8lu\n", source_names[i], (unsigned long)profile.wakeup_count[i]);
+  }
+  app_log("Active time from wakeup to sleep, in ticks\n");
+  for (uint32_t i = 0; i < SL_POWER_MANAGER_PROFILE_ACTIVE_TIME_BINS; i++) {
+    if (profile.active_time_histogram[i] != 0) {
+      app_log("  >= %-8lu %8lu\n",
+              (unsigned long)(i == 0 ? 0 : (1ul << i)),
+              (unsigned long)profile.active_time_histogram[i]);
+    }
+  }
 }
+#endif
@@ -31,6 +31,19 @@
 #ifndef APP_H
 #define APP_H
 
+#define LED_CONTROL_UUID              0xff01
+#define FAN_CONTROL_UUID              0xff02
+
+// NVM3 key of the payload counter, in the application key range
+#define APP_NVM3_KEY_SECURE_PAYLOAD   0x00002
+// NVM3 key of the key of the application payloads exchanged between the
+// central and its servers, provisioned per product, see secure_payload.h
+#define APP_NVM3_KEY_SECURE_PAYLOAD_KEY 0x00003
+// Direction byte of the payload id, after the sender address
+#define APP_SECURE_PAYLOAD_TO_CENTRAL 0x01
+// ATT error answered to reads that cannot be sealed, Unlikely Error
+#define APP_ATT_ERRCODE_UNLIKELY      0x0e
+
 /**************************************************************************//**
  * Application Init.
  *****************************************************************************/
@@ -0,0 +1,21 @@
+/***************************************************************************//**
+ * @file
+ * @brief Bluetooth stack features left out of sl_bt_stack_init.c
+ *******************************************************************************
+ * Generated by bt_feature_trim.py from the sl_bt_* commands and events the
+ * project compiles in, run it again after using a new class of the API or
+ * changing a build option. Included by sl_bt_stack_init.c when
+ * SL_BT_CONFIG_FEATURE_TRIM is set.
+ ******************************************************************************/
+
+#ifndef SL_BT_FEATURE_TRIM_H
+#define SL_BT_FEATURE_TRIM_H
+
+// scanner: no sl_bt_scanner_* command or event nor of the classes using it, about 9856 bytes of flash and 220 of RAM
+#undef SL_CATALOG_BLUETOOTH_FEATURE_SCANNER_PRESENT
+// legacy_scanner: scanner left out
+#undef SL_CATALOG_BLUETOOTH_FEATURE_LEGACY_SCANNER_PRESENT
+// gatt: no sl_bt_gatt_* command or event, about 4552 bytes of flash and 0 of RAM
+#undef SL_CATALOG_BLUETOOTH_FEATURE_GATT_PRESENT
+
+#endif // SL_BT_FEATURE_TRIM_H
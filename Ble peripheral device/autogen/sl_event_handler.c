@@ -30,54 +30,59 @@
 #include "sl_iostream_init_instances.h"
 #include "sl_power_manager.h"
 #include "sl_cos.h"
+#include "fast_boot.h"
 
 void sl_platform_init(void)
 {
-  CHIP_Init();
-  sl_device_init_nvic();
-  sl_board_preinit();
-  sl_device_init_dcdc();
-  sl_device_init_lfxo();
-  sl_device_init_hfxo();
-  sl_device_init_lfrco();
-  sl_device_init_clocks();
-  sl_device_init_emu();
-  sl_board_init();
-  bootloader_init();
-  nvm3_initDefault();
-  sl_power_manager_init();
+  FAST_BOOT_START();
+  FAST_BOOT_STEP(CHIP_Init);
+  FAST_BOOT_STEP(sl_device_init_nvic);
+  FAST_BOOT_STEP(sl_board_preinit);
+  FAST_BOOT_STEP(sl_device_init_dcdc);
+  FAST_BOOT_STEP(sl_device_init_lfxo);
+  FAST_BOOT_STEP(sl_device_init_hfxo);
+  FAST_BOOT_STEP(sl_device_init_lfrco);
+  FAST_BOOT_STEP(sl_device_init_clocks);
+  FAST_BOOT_STEP(sl_device_init_emu);
+  FAST_BOOT_STEP(sl_board_init);
+  FAST_BOOT_STEP(bootloader_init);
+  FAST_BOOT_STEP(nvm3_initDefault);
+  FAST_BOOT_STEP(sl_power_manager_init);
 }
 
 void sl_driver_init(void)
 {
-  sl_debug_swo_init();
-  sl_cos_send_config();
+  FAST_BOOT_STEP(sl_debug_swo_init);
+  FAST_BOOT_STEP(sl_cos_send_config);
 }
 
 void sl_service_init(void)
 {
-  sl_board_configure_vcom();
-  sl_sleeptimer_init();
-  sl_iostream_stdlib_disable_buffering();
-  sl_mbedtls_init();
-  sl_mpu_disable_execute_from_ram();
-  psa_crypto_init();
-  sli_aes_seed_mask();
-  sl_iostream_init_instances();
+  FAST_BOOT_STEP(sl_board_configure_vcom);
+  FAST_BOOT_STEP(sl_sleeptimer_init);
+  FAST_BOOT_STEP(sl_iostream_stdlib_disable_buffering);
+  FAST_BOOT_STEP(sl_mbedtls_init);
+  FAST_BOOT_STEP(sl_mpu_disable_execute_from_ram);
+#if !defined(MBEDTLS_PSA_CRYPTO_LAZY_INIT)
+  // Otherwise run from fast_boot_process_action() once the stack has booted
+  FAST_BOOT_STEP(psa_crypto_init);
+  FAST_BOOT_STEP(sli_aes_seed_mask);
+#endif
+  FAST_BOOT_STEP(sl_iostream_init_instances);
 }
 
 void sl_stack_init(void)
 {
-  sl_fem_util_init();
-  sl_rail_util_pa_init();
-  sl_rail_util_power_manager_init();
-  sl_rail_util_pti_init();
-  sl_bt_init();
+  FAST_BOOT_STEP(sl_fem_util_init);
+  FAST_BOOT_STEP(sl_rail_util_pa_init);
+  FAST_BOOT_STEP(sl_rail_util_power_manager_init);
+  FAST_BOOT_STEP(sl_rail_util_pti_init);
+  FAST_BOOT_STEP(sl_bt_init);
 }
 
 void sl_internal_app_init(void)
 {
-  app_log_init();
+  FAST_BOOT_STEP(app_log_init);
 }
 
 void sl_platform_process_action(void)
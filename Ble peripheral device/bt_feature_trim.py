@@ -0,0 +1,473 @@
+#!/usr/bin/env python3
+"""Leave the Bluetooth stack features the application does not use out of the image.
+
+sl_bt_stack_init.c registers a stack feature and a BGAPI class for every
+Bluetooth component of the project, whether or not the application calls
+them. This script scans the project sources for sl_bt_* commands and
+sl_bt_evt_* events, and writes autogen/sl_bt_feature_trim.h, which undefines
+the SL_CATALOG_*_PRESENT macros of the features nothing uses. With
+SL_BT_CONFIG_FEATURE_TRIM set in sl_bluetooth_config.h, sl_bt_stack_init.c
+includes it before deciding its feature and class tables, so the linker no
+longer pulls those features out of the stack libraries.
+
+A feature is kept if the project calls a command or handles an event of its
+class: the peer can cause events that no local command enabled. Code behind
+an #if that is false for the project is not scanned, the conditions known
+are the components of the catalog and the numeric macros of the project
+headers. Handlers of a class the project does not use can be compiled out
+that way.
+
+Scanned: the *.c and *.h files of the project root, autogen/*.c, and the SDK
+sources compiled by the build (from the subdir.mk files of the build
+directory). Commands sent from a host over NCP are not seen, do not trim such
+a project.
+
+The flash and RAM of each feature are estimated from the link map of a build
+without trimming: the archive members its symbols pulled into the image, and
+the members those pulled in turn. Members also needed by a kept feature may
+be counted, members pulled first by a kept feature are not.
+
+Example:
+    python3 bt_feature_trim.py            # write the header, print the report
+    python3 bt_feature_trim.py --check    # fail if the header is out of date
+"""
+import argparse
+import glob
+import os
+import re
+import sys
+
+HEADER = os.path.join("autogen", "sl_bt_feature_trim.h")
+CATALOG = os.path.join("autogen", "sl_component_catalog.h")
+STACK_INIT = "sl_bt_stack_init.c"
+
+# BGAPI classes, as declared in sl_bt_stack_init.c
+CLASSES = [
+    "system", "nvm", "ota", "gap", "sm", "external_bondingdb", "accept_list",
+    "resolving_list", "advertiser", "legacy_advertiser", "extended_advertiser",
+    "periodic_advertiser", "scanner", "sync", "pawr_advertiser", "sync_scanner",
+    "periodic_sync", "pawr_sync", "past_receiver", "advertiser_past", "sync_past",
+    "cs", "cs_test", "l2cap", "connection", "gatt", "gattdb", "gatt_server",
+    "cte_receiver", "cte_transmitter", "test", "coex", "resource",
+    "connection_analyzer",
+]
+
+ADVERTISER_CLASSES = ["advertiser", "legacy_advertiser", "extended_advertiser",
+                      "periodic_advertiser", "pawr_advertiser", "advertiser_past"]
+SYNC_CLASSES = ["sync", "sync_scanner", "periodic_sync", "pawr_sync",
+                "past_receiver", "sync_past"]
+
+# Features that can be left out. Each one is kept if any of its classes is
+# used, and names its catalog components and what it links in: stack
+# features, BGAPI classes and controller init functions. System, connection,
+# GATT server, SM and the bonding databases are always kept.
+#   (name, components, classes, features, bgapi, controller)
+FEATURES = [
+    ("advertiser", ["ADVERTISER"], ADVERTISER_CLASSES,
+     ["advertiser", "advertiser_compatibility"], ["advertiser"], ["adv"]),
+    ("legacy_advertiser", ["LEGACY_ADVERTISER"], ["legacy_advertiser"],
+     [], ["legacy_advertiser"], []),
+    ("extended_advertiser", ["EXTENDED_ADVERTISER"],
+     ["extended_advertiser", "periodic_advertiser", "pawr_advertiser"],
+     ["extended_advertiser"], ["extended_advertiser"], ["adv_ext"]),
+    ("periodic_advertiser", ["PERIODIC_ADVERTISER"],
+     ["periodic_advertiser", "pawr_advertiser", "advertiser_past"],
+     ["periodic_advertiser", "periodic_adv"], ["periodic_advertiser"],
+     ["periodic_adv", "alloc_periodic_adv"]),
+    ("pawr_advertiser", ["PAWR_ADVERTISER"], ["pawr_advertiser"],
+     [], ["pawr_advertiser"], []),
+    ("scanner", ["SCANNER"], ["scanner"] + SYNC_CLASSES,
+     ["scanner", "scanner_compatibility", "scanner_base"], ["scanner"], ["scan"]),
+    # Kept or left out along with the scanner, see trim()
+    ("legacy_scanner", ["LEGACY_SCANNER"], None, [], [], []),
+    ("extended_scanner", ["EXTENDED_SCANNER"], None,
+     ["extended_scanner"], [], ["scan_ext"]),
+    ("sync", ["SYNC"], SYNC_CLASSES,
+     ["sync", "sync_compatibility"], ["sync"], ["periodic_scan", "alloc_periodic_scan"]),
+    ("sync_scanner", ["SYNC_SCANNER"], ["sync_scanner"],
+     ["sync_scanner"], ["sync_scanner"], []),
+    ("periodic_sync", ["PERIODIC_SYNC"], ["periodic_sync"], [], ["periodic_sync"], []),
+    ("pawr_sync", ["PAWR_SYNC"], ["pawr_sync"], [], ["pawr_sync"], []),
+    ("past_receiver", ["PAST_RECEIVER"], ["past_receiver"], [], ["past_receiver"], []),
+    ("advertiser_past", ["ADVERTISER_PAST"], ["advertiser_past"], [], ["advertiser_past"], []),
+    ("sync_past", ["SYNC_PAST"], ["sync_past"], [], ["sync_past"], []),
+    ("gatt", ["GATT"], ["gatt"], ["gatt"], ["gatt"], []),
+    ("dynamic_gattdb", ["DYNAMIC_GATTDB"], ["gattdb"], ["dynamic_gattdb"], ["gattdb"], []),
+    ("l2cap", ["L2CAP"], ["l2cap"], ["l2cap"], ["l2cap"], []),
+    ("accept_list", ["ACCEPT_LIST"], ["accept_list"], ["accept_list"], ["accept_list"], []),
+    ("cs", ["CS"], ["cs", "cs_test"], ["cs"], ["cs"], []),
+    ("cs_test", ["CS_TEST"], ["cs_test"], ["cs_test"], ["cs_test"], []),
+    ("cte_receiver", ["AOA_RECEIVER", "AOD_RECEIVER"], ["cte_receiver"],
+     ["cte_receiver"], ["cte_receiver"], []),
+    ("cte_transmitter", ["AOA_TRANSMITTER", "AOD_TRANSMITTER"], ["cte_transmitter"],
+     ["cte_transmitter"], ["cte_transmitter"], []),
+    ("test", ["TEST"], ["test"], ["test"], ["test"], []),
+    ("connection_analyzer", ["CONNECTION_ANALYZER"], ["connection_analyzer"],
+     [], ["connection_analyzer"], []),
+    ("resource_report", ["RESOURCE_REPORT"], ["resource"], [], ["resource"], []),
+    ("nvm", ["NVM"], ["nvm"], [], ["nvm"], []),
+    ("ota_config", ["OTA_CONFIG"], ["ota"], [], ["ota"], []),
+    ("gap", ["GAP"], ["gap"], [], ["gap"], []),
+]
+
+# Commands that need a feature outside their own class
+COMMAND_NEEDS = {
+    "sl_bt_connection_open": "scanner",  # Initiating scans for the peer
+}
+
+LEGACY_REPORT = "sl_bt_evt_scanner_legacy_advertisement_report"
+EXTENDED_REPORT = "sl_bt_evt_scanner_extended_advertisement_report"
+COMPATIBILITY_REPORT = "sl_bt_evt_scanner_scan_report"
+
+COMMENTS = re.compile(r"/\*.*?\*/|//[^\n]*", re.S)
+COMMAND = re.compile(r"\b(sl_bt_(?!evt_)[a-z0-9_]+)\s*\(")
+EVENT = re.compile(r"\b(sl_bt_evt_[a-z0-9_]+?)_id\b")
+DEFINE = re.compile(r"^\s*#define\s+(SL_CATALOG_\w+_PRESENT)\b", re.M)
+NUMERIC = re.compile(r"^\s*#\s*define\s+(\w+)\s+\(?\s*(\d+)[uUlL]*\s*\)?\s*$", re.M)
+DIRECTIVE = re.compile(r"^\s*#\s*(if|ifdef|ifndef|elif|else|endif)\b(.*)$")
+CONDITION = re.compile(r"^(!?)\s*(?:defined\s*\(\s*(\w+)\s*\)|defined\s+(\w+)|(\w+))$")
+
+
+def component(name):
+    return "SL_CATALOG_BLUETOOTH_FEATURE_%s_PRESENT" % name
+
+
+def class_of(name, prefix):
+    """BGAPI class of a command or event, longest match first."""
+    rest = name[len(prefix):]
+    best = None
+    for c in CLASSES:
+        if rest.startswith(c + "_") and (best is None or len(c) > len(best)):
+            best = c
+    return best
+
+
+def sources(project):
+    files = set(glob.glob(os.path.join(project, "*.c")))
+    files |= set(glob.glob(os.path.join(project, "*.h")))
+    files |= set(glob.glob(os.path.join(project, "autogen", "*.c")))
+    for mk in glob.glob(os.path.join(project, "*", "**", "subdir.mk"), recursive=True):
+        with open(mk) as f:
+            for path in re.findall(r"\.\./(gecko_sdk[^\s\\]+\.c)\b", f.read()):
+                path = os.path.join(project, path)
+                if os.path.isfile(path) and os.path.basename(path) != STACK_INIT:
+                    files.add(path)
+    return sorted(files)
+
+
+def macros(project, present):
+    """Return {macro: value} for the catalog components and the numeric
+    macros of the project headers, None for those defined differently."""
+    values = {name: 1 for name in present}
+    for path in (glob.glob(os.path.join(project, "*.h"))
+                 + glob.glob(os.path.join(project, "config", "*.h"))):
+        with open(path, errors="replace") as f:
+            text = COMMENTS.sub("", f.read())
+        for name, value in NUMERIC.findall(text):
+            if values.setdefault(name, int(value)) != int(value):
+                values[name] = None
+    return values
+
+
+def evaluate(directive, condition, values):
+    """Value of a conditional, None when it depends on an unknown macro."""
+    condition = condition.strip()
+    if directive in ("ifdef", "ifndef"):
+        condition = ("!" if directive == "ifndef" else "") + "defined(%s)" % condition
+    m = CONDITION.match(condition)
+    if m is None:
+        return None
+    negate, name = m.group(1), m.group(2) or m.group(3) or m.group(4)
+    if name.isdigit():
+        value = int(name) != 0
+    elif m.group(4) is None:
+        # Only the catalog tells which components are not defined
+        if name in values:
+            value = True
+        elif name.startswith("SL_CATALOG_") and name.endswith("_PRESENT"):
+            value = False
+        else:
+            return None
+    elif values.get(name) is None:
+        return None
+    else:
+        value = values[name] != 0
+    return value != bool(negate)
+
+
+def compiled(text, values):
+    """Blank the lines an #if leaves out, keep both branches of the unknown
+    conditions."""
+    out = []
+    # [active before the #if, a branch was taken, active]
+    stack = []
+    active = True
+    for line in text.split("\n"):
+        m = DIRECTIVE.match(line)
+        if m is None:
+            out.append(line if active else "")
+            continue
+        directive, condition = m.groups()
+        if directive in ("if", "ifdef", "ifndef"):
+            value = evaluate(directive, condition, values)
+            stack.append([active, value is True, active and value is not False])
+        elif not stack:
+            pass
+        elif directive == "elif":
+            frame = stack[-1]
+            value = evaluate("if", condition, values)
+            frame[2] = frame[0] and not frame[1] and value is not False
+            frame[1] = frame[1] or value is True
+        elif directive == "else":
+            frame = stack[-1]
+            frame[2] = frame[0] and not frame[1]
+            frame[1] = True
+        else:
+            stack.pop()
+            active = stack[-1][2] if stack else True
+            out.append("")
+            continue
+        active = stack[-1][2] if stack else True
+        out.append("")
+    return "\n".join(out)
+
+
+def scan(project, present):
+    """Return {class: first use}, the commands and the events used."""
+    values = macros(project, present)
+    used = {}
+    commands = set()
+    events = set()
+    for path in sources(project):
+        with open(path, errors="replace") as f:
+            text = compiled(COMMENTS.sub("", f.read()), values)
+        where = os.path.relpath(path, project)
+        for name in COMMAND.findall(text):
+            commands.add(name)
+            c = class_of(name, "sl_bt_")
+            if c is not None:
+                used.setdefault(c, "%s in %s" % (name, where))
+        for name in EVENT.findall(text):
+            events.add(name)
+            c = class_of(name, "sl_bt_evt_")
+            if c is not None:
+                used.setdefault(c, "%s in %s" % (name, where))
+    return used, commands, events
+
+
+def trim(present, used, commands, events):
+    """Return {feature: reason} for the features to leave out."""
+    needed = {COMMAND_NEEDS[c] for c in commands if c in COMMAND_NEEDS}
+    trimmed = {}
+    for name, components, classes, _, _, _ in FEATURES:
+        if classes is None or not any(c in present for c in map(component, components)):
+            continue
+        if name not in needed and not any(c in used for c in classes):
+            trimmed[name] = "no sl_bt_%s_* command or event" % classes[0]
+            if len(classes) > 1:
+                trimmed[name] += " nor of the classes using it"
+
+    if "scanner" in trimmed:
+        trimmed["legacy_scanner"] = trimmed["extended_scanner"] = "scanner left out"
+    elif COMPATIBILITY_REPORT not in events:
+        # Each scanner reports through its own event
+        legacy = LEGACY_REPORT in events
+        extended = EXTENDED_REPORT in events or any(c in used for c in SYNC_CLASSES)
+        if extended and not legacy:
+            trimmed["legacy_scanner"] = "no %s_id" % LEGACY_REPORT
+        if legacy and not extended:
+            trimmed["extended_scanner"] = "no %s_id and no sync" % EXTENDED_REPORT
+    if "advertiser" in trimmed:
+        for name in ("legacy_advertiser", "extended_advertiser",
+                     "periodic_advertiser", "pawr_advertiser"):
+            trimmed[name] = "advertiser left out"
+
+    return {name: reason for name, reason in trimmed.items()
+            if any(c in present for c in map(component, feature(name)[1]))}
+
+
+def feature(name):
+    return next(f for f in FEATURES if f[0] == name)
+
+
+MEMBER = re.compile(r"([^\\/()]+\.a)\(([^)]+)\)")
+SECTION = re.compile(r"^ (\S+)?\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(.+)$")
+
+
+def member_key(text):
+    m = MEMBER.search(text)
+    return "%s(%s)" % m.groups() if m else None
+
+
+def read_map(path):
+    """Return {owner symbol: (flash, ram)} for the symbols sl_bt_stack_init.o
+    pulled out of the libraries."""
+    with open(path, errors="replace") as f:
+        lines = f.read().splitlines()
+
+    # Which file pulled each archive member in, and with which symbol
+    parent = {}
+    i = 1
+    while i + 1 < len(lines) and not lines[i].startswith("Discarded input sections"):
+        key = member_key(lines[i]) if not lines[i].startswith(" ") else None
+        if key is not None and lines[i + 1].startswith(" "):
+            ref = lines[i + 1].strip()
+            sym = ref[ref.rfind("(") + 1:-1] if ref.endswith(")") else None
+            parent[key] = (member_key(ref[:ref.rfind(" (")]), ref, sym)
+            i += 2
+        else:
+            i += 1
+
+    # Sizes of the members kept in the image
+    flash = {}
+    ram = {}
+    start = next(n for n, line in enumerate(lines)
+                 if line.startswith("Linker script and memory map"))
+    section = None
+    for line in lines[start:]:
+        if line.startswith(" .") and len(line.split()) == 1:
+            section = line.strip()
+            continue
+        m = SECTION.match(line)
+        if m is None:
+            section = None
+            continue
+        name = m.group(1) or section
+        section = None
+        key = member_key(m.group(4))
+        size = int(m.group(3), 16)
+        if key is None or name is None or size == 0:
+            continue
+        if name.startswith((".text", ".rodata", ".ARM.exidx")):
+            flash[key] = flash.get(key, 0) + size
+        elif name.startswith(".data"):
+            flash[key] = flash.get(key, 0) + size
+            ram[key] = ram.get(key, 0) + size
+        elif name.startswith((".bss", "COMMON")):
+            ram[key] = ram.get(key, 0) + size
+
+    # Charge each member to the symbol of sl_bt_stack_init.o at its root
+    owners = {}
+    for key in parent:
+        seen = set()
+        node = key
+        while node in parent and node not in seen:
+            seen.add(node)
+            up, ref, sym = parent[node]
+            if up is None:
+                if STACK_INIT.replace(".c", ".o") in ref:
+                    f, r = owners.get(sym, (0, 0))
+                    owners[sym] = (f + flash.get(key, 0), r + ram.get(key, 0))
+                break
+            node = up
+    return owners
+
+
+def savings(owners, name):
+    _, _, _, features, bgapi, controller = feature(name)
+    total = [0, 0]
+    for sym, (f, r) in owners.items():
+        m = (re.match(r"sli_feature_bt_(\w+?)_(init_always|on_demand)$", sym)
+             or re.match(r"sli_bgapi_class_bt_(\w+?)_(optimized|full)$", sym)
+             or re.match(r"sl_btctrl_init_(\w+)()$", sym)
+             or re.match(r"sl_btctrl_(alloc_\w+)()$", sym))
+        if m is None:
+            continue
+        kind = sym.split("_")[1]
+        if ((kind == "feature" and m.group(1) in features)
+                or (kind == "bgapi" and m.group(1) in bgapi)
+                or (kind == "btctrl" and m.group(1) in controller)):
+            total[0] += f
+            total[1] += r
+    return total
+
+
+def render(trimmed, estimates):
+    out = [
+        "/***************************************************************************//**",
+        " * @file",
+        " * @brief Bluetooth stack features left out of sl_bt_stack_init.c",
+        " *******************************************************************************",
+        " * Generated by bt_feature_trim.py from the sl_bt_* commands and events the",
+        " * project compiles in, run it again after using a new class of the API or",
+        " * changing a build option. Included by sl_bt_stack_init.c when",
+        " * SL_BT_CONFIG_FEATURE_TRIM is set.",
+        " ******************************************************************************/",
+        "",
+        "#ifndef SL_BT_FEATURE_TRIM_H",
+        "#define SL_BT_FEATURE_TRIM_H",
+        "",
+    ]
+    for name, _, _, _, _, _ in FEATURES:
+        if name not in trimmed:
+            continue
+        comment = "// %s: %s" % (name, trimmed[name])
+        if name in estimates:
+            comment += ", about %d bytes of flash and %d of RAM" % tuple(estimates[name])
+        out.append(comment)
+        for c in feature(name)[1]:
+            out.append("#undef %s" % component(c))
+    if not trimmed:
+        out.append("// Every Bluetooth feature of the project is used")
+    out += ["", "#endif // SL_BT_FEATURE_TRIM_H", ""]
+    return "\n".join(out)
+
+
+def undefs(text):
+    return sorted(re.findall(r"^#undef (\w+)", text, re.M))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--project", default=os.path.dirname(os.path.abspath(__file__)),
+                        help="project directory (default: the one of this script)")
+    parser.add_argument("--map", help="link map for the estimates "
+                        "(default: the *.map of the build directory)")
+    parser.add_argument("--check", action="store_true",
+                        help="only check that the header leaves out the same features")
+    args = parser.parse_args()
+
+    with open(os.path.join(args.project, CATALOG)) as f:
+        present = set(DEFINE.findall(f.read()))
+    used, commands, events = scan(args.project, present)
+    trimmed = trim(present, used, commands, events)
+
+    path = os.path.join(args.project, HEADER)
+    if args.check:
+        current = open(path).read() if os.path.isfile(path) else ""
+        if undefs(current) != undefs(render(trimmed, {})):
+            print("%s is out of date, run %s" % (HEADER, os.path.basename(__file__)))
+            return 1
+        return 0
+
+    maps = [args.map] if args.map else glob.glob(os.path.join(args.project, "*", "*.map"))
+    owners = read_map(maps[0]) if maps else {}
+    estimates = {name: savings(owners, name) for name in trimmed}
+    estimates = {name: e for name, e in estimates.items() if e != [0, 0]}
+
+    with open(path, "w", newline="\n") as f:
+        f.write(render(trimmed, estimates))
+
+    print("%-22s %-6s %8s %8s  %s" % ("feature", "", "flash", "RAM", "reason"))
+    total = [0, 0]
+    for name, components, classes, _, _, _ in FEATURES:
+        if not any(c in present for c in map(component, components)):
+            continue
+        if name in trimmed:
+            f, r = estimates.get(name, (0, 0))
+            total = [total[0] + f, total[1] + r]
+            print("%-22s %-6s %8s %8s  %s" % (name, "out",
+                                               f if name in estimates else "?",
+                                               r if name in estimates else "?",
+                                               trimmed[name]))
+        else:
+            reason = next((used[c] for c in classes or [] if c in used), "with the scanner")
+            print("%-22s %-6s %8s %8s  %s" % (name, "kept", "", "", reason))
+    print("%-22s %-6s %8d %8d  %s" % ("total", "", total[0], total[1],
+                                       "from " + os.path.relpath(maps[0], args.project)
+                                       if maps else "no link map, build once for estimates"))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,127 @@
+/***************************************************************************//**
+ * @file
+ * @brief Bluetooth stack buffer pool usage and sizing.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <stdint.h>
+#include "sl_bluetooth.h"
+#include "sl_bluetooth_config.h"
+
+/***************************************************************************//**
+ * Usage
+ *
+ *   The stack allocates its data buffers, the BGAPI events included, from a
+ *   pool of SL_BT_CONFIG_BUFFER_SIZE bytes. After each stack event, once the
+ *   application has handled it, the usage of the pool is read with
+ *   sl_bt_resource_get_status() and the TX queue of every open connection
+ *   with sl_bt_resource_get_connection_tx_status(). Buffers the stack had to
+ *   discard or failed to allocate come from
+ *   sl_bt_evt_system_resource_exhausted.
+ *
+ *   The stack does not expose the RX side of a connection. Its depth is
+ *   counted as the data events of the connection popped while more events
+ *   were still queued, that is the events that waited in the pool.
+ *
+ *   The report of a connection is logged when it closes.
+ *
+ * Sizing
+ *
+ *   With BUFFER_POOL_SIZING, the stack also reports each time the free space
+ *   drops BUFFER_POOL_SIZING_STEP bytes below its lowest level, so peaks
+ *   between two events are not missed, and every report carries a
+ *   recommended SL_BT_CONFIG_BUFFER_SIZE:
+ *
+ *     (peak without connection + peak per connection * SL_BT_CONFIG_MAX_CONNECTIONS)
+ *     * (100 + BUFFER_POOL_HEADROOM_PERCENT) / 100
+ *
+ *   plus the pool overhead. When buffers were discarded or failed, the peaks
+ *   are clipped by the pool, and at least BUFFER_POOL_HEADROOM_PERCENT more
+ *   than the current size is recommended. Load the links as in production
+ *   before reading it.
+ ******************************************************************************/
+
+// Set to 1 to track the peaks exactly and recommend a pool size
+#ifndef BUFFER_POOL_SIZING
+#define BUFFER_POOL_SIZING          0
+#endif
+
+// Resolution of the peaks in sizing mode, bytes
+#ifndef BUFFER_POOL_SIZING_STEP
+#define BUFFER_POOL_SIZING_STEP     64
+#endif
+
+// Margin over the measured peaks, percent
+#ifndef BUFFER_POOL_HEADROOM_PERCENT
+#define BUFFER_POOL_HEADROOM_PERCENT 25
+#endif
+
+// Connections tracked at once
+#ifndef BUFFER_POOL_MAX_CONNECTIONS
+#define BUFFER_POOL_MAX_CONNECTIONS SL_BT_CONFIG_MAX_CONNECTIONS
+#endif
+
+// Set to 1 on a device that is also a GATT client, its events are then counted
+// too. This device is a server only, bt_feature_trim.py leaves the client out
+#ifndef BUFFER_POOL_GATT_CLIENT
+#define BUFFER_POOL_GATT_CLIENT     0
+#endif
+
+// TX packets the stack tracks per connection
+#ifndef BUFFER_POOL_TX_REPORT_PACKETS
+#define BUFFER_POOL_TX_REPORT_PACKETS 16
+#endif
+
+typedef struct {
+  uint8_t connection;       // Connection handle, 0 if the entry is not used
+  uint16_t tx_flags;        // SL_BT_RESOURCE_CONNECTION_TX_FLAGS_* seen
+  uint16_t tx_packets;      // Packets in the TX queue
+  uint32_t tx_bytes;        // Bytes in the TX queue
+  uint16_t tx_peak_packets; // Most packets in the TX queue
+  uint32_t tx_peak_bytes;   // Most bytes in the TX queue
+  uint16_t rx_peak_events;  // Most data events of the connection queued at once
+} buffer_pool_connection_t;
+
+typedef struct {
+  uint32_t configured;      // SL_BT_CONFIG_BUFFER_SIZE
+  uint32_t total;           // Pool size reported by the stack
+  uint32_t used;            // Bytes in use
+  uint32_t peak;            // Most bytes in use
+  uint32_t idle_peak;       // Most bytes in use without any connection
+  uint32_t link_peak;       // Most bytes in use per open connection, beyond idle_peak
+  uint32_t buffers_discarded;
+  uint32_t buffer_allocation_failures;
+  uint32_t heap_allocation_failures;
+  uint32_t recommended;     // SL_BT_CONFIG_BUFFER_SIZE to use, 0 without BUFFER_POOL_SIZING
+  buffer_pool_connection_t connections[BUFFER_POOL_MAX_CONNECTIONS];
+} buffer_pool_report_t;
+
+/***************************************************************************//**
+ * Bluetooth stack event handler.
+ * Must be called after the application handled the event.
+ *
+ * @param[in] evt  Event coming from the Bluetooth stack.
+ ******************************************************************************/
+void buffer_pool_on_event(sl_bt_msg_t *evt);
+
+/***************************************************************************//**
+ * Get the usage of the pool and of the open connections.
+ *
+ * @param[out] report  Usage since the boot or the last reset.
+ ******************************************************************************/
+void buffer_pool_get_report(buffer_pool_report_t *report);
+
+/***************************************************************************//**
+ * Restart the peaks and the failure counts from the current usage.
+ ******************************************************************************/
+void buffer_pool_reset(void);
+
+#endif // BUFFER_POOL_H
@@ -0,0 +1,40 @@
+/***************************************************************************//**
+ * @file
+ * @brief Boot profile Config.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#ifndef FAST_BOOT_CONFIG_H
+#define FAST_BOOT_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+// <h>Boot profile
+
+// <q FAST_BOOT_PROFILE> Time the boot steps
+// <i> Default: 0
+// <i> Enables the cycle counter at reset, records the end of each step of
+// <i> sl_system_init() and of the Bluetooth boot event, and logs the step
+// <i> table once the boot completes. The system does not sleep before that.
+// <i> Enable it to measure the boot, leave it off in production images.
+#ifndef FAST_BOOT_PROFILE
+#define FAST_BOOT_PROFILE           0
+#endif
+
+// <o FAST_BOOT_MAX_STEPS> Steps recorded <1-255>
+// <i> Default: 40
+// <i> Further steps are ignored.
+#ifndef FAST_BOOT_MAX_STEPS
+#define FAST_BOOT_MAX_STEPS         40
+#endif
+
+// </h>
+
+// <<< end of configuration section >>>
+
+#endif // FAST_BOOT_CONFIG_H
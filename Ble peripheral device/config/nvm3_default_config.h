@@ -25,9 +25,10 @@
 // <o NVM3_DEFAULT_REPACK_HEADROOM> NVM3 Default Instance User Repack Headroom
 // <i> Headroom determining how many bytes below the forced repack limit the user
 // <i> repack limit should be placed. The default is 0, which means the user and
-// <i> forced repack limits are equal.
+// <i> forced repack limits are equal. A non-zero headroom lets the idle-time
+// <i> repack run before a write forces a repack.
 // <i> Default: 0
-#define NVM3_DEFAULT_REPACK_HEADROOM  0
+#define NVM3_DEFAULT_REPACK_HEADROOM  1024
 #endif
 
 #ifndef NVM3_DEFAULT_NVM_SIZE
@@ -38,6 +39,22 @@
 #define NVM3_DEFAULT_NVM_SIZE  40960
 #endif
 
+#ifndef NVM3_DEFAULT_PROFILE
+// <q NVM3_DEFAULT_PROFILE> Instrument the flash accesses of the default instance
+// <i> Measure the flash writes and page erases of the default instance and
+// <i> count the repacks forced by a write. See nvm3_profile.h.
+// <i> Default: 0
+#define NVM3_DEFAULT_PROFILE  0
+#endif
+
+#ifndef NVM3_DEFAULT_IDLE_REPACK_INTERVAL_MS
+// <o NVM3_DEFAULT_IDLE_REPACK_INTERVAL_MS> Minimum interval between idle-time repack steps (ms)
+// <i> Each step blocks for up to one page erase, the interval leaves time to
+// <i> the radio between two steps.
+// <i> Default: 100
+#define NVM3_DEFAULT_IDLE_REPACK_INTERVAL_MS  100
+#endif
+
 // </h>
 
 // <<< end of configuration section >>>
@@ -77,6 +77,38 @@
 // <i> Default: 0
 #define SL_SLEEPTIMER_DEBUGRUN  0
 
+#define SL_SLEEPTIMER_TIMER_QUEUE_DELTA_LIST  0
+#define SL_SLEEPTIMER_TIMER_QUEUE_WHEEL       1
+
+// <o SL_SLEEPTIMER_TIMER_QUEUE> Timer queue implementation
+//   <SL_SLEEPTIMER_TIMER_QUEUE_DELTA_LIST=> Delta list
+//   <SL_SLEEPTIMER_TIMER_QUEUE_WHEEL=> Timing wheel
+// <i> The delta list walks the running timers to start and stop a timer.
+// <i> The timing wheel starts a timer in constant time and stops it by walking
+// <i> a single wheel slot, at the cost of a few bytes of RAM per slot. Expiring
+// <i> a timer costs more than with the delta list, and the longest critical
+// <i> section is not shorter. Only consider it with many timers started and
+// <i> stopped before they expire, and measure with test/sleeptimer.
+// <i> Default: SL_SLEEPTIMER_TIMER_QUEUE_DELTA_LIST
+#define SL_SLEEPTIMER_TIMER_QUEUE  SL_SLEEPTIMER_TIMER_QUEUE_DELTA_LIST
+
+// <o SL_SLEEPTIMER_WHEEL_SIZE> Number of timing wheel slots <1-1024>
+// <i> Must be a power of 2. Only used with the timing wheel.
+// <i> Default: 32
+#define SL_SLEEPTIMER_WHEEL_SIZE  32
+
+// <o SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT> Timing wheel slot width, log2 of ticks <0-24>
+// <i> Each slot covers 2^N timer ticks. Only used with the timing wheel.
+// <i> N + log2(SL_SLEEPTIMER_WHEEL_SIZE) must be 32 or less.
+// <i> Default: 10
+#define SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT  10
+
+// <q SL_SLEEPTIMER_TIMER_COALESCING> Enable timer coalescing
+// <i> Timers started with a slack can expire late, within their slack, to
+// <i> share a wakeup with the timers expiring after them.
+// <i> Default: 1
+#define SL_SLEEPTIMER_TIMER_COALESCING  1
+
 #endif /* SLEEPTIMER_CONFIG_H */
 
 // <<< end of configuration section >>>
@@ -0,0 +1,132 @@
+/***************************************************************************//**
+ * @file
+ * @brief Boot step timing and deferred crypto initialization.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#include "em_device.h"
+#include "app_log.h"
+#include "psa/crypto.h"
+#include "sli_protocol_crypto.h"
+#include "fast_boot.h"
+
+#if FAST_BOOT_PROFILE
+typedef struct {
+  const char *name;
+  uint32_t us;                // End of the step, since fast_boot_start()
+} boot_step_t;
+
+static boot_step_t steps[FAST_BOOT_MAX_STEPS];
+static uint8_t step_count = 0;
+static bool steps_dropped = false;
+static uint32_t last_cycles;
+static uint64_t elapsed_us = 0;
+#endif // FAST_BOOT_PROFILE
+
+static bool booted = false;
+static bool done = false;
+
+#if FAST_BOOT_PROFILE
+static void log_steps(void);
+#endif
+
+/***************************************************************************//**
+ * Start the cycle counter and take the origin of the boot times.
+ ******************************************************************************/
+void fast_boot_start(void)
+{
+#if FAST_BOOT_PROFILE
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  last_cycles = DWT->CYCCNT;
+#endif
+}
+
+/***************************************************************************//**
+ * Record the end of a boot step.
+ ******************************************************************************/
+void fast_boot_mark(const char *step)
+{
+#if FAST_BOOT_PROFILE
+  uint32_t cycles = DWT->CYCCNT;
+
+  // The clock may have changed during the step, count it at the current one
+  elapsed_us += (uint64_t)(cycles - last_cycles) * 1000000u / SystemCoreClockGet();
+  last_cycles = cycles;
+  if (step_count < FAST_BOOT_MAX_STEPS) {
+    steps[step_count].name = step;
+    steps[step_count].us = (uint32_t)elapsed_us;
+    step_count++;
+  } else {
+    steps_dropped = true;
+  }
+#else
+  (void)step;
+#endif
+}
+
+/***************************************************************************//**
+ * Bluetooth stack event handler.
+ ******************************************************************************/
+void fast_boot_on_event(sl_bt_msg_t *evt)
+{
+  if (SL_BT_MSG_ID(evt->header) == sl_bt_evt_system_boot_id && !booted) {
+    fast_boot_mark("sl_bt_evt_system_boot");
+    booted = true;
+  }
+}
+
+/***************************************************************************//**
+ * Run the deferred initialization and log the boot steps.
+ ******************************************************************************/
+void fast_boot_process_action(void)
+{
+  if (!booted || done) {
+    return;
+  }
+
+#if defined(MBEDTLS_PSA_CRYPTO_LAZY_INIT)
+  // Left out of sl_service_init(), the radio is running by now
+  FAST_BOOT_STEP(psa_crypto_init);
+  FAST_BOOT_STEP(sli_aes_seed_mask);
+#endif
+
+  done = true;
+#if FAST_BOOT_PROFILE
+  log_steps();
+#endif
+}
+
+/***************************************************************************//**
+ * Power manager hook.
+ ******************************************************************************/
+bool fast_boot_is_ok_to_sleep(void)
+{
+  return done;
+}
+
+#if FAST_BOOT_PROFILE
+/***************************************************************************//**
+ * Log the end time and the duration of every step.
+ ******************************************************************************/
+static void log_steps(void)
+{
+  uint32_t previous = 0;
+
+  for (uint8_t i = 0; i < step_count; i++) {
+    app_log_info("boot %-34s %8lu us %8lu us\n",
+                 steps[i].name,
+                 (unsigned long)steps[i].us,
+                 (unsigned long)(steps[i].us - previous));
+    previous = steps[i].us;
+  }
+  if (steps_dropped) {
+    app_log_warning("boot steps beyond %d not recorded\n", FAST_BOOT_MAX_STEPS);
+  }
+}
+#endif // FAST_BOOT_PROFILE
@@ -0,0 +1,91 @@
+/***************************************************************************//**
+ * @file
+ * @brief Boot step timing and deferred crypto initialization.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#ifndef FAST_BOOT_H
+#define FAST_BOOT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sl_bluetooth.h"
+#include "fast_boot_config.h"
+
+/***************************************************************************//**
+ * Boot profile
+ *
+ *   Off by default. Set FAST_BOOT_PROFILE in fast_boot_config.h to 1, or
+ *   define it to 1 on the compiler command line, to measure the boot.
+ *
+ *   sl_system_init() wraps each of its calls in FAST_BOOT_STEP(), which
+ *   records the time elapsed since FAST_BOOT_START() at the end of the call.
+ *   The Bluetooth system boot event is recorded once the application has
+ *   handled it, that is once it has started advertising or scanning. The
+ *   steps are logged when the boot completes.
+ *
+ *   Times come from the cycle counter, converted with the core clock read at
+ *   each step, so the step that switches the clock is only approximate. The
+ *   system does not sleep until the boot completes, since the cycle counter
+ *   stops in EM2. The start-up code that runs before main() is not counted.
+ *
+ * Deferred crypto initialization
+ *
+ *   With MBEDTLS_PSA_CRYPTO_LAZY_INIT (SL_MBEDTLS_PSA_CRYPTO_LAZY_INIT in
+ *   sl_mbedtls_config.h), sl_service_init() leaves out psa_crypto_init() and
+ *   the RADIOAES mask seeding. They run from fast_boot_process_action() right
+ *   after the boot event, or earlier from the first PSA call that needs
+ *   them. PSA ITS already opens NVM3 and builds its cache on first use.
+ ******************************************************************************/
+
+#if FAST_BOOT_PROFILE
+#define FAST_BOOT_START()           fast_boot_start()
+#define FAST_BOOT_STEP(function) \
+  do {                           \
+    function();                  \
+    fast_boot_mark(#function);   \
+  } while (0)
+#else
+#define FAST_BOOT_START()
+#define FAST_BOOT_STEP(function)    function()
+#endif
+
+/***************************************************************************//**
+ * Start the cycle counter and take the origin of the boot times.
+ ******************************************************************************/
+void fast_boot_start(void);
+
+/***************************************************************************//**
+ * Record the end of a boot step.
+ *
+ * @param[in] step  Step name, must stay valid.
+ ******************************************************************************/
+void fast_boot_mark(const char *step);
+
+/***************************************************************************//**
+ * Bluetooth stack event handler, records the boot event.
+ * Must be called after the application handled the event.
+ *
+ * @param[in] evt  Event coming from the Bluetooth stack.
+ ******************************************************************************/
+void fast_boot_on_event(sl_bt_msg_t *evt);
+
+/***************************************************************************//**
+ * Run the deferred initialization and log the boot steps once the stack has
+ * booted. Must be called from the super loop.
+ ******************************************************************************/
+void fast_boot_process_action(void);
+
+/***************************************************************************//**
+ * Power manager hook.
+ *
+ * @return false until the boot completes.
+ ******************************************************************************/
+bool fast_boot_is_ok_to_sleep(void);
+
+#endif // FAST_BOOT_H
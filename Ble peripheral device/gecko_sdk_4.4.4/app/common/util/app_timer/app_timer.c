@@ -46,11 +46,11 @@
 // -----------------------------------------------------------------------------
 // Private variables
 
-/// Number of the triggered timers.
-static uint32_t trigger_count = 0;
+/// First timer of the queue which contains the triggered timers.
+static app_timer_t *triggered_head = NULL;
 
-/// Start of the linked list which contains the active timers.
-static app_timer_t *app_timer_head = NULL;
+/// Last timer of the queue which contains the triggered timers.
+static app_timer_t *triggered_tail = NULL;
 
 // -----------------------------------------------------------------------------
 // Private function declarations
@@ -67,32 +67,31 @@ static void app_timer_callback(sl_sleeptimer_timer_handle_t *handle,
                                void *data);
 
 /*******************************************************************************
- * Append a timer to the end of the linked list.
+ * Append a timer to the end of the triggered queue.
  *
  * @param[in] timer Pointer to the timer handle.
  *
- * @pre Assumes that the timer is not present in the list.
+ * @pre Assumes that the timer is not present in the queue.
  ******************************************************************************/
-static void append_app_timer(app_timer_t *timer);
+static void append_triggered_app_timer(app_timer_t *timer);
 
 /*******************************************************************************
- * Remove a timer from the linked list.
+ * Remove a timer from the triggered queue.
  *
  * @param[in] timer Pointer to the timer handle.
  *
- * @return Presence of the timer in the linked list.
- * @retval true  Timer was in the list.
- * @retval false Timer was not found in the list.
+ * @return Presence of the timer in the triggered queue.
+ * @retval true  Timer was in the queue.
+ * @retval false Timer was not in the queue.
  ******************************************************************************/
-static bool remove_app_timer(app_timer_t *timer);
+static bool remove_triggered_app_timer(app_timer_t *timer);
 
 /*******************************************************************************
- * Find and return the first triggered timer from the linked list.
+ * Take the first timer from the triggered queue.
  *
- * @return The first triggered timer from the linked list.
+ * @return The first triggered timer, NULL if the queue is empty.
  *
- * @note The trigger state is also reset, and it is removed from the list if
- * the timer is non-periodic.
+ * @note The trigger state is also reset.
  ******************************************************************************/
 static app_timer_t *get_triggered_app_timer(void);
 
@@ -104,16 +103,41 @@ sl_status_t app_timer_start(app_timer_t *timer,
                             app_timer_callback_t callback,
                             void *callback_data,
                             bool is_periodic)
+{
+  return app_timer_start_with_slack(timer,
+                                    timeout_ms,
+                                    0,
+                                    callback,
+                                    callback_data,
+                                    is_periodic);
+}
+
+sl_status_t app_timer_start_with_slack(app_timer_t *timer,
+                                       uint32_t timeout_ms,
+                                       uint32_t slack_ms,
+                                       app_timer_callback_t callback,
+                                       void *callback_data,
+                                       bool is_periodic)
 {
   sl_status_t sc;
   uint32_t timeout_initial_tick;
   uint32_t timer_freq;
   uint64_t required_tick;
+  uint32_t slack_tick = 0;
 
   // Check input parameters.
   if ((timeout_ms == 0) && is_periodic) {
     return SL_STATUS_INVALID_PARAMETER;
   }
+  if (is_periodic && (slack_ms >= timeout_ms)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  if (slack_ms > 0) {
+    sc = sl_sleeptimer_ms32_to_tick(slack_ms, &slack_tick);
+    if (SL_STATUS_OK != sc) {
+      return sc;
+    }
+  }
 
   // Make sure that timer is stopped, also check for NULL.
   sc = app_timer_stop(timer);
@@ -124,6 +148,7 @@ sl_status_t app_timer_start(app_timer_t *timer,
   timer->triggered = false;
   timer->overflow_counter = 0;
   timer->overflow_max = 0;
+  timer->option_flags = sl_sleeptimer_slack_to_option_flags(slack_tick);
 
   // Check if the timer has to be a long one
   if (timeout_ms > sl_sleeptimer_get_max_ms32_conversion()) {
@@ -143,7 +168,7 @@ sl_status_t app_timer_start(app_timer_t *timer,
                                             app_timer_callback,
                                             (void*)timer,
                                             0,
-                                            0);
+                                            timer->option_flags);
   } else {
     // Start sleeptimer with the given timeout/period.
     if (is_periodic) {
@@ -153,7 +178,7 @@ sl_status_t app_timer_start(app_timer_t *timer,
         app_timer_callback,
         (void*)timer,
         0,
-        0);
+        timer->option_flags);
     } else {
       sc = sl_sleeptimer_start_timer_ms(
         &timer->sleeptimer_handle,
@@ -161,7 +186,7 @@ sl_status_t app_timer_start(app_timer_t *timer,
         app_timer_callback,
         (void*)timer,
         0,
-        0);
+        timer->option_flags);
     }
   }
 
@@ -170,15 +195,13 @@ sl_status_t app_timer_start(app_timer_t *timer,
     timer->callback_data = callback_data;
     timer->periodic = is_periodic;
     timer->timeout_ms = timeout_ms;
-    append_app_timer(timer);
+    timer->slack_ms = slack_ms;
   }
   return sc;
 }
 
 sl_status_t app_timer_stop(app_timer_t *timer)
 {
-  bool timer_present;
-
   if (timer == NULL) {
     return SL_STATUS_NULL_POINTER;
   }
@@ -186,11 +209,8 @@ sl_status_t app_timer_stop(app_timer_t *timer)
   // Stop sleeptimer, ignore error code if was not running.
   (void)sl_sleeptimer_stop_timer(&timer->sleeptimer_handle);
 
-  timer_present = remove_app_timer(timer);
-  if (timer_present && timer->triggered) {
-    // Timer has been triggered but not served yet.
-    CORE_ATOMIC_SECTION(--trigger_count; )
-  }
+  // Drop the trigger if the timer has been triggered but not served yet.
+  (void)remove_triggered_app_timer(timer);
   return SL_STATUS_OK;
 }
 
@@ -199,8 +219,8 @@ sl_status_t app_timer_stop(app_timer_t *timer)
  ******************************************************************************/
 void sli_app_timer_step(void)
 {
-  if (trigger_count > 0) {
-    // Find triggered timers in list and call their callbacks.
+  if (triggered_head != NULL) {
+    // Take triggered timers from the queue and call their callbacks.
     app_timer_t *timer;
     do {
       timer = get_triggered_app_timer();
@@ -218,7 +238,7 @@ sl_power_manager_on_isr_exit_t sli_app_timer_sleep_on_isr_exit(void)
 {
   sl_power_manager_on_isr_exit_t ret = SL_POWER_MANAGER_IGNORE;
   // if there is a triggered event, wake up to handle it
-  if (trigger_count > 0) {
+  if (triggered_head != NULL) {
     ret = SL_POWER_MANAGER_WAKEUP;
   }
   return ret;
@@ -231,7 +251,7 @@ bool sli_app_timer_is_ok_to_sleep(void)
 {
   bool ret = true;
   // if there is a triggered event, do not go to sleep
-  if (trigger_count > 0) {
+  if (triggered_head != NULL) {
     ret = false;
   }
   return ret;
@@ -255,65 +275,63 @@ static void app_timer_callback(sl_sleeptimer_timer_handle_t *handle,
                                              app_timer_callback,
                                              (void*)timer,
                                              0,
-                                             0);
+                                             timer->option_flags);
       }
       timer->overflow_counter++;
     } else {
       if (LONG_TIMER_CHECK(timer)) {
         if (timer->periodic) {
           // Restart long timer
-          app_timer_start(timer,
-                          timer->timeout_ms,
-                          timer->callback,
-                          timer->callback_data,
-                          true);
+          app_timer_start_with_slack(timer,
+                                     timer->timeout_ms,
+                                     timer->slack_ms,
+                                     timer->callback,
+                                     timer->callback_data,
+                                     true);
         } else {
           // Stop periodic timer
           sl_sleeptimer_stop_timer(&timer->sleeptimer_handle);
         }
       }
-      timer->triggered = true;
-      ++trigger_count;
+      append_triggered_app_timer(timer);
     }
   }
 }
 
-static void append_app_timer(app_timer_t *timer)
+static void append_triggered_app_timer(app_timer_t *timer)
 {
   CORE_DECLARE_IRQ_STATE;
   CORE_ENTER_ATOMIC();
 
-  if (app_timer_head != NULL) {
-    app_timer_t *current = app_timer_head;
-    // Find end of list.
-    while (current->next != NULL) {
-      current = current->next;
-    }
-    current->next = timer;
+  timer->next = NULL;
+  if (triggered_tail != NULL) {
+    triggered_tail->next = timer;
   } else {
-    app_timer_head = timer;
+    triggered_head = timer;
   }
-  timer->next = NULL;
+  triggered_tail = timer;
+  timer->triggered = true;
 
   CORE_EXIT_ATOMIC();
 }
 
-static bool remove_app_timer(app_timer_t *timer)
+static bool remove_triggered_app_timer(app_timer_t *timer)
 {
+  app_timer_t *prev = NULL;
+  app_timer_t *current;
   CORE_DECLARE_IRQ_STATE;
   CORE_ENTER_ATOMIC();
 
-  app_timer_t *prev = NULL;
-  app_timer_t *current = app_timer_head;
-
-  // Find timer in list.
-  while (current != NULL && current != timer) {
+  // Look the timer up in the queue, its own fields are not initialized
+  // before its first start. The queue only holds the timers triggered
+  // but not served yet.
+  current = triggered_head;
+  while ((current != NULL) && (current != timer)) {
     prev = current;
     current = current->next;
   }
-
-  if (current != timer) {
-    // Not found.
+  if (current == NULL) {
+    // Not in the queue.
     CORE_EXIT_ATOMIC();
     return false;
   }
@@ -321,8 +339,13 @@ static bool remove_app_timer(app_timer_t *timer)
   if (prev != NULL) {
     prev->next = timer->next;
   } else {
-    app_timer_head = timer->next;
+    triggered_head = timer->next;
   }
+  if (timer->next == NULL) {
+    triggered_tail = prev;
+  }
+  timer->triggered = false;
+
   CORE_EXIT_ATOMIC();
   return true;
 }
@@ -332,23 +355,15 @@ static app_timer_t *get_triggered_app_timer(void)
   CORE_DECLARE_IRQ_STATE;
   CORE_ENTER_ATOMIC();
 
-  // Find the first triggered timer in list
-  app_timer_t *timer = app_timer_head;
-  while (timer != NULL) {
-    if (timer->triggered) {
-      // Timer found
-      timer->triggered = false;
-      --trigger_count;
-      if (!timer->periodic) {
-        (void)remove_app_timer(timer);
-      }
-
-      CORE_EXIT_ATOMIC();
-      return timer;
+  app_timer_t *timer = triggered_head;
+  if (timer != NULL) {
+    triggered_head = timer->next;
+    if (triggered_head == NULL) {
+      triggered_tail = NULL;
     }
-    timer = timer->next;
+    timer->triggered = false;
   }
 
   CORE_EXIT_ATOMIC();
-  return NULL;
+  return timer;
 }
@@ -0,0 +1,36 @@
+/***************************************************************************//**
+ * @file
+ * @brief NVM3 host build definitions.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#ifndef NVM3_HAL_HOST_H
+#define NVM3_HAL_HOST_H
+
+// Replaces sl_assert.h and sl_common.h when NVM3 is built for the host,
+// with NVM3_HOST_BUILD defined.
+
+#include <assert.h>
+
+#ifndef EFM_ASSERT
+#define EFM_ASSERT(expr)  assert(expr)
+#endif
+
+#ifndef STRINGIZE
+#define STRINGIZE(X)  #X
+#endif
+
+#ifndef SL_ATTRIBUTE_SECTION
+#define SL_ATTRIBUTE_SECTION(X)  __attribute__ ((section(X)))
+#endif
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE  static inline
+#endif
+
+#endif /* NVM3_HAL_HOST_H */
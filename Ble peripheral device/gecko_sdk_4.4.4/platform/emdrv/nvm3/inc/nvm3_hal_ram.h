@@ -0,0 +1,181 @@
+/***************************************************************************//**
+ * @file
+ * @brief NVM3 driver HAL for RAM and memory-mapped file storage
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#ifndef NVM3_HAL_RAM_H
+#define NVM3_HAL_RAM_H
+
+#include "nvm3_hal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @addtogroup nvm3
+ * @{
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @addtogroup nvm3hal
+ * @{
+ * @details
+ * This module provides the NVM3 interface to an NVM simulated in RAM, or in a
+ * memory-mapped file on hosts with NVM3_HOST_BUILD defined. It lets NVM3 and
+ * its users be benchmarked and stress-tested without a device.
+ *
+ * The NVM area is the RAM buffer given as nvmAdr in the NVM3 init data. It
+ * behaves like flash: a page erase sets all bits, a write can only clear bits.
+ * Every operation adds its configured duration to a simulated time, and the
+ * erase count of each page is tracked. A page erased more than the configured
+ * endurance fails to erase.
+ *
+ * @note The features available through the handle are used by the NVM3 and
+ * should not be used directly by any applications.
+ ******************************************************************************/
+
+/******************************************************************************
+ ******************************    MACROS    **********************************
+ *****************************************************************************/
+
+#define NVM3_HAL_RAM_MAX_PAGE_COUNT   64U   ///< Maximum number of pages with tracked erase counts
+
+/// Default configuration, page size and operation durations close to the
+/// Series 2 internal flash.
+#define NVM3_HAL_RAM_CONFIG_DEFAULT                                  \
+  {                                                                  \
+    .pageSize = 8192U,            /* Page size, bytes */             \
+    .writeSize = NVM3_HAL_WRITE_SIZE_32,                             \
+    .readWordTimeNs = 25U,        /* Time to read a word */          \
+    .writeWordTimeNs = 50000U,    /* Time to write a word */         \
+    .pageEraseTimeNs = 20000000U, /* Time to erase a page */         \
+    .eraseEndurance = 10000U,     /* Erase cycles of a page */       \
+    .simulateDelay = false,       /* Wait for the operation time */  \
+  }
+
+/******************************************************************************
+ ******************************   TYPEDEFS   **********************************
+ *****************************************************************************/
+
+/// @brief Simulated NVM properties.
+typedef struct {
+  size_t pageSize;              ///< Page size in bytes.
+  uint8_t writeSize;            ///< Write-size reported to the NVM3: NVM3_HAL_WRITE_SIZE_32 or NVM3_HAL_WRITE_SIZE_16.
+  uint32_t readWordTimeNs;      ///< Simulated time to read one word, in ns.
+  uint32_t writeWordTimeNs;     ///< Simulated time to write one word, in ns.
+  uint32_t pageEraseTimeNs;     ///< Simulated time to erase one page, in ns.
+  uint32_t eraseEndurance;      ///< Erase cycles before a page fails to erase, 0 for no limit.
+  bool simulateDelay;           ///< Busy-wait for the simulated time of each operation. Only supported with NVM3_HOST_BUILD.
+} nvm3_HalRamConfig_t;
+
+/// @brief Operation counters and simulated time.
+typedef struct {
+  uint32_t readWordCnt;         ///< Words read.
+  uint32_t writeWordCnt;        ///< Words written.
+  uint32_t rewriteWordCnt;      ///< Words written while not erased.
+  uint32_t pageEraseCnt;        ///< Pages erased.
+  uint32_t eraseFailCnt;        ///< Erases that failed because the page is worn out.
+  uint32_t maxPageEraseCnt;     ///< Erase count of the most erased page.
+  uint64_t timeNs;              ///< Simulated time spent in NVM operations, in ns.
+} nvm3_HalRamStats_t;
+
+/*******************************************************************************
+ ***************************   GLOBAL VARIABLES   ******************************
+ ******************************************************************************/
+
+extern const nvm3_HalHandle_t nvm3_halRamHandle;        ///< The HAL RAM handle.
+
+/*******************************************************************************
+ *****************************   PROTOTYPES   **********************************
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @brief
+ *   Set the simulated NVM properties.
+ *
+ * @details
+ *   Must be called before nvm3_open(). NVM3_HAL_RAM_CONFIG_DEFAULT is used
+ *   otherwise.
+ *
+ * @param[in] config
+ *   The simulated NVM properties.
+ ******************************************************************************/
+void nvm3_halRamConfigure(const nvm3_HalRamConfig_t *config);
+
+/***************************************************************************//**
+ * @brief
+ *   Get the operation counters and the simulated time.
+ *
+ * @param[out] stats
+ *   A pointer to the structure that receives the counters.
+ ******************************************************************************/
+void nvm3_halRamGetStats(nvm3_HalRamStats_t *stats);
+
+/***************************************************************************//**
+ * @brief
+ *   Reset the operation counters and the simulated time. The page erase
+ *   counts are kept, as they model the wear of the NVM.
+ ******************************************************************************/
+void nvm3_halRamResetStats(void);
+
+/***************************************************************************//**
+ * @brief
+ *   Get the erase count of a page.
+ *
+ * @param[in] pageIdx
+ *   Index of the page from the start of the NVM area.
+ *
+ * @return
+ *   The number of times the page was erased since the last call to
+ *   nvm3_halRamConfigure().
+ ******************************************************************************/
+uint32_t nvm3_halRamGetPageEraseCount(size_t pageIdx);
+
+#if defined(NVM3_HOST_BUILD)
+/***************************************************************************//**
+ * @brief
+ *   Map a file as the NVM area, so the content persists across runs.
+ *
+ * @details
+ *   The file is created or extended as needed, new content is erased. Pass
+ *   the returned address as nvmAdr in the NVM3 init data.
+ *
+ * @param[in] path
+ *   The file path.
+ * @param[in] nvmSize
+ *   The NVM area size, a multiple of the page size.
+ * @param[out] nvmAdr
+ *   The address of the mapped NVM area.
+ *
+ * @return
+ *   @ref ECODE_NVM3_OK on success or a NVM3 @ref Ecode_t on failure.
+ ******************************************************************************/
+Ecode_t nvm3_halRamMapFile(const char *path, size_t nvmSize, nvm3_HalPtr_t *nvmAdr);
+
+/***************************************************************************//**
+ * @brief
+ *   Unmap a file mapped by nvm3_halRamMapFile(). Call nvm3_close() first.
+ *
+ * @param[in] nvmAdr
+ *   The address of the mapped NVM area.
+ * @param[in] nvmSize
+ *   The NVM area size.
+ ******************************************************************************/
+void nvm3_halRamUnmapFile(nvm3_HalPtr_t nvmAdr, size_t nvmSize);
+#endif
+
+/** @} (end addtogroup nvm3hal) */
+/** @} (end addtogroup nvm3) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NVM3_HAL_RAM_H */
@@ -0,0 +1,290 @@
+/***************************************************************************//**
+ * @file
+ * @brief NVM3 driver HAL for RAM and memory-mapped file storage
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <string.h>
+#include "nvm3.h"
+#include "nvm3_hal_ram.h"
+
+#if defined(NVM3_HOST_BUILD)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/***************************************************************************//**
+ * @addtogroup nvm3
+ * @{
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @addtogroup nvm3hal
+ * @{
+ ******************************************************************************/
+
+/******************************************************************************
+ ***************************   LOCAL VARIABLES   ******************************
+ *****************************************************************************/
+
+static nvm3_HalRamConfig_t halConfig = NVM3_HAL_RAM_CONFIG_DEFAULT;
+static nvm3_HalRamStats_t halStats;
+static uint32_t pageEraseCnt[NVM3_HAL_RAM_MAX_PAGE_COUNT];
+
+// The NVM area given to open
+static uint8_t *ramBase = NULL;
+static size_t ramSize = 0U;
+
+/******************************************************************************
+ ***************************   LOCAL FUNCTIONS   ******************************
+ *****************************************************************************/
+
+/** @cond DO_NOT_INCLUDE_WITH_DOXYGEN */
+
+// Account the simulated time of an operation.
+static void addTime(uint64_t ns)
+{
+  halStats.timeNs += ns;
+
+#if defined(NVM3_HOST_BUILD)
+  if (halConfig.simulateDelay && (ns > 0U)) {
+    struct timespec start;
+    struct timespec now;
+    uint64_t elapsed;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      elapsed = (uint64_t)(now.tv_sec - start.tv_sec) * 1000000000U
+                + (uint64_t)now.tv_nsec - (uint64_t)start.tv_nsec;
+    } while (elapsed < ns);
+  }
+#endif
+}
+
+// Check that an access is inside the NVM area.
+static bool isInRange(const void *adr, size_t len)
+{
+  const uint8_t *p = adr;
+
+  return (ramBase != NULL)
+         && (p >= ramBase)
+         && (len <= ramSize)
+         && ((size_t)(p - ramBase) <= (ramSize - len));
+}
+
+/** @endcond */
+
+static Ecode_t nvm3_halRamOpen(nvm3_HalPtr_t nvmAdr, size_t flashSize)
+{
+  if ((nvmAdr == NULL)
+      || (((size_t)nvmAdr % sizeof(uint32_t)) != 0U)
+      || (halConfig.pageSize == 0U)
+      || ((flashSize % halConfig.pageSize) != 0U)) {
+    return ECODE_NVM3_ERR_INT_ADDR_INVALID;
+  }
+
+  ramBase = nvmAdr;
+  ramSize = flashSize;
+
+  return ECODE_NVM3_OK;
+}
+
+static void nvm3_halRamClose(void)
+{
+  ramBase = NULL;
+  ramSize = 0U;
+}
+
+static Ecode_t nvm3_halRamGetInfo(nvm3_HalInfo_t *halInfo)
+{
+  halInfo->deviceFamilyPartNumber = 0U;
+  halInfo->memoryMapped = 1;
+  halInfo->writeSize = halConfig.writeSize;
+  halInfo->pageSize = halConfig.pageSize;
+  halInfo->systemUnique = 0U;
+
+  return ECODE_NVM3_OK;
+}
+
+static void nvm3_halRamAccess(nvm3_HalNvmAccessCode_t access)
+{
+  (void)access;
+}
+
+static Ecode_t nvm3_halRamReadWords(nvm3_HalPtr_t nvmAdr, void *dst, size_t wordCnt)
+{
+  if (!isInRange(nvmAdr, wordCnt * sizeof(uint32_t))) {
+    return ECODE_NVM3_ERR_INT_ADDR_INVALID;
+  }
+
+  (void)memcpy(dst, nvmAdr, wordCnt * sizeof(uint32_t));
+  halStats.readWordCnt += wordCnt;
+  addTime((uint64_t)wordCnt * halConfig.readWordTimeNs);
+
+  return ECODE_NVM3_OK;
+}
+
+static Ecode_t nvm3_halRamWriteWords(nvm3_HalPtr_t nvmAdr, void const *src, size_t wordCnt)
+{
+  const uint8_t *pSrc = src;
+  uint8_t *pDst = nvmAdr;
+  Ecode_t halSta = ECODE_NVM3_OK;
+  uint32_t srcWord;
+  uint32_t dstWord;
+  size_t i;
+
+  if (((size_t)pDst % sizeof(uint32_t)) != 0U) {
+    return ECODE_NVM3_ERR_ALIGNMENT_INVALID;
+  }
+  if (!isInRange(nvmAdr, wordCnt * sizeof(uint32_t))) {
+    return ECODE_NVM3_ERR_INT_ADDR_INVALID;
+  }
+
+  for (i = 0U; i < wordCnt; i++) {
+    (void)memcpy(&srcWord, &pSrc[i * sizeof(uint32_t)], sizeof(uint32_t));
+    (void)memcpy(&dstWord, &pDst[i * sizeof(uint32_t)], sizeof(uint32_t));
+    if (dstWord != 0xFFFFFFFFUL) {
+      halStats.rewriteWordCnt++;
+    }
+    // Programming can only clear bits, like flash
+    if ((srcWord & ~dstWord) != 0U) {
+      halSta = ECODE_NVM3_ERR_WRITE_FAILED;
+    }
+    dstWord &= srcWord;
+    (void)memcpy(&pDst[i * sizeof(uint32_t)], &dstWord, sizeof(uint32_t));
+  }
+
+  halStats.writeWordCnt += wordCnt;
+  addTime((uint64_t)wordCnt * halConfig.writeWordTimeNs);
+
+  return halSta;
+}
+
+static Ecode_t nvm3_halRamPageErase(nvm3_HalPtr_t nvmAdr)
+{
+  size_t pageIdx;
+
+  if (!isInRange(nvmAdr, halConfig.pageSize)
+      || ((((uint8_t *)nvmAdr - ramBase) % halConfig.pageSize) != 0U)) {
+    return ECODE_NVM3_ERR_INT_ADDR_INVALID;
+  }
+
+  pageIdx = (size_t)((uint8_t *)nvmAdr - ramBase) / halConfig.pageSize;
+  addTime(halConfig.pageEraseTimeNs);
+
+  if (pageIdx < NVM3_HAL_RAM_MAX_PAGE_COUNT) {
+    if ((halConfig.eraseEndurance != 0U)
+        && (pageEraseCnt[pageIdx] >= halConfig.eraseEndurance)) {
+      // Worn out, the page keeps its content
+      halStats.eraseFailCnt++;
+      return ECODE_NVM3_ERR_ERASE_FAILED;
+    }
+    pageEraseCnt[pageIdx]++;
+    if (pageEraseCnt[pageIdx] > halStats.maxPageEraseCnt) {
+      halStats.maxPageEraseCnt = pageEraseCnt[pageIdx];
+    }
+  }
+
+  (void)memset(nvmAdr, 0xFF, halConfig.pageSize);
+  halStats.pageEraseCnt++;
+
+  return ECODE_NVM3_OK;
+}
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+
+void nvm3_halRamConfigure(const nvm3_HalRamConfig_t *config)
+{
+  halConfig = *config;
+  (void)memset(pageEraseCnt, 0, sizeof(pageEraseCnt));
+  (void)memset(&halStats, 0, sizeof(halStats));
+}
+
+void nvm3_halRamGetStats(nvm3_HalRamStats_t *stats)
+{
+  *stats = halStats;
+}
+
+void nvm3_halRamResetStats(void)
+{
+  uint32_t maxPageEraseCnt = halStats.maxPageEraseCnt;
+
+  (void)memset(&halStats, 0, sizeof(halStats));
+  halStats.maxPageEraseCnt = maxPageEraseCnt;
+}
+
+uint32_t nvm3_halRamGetPageEraseCount(size_t pageIdx)
+{
+  return (pageIdx < NVM3_HAL_RAM_MAX_PAGE_COUNT) ? pageEraseCnt[pageIdx] : 0U;
+}
+
+#if defined(NVM3_HOST_BUILD)
+Ecode_t nvm3_halRamMapFile(const char *path, size_t nvmSize, nvm3_HalPtr_t *nvmAdr)
+{
+  struct stat st;
+  uint8_t *adr;
+  size_t oldSize;
+  int fd;
+
+  fd = open(path, O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    return ECODE_NVM3_ERR_PARAMETER;
+  }
+  if ((fstat(fd, &st) != 0)
+      || ((st.st_size < (off_t)nvmSize) && (ftruncate(fd, (off_t)nvmSize) != 0))) {
+    (void)close(fd);
+    return ECODE_NVM3_ERR_INT_EMULATOR;
+  }
+  oldSize = (size_t)st.st_size;
+
+  adr = mmap(NULL, nvmSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (adr == MAP_FAILED) {
+    return ECODE_NVM3_ERR_INT_EMULATOR;
+  }
+
+  // Content added to the file is erased
+  if (oldSize < nvmSize) {
+    (void)memset(&adr[oldSize], 0xFF, nvmSize - oldSize);
+  }
+
+  *nvmAdr = adr;
+
+  return ECODE_NVM3_OK;
+}
+
+void nvm3_halRamUnmapFile(nvm3_HalPtr_t nvmAdr, size_t nvmSize)
+{
+  (void)msync(nvmAdr, nvmSize, MS_SYNC);
+  (void)munmap(nvmAdr, nvmSize);
+}
+#endif
+
+/*******************************************************************************
+ ***************************   GLOBAL VARIABLES   ******************************
+ ******************************************************************************/
+
+const nvm3_HalHandle_t nvm3_halRamHandle = {
+  .open = nvm3_halRamOpen,                      ///< Set the open function
+  .close = nvm3_halRamClose,                    ///< Set the close function
+  .getInfo = nvm3_halRamGetInfo,                ///< Set the get-info function
+  .access = nvm3_halRamAccess,                  ///< Set the access function
+  .pageErase = nvm3_halRamPageErase,            ///< Set the page-erase function
+  .readWords = nvm3_halRamReadWords,            ///< Set the read-words function
+  .writeWords = nvm3_halRamWriteWords,          ///< Set the write-words function
+};
+
+/** @} (end addtogroup nvm3hal) */
+/** @} (end addtogroup nvm3) */
@@ -0,0 +1,266 @@
+/***************************************************************************//**
+ * @file
+ * @brief NVM3 instrumentation and idle-time repack
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <string.h>
+#include "nvm3.h"
+#include "nvm3_default.h"
+#include "nvm3_default_config.h"
+#include "nvm3_hal_flash.h"
+#include "nvm3_profile.h"
+#include "sl_sleeptimer.h"
+
+/***************************************************************************//**
+ * @addtogroup nvm3
+ * @{
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @addtogroup nvm3profile
+ * @{
+ ******************************************************************************/
+
+/******************************************************************************
+ ******************************    MACROS    **********************************
+ *****************************************************************************/
+
+#ifndef NVM3_DEFAULT_IDLE_REPACK_INTERVAL_MS
+#define NVM3_DEFAULT_IDLE_REPACK_INTERVAL_MS  100U
+#endif
+
+/******************************************************************************
+ ***************************   LOCAL VARIABLES   ******************************
+ *****************************************************************************/
+
+static nvm3_ProfileStats_t profileStats;
+
+// Set while a repack step runs, to tell its erases from forced ones
+static bool isIdleRepackRunning = false;
+
+// Set by the power manager hook when the system was about to sleep
+static volatile bool isIdle = false;
+
+// Repack needed and allowed, updated by the process action
+static volatile bool isRepackDue = false;
+
+static uint32_t lastRepackTick = 0U;
+
+/******************************************************************************
+ ***************************   LOCAL FUNCTIONS   ******************************
+ *****************************************************************************/
+
+/** @cond DO_NOT_INCLUDE_WITH_DOXYGEN */
+
+// Get the time elapsed since a tick, in us.
+static uint32_t elapsedUs(uint32_t startTick)
+{
+  uint64_t ticks = (uint32_t)(sl_sleeptimer_get_tick_count() - startTick);
+
+  return (uint32_t)((ticks * 1000000U) / sl_sleeptimer_get_timer_frequency());
+}
+
+// Update a worst-case latency.
+static void updateMax(uint32_t *max, uint32_t us)
+{
+  if (us > *max) {
+    *max = us;
+  }
+}
+
+// Check if the location of an object is in the cache.
+static bool isCached(nvm3_Handle_t *h, nvm3_ObjectKey_t key)
+{
+  size_t i;
+
+  for (i = 0U; i < h->cache.entryCount; i++) {
+    if ((h->cache.entryPtr[i].ptr != NULL) && (h->cache.entryPtr[i].key == key)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Count a cache lookup.
+static void countLookup(nvm3_Handle_t *h, nvm3_ObjectKey_t key)
+{
+  if (isCached(h, key)) {
+    profileStats.cacheHitCnt++;
+  } else {
+    profileStats.cacheMissCnt++;
+  }
+}
+
+/** @endcond */
+
+static Ecode_t nvm3_halProfileOpen(nvm3_HalPtr_t nvmAdr, size_t flashSize)
+{
+  return nvm3_halOpen(&nvm3_halFlashHandle, nvmAdr, flashSize);
+}
+
+static void nvm3_halProfileClose(void)
+{
+  nvm3_halClose(&nvm3_halFlashHandle);
+}
+
+static Ecode_t nvm3_halProfileGetInfo(nvm3_HalInfo_t *halInfo)
+{
+  return nvm3_halGetInfo(&nvm3_halFlashHandle, halInfo);
+}
+
+static void nvm3_halProfileAccess(nvm3_HalNvmAccessCode_t access)
+{
+  nvm3_halNvmAccess(&nvm3_halFlashHandle, access);
+}
+
+static Ecode_t nvm3_halProfileReadWords(nvm3_HalPtr_t nvmAdr, void *dst, size_t wordCnt)
+{
+  return nvm3_halReadWords(&nvm3_halFlashHandle, nvmAdr, dst, wordCnt);
+}
+
+static Ecode_t nvm3_halProfileWriteWords(nvm3_HalPtr_t nvmAdr, void const *src, size_t wordCnt)
+{
+  uint32_t startTick = sl_sleeptimer_get_tick_count();
+  Ecode_t halSta;
+
+  halSta = nvm3_halWriteWords(&nvm3_halFlashHandle, nvmAdr, src, wordCnt);
+
+  profileStats.halWriteCnt++;
+  updateMax(&profileStats.halWriteTimeMaxUs, elapsedUs(startTick));
+
+  return halSta;
+}
+
+static Ecode_t nvm3_halProfilePageErase(nvm3_HalPtr_t nvmAdr)
+{
+  uint32_t startTick = sl_sleeptimer_get_tick_count();
+  Ecode_t halSta;
+
+  halSta = nvm3_halPageErase(&nvm3_halFlashHandle, nvmAdr);
+
+  profileStats.pageEraseCnt++;
+  if (!isIdleRepackRunning) {
+    profileStats.forcedEraseCnt++;
+  }
+  updateMax(&profileStats.pageEraseTimeMaxUs, elapsedUs(startTick));
+
+  return halSta;
+}
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+
+Ecode_t nvm3_profileReadData(nvm3_Handle_t *h, nvm3_ObjectKey_t key, void *value, size_t len)
+{
+  uint32_t startTick = sl_sleeptimer_get_tick_count();
+  Ecode_t sta;
+
+  countLookup(h, key);
+  sta = nvm3_readData(h, key, value, len);
+
+  profileStats.readCnt++;
+  updateMax(&profileStats.readTimeMaxUs, elapsedUs(startTick));
+
+  return sta;
+}
+
+Ecode_t nvm3_profileWriteData(nvm3_Handle_t *h, nvm3_ObjectKey_t key, const void *value, size_t len)
+{
+  uint32_t startTick = sl_sleeptimer_get_tick_count();
+  Ecode_t sta;
+
+  countLookup(h, key);
+  sta = nvm3_writeData(h, key, value, len);
+
+  profileStats.writeCnt++;
+  updateMax(&profileStats.writeTimeMaxUs, elapsedUs(startTick));
+
+  return sta;
+}
+
+void nvm3_profileGetStats(nvm3_Handle_t *h, nvm3_ProfileStats_t *stats)
+{
+  size_t i;
+
+  *stats = profileStats;
+  stats->cacheEntryCount = h->cache.entryCount;
+  stats->cacheOverflow = h->cache.overflow;
+  stats->cacheUsedCount = 0U;
+  for (i = 0U; i < h->cache.entryCount; i++) {
+    if (h->cache.entryPtr[i].ptr != NULL) {
+      stats->cacheUsedCount++;
+    }
+  }
+}
+
+void nvm3_profileResetStats(void)
+{
+  (void)memset(&profileStats, 0, sizeof(profileStats));
+}
+
+bool nvm3_idleRepackIsOkToSleep(void)
+{
+  if (!isRepackDue) {
+    return true;
+  }
+  if ((uint32_t)(sl_sleeptimer_get_tick_count() - lastRepackTick)
+      < sl_sleeptimer_ms_to_tick(NVM3_DEFAULT_IDLE_REPACK_INTERVAL_MS)) {
+    // Too early, the next wakeup gives another chance
+    return true;
+  }
+
+  isIdle = true;
+  return false;
+}
+
+void nvm3_idleRepackProcessAction(void)
+{
+  uint32_t startTick;
+
+  if (isIdle) {
+    isIdle = false;
+    if (isRepackDue && nvm3_idleRepackIsAllowed()) {
+      startTick = sl_sleeptimer_get_tick_count();
+      isIdleRepackRunning = true;
+      (void)nvm3_repack(nvm3_defaultHandle);
+      isIdleRepackRunning = false;
+      lastRepackTick = sl_sleeptimer_get_tick_count();
+
+      profileStats.idleRepackCnt++;
+      updateMax(&profileStats.idleRepackTimeMaxUs, elapsedUs(startTick));
+    }
+  }
+
+  isRepackDue = nvm3_repackNeeded(nvm3_defaultHandle) && nvm3_idleRepackIsAllowed();
+}
+
+SL_WEAK bool nvm3_idleRepackIsAllowed(void)
+{
+  return true;
+}
+
+/*******************************************************************************
+ ***************************   GLOBAL VARIABLES   ******************************
+ ******************************************************************************/
+
+const nvm3_HalHandle_t nvm3_halProfileHandle = {
+  .open = nvm3_halProfileOpen,                  ///< Set the open function
+  .close = nvm3_halProfileClose,                ///< Set the close function
+  .getInfo = nvm3_halProfileGetInfo,            ///< Set the get-info function
+  .access = nvm3_halProfileAccess,              ///< Set the access function
+  .pageErase = nvm3_halProfilePageErase,        ///< Set the page-erase function
+  .readWords = nvm3_halProfileReadWords,        ///< Set the read-words function
+  .writeWords = nvm3_halProfileWriteWords,      ///< Set the write-words function
+};
+
+/** @} (end addtogroup nvm3profile) */
+/** @} (end addtogroup nvm3) */
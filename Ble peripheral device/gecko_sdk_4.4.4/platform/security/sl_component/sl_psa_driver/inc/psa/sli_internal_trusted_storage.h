@@ -60,6 +60,32 @@ psa_status_t sli_psa_its_encrypted(void);
 psa_status_t sli_psa_its_set_root_key(uint8_t *root_key, size_t root_key_size);
 #endif // defined(SLI_PSA_ITS_ENCRYPTED) && !defined(SEMAILBOX_PRESENT)
 
+#if defined(SLI_PSA_ITS_ENCRYPTED)
+/* Number of derived session keys kept in RAM */
+#ifndef SL_PSA_ITS_SESSION_KEY_CACHE_SIZE
+#define SL_PSA_ITS_SESSION_KEY_CACHE_SIZE    (1)
+#endif
+
+/* Counters of the session key cache. A miss costs a key derivation. */
+typedef struct {
+  uint32_t hits;
+  uint32_t misses;
+  uint32_t evictions;
+} sli_psa_its_session_key_cache_stats_t;
+
+/**
+ * \brief Get the session key cache counters.
+ *
+ * \param[out] stats          Pointer to the structure that receives the counters.
+ */
+void sli_psa_its_get_session_key_cache_stats(sli_psa_its_session_key_cache_stats_t *stats);
+
+/**
+ * \brief Reset the session key cache counters.
+ */
+void sli_psa_its_reset_session_key_cache_stats(void);
+#endif // defined(SLI_PSA_ITS_ENCRYPTED)
+
 /* Magic values for ITS metadata versions */
 #define SLI_PSA_ITS_META_MAGIC_V1             (0x05E175D1UL)
 #define SLI_PSA_ITS_META_MAGIC_V2             (0x5E175D10UL)
@@ -306,6 +306,11 @@ psa_status_t sli_cryptoacc_transparent_aead_verify(sli_cryptoacc_transparent_aea
 
 psa_status_t sli_cryptoacc_transparent_aead_abort(sli_cryptoacc_transparent_aead_operation_t *operation);
 
+psa_status_t sli_cryptoacc_transparent_aead_batch(psa_algorithm_t alg,
+                                                  bool encrypt,
+                                                  sli_cryptoacc_transparent_batch_item_t *items,
+                                                  size_t item_count);
+
 psa_status_t sli_cryptoacc_transparent_generate_key(const psa_key_attributes_t *attributes,
                                                     uint8_t *key_buffer,
                                                     size_t key_buffer_size,
@@ -336,6 +341,14 @@ psa_status_t sli_cryptoacc_transparent_key_agreement(psa_algorithm_t alg,
                                                      size_t output_size,
                                                      size_t *output_length);
 
+bool sli_cryptoacc_ecc_keypair_cache_is_ok_to_sleep(void);
+
+void sli_cryptoacc_ecc_keypair_cache_process_action(void);
+
+void sli_cryptoacc_ecc_keypair_cache_enable(bool enable);
+
+void sli_cryptoacc_ecc_keypair_cache_get_stats(sli_cryptoacc_ecc_keypair_cache_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
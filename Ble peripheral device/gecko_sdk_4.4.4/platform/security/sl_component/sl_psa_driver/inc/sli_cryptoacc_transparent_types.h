@@ -62,11 +62,19 @@ SL_ENUM(sli_aes_mode_t) {
   SLI_AES_DEC = 2,
 };
 
+/// Number of 64-byte blocks a hash operation stages before handing them to
+/// the CRYPTOACC, so that small updates cost one transfer per staging buffer
+/// instead of one per block.
+#ifndef SL_CRYPTOACC_HASH_STAGING_BLOCKS
+#define SL_CRYPTOACC_HASH_STAGING_BLOCKS 1
+#endif
+
 typedef struct {
   sx_hash_fct_t hash_type;            ///< Hash type
   uint32_t total;                     ///< Number of bytes processed
+  uint32_t buffered;                  ///< Number of bytes staged in buffer
   uint8_t state[32];                  ///< Intermediate digest state
-  uint8_t buffer[64];                 ///< Data block being processed
+  uint8_t buffer[64 * SL_CRYPTOACC_HASH_STAGING_BLOCKS]; ///< Data staged for processing
 } sli_cryptoacc_transparent_hash_operation_t;
 
 typedef struct {
@@ -122,6 +130,54 @@ typedef struct {
   } ctx;
 } sli_cryptoacc_transparent_aead_operation_t;
 
+/// Enable sli_cryptoacc_transparent_aead_batch(), which chains several
+/// AES-CTR or AES-CCM messages in one CRYPTOACC transfer.
+#ifndef SL_CRYPTOACC_AEAD_BATCH
+#define SL_CRYPTOACC_AEAD_BATCH 0
+#endif
+
+/// Number of batch items chained in one CRYPTOACC transfer. Larger batches
+/// are processed in several transfers.
+#ifndef SLI_CRYPTOACC_BATCH_MAX_ITEMS
+#define SLI_CRYPTOACC_BATCH_MAX_ITEMS 4
+#endif
+
+/// One independent message of a batch of AES-CTR or AES-CCM operations.
+typedef struct {
+  const uint8_t *key;                       ///< Raw AES key
+  size_t key_length;                        ///< Key length, 16, 24 or 32 bytes
+  const uint8_t *nonce;                     ///< CTR: 16-byte counter block, CCM: nonce
+  size_t nonce_length;                      ///< Nonce length
+  const uint8_t *additional_data;           ///< CCM only, additional data
+  size_t additional_data_length;            ///< Additional data length
+  const uint8_t *input;                     ///< Plaintext or ciphertext
+  size_t input_length;                      ///< Input length
+  uint8_t *output;                          ///< input_length bytes, same as input or not overlapping it
+  uint8_t *tag;                             ///< CCM only, output tag when encrypting, tag to verify when decrypting
+  size_t tag_length;                        ///< Tag length
+  psa_status_t status;                      ///< Result of this message
+} sli_cryptoacc_transparent_batch_item_t;
+
+/// Number of P-256 keypairs generated ahead of psa_generate_key(), 0 to
+/// disable the keypair cache.
+#ifndef SL_CRYPTOACC_ECC_KEYPAIR_CACHE_SIZE
+#define SL_CRYPTOACC_ECC_KEYPAIR_CACHE_SIZE 0
+#endif
+
+/// Seconds after which an unused cached keypair is wiped and generated
+/// again, 0 to keep cached keypairs until used.
+#ifndef SL_CRYPTOACC_ECC_KEYPAIR_CACHE_MAX_AGE_S
+#define SL_CRYPTOACC_ECC_KEYPAIR_CACHE_MAX_AGE_S 0
+#endif
+
+/// Counters of the keypair cache.
+typedef struct {
+  uint32_t hits;                            ///< Keypairs served from the cache
+  uint32_t misses;                          ///< Keypairs generated on request
+  uint32_t refills;                         ///< Keypairs generated in idle time
+  uint32_t expired;                         ///< Keypairs wiped unused
+} sli_cryptoacc_ecc_keypair_cache_stats_t;
+
 #ifdef __cplusplus
 }
 #endif
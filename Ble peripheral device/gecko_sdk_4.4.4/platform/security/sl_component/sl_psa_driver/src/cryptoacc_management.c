@@ -40,6 +40,159 @@
 
 #include "sx_aes.h"
 #include "ba414ep_config.h"
+#include "cryptodma_internal.h"
+#include "cryptolib_def.h"
+#include "cryptoacc_management.h"
+
+#include "em_core.h"
+#include "em_emu.h"
+
+#if defined(SL_COMPONENT_CATALOG_PRESENT)
+#include "sl_component_catalog.h"
+#endif
+#if defined(SL_CATALOG_POWER_MANAGER_PRESENT)
+#include "sl_power_manager.h"
+#endif
+
+/// Priority to use for the CRYPTOACC IRQ signalling job completion
+#if defined(CRYPTOACC_MANAGEMENT_USER_IRQ_PRIORITY)
+  #define CRYPTOACC_MANAGEMENT_IRQ_PRIORITY CRYPTOACC_MANAGEMENT_USER_IRQ_PRIORITY
+#else
+  #define CRYPTOACC_MANAGEMENT_IRQ_PRIORITY CORE_INTERRUPT_DEFAULT_PRIORITY
+#endif
+
+//------------------------------------------------------------------------------
+// Job Queue State
+
+// Queued jobs, the head is in progress while job_running is set.
+static cryptoacc_job_t *job_head = NULL;
+static cryptoacc_job_t *job_tail = NULL;
+static volatile bool job_running = false;
+
+// Set while a synchronous caller owns the device.
+static volatile bool sync_owned = false;
+// Synchronous callers waiting for the job in progress.
+static volatile uint32_t sync_waiting = 0;
+
+#if defined(SL_CATALOG_POWER_MANAGER_PRESENT)
+// The device stops in EM2, sleep no deeper than EM1 while jobs are queued.
+static bool em1_required = false;
+#endif
+
+//------------------------------------------------------------------------------
+// Static Functions
+
+static void clock_enable(void)
+{
+  CMU->CLKEN1_SET = CMU_CLKEN1_CRYPTOACC;
+  CMU->CRYPTOACCCLKCTRL_SET = (CMU_CRYPTOACCCLKCTRL_PKEN
+                               | CMU_CRYPTOACCCLKCTRL_AESEN);
+}
+
+static void clock_disable(void)
+{
+  CMU->CLKEN1_CLR = CMU_CLKEN1_CRYPTOACC;
+  CMU->CRYPTOACCCLKCTRL_CLR = (CMU_CRYPTOACCCLKCTRL_PKEN
+                               | CMU_CRYPTOACCCLKCTRL_AESEN);
+}
+
+// Start a job. Called with interrupts masked.
+static void start_job(cryptoacc_job_t *job)
+{
+  job_running = true;
+  #if defined(SL_CATALOG_POWER_MANAGER_PRESENT)
+  if (!em1_required) {
+    em1_required = true;
+    sl_power_manager_add_em_requirement(SL_POWER_MANAGER_EM1);
+  }
+  #endif
+  clock_enable();
+  NVIC_ClearPendingIRQ(CRYPTOACC_IRQn);
+  NVIC_SetPriority(CRYPTOACC_IRQn, CRYPTOACC_MANAGEMENT_IRQ_PRIORITY);
+  NVIC_EnableIRQ(CRYPTOACC_IRQn);
+  cryptodma_start_sg(job->fetch, job->push);
+}
+
+// Start the job at the head of the queue. Called with interrupts masked, when
+// the device is free.
+static void start_next_job(void)
+{
+  if ((job_head == NULL) || job_running || sync_owned || (sync_waiting != 0U)) {
+    return;
+  }
+
+  start_job(job_head);
+}
+
+// Check whether the caller can sleep until the CRYPTOACC interrupt.
+static bool can_wait_for_irq(void)
+{
+  return !CORE_InIrqContext() && !CORE_IrqIsDisabled();
+}
+
+// Sleep in EM1 until the flag is set by the CRYPTOACC interrupt.
+static void wait_for_irq(volatile bool *flag, bool value)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  // The interrupt wakes the core up even when masked, and runs on the yield
+  CORE_ENTER_CRITICAL();
+  while (*flag != value) {
+    EMU_EnterEM1();
+    CORE_YIELD_CRITICAL();
+  }
+  CORE_EXIT_CRITICAL();
+}
+
+static void owner_job_done(cryptoacc_job_t *job, psa_status_t status)
+{
+  *(psa_status_t *)job->user_data = status;
+}
+
+// Run the transfers of the owner of the device, see cryptodma_set_sg_runner().
+// The transfer is queued as a job ahead of the queued ones, and the owner
+// sleeps until it is complete.
+static void run_sg_as_job(struct dma_sg_descr_s *fetch,
+                          struct dma_sg_descr_s *push)
+{
+  CORE_DECLARE_IRQ_STATE;
+  psa_status_t status = PSA_OPERATION_INCOMPLETE;
+  cryptoacc_job_t job = {
+    .fetch = fetch,
+    .push = push,
+    .callback = owner_job_done,
+    .user_data = (void *)&status,
+  };
+
+  if (!can_wait_for_irq()) {
+    // Poll the interrupt line instead, it stays disabled in the NVIC
+    NVIC_ClearPendingIRQ(CRYPTOACC_IRQn);
+    cryptodma_start_sg(fetch, push);
+    while (!NVIC_GetPendingIRQ(CRYPTOACC_IRQn)) {
+    }
+    NVIC_ClearPendingIRQ(CRYPTOACC_IRQn);
+    if (cryptodma_finish_sg(push) != CRYPTOLIB_SUCCESS) {
+      TRIGGER_HARDFAULT_FCT();
+    }
+    return;
+  }
+
+  CORE_ENTER_ATOMIC();
+  job.next = job_head;
+  job_head = &job;
+  if (job_tail == NULL) {
+    job_tail = &job;
+  }
+  start_job(&job);
+  CORE_EXIT_ATOMIC();
+
+  wait_for_irq(&job_running, false);
+
+  // The library has no error path for the transfers
+  if (status != PSA_SUCCESS) {
+    TRIGGER_HARDFAULT_FCT();
+  }
+}
 
 //------------------------------------------------------------------------------
 // RTOS Synchronization and Clocking Functions
@@ -47,6 +200,8 @@
 // Get ownership of an available CRYPTOACC device.
 psa_status_t cryptoacc_management_acquire(void)
 {
+  CORE_DECLARE_IRQ_STATE;
+
   #if defined(MBEDTLS_THREADING_C)
   if ((SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk) != 0U) {
     return PSA_ERROR_HARDWARE_FAILURE;
@@ -59,9 +214,31 @@ psa_status_t cryptoacc_management_acquire(void)
   }
   #endif
 
-  CMU->CLKEN1_SET = CMU_CLKEN1_CRYPTOACC;
-  CMU->CRYPTOACCCLKCTRL_SET = (CMU_CRYPTOACCCLKCTRL_PKEN
-                               | CMU_CRYPTOACCCLKCTRL_AESEN);
+  // Take turns with the asynchronous jobs: wait for the one in progress, and
+  // hold back the queued ones until the device is released.
+  CORE_ENTER_ATOMIC();
+  if (job_running && ((SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk) != 0U)) {
+    // Waiting here would block the completion interrupt
+    CORE_EXIT_ATOMIC();
+    return PSA_ERROR_BAD_STATE;
+  }
+  sync_waiting++;
+  CORE_EXIT_ATOMIC();
+
+  if (can_wait_for_irq()) {
+    wait_for_irq(&job_running, false);
+  } else {
+    while (job_running) {
+    }
+  }
+
+  CORE_ENTER_ATOMIC();
+  sync_waiting--;
+  sync_owned = true;
+  CORE_EXIT_ATOMIC();
+
+  clock_enable();
+  cryptodma_set_sg_runner(run_sg_as_job);
 
   return PSA_SUCCESS;
 }
@@ -69,9 +246,15 @@ psa_status_t cryptoacc_management_acquire(void)
 // Release ownership of a reserved CRYPTOACC device.
 psa_status_t cryptoacc_management_release(void)
 {
-  CMU->CLKEN1_CLR = CMU_CLKEN1_CRYPTOACC;
-  CMU->CRYPTOACCCLKCTRL_CLR = (CMU_CRYPTOACCCLKCTRL_PKEN
-                               | CMU_CRYPTOACCCLKCTRL_AESEN);
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  sync_owned = false;
+  start_next_job();
+  if (!job_running) {
+    clock_disable();
+  }
+  CORE_EXIT_ATOMIC();
 
   #if defined(MBEDTLS_THREADING_C)
   if (sli_se_lock_release() != SL_STATUS_OK) {
@@ -82,6 +265,78 @@ psa_status_t cryptoacc_management_release(void)
   return PSA_SUCCESS;
 }
 
+//------------------------------------------------------------------------------
+// Asynchronous Job Functions
+
+// Queue a job, and start it if the device is free.
+psa_status_t cryptoacc_management_submit(cryptoacc_job_t *job)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  if ((job == NULL) || (job->fetch == NULL) || (job->push == NULL)
+      || (job->callback == NULL)) {
+    return PSA_ERROR_INVALID_ARGUMENT;
+  }
+
+  job->next = NULL;
+
+  CORE_ENTER_ATOMIC();
+  if (job_tail == NULL) {
+    job_head = job;
+  } else {
+    job_tail->next = job;
+  }
+  job_tail = job;
+  start_next_job();
+  CORE_EXIT_ATOMIC();
+
+  return PSA_SUCCESS;
+}
+
+// Check whether jobs are queued or in progress.
+bool cryptoacc_management_jobs_pending(void)
+{
+  return job_head != NULL;
+}
+
+// Complete the job in progress and start the next one.
+void CRYPTOACC_IRQHandler(void)
+{
+  cryptoacc_job_t *job;
+  psa_status_t status;
+
+  NVIC_DisableIRQ(CRYPTOACC_IRQn);
+  if (!job_running) {
+    return;
+  }
+
+  job = job_head;
+  status = (cryptodma_finish_sg(job->push) == CRYPTOLIB_SUCCESS)
+           ? PSA_SUCCESS : PSA_ERROR_HARDWARE_FAILURE;
+
+  job_head = job->next;
+  if (job_head == NULL) {
+    job_tail = NULL;
+  }
+  job_running = false;
+  if (!sync_owned && ((job_head == NULL) || (sync_waiting != 0U))) {
+    clock_disable();
+  }
+  #if defined(SL_CATALOG_POWER_MANAGER_PRESENT)
+  if ((job_head == NULL) && em1_required) {
+    em1_required = false;
+    sl_power_manager_remove_em_requirement(SL_POWER_MANAGER_EM1);
+  }
+  #endif
+
+  // The callback may submit jobs or use the device synchronously
+  job->callback(job, status);
+
+  CORE_ATOMIC_SECTION(
+    start_next_job();
+    )
+}
+
 //------------------------------------------------------------------------------
 // Countermeasure Initialization Functions
 
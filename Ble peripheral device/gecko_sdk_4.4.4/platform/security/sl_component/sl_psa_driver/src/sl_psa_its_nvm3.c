@@ -222,15 +222,19 @@ static root_key_t g_root_key = {
 
 typedef struct {
   bool active;
+  uint32_t last_use;
   psa_storage_uid_t uid;
   uint8_t data[SESSION_KEY_SIZE];
 } session_key_t;
 
-static session_key_t g_cached_session_key = {
-  .active = false,
-  .uid = 0,
-  .data = { 0 },
-};
+// Session keys of the most recently used files. When the cache is full, the
+// least recently used entry is zeroized and replaced.
+static session_key_t g_cached_session_keys[SL_PSA_ITS_SESSION_KEY_CACHE_SIZE] = { 0 };
+
+// Incremented on every cache access, to order the entries by last use
+static uint32_t g_session_key_use_count = 0;
+
+static sli_psa_its_session_key_cache_stats_t g_session_key_cache_stats = { 0 };
 #endif // defined(SLI_PSA_ITS_ENCRYPTED)
 
 // -------------------------------------
@@ -520,12 +524,61 @@ static nvm3_ObjectKey_t prepare_its_get_nvm3_id(psa_storage_uid_t uid)
 }
 
 #if defined(SLI_PSA_ITS_ENCRYPTED)
-static inline void cache_session_key(uint8_t *session_key, psa_storage_uid_t uid)
+static session_key_t *lookup_session_key(psa_storage_uid_t uid)
+{
+  for (size_t i = 0; i < SL_PSA_ITS_SESSION_KEY_CACHE_SIZE; i++) {
+    if (g_cached_session_keys[i].active && g_cached_session_keys[i].uid == uid) {
+      g_cached_session_keys[i].last_use = ++g_session_key_use_count;
+      g_session_key_cache_stats.hits++;
+      return &g_cached_session_keys[i];
+    }
+  }
+  g_session_key_cache_stats.misses++;
+  return NULL;
+}
+
+static void cache_session_key(uint8_t *session_key, psa_storage_uid_t uid)
 {
+  session_key_t *entry = NULL;
+  session_key_t *oldest = &g_cached_session_keys[0];
+
+  // Use the entry of the UID if any, else a free entry, else the least
+  // recently used one
+  for (size_t i = 0; i < SL_PSA_ITS_SESSION_KEY_CACHE_SIZE; i++) {
+    session_key_t *candidate = &g_cached_session_keys[i];
+    if (candidate->active && candidate->uid == uid) {
+      entry = candidate;
+      break;
+    }
+    if (!candidate->active) {
+      if (entry == NULL) {
+        entry = candidate;
+      }
+    } else if ((uint32_t)(g_session_key_use_count - candidate->last_use)
+               > (uint32_t)(g_session_key_use_count - oldest->last_use)) {
+      oldest = candidate;
+    }
+  }
+  if (entry == NULL) {
+    entry = oldest;
+    memset(entry->data, 0, sizeof(entry->data));
+    g_session_key_cache_stats.evictions++;
+  }
+
   // Cache the session key
-  memcpy(g_cached_session_key.data, session_key, sizeof(g_cached_session_key.data));
-  g_cached_session_key.uid = uid;
-  g_cached_session_key.active = true;
+  memcpy(entry->data, session_key, sizeof(entry->data));
+  entry->uid = uid;
+  entry->last_use = ++g_session_key_use_count;
+  entry->active = true;
+}
+
+static void uncache_session_key(psa_storage_uid_t uid)
+{
+  for (size_t i = 0; i < SL_PSA_ITS_SESSION_KEY_CACHE_SIZE; i++) {
+    if (g_cached_session_keys[i].active && g_cached_session_keys[i].uid == uid) {
+      memset(&g_cached_session_keys[i], 0, sizeof(g_cached_session_keys[i]));
+    }
+  }
 }
 
 /**
@@ -749,10 +802,11 @@ static psa_status_t decrypt_its_file(sli_its_file_meta_v2_t *metadata,
 
   psa_status_t psa_status = PSA_ERROR_CORRUPTION_DETECTED;
   uint8_t session_key[SESSION_KEY_SIZE];
+  session_key_t *cached_session_key = lookup_session_key(metadata->uid);
 
-  if (g_cached_session_key.active && g_cached_session_key.uid == metadata->uid) {
+  if (cached_session_key != NULL) {
     // Use cached session key if it's already set and UID matches
-    memcpy(session_key, g_cached_session_key.data, sizeof(session_key));
+    memcpy(session_key, cached_session_key->data, sizeof(session_key));
   } else {
     psa_status = derive_session_key(blob->iv, AES_IV_GCM_SIZE, session_key, sizeof(session_key));
     if (psa_status != PSA_SUCCESS) {
@@ -1375,6 +1429,9 @@ psa_status_t psa_its_remove(psa_storage_uid_t uid)
       previous_lookup.set = false;
     }
     cache_clear(nvm3_object_id);
+#if defined(SLI_PSA_ITS_ENCRYPTED)
+    uncache_session_key(uid);
+#endif
 
     psa_status = PSA_SUCCESS;
   } else {
@@ -1600,6 +1657,30 @@ psa_status_t sli_psa_its_set_root_key(uint8_t *root_key, size_t root_key_size)
 }
 #endif // defined(SLI_PSA_ITS_ENCRYPTED) && !defined(SEMAILBOX_PRESENT)
 
+#if defined(SLI_PSA_ITS_ENCRYPTED)
+/**
+ * \brief Get the session key cache counters.
+ *
+ * \param[out] stats          Pointer to the structure that receives the counters.
+ */
+void sli_psa_its_get_session_key_cache_stats(sli_psa_its_session_key_cache_stats_t *stats)
+{
+  sli_its_acquire_mutex();
+  *stats = g_session_key_cache_stats;
+  sli_its_release_mutex();
+}
+
+/**
+ * \brief Reset the session key cache counters.
+ */
+void sli_psa_its_reset_session_key_cache_stats(void)
+{
+  sli_its_acquire_mutex();
+  memset(&g_session_key_cache_stats, 0, sizeof(g_session_key_cache_stats));
+  sli_its_release_mutex();
+}
+#endif // defined(SLI_PSA_ITS_ENCRYPTED)
+
 #else // (!SL_PSA_ITS_SUPPORT_V3_DRIVER)
 
 // -------------------------------------
@@ -1617,6 +1698,11 @@ psa_status_t sli_psa_its_set_root_key(uint8_t *root_key, size_t root_key_size)
 
 #define SLI_PSA_ITS_CACHE_INIT_CHUNK_SIZE 16
 
+// Index the UID stored in each NVM3 object in RAM unless disabled.
+#if !defined(SL_PSA_ITS_REMOVE_UID_INDEX)
+#define SLI_PSA_ITS_UID_INDEX
+#endif
+
 // Internal error codes local to this compile unit
 #define SLI_PSA_ITS_ECODE_NO_VALID_HEADER (ECODE_EMDRV_NVM3_BASE - 1)
 #define SLI_PSA_ITS_ECODE_NEEDS_UPGRADE   (ECODE_EMDRV_NVM3_BASE - 2)
@@ -1627,6 +1713,12 @@ psa_status_t sli_psa_its_set_root_key(uint8_t *root_key, size_t root_key_size)
 SLI_STATIC bool nvm3_uid_set_cache_initialized = false;
 SLI_STATIC uint32_t nvm3_uid_set_cache[(SL_PSA_ITS_MAX_FILES + 31) / 32] = { 0 };
 SLI_STATIC uint32_t nvm3_uid_tomb_cache[(SL_PSA_ITS_MAX_FILES + 31) / 32] = { 0 };
+#if defined(SLI_PSA_ITS_UID_INDEX)
+// Fingerprint of the UID stored in each NVM3 object, lets lookups skip objects
+// holding other UIDs without reading their metadata from flash
+SLI_STATIC uint16_t nvm3_uid_index[SL_PSA_ITS_MAX_FILES] = { 0 };
+SLI_STATIC uint32_t nvm3_uid_index_valid[(SL_PSA_ITS_MAX_FILES + 31) / 32] = { 0 };
+#endif
 #if SL_PSA_ITS_SUPPORT_V2_DRIVER
 SLI_STATIC uint32_t its_driver_version = SLI_PSA_ITS_NOT_CHECKED;
 #endif // SL_PSA_ITS_SUPPORT_V2_DRIVER
@@ -1651,15 +1743,19 @@ static root_key_t g_root_key = {
 
 typedef struct {
   bool active;
+  uint32_t last_use;
   psa_storage_uid_t uid;
   uint8_t data[SESSION_KEY_SIZE];
 } session_key_t;
 
-static session_key_t g_cached_session_key = {
-  .active = false,
-  .uid = 0,
-  .data = { 0 },
-};
+// Session keys of the most recently used files. When the cache is full, the
+// least recently used entry is zeroized and replaced.
+static session_key_t g_cached_session_keys[SL_PSA_ITS_SESSION_KEY_CACHE_SIZE] = { 0 };
+
+// Incremented on every cache access, to order the entries by last use
+static uint32_t g_session_key_use_count = 0;
+
+static sli_psa_its_session_key_cache_stats_t g_session_key_cache_stats = { 0 };
 #endif // defined(SLI_PSA_ITS_ENCRYPTED)
 
 // -------------------------------------
@@ -1683,6 +1779,10 @@ static psa_status_t find_nvm3_id(psa_storage_uid_t uid,
                                  size_t* its_file_size,
                                  nvm3_ObjectKey_t * output_nvm3_id);
 static nvm3_ObjectKey_t derive_nvm3_id(psa_storage_uid_t uid);
+static Ecode_t get_file_metadata(nvm3_ObjectKey_t key,
+                                 sli_its_file_meta_v2_t* metadata,
+                                 size_t* its_file_offset,
+                                 size_t* its_file_size);
 
 #if defined(TFM_CONFIG_SL_SECURE_LIBRARY)
 static inline bool object_lives_in_s(const void *object, size_t object_size);
@@ -1802,6 +1902,47 @@ static inline bool lookup_tomb(nvm3_ObjectKey_t key)
   return (bool)((nvm3_uid_tomb_cache[get_index(key)] >> get_offset(key)) & 0x1);
 }
 
+#if defined(SLI_PSA_ITS_UID_INDEX)
+static inline uint16_t uid_fingerprint(psa_storage_uid_t uid)
+{
+  uint32_t folded = (uint32_t)(uid >> 32) ^ (uint32_t)uid;
+  return (uint16_t)((folded >> 16) ^ folded);
+}
+#endif
+
+static inline void set_uid_index(nvm3_ObjectKey_t key, psa_storage_uid_t uid)
+{
+#if defined(SLI_PSA_ITS_UID_INDEX)
+  nvm3_uid_index[key - SLI_PSA_ITS_NVM3_RANGE_START] = uid_fingerprint(uid);
+  nvm3_uid_index_valid[get_index(key)] |= (1 << get_offset(key));
+#else
+  (void)key;
+  (void)uid;
+#endif
+}
+
+static inline void clear_uid_index(nvm3_ObjectKey_t key)
+{
+#if defined(SLI_PSA_ITS_UID_INDEX)
+  nvm3_uid_index_valid[get_index(key)] &= ~(1 << get_offset(key));
+#else
+  (void)key;
+#endif
+}
+
+// Check if an object is known to hold another UID
+static inline bool lookup_uid_index_mismatch(nvm3_ObjectKey_t key, psa_storage_uid_t uid)
+{
+#if defined(SLI_PSA_ITS_UID_INDEX)
+  return ((nvm3_uid_index_valid[get_index(key)] >> get_offset(key)) & 0x1)
+         && (nvm3_uid_index[key - SLI_PSA_ITS_NVM3_RANGE_START] != uid_fingerprint(uid));
+#else
+  (void)key;
+  (void)uid;
+  return false;
+#endif
+}
+
 static inline nvm3_ObjectKey_t increment_obj_id(nvm3_ObjectKey_t id)
 {
   return SLI_PSA_ITS_NVM3_RANGE_START + ((id - SLI_PSA_ITS_NVM3_RANGE_START + 1)
@@ -1831,6 +1972,10 @@ static inline nvm3_ObjectKey_t derive_nvm3_id(psa_storage_uid_t uid)
 
 static void init_cache(void)
 {
+#if defined(SLI_PSA_ITS_UID_INDEX)
+  sli_its_file_meta_v2_t its_file_meta;
+  Ecode_t status;
+#endif
   size_t num_keys_referenced_by_nvm3;
   nvm3_ObjectKey_t keys_referenced_by_nvm3[SLI_PSA_ITS_CACHE_INIT_CHUNK_SIZE] = { 0 };
   size_t num_del_keys_from_nvm3;
@@ -1851,6 +1996,12 @@ static void init_cache(void)
 
     for (size_t i = 0; i < num_keys_referenced_by_nvm3; i++) {
       set_cache(keys_referenced_by_nvm3[i]);
+#if defined(SLI_PSA_ITS_UID_INDEX)
+      status = get_file_metadata(keys_referenced_by_nvm3[i], &its_file_meta, NULL, NULL);
+      if (status == ECODE_NVM3_OK || status == SLI_PSA_ITS_ECODE_NEEDS_UPGRADE) {
+        set_uid_index(keys_referenced_by_nvm3[i], its_file_meta.uid);
+      }
+#endif
     }
     num_del_keys_from_nvm3 = nvm3_enumDeletedObjects(nvm3_defaultHandle,
                                                      deleted_keys_from_nvm3,
@@ -2267,6 +2418,7 @@ psa_status_t psa_its_set_v1(psa_storage_uid_t uid,
     // Power-loss might occur, however upon boot, the look-up table will be
     // re-filled as long as the data has been successfully written to NVM3.
     set_cache(nvm3_object_id);
+    set_uid_index(nvm3_object_id, uid);
   } else {
     psa_status = PSA_ERROR_STORAGE_FAILURE;
   }
@@ -2370,8 +2522,16 @@ static psa_status_t find_nvm3_id(psa_storage_uid_t uid,
         }
       }
     }
+    if (lookup_uid_index_mismatch(nvm3_object_id, uid)) {
+      // Holds another UID, no need to read its metadata
+      nvm3_object_id = increment_obj_id(nvm3_object_id);
+      continue;
+    }
     status = get_file_metadata(nvm3_object_id, its_file_meta, its_file_offset,
                                its_file_size);
+    if (status == ECODE_NVM3_OK || status == SLI_PSA_ITS_ECODE_NEEDS_UPGRADE) {
+      set_uid_index(nvm3_object_id, its_file_meta->uid);
+    }
 
     if (status == SLI_PSA_ITS_ECODE_NO_VALID_HEADER
         || status == ECODE_NVM3_ERR_READ_DATA_SIZE) {
@@ -2429,12 +2589,61 @@ static psa_status_t find_nvm3_id(psa_storage_uid_t uid,
 }
 
 #if defined(SLI_PSA_ITS_ENCRYPTED)
-static inline void cache_session_key(uint8_t *session_key, psa_storage_uid_t uid)
+static session_key_t *lookup_session_key(psa_storage_uid_t uid)
+{
+  for (size_t i = 0; i < SL_PSA_ITS_SESSION_KEY_CACHE_SIZE; i++) {
+    if (g_cached_session_keys[i].active && g_cached_session_keys[i].uid == uid) {
+      g_cached_session_keys[i].last_use = ++g_session_key_use_count;
+      g_session_key_cache_stats.hits++;
+      return &g_cached_session_keys[i];
+    }
+  }
+  g_session_key_cache_stats.misses++;
+  return NULL;
+}
+
+static void cache_session_key(uint8_t *session_key, psa_storage_uid_t uid)
 {
+  session_key_t *entry = NULL;
+  session_key_t *oldest = &g_cached_session_keys[0];
+
+  // Use the entry of the UID if any, else a free entry, else the least
+  // recently used one
+  for (size_t i = 0; i < SL_PSA_ITS_SESSION_KEY_CACHE_SIZE; i++) {
+    session_key_t *candidate = &g_cached_session_keys[i];
+    if (candidate->active && candidate->uid == uid) {
+      entry = candidate;
+      break;
+    }
+    if (!candidate->active) {
+      if (entry == NULL) {
+        entry = candidate;
+      }
+    } else if ((uint32_t)(g_session_key_use_count - candidate->last_use)
+               > (uint32_t)(g_session_key_use_count - oldest->last_use)) {
+      oldest = candidate;
+    }
+  }
+  if (entry == NULL) {
+    entry = oldest;
+    memset(entry->data, 0, sizeof(entry->data));
+    g_session_key_cache_stats.evictions++;
+  }
+
   // Cache the session key
-  memcpy(g_cached_session_key.data, session_key, sizeof(g_cached_session_key.data));
-  g_cached_session_key.uid = uid;
-  g_cached_session_key.active = true;
+  memcpy(entry->data, session_key, sizeof(entry->data));
+  entry->uid = uid;
+  entry->last_use = ++g_session_key_use_count;
+  entry->active = true;
+}
+
+static void uncache_session_key(psa_storage_uid_t uid)
+{
+  for (size_t i = 0; i < SL_PSA_ITS_SESSION_KEY_CACHE_SIZE; i++) {
+    if (g_cached_session_keys[i].active && g_cached_session_keys[i].uid == uid) {
+      memset(&g_cached_session_keys[i], 0, sizeof(g_cached_session_keys[i]));
+    }
+  }
 }
 
 /**
@@ -2658,10 +2867,11 @@ static psa_status_t sli_decrypt_its_file(sli_its_file_meta_v2_t *metadata,
 
   psa_status_t psa_status = PSA_ERROR_CORRUPTION_DETECTED;
   uint8_t session_key[SESSION_KEY_SIZE];
+  session_key_t *cached_session_key = lookup_session_key(metadata->uid);
 
-  if (g_cached_session_key.active && g_cached_session_key.uid == metadata->uid) {
+  if (cached_session_key != NULL) {
     // Use cached session key if it's already set and UID matches
-    memcpy(session_key, g_cached_session_key.data, sizeof(session_key));
+    memcpy(session_key, cached_session_key->data, sizeof(session_key));
   } else {
     psa_status = derive_session_key(blob->iv, AES_GCM_IV_SIZE, session_key, sizeof(session_key));
     if (psa_status != PSA_SUCCESS) {
@@ -2908,6 +3118,7 @@ psa_status_t psa_its_set(psa_storage_uid_t uid,
     // Power-loss might occur, however upon boot, the look-up table will be
     // re-filled as long as the data has been successfully written to NVM3.
     set_cache(nvm3_object_id);
+    set_uid_index(nvm3_object_id, uid);
   } else {
     psa_status = PSA_ERROR_STORAGE_FAILURE;
   }
@@ -3171,7 +3382,11 @@ psa_status_t psa_its_remove(psa_storage_uid_t uid)
     // Power-loss might occur, however upon boot, the look-up table will be
     // re-filled as long as the data has been successfully written to NVM3.
     clear_cache(nvm3_object_id);
+    clear_uid_index(nvm3_object_id);
     set_tomb(nvm3_object_id);
+#if defined(SLI_PSA_ITS_ENCRYPTED)
+    uncache_session_key(uid);
+#endif
     psa_status = PSA_SUCCESS;
   } else {
     psa_status = PSA_ERROR_STORAGE_FAILURE;
@@ -3299,5 +3514,29 @@ psa_status_t sli_psa_its_set_root_key(uint8_t *root_key, size_t root_key_size)
   return PSA_SUCCESS;
 }
 #endif // defined(SLI_PSA_ITS_ENCRYPTED) && !defined(SEMAILBOX_PRESENT)
+
+#if defined(SLI_PSA_ITS_ENCRYPTED)
+/**
+ * \brief Get the session key cache counters.
+ *
+ * \param[out] stats          Pointer to the structure that receives the counters.
+ */
+void sli_psa_its_get_session_key_cache_stats(sli_psa_its_session_key_cache_stats_t *stats)
+{
+  sli_its_acquire_mutex();
+  *stats = g_session_key_cache_stats;
+  sli_its_release_mutex();
+}
+
+/**
+ * \brief Reset the session key cache counters.
+ */
+void sli_psa_its_reset_session_key_cache_stats(void)
+{
+  sli_its_acquire_mutex();
+  memset(&g_session_key_cache_stats, 0, sizeof(g_session_key_cache_stats));
+  sli_its_release_mutex();
+}
+#endif // defined(SLI_PSA_ITS_ENCRYPTED)
 #endif // (!SL_PSA_ITS_SUPPORT_V3_DRIVER)
 #endif // MBEDTLS_PSA_CRYPTO_STORAGE_C && !MBEDTLS_PSA_ITS_FILE_C
@@ -1822,4 +1822,155 @@ psa_status_t sli_cryptoacc_transparent_aead_abort(sli_cryptoacc_transparent_aead
   return PSA_SUCCESS;
 }
 
+#if SL_CRYPTOACC_AEAD_BATCH && (defined(PSA_WANT_ALG_CCM) || defined(PSA_WANT_ALG_CTR))
+
+// Descriptors of the items of one transfer. Only used while owning the
+// CRYPTOACC, which serializes the callers.
+static struct sx_aes_batch_item batch_workspace[SLI_CRYPTOACC_BATCH_MAX_ITEMS];
+
+static psa_status_t check_batch_item(const sli_cryptoacc_transparent_batch_item_t *item,
+                                     bool is_ccm)
+{
+  if (item->key == NULL
+      || (item->key_length != 16 && item->key_length != 24 && item->key_length != 32)
+      || item->nonce == NULL
+      || (item->input_length > 0 && (item->input == NULL || item->output == NULL))
+      || (item->output > item->input && item->output < item->input + item->input_length)) {
+    return PSA_ERROR_INVALID_ARGUMENT;
+  }
+
+  if (!is_ccm) {
+    if (item->nonce_length != AES_IV_SIZE || item->input_length == 0) {
+      return PSA_ERROR_INVALID_ARGUMENT;
+    }
+    return PSA_SUCCESS;
+  }
+
+  unsigned char q = 16 - 1 - (unsigned char) item->nonce_length;
+  if (item->nonce_length < 7
+      || item->nonce_length > 13
+      || (item->additional_data == NULL && item->additional_data_length > 0)
+      || item->tag == NULL
+      || item->tag_length < 4
+      || item->tag_length > 16
+      || item->tag_length % 2 != 0
+      || (q < sizeof(item->input_length)
+          && item->input_length >= (1UL << (q * 8)))) {
+    return PSA_ERROR_INVALID_ARGUMENT;
+  }
+  return PSA_SUCCESS;
+}
+
+#endif // SL_CRYPTOACC_AEAD_BATCH && (PSA_WANT_ALG_CCM || PSA_WANT_ALG_CTR)
+
+// Process independent AES-CTR or AES-CCM messages, each with its own key and
+// nonce. Up to SLI_CRYPTOACC_BATCH_MAX_ITEMS messages are chained in one
+// CRYPTOACC transfer, which saves the setup of a transfer per message.
+// Returns PSA_ERROR_NOT_SUPPORTED unless SL_CRYPTOACC_AEAD_BATCH is enabled.
+psa_status_t sli_cryptoacc_transparent_aead_batch(psa_algorithm_t alg,
+                                                  bool encrypt,
+                                                  sli_cryptoacc_transparent_batch_item_t *items,
+                                                  size_t item_count)
+{
+#if SL_CRYPTOACC_AEAD_BATCH && (defined(PSA_WANT_ALG_CCM) || defined(PSA_WANT_ALG_CTR))
+
+  enum sx_aes_batch_mode mode;
+  bool is_ccm = false;
+  psa_status_t return_status = PSA_SUCCESS;
+  psa_status_t status;
+
+  if (items == NULL || item_count == 0) {
+    return PSA_ERROR_INVALID_ARGUMENT;
+  }
+
+#if defined(PSA_WANT_ALG_CTR)
+  if (alg == PSA_ALG_CTR) {
+    mode = encrypt ? SX_AES_BATCH_CTR_ENCRYPT : SX_AES_BATCH_CTR_DECRYPT;
+  } else
+#endif // PSA_WANT_ALG_CTR
+#if defined(PSA_WANT_ALG_CCM)
+  if (PSA_ALG_IS_AEAD(alg)
+      && PSA_ALG_AEAD_WITH_SHORTENED_TAG(alg, 0) == PSA_ALG_AEAD_WITH_SHORTENED_TAG(PSA_ALG_CCM, 0)) {
+    mode = encrypt ? SX_AES_BATCH_CCM_ENCRYPT : SX_AES_BATCH_CCM_DECRYPT;
+    is_ccm = true;
+  } else
+#endif // PSA_WANT_ALG_CCM
+  {
+    return PSA_ERROR_NOT_SUPPORTED;
+  }
+
+  for (size_t i = 0; i < item_count; i++) {
+    items[i].status = check_batch_item(&items[i], is_ccm);
+    if (items[i].status != PSA_SUCCESS) {
+      return_status = items[i].status;
+    }
+  }
+  if (return_status != PSA_SUCCESS) {
+    return return_status;
+  }
+
+  for (size_t first = 0; first < item_count; first += SLI_CRYPTOACC_BATCH_MAX_ITEMS) {
+    size_t count = item_count - first;
+    if (count > SLI_CRYPTOACC_BATCH_MAX_ITEMS) {
+      count = SLI_CRYPTOACC_BATCH_MAX_ITEMS;
+    }
+
+    status = cryptoacc_management_acquire();
+    if (status != PSA_SUCCESS) {
+      return status;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+      const sli_cryptoacc_transparent_batch_item_t *item = &items[first + i];
+      struct sx_aes_batch_item *work = &batch_workspace[i];
+
+      work->key = block_t_convert(item->key, item->key_length);
+      work->iv = block_t_convert(item->nonce, item->nonce_length);
+      work->aad = block_t_convert(item->additional_data,
+                                  is_ccm ? item->additional_data_length : 0);
+      work->datain = block_t_convert(item->input, item->input_length);
+      work->dataout = block_t_convert(item->output, item->input_length);
+      work->mac = block_t_convert(item->tag, is_ccm ? item->tag_length : 0);
+    }
+
+    uint32_t sx_ret = sx_aes_batch(mode, batch_workspace, count);
+
+    for (size_t i = 0; i < count; i++) {
+      sli_cryptoacc_transparent_batch_item_t *item = &items[first + i];
+
+      if (sx_ret != CRYPTOLIB_SUCCESS && sx_ret != CRYPTOLIB_INVALID_SIGN_ERR) {
+        item->status = PSA_ERROR_HARDWARE_FAILURE;
+      } else if (batch_workspace[i].status != CRYPTOLIB_SUCCESS) {
+        // Do not release unauthenticated plaintext.
+        item->status = PSA_ERROR_INVALID_SIGNATURE;
+        memset(item->output, 0, item->input_length);
+      } else {
+        item->status = PSA_SUCCESS;
+      }
+      if (item->status != PSA_SUCCESS && return_status == PSA_SUCCESS) {
+        return_status = item->status;
+      }
+    }
+    memset(batch_workspace, 0, count * sizeof(batch_workspace[0]));
+
+    status = cryptoacc_management_release();
+    if (status != PSA_SUCCESS) {
+      return PSA_ERROR_HARDWARE_FAILURE;
+    }
+  }
+
+  return return_status;
+
+#else // SL_CRYPTOACC_AEAD_BATCH && (PSA_WANT_ALG_CCM || PSA_WANT_ALG_CTR)
+
+  (void)alg;
+  (void)encrypt;
+  (void)items;
+  (void)item_count;
+
+  return PSA_ERROR_NOT_SUPPORTED;
+
+#endif // SL_CRYPTOACC_AEAD_BATCH && (PSA_WANT_ALG_CCM || PSA_WANT_ALG_CTR)
+}
+
 #endif // defined(CRYPTOACC_PRESENT)
@@ -82,6 +82,31 @@ static const uint8_t init_state_sha256[32] = {
 };
 #endif // PSA_WANT_ALG_SHA_256
 
+// Hash whole blocks into the intermediate state of the operation.
+static psa_status_t hash_update_blocks(sli_cryptoacc_transparent_hash_operation_t *operation,
+                                       const uint8_t *input,
+                                       size_t input_length)
+{
+  block_t state = block_t_convert((uint8_t*)operation->state,
+                                  sx_hash_get_state_size(operation->hash_type));
+  block_t data_in = block_t_convert((uint8_t*)input, input_length);
+  uint32_t sx_ret;
+  psa_status_t status;
+
+  status = cryptoacc_management_acquire();
+  if (status != PSA_SUCCESS) {
+    return status;
+  }
+  sx_ret = sx_hash_update_blk(operation->hash_type, state, data_in);
+  status = cryptoacc_management_release();
+  if (sx_ret != CRYPTOLIB_SUCCESS
+      || status != PSA_SUCCESS) {
+    return PSA_ERROR_HARDWARE_FAILURE;
+  }
+
+  return PSA_SUCCESS;
+}
+
 #endif // PSA_WANT_ALG_SHA_*
 
 psa_status_t sli_cryptoacc_transparent_hash_setup(sli_cryptoacc_transparent_hash_operation_t *operation,
@@ -147,10 +172,7 @@ psa_status_t sli_cryptoacc_transparent_hash_update(sli_cryptoacc_transparent_has
   || defined(PSA_WANT_ALG_SHA_224) \
   || defined(PSA_WANT_ALG_SHA_256)
 
-  size_t blocks, fill, left;
-  block_t data_in;
-  block_t state;
-  uint32_t sx_ret;
+  size_t blocks, fill;
   psa_status_t status;
 
   if (operation == NULL
@@ -178,58 +200,48 @@ psa_status_t sli_cryptoacc_transparent_hash_update(sli_cryptoacc_transparent_has
     return PSA_SUCCESS;
   }
 
-  state = block_t_convert((uint8_t*)operation->state,
-                          sx_hash_get_state_size(operation->hash_type));
-
-  // Same blocksize for all of SHA-256, SHA-224, and SHA-256.
-  left = (operation->total & (SHA256_BLOCKSIZE - 1));
-  fill = SHA256_BLOCKSIZE - left;
-
   operation->total += input_length;
 
-  if ((left > 0) && (input_length >= fill)) {
-    memcpy((void *)(operation->buffer + left), input, fill);
+  // Top up the staging buffer, and only hash it once it is full.
+  if (operation->buffered > 0) {
+    fill = sizeof(operation->buffer) - operation->buffered;
+    if (fill > input_length) {
+      fill = input_length;
+    }
+    memcpy((void *)(operation->buffer + operation->buffered), input, fill);
+    operation->buffered += fill;
+    input += fill;
+    input_length -= fill;
 
-    data_in = block_t_convert(operation->buffer, SHA256_BLOCKSIZE);
+    if (operation->buffered < sizeof(operation->buffer)) {
+      return PSA_SUCCESS;
+    }
 
-    status = cryptoacc_management_acquire();
+    status = hash_update_blocks(operation, operation->buffer, sizeof(operation->buffer));
     if (status != PSA_SUCCESS) {
       return status;
     }
-    sx_ret = sx_hash_update_blk(operation->hash_type, state, data_in);
-    status = cryptoacc_management_release();
-    if (sx_ret != CRYPTOLIB_SUCCESS
-        || status != PSA_SUCCESS) {
-      return PSA_ERROR_HARDWARE_FAILURE;
-    }
-
-    input += fill;
-    input_length -= fill;
-    left = 0;
+    operation->buffered = 0;
   }
 
-  if (input_length >= SHA256_BLOCKSIZE) {
+  // Hash the whole blocks of an input at least as large as the staging buffer
+  // straight from the input. Same blocksize for all of SHA-1, SHA-224, and
+  // SHA-256.
+  if (input_length >= sizeof(operation->buffer)) {
     blocks = input_length / SHA256_BLOCKSIZE;
 
-    data_in = block_t_convert((uint8_t*)input, SHA256_BLOCKSIZE * blocks);
-
-    status = cryptoacc_management_acquire();
+    status = hash_update_blocks(operation, input, SHA256_BLOCKSIZE * blocks);
     if (status != PSA_SUCCESS) {
       return status;
     }
-    sx_ret = sx_hash_update_blk(operation->hash_type, state, data_in);
-    status = cryptoacc_management_release();
-    if (sx_ret != CRYPTOLIB_SUCCESS
-        || status != PSA_SUCCESS) {
-      return PSA_ERROR_HARDWARE_FAILURE;
-    }
 
     input += SHA256_BLOCKSIZE * blocks;
     input_length -= SHA256_BLOCKSIZE * blocks;
   }
 
   if (input_length > 0) {
-    memcpy((void *)(operation->buffer + left), input, input_length);
+    memcpy((void *)operation->buffer, input, input_length);
+    operation->buffered = input_length;
   }
 
   return PSA_SUCCESS;
@@ -289,7 +301,7 @@ psa_status_t sli_cryptoacc_transparent_hash_finish(sli_cryptoacc_transparent_has
   state = block_t_convert((uint8_t*)operation->state,
                           sx_hash_get_state_size(operation->hash_type));
   data_in = block_t_convert((uint8_t*)operation->buffer,
-                            (operation->total & (SHA256_BLOCKSIZE - 1)));
+                            operation->buffered);
 
   data_out = block_t_convert((uint8_t*)operation->state,
                              sx_hash_get_state_size(operation->hash_type));
@@ -46,6 +46,131 @@
 
 #include <string.h>
 
+#if defined(SLI_PSA_DRIVER_FEATURE_P256R1) && (SL_CRYPTOACC_ECC_KEYPAIR_CACHE_SIZE > 0)
+  #define ECC_KEYPAIR_CACHE
+  #include "sl_component_catalog.h"
+  #if defined(SL_CATALOG_SLEEPTIMER_PRESENT) && (SL_CRYPTOACC_ECC_KEYPAIR_CACHE_MAX_AGE_S > 0)
+    #include "sl_sleeptimer.h"
+    #define ECC_KEYPAIR_CACHE_EXPIRY
+  #endif
+#endif
+
+// -----------------------------------------------------------------------------
+// Keypair cache
+//
+// LE Secure Connections pairing generates a P-256 keypair and exports its
+// public key at connection time. The cache generates the next keypairs in
+// idle time, psa_generate_key() then takes the private key from the cache and
+// the export of its public key returns the precomputed one.
+
+#if defined(ECC_KEYPAIR_CACHE)
+
+#define ECC_KEYPAIR_PRIV_SIZE (32)
+#define ECC_KEYPAIR_PUB_SIZE  (64)
+
+typedef struct {
+  uint8_t priv[ECC_KEYPAIR_PRIV_SIZE];
+  uint8_t pub[ECC_KEYPAIR_PUB_SIZE];
+  uint64_t created;                   // Sleeptimer ticks
+  bool valid;
+} ecc_keypair_t;
+
+static ecc_keypair_t ecc_keypair_cache[SL_CRYPTOACC_ECC_KEYPAIR_CACHE_SIZE];
+
+// Keypair handed out by the last cache hit, until its public key is exported.
+static ecc_keypair_t ecc_keypair_issued;
+
+static bool ecc_keypair_cache_enabled = true;
+static bool ecc_keypair_cache_refill_pending = false;
+static bool ecc_keypair_cache_refill_failed = false;
+static sli_cryptoacc_ecc_keypair_cache_stats_t ecc_keypair_cache_stats;
+
+static void ecc_keypair_wipe(ecc_keypair_t *keypair)
+{
+  sli_psa_zeroize(keypair, sizeof(*keypair));
+}
+
+static uint64_t ecc_keypair_now(void)
+{
+#if defined(ECC_KEYPAIR_CACHE_EXPIRY)
+  return sl_sleeptimer_get_tick_count64();
+#else
+  return 0;
+#endif
+}
+
+static bool ecc_keypair_is_expired(const ecc_keypair_t *keypair)
+{
+#if defined(ECC_KEYPAIR_CACHE_EXPIRY)
+  uint64_t age_ms = 0;
+
+  sl_sleeptimer_tick64_to_ms(ecc_keypair_now() - keypair->created, &age_ms);
+  return age_ms >= (uint64_t)SL_CRYPTOACC_ECC_KEYPAIR_CACHE_MAX_AGE_S * 1000u;
+#else
+  (void)keypair;
+  return false;
+#endif
+}
+
+// Generate a P-256 keypair. The caller owns the CRYPTOACC.
+static psa_status_t ecc_keypair_generate(ecc_keypair_t *keypair)
+{
+  block_t n = block_t_convert(sx_ecc_curve_p256.params.addr + (1 * sx_ecc_curve_p256.bytesize),
+                              sx_ecc_curve_p256.bytesize);
+  block_t priv = block_t_convert(keypair->priv, sizeof(keypair->priv));
+  block_t pub = block_t_convert(keypair->pub, sizeof(keypair->pub));
+
+  uint32_t sx_ret = ecc_generate_private_key(n, priv, sli_cryptoacc_trng_wrapper);
+  if (sx_ret == CRYPTOLIB_SUCCESS) {
+    sx_ret = ecc_generate_public_key(sx_ecc_curve_p256.params,
+                                     pub,
+                                     priv,
+                                     sizeof(keypair->priv),
+                                     sx_ecc_curve_p256.pk_flags);
+  }
+  if (sx_ret != CRYPTOLIB_SUCCESS) {
+    ecc_keypair_wipe(keypair);
+    return PSA_ERROR_HARDWARE_FAILURE;
+  }
+
+  keypair->created = ecc_keypair_now();
+  keypair->valid = true;
+  return PSA_SUCCESS;
+}
+
+// Move a cached keypair to the issued slot, if there is one.
+static bool ecc_keypair_cache_take(void)
+{
+  bool hit = false;
+
+  ecc_keypair_wipe(&ecc_keypair_issued);
+  for (size_t i = 0; i < SL_CRYPTOACC_ECC_KEYPAIR_CACHE_SIZE; i++) {
+    if (!ecc_keypair_cache[i].valid) {
+      continue;
+    }
+    if (ecc_keypair_is_expired(&ecc_keypair_cache[i])) {
+      ecc_keypair_wipe(&ecc_keypair_cache[i]);
+      ecc_keypair_cache_stats.expired++;
+      continue;
+    }
+    if (!hit) {
+      ecc_keypair_issued = ecc_keypair_cache[i];
+      ecc_keypair_wipe(&ecc_keypair_cache[i]);
+      hit = true;
+    }
+  }
+
+  if (hit) {
+    ecc_keypair_cache_stats.hits++;
+  } else {
+    ecc_keypair_cache_stats.misses++;
+  }
+  ecc_keypair_cache_refill_failed = false;
+  return hit;
+}
+
+#endif // ECC_KEYPAIR_CACHE
+
 // -----------------------------------------------------------------------------
 // Driver entry points
 
@@ -133,6 +258,18 @@ psa_status_t sli_cryptoacc_transparent_generate_key(
 
   block_t priv = block_t_convert(key_buffer, PSA_BITS_TO_BYTES(key_bits));
 
+#if defined(ECC_KEYPAIR_CACHE)
+  if (ecc_keypair_cache_enabled
+      && key_bits == 256
+      && curve_type == PSA_ECC_FAMILY_SECP_R1) {
+    if (ecc_keypair_cache_take()) {
+      memcpy(key_buffer, ecc_keypair_issued.priv, ECC_KEYPAIR_PRIV_SIZE);
+      *key_length = ECC_KEYPAIR_PRIV_SIZE;
+      return PSA_SUCCESS;
+    }
+  }
+#endif // ECC_KEYPAIR_CACHE
+
   // Get random number < n -> private key.
   psa_status_t status = cryptoacc_management_acquire();
   if (status != PSA_SUCCESS) {
@@ -258,6 +395,22 @@ psa_status_t sli_cryptoacc_transparent_export_public_key(
   block_t priv = block_t_convert(key_buffer, PSA_BITS_TO_BYTES(key_bits));
   block_t pub = block_t_convert(data + 1, PSA_BITS_TO_BYTES(key_bits) * 2);
 
+#if defined(ECC_KEYPAIR_CACHE)
+  // The public key of a keypair from the cache is already known.
+  if (ecc_keypair_issued.valid
+      && key_bits == 256
+      && curve_type == PSA_ECC_FAMILY_SECP_R1
+      && sli_psa_safer_memcmp(key_buffer,
+                              ecc_keypair_issued.priv,
+                              ECC_KEYPAIR_PRIV_SIZE) == 0) {
+    memcpy(data + 1, ecc_keypair_issued.pub, ECC_KEYPAIR_PUB_SIZE);
+    ecc_keypair_wipe(&ecc_keypair_issued);
+    data[0] = 0x04;
+    *data_length = ECC_KEYPAIR_PUB_SIZE + 1;
+    return PSA_SUCCESS;
+  }
+#endif // ECC_KEYPAIR_CACHE
+
   psa_status_t status = cryptoacc_management_acquire();
   if (status != PSA_SUCCESS) {
     return status;
@@ -481,4 +634,105 @@ psa_status_t sli_cryptoacc_transparent_import_key(
 #endif // SLI_PSA_DRIVER_FEATURE_ECC
 }
 
+// -----------------------------------------------------------------------------
+// Keypair cache entry points
+
+/***************************************************************************//**
+ * Check whether the keypair cache needs a refill before sleeping. Call from
+ * the app_is_ok_to_sleep() power manager hook, with interrupts disabled.
+ * Returns false to stay awake for one more pass of the super loop, in which
+ * sli_cryptoacc_ecc_keypair_cache_process_action() generates the keypair.
+ ******************************************************************************/
+bool sli_cryptoacc_ecc_keypair_cache_is_ok_to_sleep(void)
+{
+#if defined(ECC_KEYPAIR_CACHE)
+  if (!ecc_keypair_cache_enabled || ecc_keypair_cache_refill_failed) {
+    return true;
+  }
+  for (size_t i = 0; i < SL_CRYPTOACC_ECC_KEYPAIR_CACHE_SIZE; i++) {
+    if (!ecc_keypair_cache[i].valid || ecc_keypair_is_expired(&ecc_keypair_cache[i])) {
+      ecc_keypair_cache_refill_pending = true;
+      return false;
+    }
+  }
+#endif // ECC_KEYPAIR_CACHE
+
+  return true;
+}
+
+/***************************************************************************//**
+ * Generate one keypair for the cache, if
+ * sli_cryptoacc_ecc_keypair_cache_is_ok_to_sleep() asked for it. Call from
+ * the super loop. Blocks for one keypair generation.
+ ******************************************************************************/
+void sli_cryptoacc_ecc_keypair_cache_process_action(void)
+{
+#if defined(ECC_KEYPAIR_CACHE)
+  if (!ecc_keypair_cache_refill_pending) {
+    return;
+  }
+  ecc_keypair_cache_refill_pending = false;
+
+  for (size_t i = 0; i < SL_CRYPTOACC_ECC_KEYPAIR_CACHE_SIZE; i++) {
+    ecc_keypair_t *keypair = &ecc_keypair_cache[i];
+
+    if (keypair->valid) {
+      if (!ecc_keypair_is_expired(keypair)) {
+        continue;
+      }
+      ecc_keypair_wipe(keypair);
+      ecc_keypair_cache_stats.expired++;
+    }
+
+    psa_status_t status = cryptoacc_management_acquire();
+    if (status == PSA_SUCCESS) {
+      status = ecc_keypair_generate(keypair);
+      if (cryptoacc_management_release() != PSA_SUCCESS) {
+        ecc_keypair_wipe(keypair);
+        status = PSA_ERROR_HARDWARE_FAILURE;
+      }
+    }
+    if (status != PSA_SUCCESS) {
+      // Do not keep the system awake retrying, until the cache is used again.
+      ecc_keypair_cache_refill_failed = true;
+    } else {
+      ecc_keypair_cache_stats.refills++;
+    }
+    return;
+  }
+#endif // ECC_KEYPAIR_CACHE
+}
+
+/***************************************************************************//**
+ * Enable or disable the keypair cache, for instance to measure pairing with
+ * and without it. Disabling wipes the cached keypairs.
+ ******************************************************************************/
+void sli_cryptoacc_ecc_keypair_cache_enable(bool enable)
+{
+#if defined(ECC_KEYPAIR_CACHE)
+  ecc_keypair_cache_enabled = enable;
+  if (!enable) {
+    for (size_t i = 0; i < SL_CRYPTOACC_ECC_KEYPAIR_CACHE_SIZE; i++) {
+      ecc_keypair_wipe(&ecc_keypair_cache[i]);
+    }
+    ecc_keypair_wipe(&ecc_keypair_issued);
+  }
+#else
+  (void)enable;
+#endif // ECC_KEYPAIR_CACHE
+}
+
+/***************************************************************************//**
+ * Get the counters of the keypair cache. All zero if the cache is disabled at
+ * build time.
+ ******************************************************************************/
+void sli_cryptoacc_ecc_keypair_cache_get_stats(sli_cryptoacc_ecc_keypair_cache_stats_t *stats)
+{
+#if defined(ECC_KEYPAIR_CACHE)
+  *stats = ecc_keypair_cache_stats;
+#else
+  memset(stats, 0, sizeof(*stats));
+#endif // ECC_KEYPAIR_CACHE
+}
+
 #endif // SLI_MBEDTLS_DEVICE_VSE
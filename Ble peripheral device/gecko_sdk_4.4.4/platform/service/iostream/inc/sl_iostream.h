@@ -112,6 +112,8 @@ typedef struct {
   void *context;                                                                                ///< context
   sl_status_t (*write)(void *context, const void *buffer, size_t buffer_length);                ///< write
   sl_status_t (*read)(void *context, void *buffer, size_t buffer_length, size_t *bytes_read);   ///< read
+  sl_status_t (*peek)(void *context, const void **span, size_t *span_length);                   ///< peek. Optional, NULL when not supported.
+  sl_status_t (*commit)(void *context, size_t length);                                          ///< commit. Optional, NULL when not supported.
 } sl_iostream_t;
 
 /// @brief Enumeration representing the possible types of iostream instances.
@@ -208,6 +210,49 @@ sl_status_t sl_iostream_read(sl_iostream_t *stream,
                              size_t buffer_length,
                              size_t *bytes_read);
 
+/***************************************************************************//**
+ * Get a contiguous span of received data without copying it out of the stream.
+ *
+ * @param[in]  stream        I/O Stream to be used.
+ *                             SL_IOSTREAM_STDIN;            Default input stream will be used.
+ *                             Pointer to specific stream;   Specific stream will be used.
+ *
+ * @param[out] span          Pointer to the first unread byte in the stream's
+ *                           receive buffer.
+ *
+ * @param[out] span_length   Number of contiguous bytes readable from span.
+ *
+ * @return  Status result
+ *            SL_STATUS_OK;                    Data is available in span.
+ *            SL_STATUS_EMPTY;                 No data received.
+ *            SL_STATUS_NOT_SUPPORTED;         The stream cannot expose its receive buffer.
+ *            SL_STATUS_INVALID_CONFIGURATION; No stream or stream has no read support.
+ *
+ * @note  The span stays valid until it is released with sl_iostream_commit().
+ *        When the receive buffer wraps around, the remaining data is returned
+ *        by the next call, after the current span has been committed.
+ *        This function never blocks and must not be interleaved with
+ *        sl_iostream_read() on the same stream.
+ ******************************************************************************/
+sl_status_t sl_iostream_peek(sl_iostream_t *stream,
+                             const void **span,
+                             size_t *span_length);
+
+/***************************************************************************//**
+ * Release data previously obtained with sl_iostream_peek().
+ *
+ * @param[in] stream   I/O Stream to be used.
+ *                       SL_IOSTREAM_STDIN;            Default input stream will be used.
+ *                       Pointer to specific stream;   Specific stream will be used.
+ *
+ * @param[in] length   Number of bytes consumed from the start of the span. Must
+ *                     not exceed the span length returned by the last peek.
+ *
+ * @return  Status result
+ ******************************************************************************/
+sl_status_t sl_iostream_commit(sl_iostream_t *stream,
+                               size_t length);
+
 /***************************************************************************//**
  * Print a character on stream.
  *
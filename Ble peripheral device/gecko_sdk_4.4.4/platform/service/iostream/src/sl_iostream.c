@@ -64,6 +64,8 @@ static sl_iostream_t  *sli_iostream_default = NULL;
 sl_iostream_t sl_iostream_null = {
   .write   = NULL,
   .read    = NULL,
+  .peek    = NULL,
+  .commit  = NULL,
   .context = NULL
 };
 
@@ -215,6 +217,53 @@ sl_status_t sl_iostream_read(sl_iostream_t *stream,
   }
 }
 
+/***************************************************************************//**
+ * Stream peek implementation
+ ******************************************************************************/
+sl_status_t sl_iostream_peek(sl_iostream_t *stream,
+                             const void **span,
+                             size_t *span_length)
+{
+  if (stream == SL_IOSTREAM_STDIN) {
+    stream = sl_iostream_get_default();
+  }
+
+  if ((span == NULL) || (span_length == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if ((stream == NULL) || (stream->read == NULL)) {
+    return SL_STATUS_INVALID_CONFIGURATION;
+  }
+
+  if (stream->peek == NULL) {
+    return SL_STATUS_NOT_SUPPORTED;
+  }
+
+  return stream->peek(stream->context, span, span_length);
+}
+
+/***************************************************************************//**
+ * Stream commit implementation
+ ******************************************************************************/
+sl_status_t sl_iostream_commit(sl_iostream_t *stream,
+                               size_t length)
+{
+  if (stream == SL_IOSTREAM_STDIN) {
+    stream = sl_iostream_get_default();
+  }
+
+  if ((stream == NULL) || (stream->read == NULL)) {
+    return SL_STATUS_INVALID_CONFIGURATION;
+  }
+
+  if (stream->commit == NULL) {
+    return SL_STATUS_NOT_SUPPORTED;
+  }
+
+  return stream->commit(stream->context, length);
+}
+
 /***************************************************************************//**
  * Stream putchar implementation
  ******************************************************************************/
@@ -0,0 +1,83 @@
+/***************************************************************************//**
+ * @file
+ * @brief Power Manager energy mode profiling API definition.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+
+#ifndef SL_POWER_MANAGER_PROFILE_H
+#define SL_POWER_MANAGER_PROFILE_H
+
+#include <stdint.h>
+#include "sl_power_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @addtogroup power_manager
+ * @{
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+// Defines
+
+/// Number of energy modes profiled, EM0 to EM3.
+#define SL_POWER_MANAGER_PROFILE_EM_COUNT           4
+
+/// Number of bins of the active time histogram.
+#define SL_POWER_MANAGER_PROFILE_ACTIVE_TIME_BINS   16
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+/// Source of a wakeup, from the interrupt pending when the core wakes up.
+/// Only the interrupts that can wake up the core from the energy mode it left
+/// are classified, the USART and the radio core only from EM1.
+SL_ENUM(sl_power_manager_wakeup_source_t) {
+  SL_POWER_MANAGER_WAKEUP_SOURCE_SLEEPTIMER = 0,  ///< Sleeptimer interrupt
+  SL_POWER_MANAGER_WAKEUP_SOURCE_RADIO,           ///< Radio interrupt, for example a BLE event
+  SL_POWER_MANAGER_WAKEUP_SOURCE_UART,            ///< UART receive interrupt
+  SL_POWER_MANAGER_WAKEUP_SOURCE_OTHER,           ///< Any other interrupt
+  SL_POWER_MANAGER_WAKEUP_SOURCE_COUNT            ///< Number of wakeup sources
+};
+
+/// Energy mode profile.
+typedef struct {
+  uint64_t duration_tick;                                         ///< Sleeptimer ticks covered by the profile
+  uint64_t residency_tick[SL_POWER_MANAGER_PROFILE_EM_COUNT];     ///< Sleeptimer ticks spent in each energy mode. EM0 is the time the core runs.
+  uint32_t transition_count[SL_POWER_MANAGER_PROFILE_EM_COUNT];   ///< Transitions into each energy mode
+  uint32_t wakeup_count[SL_POWER_MANAGER_WAKEUP_SOURCE_COUNT];    ///< Wakeups by source
+  uint32_t active_time_histogram[SL_POWER_MANAGER_PROFILE_ACTIVE_TIME_BINS];  ///< Active periods from wakeup to sleep. Bin n counts the periods of 2^n to 2^(n+1) - 1 ticks, the last bin counts longer ones too.
+} sl_power_manager_profile_t;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************//**
+ * Get the energy mode profile accumulated since the initialization or the
+ * last reset.
+ *
+ * @param profile  Pointer to the profile to fill.
+ *
+ * @note The residency of the current energy mode is accounted up to the call.
+ ******************************************************************************/
+void sl_power_manager_profile_get(sl_power_manager_profile_t *profile);
+
+/***************************************************************************//**
+ * Reset the energy mode profile.
+ ******************************************************************************/
+void sl_power_manager_profile_reset(void);
+
+/** @} (end addtogroup power_manager) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_POWER_MANAGER_PROFILE_H
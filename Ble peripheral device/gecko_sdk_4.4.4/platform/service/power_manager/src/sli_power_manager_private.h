@@ -77,6 +77,12 @@ void sli_power_manager_apply_em(sl_power_manager_em_t em);
 
 void sli_power_manager_debug_init(void);
 
+void sli_power_manager_profile_init(void);
+
+void sli_power_manager_profile_on_sleep(sl_power_manager_em_t em);
+
+void sli_power_manager_profile_on_wakeup(void);
+
 #if !defined(SL_CATALOG_POWER_MANAGER_NO_DEEPSLEEP_PRESENT)
 void sli_power_manager_save_states(void);
 
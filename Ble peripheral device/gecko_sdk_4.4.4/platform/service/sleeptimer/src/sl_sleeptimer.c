@@ -70,6 +70,42 @@
 // The difference should be null or of few ticks since the counter never stop.
 #define MIN_DIFF_BETWEEN_COUNT_AND_EXPIRATION  2
 
+#if !defined(SL_SLEEPTIMER_TIMER_COALESCING)
+#define SL_SLEEPTIMER_TIMER_COALESCING         1
+#endif
+
+// Option flags of a timer, without its slack.
+#define OPTION_FLAGS(handle)                   ((uint16_t)((handle)->option_flags & ~SL_SLEEPTIMER_SLACK_MASK))
+
+#if !defined(SL_SLEEPTIMER_TIMER_QUEUE)
+#define SL_SLEEPTIMER_TIMER_QUEUE_DELTA_LIST   0
+#define SL_SLEEPTIMER_TIMER_QUEUE_WHEEL        1
+#define SL_SLEEPTIMER_TIMER_QUEUE              SL_SLEEPTIMER_TIMER_QUEUE_DELTA_LIST
+#endif
+
+#if (SL_SLEEPTIMER_TIMER_QUEUE == SL_SLEEPTIMER_TIMER_QUEUE_WHEEL)
+#if !defined(SL_SLEEPTIMER_WHEEL_SIZE)
+#define SL_SLEEPTIMER_WHEEL_SIZE               32
+#endif
+#if !defined(SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT)
+#define SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT   10
+#endif
+#if ((SL_SLEEPTIMER_WHEEL_SIZE & (SL_SLEEPTIMER_WHEEL_SIZE - 1)) != 0)
+#error "SL_SLEEPTIMER_WHEEL_SIZE must be a power of 2"
+#endif
+#if (SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT > 24)
+#error "SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT must be 24 or less"
+#endif
+// A rotation must fit in the 32-bit tick counter, or the slot numbering would
+// jump at the counter wraparound.
+#if (SL_SLEEPTIMER_WHEEL_SIZE > (1 << (32 - SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT)))
+#error "SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT + log2(SL_SLEEPTIMER_WHEEL_SIZE) must be 32 or less"
+#endif
+#define WHEEL_MASK                             (SL_SLEEPTIMER_WHEEL_SIZE - 1u)
+#define WHEEL_SLOT(tick)                       (((tick) >> SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT) & WHEEL_MASK)
+#define WHEEL_BITMAP_WORDS                     ((SL_SLEEPTIMER_WHEEL_SIZE + 31u) / 32u)
+#endif
+
 /// @brief Time Format.
 SLEEPTIMER_ENUM(sl_sleeptimer_time_format_t) {
   TIME_FORMAT_UNIX = 0,           ///< Number of seconds since January 1, 1970, 00:00. Type is signed, so represented on 31 bit.
@@ -100,12 +136,26 @@ static uint32_t calculated_sec_count = 0;
 // Timer frequency in Hz.
 static uint32_t timer_frequency;
 
-// Head of timer list.
+// Head of timer list. With the timing wheel, next timer to expire in the wheel.
 static sl_sleeptimer_timer_handle_t *timer_head;
 
 // Count at last update of delta of first timer.
 static volatile sl_sleeptimer_tick_count_t last_delta_update_count;
 
+#if (SL_SLEEPTIMER_TIMER_QUEUE == SL_SLEEPTIMER_TIMER_QUEUE_WHEEL)
+// Timing wheel slots. Each slot holds an unsorted list of the timers whose
+// expiration tick, stored in the delta field, maps to the slot.
+static sl_sleeptimer_timer_handle_t *timer_wheel[SL_SLEEPTIMER_WHEEL_SIZE];
+
+// One bit per wheel slot holding at least one timer, so the searches skip
+// the empty slots a word at a time.
+static uint32_t timer_wheel_occupied[WHEEL_BITMAP_WORDS];
+
+// Expired timers waiting to be processed.
+static sl_sleeptimer_timer_handle_t *expired_head;
+static sl_sleeptimer_timer_handle_t *expired_tail;
+#endif
+
 // Initialization flag.
 static bool is_sleeptimer_initialized = false;
 
@@ -118,14 +168,60 @@ static uint32_t max_millisecond_conversion;
 // Sleep on ISR exit flag.
 static bool sleep_on_isr_exit = false;
 
-static void delta_list_insert_timer(sl_sleeptimer_timer_handle_t *handle,
-                                    sl_sleeptimer_tick_count_t timeout);
+// Value of the comparator for the next timer.
+static sl_sleeptimer_tick_count_t comparator_value;
 
-static sl_status_t delta_list_remove_timer(sl_sleeptimer_timer_handle_t *handle);
+// Number of wakeups saved by the current comparator value.
+static uint32_t coalesced_wakeups;
 
-static void set_comparator_for_next_timer(void);
+#if SL_SLEEPTIMER_TIMER_COALESCING
+// Number of queued timers started with a slack.
+static uint32_t slack_timer_count;
+#endif
+
+// Timer wakeup statistics.
+static sl_sleeptimer_wakeup_stats_t wakeup_stats;
+
+static void timer_queue_init(void);
+
+static void timer_queue_insert(sl_sleeptimer_timer_handle_t *handle,
+                               sl_sleeptimer_tick_count_t timeout);
+
+static sl_status_t timer_queue_remove(sl_sleeptimer_timer_handle_t *handle);
+
+static void timer_queue_update(void);
+
+static sl_sleeptimer_timer_handle_t *timer_queue_get_first(void);
+
+static sl_sleeptimer_timer_handle_t *timer_queue_get_expired(void);
+
+static bool timer_queue_contains(sl_sleeptimer_timer_handle_t *handle);
+
+static sl_status_t timer_queue_get_timeout(sl_sleeptimer_timer_handle_t *handle,
+                                           uint32_t *timeout);
+
+static sl_status_t timer_queue_get_first_timeout(uint16_t option_flags,
+                                                 uint32_t *timeout);
+
+static sl_sleeptimer_tick_count_t get_restore_adjusted_timeout(sl_sleeptimer_timer_handle_t *handle,
+                                                               sl_sleeptimer_tick_count_t timeout);
+
+#if SL_SLEEPTIMER_TIMER_COALESCING
+static bool timer_queue_get_next_expiry(sl_sleeptimer_tick_count_t after,
+                                        sl_sleeptimer_tick_count_t limit,
+                                        sl_sleeptimer_tick_count_t *timeout,
+                                        sl_sleeptimer_tick_count_t *deadline);
+
+static sl_sleeptimer_tick_count_t get_deadline(sl_sleeptimer_timer_handle_t *handle,
+                                               sl_sleeptimer_tick_count_t timeout);
+#endif
 
-static void update_delta_list(void);
+static sl_sleeptimer_tick_count_t get_comparator_timeout(sl_sleeptimer_tick_count_t first_timeout);
+
+static void update_slack_timer_count(sl_sleeptimer_timer_handle_t *handle,
+                                     bool queued);
+
+static void set_comparator_for_next_timer(void);
 
 __STATIC_INLINE uint32_t div_to_log2(uint32_t div);
 
@@ -180,7 +276,10 @@ sl_status_t sl_sleeptimer_init(void)
 
   CORE_ENTER_ATOMIC();
   if (!is_sleeptimer_initialized) {
-    timer_head  = NULL;
+    timer_queue_init();
+#if SL_SLEEPTIMER_TIMER_COALESCING
+    slack_timer_count = 0u;
+#endif
     last_delta_update_count = 0u;
     overflow_counter = 0u;
     sleeptimer_hal_init_timer();
@@ -450,23 +549,23 @@ sl_status_t sl_sleeptimer_stop_timer(sl_sleeptimer_timer_handle_t *handle)
   }
 
   CORE_ENTER_CRITICAL();
-  update_delta_list();
+  timer_queue_update();
 
   // If first timer in list, update timer comparator.
-  if (timer_head == handle) {
+  if (timer_queue_get_first() == handle) {
     set_comparator = true;
   }
 
-  error = delta_list_remove_timer(handle);
+  error = timer_queue_remove(handle);
   if (error != SL_STATUS_OK) {
     CORE_EXIT_CRITICAL();
 
     return error;
   }
 
-  if (set_comparator && timer_head) {
+  if (set_comparator && timer_queue_get_first()) {
     set_comparator_for_next_timer();
-  } else if (!timer_head) {
+  } else if (!timer_queue_get_first()) {
     sleeptimer_hal_disable_int(SLEEPTIMER_EVENT_COMP);
   }
 
@@ -482,21 +581,12 @@ sl_status_t sl_sleeptimer_is_timer_running(sl_sleeptimer_timer_handle_t *handle,
                                            bool *running)
 {
   CORE_DECLARE_IRQ_STATE;
-  sl_sleeptimer_timer_handle_t *current;
 
   if (handle == NULL || running == NULL) {
     return SL_STATUS_NULL_POINTER;
   } else {
-    *running = false;
     CORE_ENTER_ATOMIC();
-    current = timer_head;
-    while (current != NULL && !*running) {
-      if (current == handle) {
-        *running = true;
-      } else {
-        current = current->next;
-      }
-    }
+    *running = timer_queue_contains(handle);
     CORE_EXIT_ATOMIC();
   }
   return SL_STATUS_OK;
@@ -509,7 +599,6 @@ sl_status_t sl_sleeptimer_get_timer_time_remaining(sl_sleeptimer_timer_handle_t
                                                    uint32_t *time)
 {
   CORE_DECLARE_IRQ_STATE;
-  sl_sleeptimer_timer_handle_t *current;
 
   if (handle == NULL || time == NULL) {
     return SL_STATUS_NULL_POINTER;
@@ -517,17 +606,9 @@ sl_status_t sl_sleeptimer_get_timer_time_remaining(sl_sleeptimer_timer_handle_t
 
   CORE_ENTER_ATOMIC();
 
-  update_delta_list();
-  *time  = handle->delta;
-
-  // Retrieve timer in list and add the deltas.
-  current = timer_head;
-  while (current != handle && current != NULL) {
-    *time += current->delta;
-    current = current->next;
-  }
+  timer_queue_update();
 
-  if (current != handle) {
+  if (timer_queue_get_timeout(handle, time) != SL_STATUS_OK) {
     CORE_EXIT_ATOMIC();
 
     return SL_STATUS_NOT_READY;
@@ -553,36 +634,106 @@ sl_status_t sl_sleeptimer_get_remaining_time_of_first_timer(uint16_t option_flag
                                                             uint32_t *time_remaining)
 {
   CORE_DECLARE_IRQ_STATE;
-  sl_sleeptimer_timer_handle_t *current;
   uint32_t time = 0;
 
   CORE_ENTER_ATOMIC();
-  // parse list and retrieve first timer with option flags requirement.
-  current = timer_head;
-  while (current != NULL) {
-    // save time remaining for timer.
-    time += current->delta;
-    // Check if the current timer has the flags requested
-    if (current->option_flags == option_flags
-        || option_flags == SL_SLEEPTIMER_ANY_FLAG) {
-      // Substract time since last compare match.
-      if (time > (sleeptimer_hal_get_counter() - last_delta_update_count)) {
-        time -= (sleeptimer_hal_get_counter() - last_delta_update_count);
-      } else {
-        time = 0;
-      }
-      *time_remaining = time;
-      CORE_EXIT_ATOMIC();
-
-      return SL_STATUS_OK;
+  // Retrieve first timer with option flags requirement.
+  if (timer_queue_get_first_timeout(option_flags, &time) == SL_STATUS_OK) {
+    // Substract time since last compare match.
+    if (time > (sleeptimer_hal_get_counter() - last_delta_update_count)) {
+      time -= (sleeptimer_hal_get_counter() - last_delta_update_count);
+    } else {
+      time = 0;
     }
-    current = current->next;
+    *time_remaining = time;
+    CORE_EXIT_ATOMIC();
+
+    return SL_STATUS_OK;
   }
   CORE_EXIT_ATOMIC();
 
   return SL_STATUS_EMPTY;
 }
 
+/**************************************************************************//**
+ * Gets the time remaining until the compare match that expires the first
+ * timer with the matching set of flags.
+ *****************************************************************************/
+sl_status_t sli_sleeptimer_get_remaining_time_of_first_wakeup(uint16_t option_flags,
+                                                              uint32_t *time_remaining)
+{
+  CORE_DECLARE_IRQ_STATE;
+  uint32_t time = 0;
+  uint32_t elapsed;
+
+  CORE_ENTER_ATOMIC();
+  if (timer_queue_get_first_timeout(option_flags, &time) != SL_STATUS_OK) {
+    CORE_EXIT_ATOMIC();
+
+    return SL_STATUS_EMPTY;
+  }
+
+  // Unless the compare match is already pending, the comparator is set for
+  // the first timer, delayed within the slack of the timers it coalesces. The
+  // timers expiring up to the comparator, even the ones already moved out of
+  // the queue, all expire at the comparator.
+  if (!sli_sleeptimer_hal_is_int_status_set(SLEEPTIMER_EVENT_COMP)
+      && (time <= (comparator_value - last_delta_update_count))) {
+    time = comparator_value - last_delta_update_count;
+  }
+
+  // Substract time since last compare match.
+  elapsed = sleeptimer_hal_get_counter() - last_delta_update_count;
+  *time_remaining = (time > elapsed) ? (time - elapsed) : 0u;
+  CORE_EXIT_ATOMIC();
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Converts a slack to the option flags allowing a timer to expire late.
+ ******************************************************************************/
+uint16_t sl_sleeptimer_slack_to_option_flags(uint32_t slack)
+{
+  uint16_t slack_log2 = 0;
+
+  while ((slack_log2 < 31u) && ((((uint64_t)1u << (slack_log2 + 1u)) - 1u) <= slack)) {
+    slack_log2++;
+  }
+
+  return SL_SLEEPTIMER_SLACK_FLAGS(slack_log2);
+}
+
+/***************************************************************************//**
+ * Gets the timer wakeup statistics.
+ ******************************************************************************/
+void sl_sleeptimer_get_wakeup_stats(sl_sleeptimer_wakeup_stats_t *stats)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  if (stats == NULL) {
+    return;
+  }
+
+  CORE_ENTER_ATOMIC();
+  *stats = wakeup_stats;
+  CORE_EXIT_ATOMIC();
+}
+
+/***************************************************************************//**
+ * Resets the timer wakeup statistics.
+ ******************************************************************************/
+void sl_sleeptimer_reset_wakeup_stats(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  wakeup_stats.wakeups = 0;
+  wakeup_stats.expirations = 0;
+  wakeup_stats.wakeups_avoided = 0;
+  CORE_EXIT_ATOMIC();
+}
+
 /**************************************************************************//**
  * Determines if next timer to expire has the option flag
  * "SL_SLEEPTIMER_POWER_MANAGER_EARLY_WAKEUP_TIMER_FLAG".
@@ -606,7 +757,7 @@ bool sli_sleeptimer_is_power_manager_timer_next_to_expire(void)
   // Make sure that the Power Manager Sleeptimer is actually expired in addition
   // to being the next timer.
   if ((next_timer_is_power_manager)
-      && ((sl_sleeptimer_get_tick_count() - timer_head->timeout_expected_tc) > MIN_DIFF_BETWEEN_COUNT_AND_EXPIRATION)) {
+      && ((sl_sleeptimer_get_tick_count() - timer_queue_get_first()->timeout_expected_tc) > MIN_DIFF_BETWEEN_COUNT_AND_EXPIRATION)) {
     next_timer_is_power_manager = false;
   }
 
@@ -1261,9 +1412,9 @@ void process_timer_irq(uint8_t local_flag)
 #endif
     overflow_counter++;
 
-    update_delta_list();
+    timer_queue_update();
 
-    if (timer_head) {
+    if (timer_queue_get_first()) {
       set_comparator_for_next_timer();
     }
   }
@@ -1273,26 +1424,18 @@ void process_timer_irq(uint8_t local_flag)
 
     uint32_t nb_timer_expire = 0u;
     uint16_t option_flags = 0;
+    uint32_t coalesced = coalesced_wakeups;
 
     CORE_ENTER_ATOMIC();
     // Make sure the timers list is up to date with the time elapsed since the last update
-    update_delta_list();
+    timer_queue_update();
 
-    // Process all timers that have expired.
-    while ((timer_head) && (timer_head->delta == 0)) {
-      sl_sleeptimer_timer_handle_t *temp = timer_head;
-      current = timer_head;
+    // Process all timers that have expired, timers with higher priority first.
+    while ((current = timer_queue_get_expired()) != NULL) {
       int32_t periodic_correction = 0u;
       int64_t timeout_temp = 0;
       bool skip_remove = false;
 
-      // Process timers with higher priority first
-      while ((temp != NULL) && (temp->delta == 0)) {
-        if (current->priority > temp->priority) {
-          current = temp;
-        }
-        temp = temp->next;
-      }
       CORE_EXIT_ATOMIC();
 
       // Check if current periodic timer was delayed more than its actual timeout value
@@ -1312,7 +1455,7 @@ void process_timer_irq(uint8_t local_flag)
       // that was intentionally kept at the head of the timers list.
       if (skip_remove != true) {
         CORE_ENTER_ATOMIC();
-        delta_list_remove_timer(current);
+        timer_queue_remove(current);
         CORE_EXIT_ATOMIC();
       }
 
@@ -1334,7 +1477,7 @@ void process_timer_irq(uint8_t local_flag)
           }
         }
         CORE_ENTER_ATOMIC();
-        delta_list_insert_timer(current, (sl_sleeptimer_tick_count_t)timeout_temp);
+        timer_queue_insert(current, (sl_sleeptimer_tick_count_t)timeout_temp);
         current->timeout_expected_tc += current->timeout_periodic;
         CORE_EXIT_ATOMIC();
       }
@@ -1351,7 +1494,13 @@ void process_timer_irq(uint8_t local_flag)
       CORE_ENTER_ATOMIC();
 
       // Re-update the list to account for delays during timer's callback.
-      update_delta_list();
+      timer_queue_update();
+    }
+
+    if (nb_timer_expire > 0u) {
+      wakeup_stats.wakeups++;
+      wakeup_stats.expirations += nb_timer_expire;
+      wakeup_stats.wakeups_avoided += SL_MIN(coalesced, nb_timer_expire - 1u);
     }
 
     // If the only timer expired is the internal Power Manager one,
@@ -1363,7 +1512,7 @@ void process_timer_irq(uint8_t local_flag)
       }
     }
 
-    if (timer_head) {
+    if (timer_queue_get_first()) {
       set_comparator_for_next_timer();
     } else {
       sleeptimer_hal_disable_int(SLEEPTIMER_EVENT_COMP);
@@ -1389,152 +1538,979 @@ static void delay_callback(sl_sleeptimer_timer_handle_t *handle,
 }
 
 /*******************************************************************************
- * Inserts a timer in the delta list.
+ * Extends a timeout to the power manager restore delay if needed.
  *
  * @param handle Pointer to handle to timer.
  * @param timeout Timer timeout, in ticks.
+ *
+ * @return Timeout to use for the timer, in ticks.
  ******************************************************************************/
-static void delta_list_insert_timer(sl_sleeptimer_timer_handle_t *handle,
-                                    sl_sleeptimer_tick_count_t timeout)
+static sl_sleeptimer_tick_count_t get_restore_adjusted_timeout(sl_sleeptimer_timer_handle_t *handle,
+                                                               sl_sleeptimer_tick_count_t timeout)
 {
-  sl_sleeptimer_tick_count_t local_handle_delta = timeout;
-
 #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
   // If Power Manager is present, it's possible that a clock restore is needed right away
   // if we are in the context of a deepsleep and the timeout value is smaller than the restore time.
   // If it's the case, the restore will be started and the timeout value will be updated to match
   // the restore delay.
-  if (handle->option_flags == 0) {
+  if (OPTION_FLAGS(handle) == 0) {
     uint32_t wakeup_delay = sli_power_manager_get_restore_delay();
 
-    if (local_handle_delta < wakeup_delay) {
-      local_handle_delta = wakeup_delay;
+    if (timeout < wakeup_delay) {
+      timeout = wakeup_delay;
       sli_power_manager_initiate_restore();
     }
   }
+#else
+  (void)handle;
 #endif
 
-  handle->delta = local_handle_delta;
+  return timeout;
+}
 
-  if (timer_head != NULL) {
-    sl_sleeptimer_timer_handle_t *prev = NULL;
-    sl_sleeptimer_timer_handle_t *current = timer_head;
-    // Find timer position taking into accounts the deltas and priority.
-    while (current != NULL
-           && (local_handle_delta >= current->delta || current->delta == 0u
-               || (((local_handle_delta - current->delta) == 0) && (handle->priority > current->priority)))) {
-      local_handle_delta -= current->delta;
-      handle->delta = local_handle_delta;
-      prev = current;
-      current = current->next;
-    }
+#if SL_SLEEPTIMER_TIMER_COALESCING
+/*******************************************************************************
+ * Gets the latest expiration tolerated by a timer.
+ *
+ * @param handle Pointer to handle to timer.
+ * @param timeout Timer timeout, relative to the last update.
+ *
+ * @return Timeout plus the timer slack, saturated.
+ ******************************************************************************/
+static sl_sleeptimer_tick_count_t get_deadline(sl_sleeptimer_timer_handle_t *handle,
+                                               sl_sleeptimer_tick_count_t timeout)
+{
+  uint32_t slack_log2 = (handle->option_flags & SL_SLEEPTIMER_SLACK_MASK) >> SL_SLEEPTIMER_SLACK_SHIFT;
+  sl_sleeptimer_tick_count_t slack = (1u << slack_log2) - 1u;
 
-    // Insert timer in middle of delta list.
-    if (prev != NULL) {
-      prev->next = handle;
-    } else {
-      timer_head = handle;
-    }
-    handle->next = current;
+  if (slack > (UINT32_MAX - timeout)) {
+    return UINT32_MAX;
+  }
 
-    if (current != NULL) {
-      current->delta -= local_handle_delta;
+  return timeout + slack;
+}
+#endif
+
+/*******************************************************************************
+ * Gets the timeout at which to set the comparator for the next timer.
+ * The compare match is delayed to the expiration of the following timers as
+ * long as every timer expiring before tolerates it, so that they all expire
+ * during the same wakeup.
+ *
+ * @param first_timeout Timeout of the next timer, relative to the last update.
+ *
+ * @return Comparator timeout, relative to the last update.
+ ******************************************************************************/
+static sl_sleeptimer_tick_count_t get_comparator_timeout(sl_sleeptimer_tick_count_t first_timeout)
+{
+  sl_sleeptimer_tick_count_t timeout = first_timeout;
+#if SL_SLEEPTIMER_TIMER_COALESCING
+  sl_sleeptimer_tick_count_t deadline = first_timeout;
+  sl_sleeptimer_tick_count_t next_timeout;
+  sl_sleeptimer_tick_count_t next_deadline;
+
+  coalesced_wakeups = 0;
+
+  // Only walk the timer queue if a queued timer tolerates a late expiration.
+  if (slack_timer_count != 0u) {
+    timer_queue_get_next_expiry(first_timeout - 1u, first_timeout, &timeout, &deadline);
+
+    while ((deadline > timeout)
+           && timer_queue_get_next_expiry(timeout, deadline, &next_timeout, &next_deadline)) {
+      timeout = next_timeout;
+      deadline = SL_MIN(deadline, next_deadline);
+      coalesced_wakeups++;
     }
-  } else {
-    timer_head = handle;
-    handle->next = NULL;
   }
+#endif
+
+  comparator_value = last_delta_update_count + timeout;
+
+  return timeout;
 }
 
 /*******************************************************************************
- * Removes a timer from delta list.
+ * Updates the number of queued timers that have a slack.
  *
  * @param handle Pointer to handle to timer.
- *
- * @return 0 if successful. Error code otherwise.
+ * @param queued true if the timer was inserted in the timer queue, false if
+ *               it was removed from it.
  ******************************************************************************/
-static sl_status_t delta_list_remove_timer(sl_sleeptimer_timer_handle_t *handle)
+static void update_slack_timer_count(sl_sleeptimer_timer_handle_t *handle,
+                                     bool queued)
 {
-  sl_sleeptimer_timer_handle_t *prev = NULL;
-  sl_sleeptimer_timer_handle_t *current = timer_head;
-
-  // Retrieve timer in delta list.
-  while (current != NULL && current != handle) {
-    prev = current;
-    current = current->next;
+#if SL_SLEEPTIMER_TIMER_COALESCING
+  if ((handle->option_flags & SL_SLEEPTIMER_SLACK_MASK) != 0u) {
+    if (queued) {
+      slack_timer_count++;
+    } else {
+      slack_timer_count--;
+    }
   }
+#else
+  (void)handle;
+  (void)queued;
+#endif
+}
 
-  if (current != handle) {
-    return SL_STATUS_INVALID_STATE;
+#if (SL_SLEEPTIMER_TIMER_QUEUE == SL_SLEEPTIMER_TIMER_QUEUE_WHEEL)
+/*******************************************************************************
+ * Timing wheel timer queue.
+ *
+ * The delta field of a queued timer holds its absolute expiration tick. Timers
+ * are hashed in a wheel slot by expiration tick, so inserting a timer is O(1)
+ * and removing it only walks its slot. Wraparound is handled by comparing
+ * expiration ticks relative to last_delta_update_count, which never passes
+ * the expiration of a timer still in the wheel: when it would, the timer is
+ * first moved to the expired list.
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Initializes the timer queue.
+ ******************************************************************************/
+static void timer_queue_init(void)
+{
+  for (uint32_t i = 0; i < SL_SLEEPTIMER_WHEEL_SIZE; i++) {
+    timer_wheel[i] = NULL;
   }
+  for (uint32_t i = 0; i < WHEEL_BITMAP_WORDS; i++) {
+    timer_wheel_occupied[i] = 0;
+  }
+  timer_head = NULL;
+  expired_head = NULL;
+  expired_tail = NULL;
+}
 
-  if (prev != NULL) {
-    prev->next = handle->next;
+/*******************************************************************************
+ * Appends a timer to the expired list.
+ *
+ * @param handle Pointer to handle to timer.
+ ******************************************************************************/
+static void expired_list_append(sl_sleeptimer_timer_handle_t *handle)
+{
+  handle->next = NULL;
+  if (expired_tail != NULL) {
+    expired_tail->next = handle;
   } else {
-    timer_head = handle->next;
+    expired_head = handle;
   }
+  expired_tail = handle;
+}
 
-  // Update delta of next timer
-  if (handle->next != NULL) {
-    handle->next->delta += handle->delta;
+/*******************************************************************************
+ * Updates the occupied bit of a wheel slot.
+ *
+ * @param slot Wheel slot.
+ ******************************************************************************/
+static void wheel_update_occupied(uint32_t slot)
+{
+  if (timer_wheel[slot] != NULL) {
+    timer_wheel_occupied[slot / 32u] |= (1u << (slot % 32u));
+  } else {
+    timer_wheel_occupied[slot / 32u] &= ~(1u << (slot % 32u));
   }
-
-  return SL_STATUS_OK;
 }
 
 /*******************************************************************************
- * Sets comparator for next timer.
+ * Finds the next occupied wheel slot, in rotation order.
+ *
+ * @param slot Wheel slot the rotation starts from.
+ * @param index Position in the rotation to start searching from.
+ *
+ * @return Position in the rotation of the first occupied slot at or after
+ *         index, SL_SLEEPTIMER_WHEEL_SIZE if none.
  ******************************************************************************/
-static void set_comparator_for_next_timer(void)
+static uint32_t wheel_next_occupied(uint32_t slot, uint32_t index)
 {
-  if (timer_head->delta > 0) {
-    sl_sleeptimer_tick_count_t compare_value;
+  while (index < SL_SLEEPTIMER_WHEEL_SIZE) {
+    uint32_t current = (slot + index) & WHEEL_MASK;
+    uint32_t bits = timer_wheel_occupied[current / 32u] >> (current % 32u);
 
-    compare_value = last_delta_update_count + timer_head->delta;
-
-    sleeptimer_hal_enable_int(SLEEPTIMER_EVENT_COMP);
-    sleeptimer_hal_set_compare(compare_value);
-  } else {
-    // In case timer has already expire, don't attempt to set comparator. Just
-    // trigger compare match interrupt.
-    sleeptimer_hal_enable_int(SLEEPTIMER_EVENT_COMP);
-    sleeptimer_hal_set_int(SLEEPTIMER_EVENT_COMP);
+    if (bits != 0u) {
+      index += SL_CTZ(bits);
+      return SL_MIN(index, (uint32_t)SL_SLEEPTIMER_WHEEL_SIZE);
+    }
+    // Nothing left in this word
+    index += 32u - (current % 32u);
   }
 
-  update_next_timer_to_expire_is_power_manager();
+  return SL_SLEEPTIMER_WHEEL_SIZE;
 }
 
 /*******************************************************************************
- * Updates timer list's deltas.
+ * Finds the next timer to expire in the wheel.
+ *
+ * @param option_flags Option flags the timer must have, or
+ *        SL_SLEEPTIMER_ANY_FLAG.
+ *
+ * @return Pointer to handle to timer, NULL if none.
  ******************************************************************************/
-static void update_delta_list(void)
+static sl_sleeptimer_timer_handle_t *wheel_find_first(uint16_t option_flags)
 {
-  sl_sleeptimer_tick_count_t current_cnt = sleeptimer_hal_get_counter();
-  sl_sleeptimer_timer_handle_t *timer_handle = timer_head;
-  sl_sleeptimer_tick_count_t time_diff = current_cnt - last_delta_update_count;
+  sl_sleeptimer_timer_handle_t *first = NULL;
+  sl_sleeptimer_timer_handle_t *current;
+  sl_sleeptimer_tick_count_t first_delta = 0;
+  sl_sleeptimer_tick_count_t delta;
+  uint32_t slot = WHEEL_SLOT(last_delta_update_count);
+  uint32_t offset = last_delta_update_count & ((1u << SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT) - 1u);
+
+  // Scan one rotation from the current slot. The first slot holding a timer
+  // expiring during this rotation holds the next timer to expire.
+  for (uint32_t i = wheel_next_occupied(slot, 0u);
+       (i < SL_SLEEPTIMER_WHEEL_SIZE) && (first == NULL);
+       i = wheel_next_occupied(slot, i + 1u)) {
+    current = timer_wheel[(slot + i) & WHEEL_MASK];
+    while (current != NULL) {
+      delta = current->delta - last_delta_update_count;
+      if (((((uint64_t)offset + delta) >> SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT) == i)
+          && (option_flags == SL_SLEEPTIMER_ANY_FLAG || OPTION_FLAGS(current) == option_flags)
+          && (first == NULL || delta < first_delta)) {
+        first = current;
+        first_delta = delta;
+      }
+      current = current->next;
+    }
+  }
 
-  // Go through the delta timer list and update every necessary deltas
-  // according to the time elapsed since the last update.
-  while (timer_handle != NULL && time_diff > 0) {
-    if (timer_handle->delta >= time_diff) {
-      timer_handle->delta -= time_diff;
-      time_diff = 0;
-    } else {
-      time_diff -= timer_handle->delta;
-      timer_handle->delta = 0;
+  // All timers expire after more than one rotation, look at all of them.
+  if (first == NULL) {
+    for (uint32_t i = wheel_next_occupied(0u, 0u);
+         i < SL_SLEEPTIMER_WHEEL_SIZE;
+         i = wheel_next_occupied(0u, i + 1u)) {
+      current = timer_wheel[i];
+      while (current != NULL) {
+        delta = current->delta - last_delta_update_count;
+        if ((option_flags == SL_SLEEPTIMER_ANY_FLAG || OPTION_FLAGS(current) == option_flags)
+            && (first == NULL || delta < first_delta)) {
+          first = current;
+          first_delta = delta;
+        }
+        current = current->next;
+      }
     }
-    timer_handle = timer_handle->next;
   }
 
-  last_delta_update_count = current_cnt;
+  return first;
 }
 
 /*******************************************************************************
- * Creates and start a 32 bits timer.
+ * Inserts a timer in the timer queue.
  *
  * @param handle Pointer to handle to timer.
- * @param timeout_initial Initial timeout, in timer ticks.
- * @param timeout_periodic Periodic timeout, in timer ticks. This timeout
+ * @param timeout Timer timeout, in ticks.
+ ******************************************************************************/
+static void timer_queue_insert(sl_sleeptimer_timer_handle_t *handle,
+                               sl_sleeptimer_tick_count_t timeout)
+{
+  uint32_t slot;
+
+  update_slack_timer_count(handle, true);
+  timeout = get_restore_adjusted_timeout(handle, timeout);
+  handle->delta = last_delta_update_count + timeout;
+
+  if (timeout == 0u) {
+    expired_list_append(handle);
+    return;
+  }
+
+  slot = WHEEL_SLOT(handle->delta);
+  handle->next = timer_wheel[slot];
+  timer_wheel[slot] = handle;
+  wheel_update_occupied(slot);
+
+  if ((timer_head == NULL)
+      || (timeout < (timer_head->delta - last_delta_update_count))) {
+    timer_head = handle;
+  }
+}
+
+/*******************************************************************************
+ * Removes a timer from the timer queue.
+ *
+ * @param handle Pointer to handle to timer.
+ *
+ * @return 0 if successful. Error code otherwise.
+ ******************************************************************************/
+static sl_status_t timer_queue_remove(sl_sleeptimer_timer_handle_t *handle)
+{
+  uint32_t slot = WHEEL_SLOT(handle->delta);
+  sl_sleeptimer_timer_handle_t **link = &timer_wheel[slot];
+  sl_sleeptimer_timer_handle_t *prev = NULL;
+  sl_sleeptimer_timer_handle_t *current;
+
+  // Retrieve timer in its wheel slot.
+  while (*link != NULL && *link != handle) {
+    link = &(*link)->next;
+  }
+
+  if (*link == handle) {
+    *link = handle->next;
+    wheel_update_occupied(slot);
+    if (timer_head == handle) {
+      timer_head = wheel_find_first(SL_SLEEPTIMER_ANY_FLAG);
+    }
+    update_slack_timer_count(handle, false);
+    return SL_STATUS_OK;
+  }
+
+  // Retrieve timer in expired list.
+  current = expired_head;
+  while (current != NULL && current != handle) {
+    prev = current;
+    current = current->next;
+  }
+
+  if (current != handle) {
+    return SL_STATUS_INVALID_STATE;
+  }
+
+  if (prev != NULL) {
+    prev->next = handle->next;
+  } else {
+    expired_head = handle->next;
+  }
+  if (expired_tail == handle) {
+    expired_tail = prev;
+  }
+  update_slack_timer_count(handle, false);
+
+  return SL_STATUS_OK;
+}
+
+/*******************************************************************************
+ * Moves the timers that expired since the last update to the expired list.
+ ******************************************************************************/
+static void timer_queue_update(void)
+{
+  sl_sleeptimer_tick_count_t current_cnt = sleeptimer_hal_get_counter();
+  sl_sleeptimer_tick_count_t time_diff = current_cnt - last_delta_update_count;
+
+  // Only the slots elapsed since the last update need to be visited, and only
+  // if the next timer to expire did.
+  if ((timer_head != NULL)
+      && ((timer_head->delta - last_delta_update_count) <= time_diff)) {
+    uint32_t slot = WHEEL_SLOT(last_delta_update_count);
+    uint32_t offset = last_delta_update_count & ((1u << SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT) - 1u);
+    uint64_t slot_count = (((uint64_t)offset + time_diff) >> SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT) + 1u;
+
+    if (slot_count > SL_SLEEPTIMER_WHEEL_SIZE) {
+      slot_count = SL_SLEEPTIMER_WHEEL_SIZE;
+    }
+
+    for (uint32_t i = wheel_next_occupied(slot, 0u);
+         i < slot_count;
+         i = wheel_next_occupied(slot, i + 1u)) {
+      sl_sleeptimer_timer_handle_t **link = &timer_wheel[(slot + i) & WHEEL_MASK];
+
+      while (*link != NULL) {
+        sl_sleeptimer_timer_handle_t *current = *link;
+
+        if ((current->delta - last_delta_update_count) <= time_diff) {
+          *link = current->next;
+          expired_list_append(current);
+        } else {
+          link = &current->next;
+        }
+      }
+      wheel_update_occupied((slot + i) & WHEEL_MASK);
+    }
+
+    last_delta_update_count = current_cnt;
+    timer_head = wheel_find_first(SL_SLEEPTIMER_ANY_FLAG);
+  } else {
+    last_delta_update_count = current_cnt;
+  }
+}
+
+/*******************************************************************************
+ * Gets the next timer to expire.
+ *
+ * @return Pointer to handle to timer, NULL if the queue is empty.
+ ******************************************************************************/
+static sl_sleeptimer_timer_handle_t *timer_queue_get_first(void)
+{
+  return (expired_head != NULL) ? expired_head : timer_head;
+}
+
+/*******************************************************************************
+ * Gets the expired timer with the highest priority. Among timers with the same
+ * priority, the one that expired first is returned.
+ *
+ * @return Pointer to handle to timer, NULL if no timer expired.
+ ******************************************************************************/
+static sl_sleeptimer_timer_handle_t *timer_queue_get_expired(void)
+{
+  sl_sleeptimer_timer_handle_t *current = expired_head;
+  sl_sleeptimer_timer_handle_t *temp = expired_head;
+
+  while (temp != NULL) {
+    if ((current->priority > temp->priority)
+        || ((current->priority == temp->priority)
+            && ((last_delta_update_count - temp->delta) > (last_delta_update_count - current->delta)))) {
+      current = temp;
+    }
+    temp = temp->next;
+  }
+
+  return current;
+}
+
+/*******************************************************************************
+ * Determines if a timer is in the expired list.
+ *
+ * @param handle Pointer to handle to timer.
+ *
+ * @return true if the timer is in the expired list, false otherwise.
+ ******************************************************************************/
+static bool expired_list_contains(sl_sleeptimer_timer_handle_t *handle)
+{
+  sl_sleeptimer_timer_handle_t *current = expired_head;
+
+  while (current != NULL && current != handle) {
+    current = current->next;
+  }
+
+  return current == handle;
+}
+
+/*******************************************************************************
+ * Determines if a timer is in the wheel.
+ *
+ * @param handle Pointer to handle to timer.
+ *
+ * @return true if the timer is in the wheel, false otherwise.
+ ******************************************************************************/
+static bool wheel_contains(sl_sleeptimer_timer_handle_t *handle)
+{
+  sl_sleeptimer_timer_handle_t *current = timer_wheel[WHEEL_SLOT(handle->delta)];
+
+  while (current != NULL && current != handle) {
+    current = current->next;
+  }
+
+  return current == handle;
+}
+
+/*******************************************************************************
+ * Determines if a timer is in the timer queue.
+ *
+ * @param handle Pointer to handle to timer.
+ *
+ * @return true if the timer is running, false otherwise.
+ ******************************************************************************/
+static bool timer_queue_contains(sl_sleeptimer_timer_handle_t *handle)
+{
+  return wheel_contains(handle) || expired_list_contains(handle);
+}
+
+/*******************************************************************************
+ * Gets the timeout of a timer, relative to the last update.
+ *
+ * @param handle Pointer to handle to timer.
+ * @param timeout Pointer to timeout, in ticks.
+ *
+ * @return 0 if successful. Error code otherwise.
+ ******************************************************************************/
+static sl_status_t timer_queue_get_timeout(sl_sleeptimer_timer_handle_t *handle,
+                                           uint32_t *timeout)
+{
+  if (wheel_contains(handle)) {
+    *timeout = handle->delta - last_delta_update_count;
+  } else if (expired_list_contains(handle)) {
+    *timeout = 0;
+  } else {
+    return SL_STATUS_NOT_READY;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/*******************************************************************************
+ * Gets the timeout of the first timer with the matching set of flags,
+ * relative to the last update.
+ *
+ * @param option_flags Option flags the timer must have, or
+ *        SL_SLEEPTIMER_ANY_FLAG.
+ * @param timeout Pointer to timeout, in ticks.
+ *
+ * @return 0 if successful. Error code otherwise.
+ ******************************************************************************/
+static sl_status_t timer_queue_get_first_timeout(uint16_t option_flags,
+                                                 uint32_t *timeout)
+{
+  sl_sleeptimer_timer_handle_t *current = expired_head;
+
+  while (current != NULL) {
+    if (OPTION_FLAGS(current) == option_flags
+        || option_flags == SL_SLEEPTIMER_ANY_FLAG) {
+      *timeout = 0;
+      return SL_STATUS_OK;
+    }
+    current = current->next;
+  }
+
+  if (option_flags == SL_SLEEPTIMER_ANY_FLAG) {
+    current = timer_head;
+  } else {
+    current = wheel_find_first(option_flags);
+  }
+
+  if (current == NULL) {
+    return SL_STATUS_EMPTY;
+  }
+
+  *timeout = current->delta - last_delta_update_count;
+  return SL_STATUS_OK;
+}
+
+#if SL_SLEEPTIMER_TIMER_COALESCING
+/*******************************************************************************
+ * Finds the first expiration in a range of timeouts.
+ *
+ * @param after Start of the range, excluded, relative to the last update.
+ * @param limit End of the range, included, relative to the last update.
+ * @param timeout Pointer to the first timeout found in the range.
+ * @param deadline Pointer to the latest expiration tolerated by the timers
+ *        expiring at that timeout.
+ *
+ * @return true if a timer expires in the range, false otherwise.
+ ******************************************************************************/
+static bool timer_queue_get_next_expiry(sl_sleeptimer_tick_count_t after,
+                                        sl_sleeptimer_tick_count_t limit,
+                                        sl_sleeptimer_tick_count_t *timeout,
+                                        sl_sleeptimer_tick_count_t *deadline)
+{
+  bool found = false;
+  uint32_t offset = last_delta_update_count & ((1u << SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT) - 1u);
+  uint64_t first_slot = ((uint64_t)offset + after + 1u) >> SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT;
+  uint64_t slot_count = (((uint64_t)offset + limit) >> SL_SLEEPTIMER_WHEEL_RESOLUTION_SHIFT) - first_slot + 1u;
+  uint32_t slot = WHEEL_SLOT(last_delta_update_count + after + 1u);
+
+  for (uint32_t i = wheel_next_occupied(slot, 0u);
+       i < SL_MIN(slot_count, (uint64_t)SL_SLEEPTIMER_WHEEL_SIZE);
+       i = wheel_next_occupied(slot, i + 1u)) {
+    sl_sleeptimer_timer_handle_t *current = timer_wheel[(slot + i) & WHEEL_MASK];
+
+    while (current != NULL) {
+      sl_sleeptimer_tick_count_t delta = current->delta - last_delta_update_count;
+
+      if ((delta > after) && (delta <= limit)) {
+        if (!found || (delta < *timeout)) {
+          found = true;
+          *timeout = delta;
+          *deadline = get_deadline(current, delta);
+        } else if (delta == *timeout) {
+          *deadline = SL_MIN(*deadline, get_deadline(current, delta));
+        }
+      }
+      current = current->next;
+    }
+
+    // Within one rotation, the first slot with a match holds the first expiration.
+    if (found && (slot_count <= SL_SLEEPTIMER_WHEEL_SIZE)) {
+      break;
+    }
+  }
+
+  return found;
+}
+#endif
+
+/*******************************************************************************
+ * Sets comparator for next timer.
+ ******************************************************************************/
+static void set_comparator_for_next_timer(void)
+{
+  if (expired_head == NULL) {
+    sl_sleeptimer_tick_count_t compare_value;
+
+    compare_value = last_delta_update_count
+                    + get_comparator_timeout(timer_head->delta - last_delta_update_count);
+
+    sleeptimer_hal_enable_int(SLEEPTIMER_EVENT_COMP);
+    sleeptimer_hal_set_compare(compare_value);
+  } else {
+    // In case timer has already expire, don't attempt to set comparator. Just
+    // trigger compare match interrupt.
+    coalesced_wakeups = 0;
+    comparator_value = last_delta_update_count;
+    sleeptimer_hal_enable_int(SLEEPTIMER_EVENT_COMP);
+    sleeptimer_hal_set_int(SLEEPTIMER_EVENT_COMP);
+  }
+
+  update_next_timer_to_expire_is_power_manager();
+}
+
+/*******************************************************************************
+ * Updates internal flag that indicates if next timer to expire is the power
+ * manager's one.
+ ******************************************************************************/
+static void update_next_timer_to_expire_is_power_manager(void)
+{
+  sl_sleeptimer_timer_handle_t *current = expired_head;
+  sl_sleeptimer_tick_count_t first_delta = 0;
+  uint32_t slot;
+
+  next_timer_to_expire_is_power_manager = false;
+
+  while (current != NULL) {
+    if (current->option_flags & SLI_SLEEPTIMER_POWER_MANAGER_EARLY_WAKEUP_TIMER_FLAG) {
+      next_timer_to_expire_is_power_manager = true;
+      return;
+    }
+    current = current->next;
+  }
+
+  if (timer_head == NULL) {
+    return;
+  }
+
+  if (expired_head == NULL) {
+    first_delta = timer_head->delta - last_delta_update_count;
+  }
+
+  // Timers expiring within one tick of the first one are in its slot or in the
+  // next one.
+  slot = WHEEL_SLOT(last_delta_update_count + first_delta);
+  for (uint32_t i = 0; i < 2u; i++) {
+    current = timer_wheel[(slot + i) & WHEEL_MASK];
+    while (current != NULL) {
+      if ((((current->delta - last_delta_update_count) - first_delta) <= 1u)
+          && (current->option_flags & SLI_SLEEPTIMER_POWER_MANAGER_EARLY_WAKEUP_TIMER_FLAG)) {
+        next_timer_to_expire_is_power_manager = true;
+        return;
+      }
+      current = current->next;
+    }
+  }
+}
+#else
+
+/*******************************************************************************
+ * Initializes the timer queue.
+ ******************************************************************************/
+static void timer_queue_init(void)
+{
+  timer_head = NULL;
+}
+
+/*******************************************************************************
+ * Inserts a timer in the delta list.
+ *
+ * @param handle Pointer to handle to timer.
+ * @param timeout Timer timeout, in ticks.
+ ******************************************************************************/
+static void timer_queue_insert(sl_sleeptimer_timer_handle_t *handle,
+                               sl_sleeptimer_tick_count_t timeout)
+{
+  sl_sleeptimer_tick_count_t local_handle_delta = get_restore_adjusted_timeout(handle, timeout);
+
+  update_slack_timer_count(handle, true);
+  handle->delta = local_handle_delta;
+
+  if (timer_head != NULL) {
+    sl_sleeptimer_timer_handle_t *prev = NULL;
+    sl_sleeptimer_timer_handle_t *current = timer_head;
+    // Find timer position taking into accounts the deltas and priority.
+    while (current != NULL
+           && (local_handle_delta >= current->delta || current->delta == 0u
+               || (((local_handle_delta - current->delta) == 0) && (handle->priority > current->priority)))) {
+      local_handle_delta -= current->delta;
+      handle->delta = local_handle_delta;
+      prev = current;
+      current = current->next;
+    }
+
+    // Insert timer in middle of delta list.
+    if (prev != NULL) {
+      prev->next = handle;
+    } else {
+      timer_head = handle;
+    }
+    handle->next = current;
+
+    if (current != NULL) {
+      current->delta -= local_handle_delta;
+    }
+  } else {
+    timer_head = handle;
+    handle->next = NULL;
+  }
+}
+
+/*******************************************************************************
+ * Removes a timer from delta list.
+ *
+ * @param handle Pointer to handle to timer.
+ *
+ * @return 0 if successful. Error code otherwise.
+ ******************************************************************************/
+static sl_status_t timer_queue_remove(sl_sleeptimer_timer_handle_t *handle)
+{
+  sl_sleeptimer_timer_handle_t *prev = NULL;
+  sl_sleeptimer_timer_handle_t *current = timer_head;
+
+  // Retrieve timer in delta list.
+  while (current != NULL && current != handle) {
+    prev = current;
+    current = current->next;
+  }
+
+  if (current != handle) {
+    return SL_STATUS_INVALID_STATE;
+  }
+
+  if (prev != NULL) {
+    prev->next = handle->next;
+  } else {
+    timer_head = handle->next;
+  }
+
+  // Update delta of next timer
+  if (handle->next != NULL) {
+    handle->next->delta += handle->delta;
+  }
+  update_slack_timer_count(handle, false);
+
+  return SL_STATUS_OK;
+}
+
+#if SL_SLEEPTIMER_TIMER_COALESCING
+/*******************************************************************************
+ * Finds the first expiration in a range of timeouts.
+ *
+ * @param after Start of the range, excluded, relative to the last update.
+ * @param limit End of the range, included, relative to the last update.
+ * @param timeout Pointer to the first timeout found in the range.
+ * @param deadline Pointer to the latest expiration tolerated by the timers
+ *        expiring at that timeout.
+ *
+ * @return true if a timer expires in the range, false otherwise.
+ ******************************************************************************/
+static bool timer_queue_get_next_expiry(sl_sleeptimer_tick_count_t after,
+                                        sl_sleeptimer_tick_count_t limit,
+                                        sl_sleeptimer_tick_count_t *timeout,
+                                        sl_sleeptimer_tick_count_t *deadline)
+{
+  sl_sleeptimer_timer_handle_t *current = timer_head;
+  sl_sleeptimer_tick_count_t time = 0;
+  bool found = false;
+
+  while (current != NULL) {
+    time += current->delta;
+    if ((time > limit) || (found && (time != *timeout))) {
+      break;
+    }
+    if (time > after) {
+      if (!found) {
+        found = true;
+        *timeout = time;
+        *deadline = get_deadline(current, time);
+      } else {
+        *deadline = SL_MIN(*deadline, get_deadline(current, time));
+      }
+    }
+    current = current->next;
+  }
+
+  return found;
+}
+#endif
+
+/*******************************************************************************
+ * Sets comparator for next timer.
+ ******************************************************************************/
+static void set_comparator_for_next_timer(void)
+{
+  if (timer_head->delta > 0) {
+    sl_sleeptimer_tick_count_t compare_value;
+
+    compare_value = last_delta_update_count + get_comparator_timeout(timer_head->delta);
+
+    sleeptimer_hal_enable_int(SLEEPTIMER_EVENT_COMP);
+    sleeptimer_hal_set_compare(compare_value);
+  } else {
+    // In case timer has already expire, don't attempt to set comparator. Just
+    // trigger compare match interrupt.
+    coalesced_wakeups = 0;
+    comparator_value = last_delta_update_count;
+    sleeptimer_hal_enable_int(SLEEPTIMER_EVENT_COMP);
+    sleeptimer_hal_set_int(SLEEPTIMER_EVENT_COMP);
+  }
+
+  update_next_timer_to_expire_is_power_manager();
+}
+
+/*******************************************************************************
+ * Updates timer list's deltas.
+ ******************************************************************************/
+static void timer_queue_update(void)
+{
+  sl_sleeptimer_tick_count_t current_cnt = sleeptimer_hal_get_counter();
+  sl_sleeptimer_timer_handle_t *timer_handle = timer_head;
+  sl_sleeptimer_tick_count_t time_diff = current_cnt - last_delta_update_count;
+
+  // Go through the delta timer list and update every necessary deltas
+  // according to the time elapsed since the last update.
+  while (timer_handle != NULL && time_diff > 0) {
+    if (timer_handle->delta >= time_diff) {
+      timer_handle->delta -= time_diff;
+      time_diff = 0;
+    } else {
+      time_diff -= timer_handle->delta;
+      timer_handle->delta = 0;
+    }
+    timer_handle = timer_handle->next;
+  }
+
+  last_delta_update_count = current_cnt;
+}
+
+/*******************************************************************************
+ * Gets the next timer to expire.
+ *
+ * @return Pointer to handle to timer, NULL if the list is empty.
+ ******************************************************************************/
+static sl_sleeptimer_timer_handle_t *timer_queue_get_first(void)
+{
+  return timer_head;
+}
+
+/*******************************************************************************
+ * Gets the expired timer with the highest priority.
+ *
+ * @return Pointer to handle to timer, NULL if no timer expired.
+ ******************************************************************************/
+static sl_sleeptimer_timer_handle_t *timer_queue_get_expired(void)
+{
+  sl_sleeptimer_timer_handle_t *temp = timer_head;
+  sl_sleeptimer_timer_handle_t *current = timer_head;
+
+  if ((timer_head == NULL) || (timer_head->delta != 0)) {
+    return NULL;
+  }
+
+  while ((temp != NULL) && (temp->delta == 0)) {
+    if (current->priority > temp->priority) {
+      current = temp;
+    }
+    temp = temp->next;
+  }
+
+  return current;
+}
+
+/*******************************************************************************
+ * Determines if a timer is in the delta list.
+ *
+ * @param handle Pointer to handle to timer.
+ *
+ * @return true if the timer is running, false otherwise.
+ ******************************************************************************/
+static bool timer_queue_contains(sl_sleeptimer_timer_handle_t *handle)
+{
+  sl_sleeptimer_timer_handle_t *current = timer_head;
+
+  while (current != NULL && current != handle) {
+    current = current->next;
+  }
+
+  return current == handle;
+}
+
+/*******************************************************************************
+ * Gets the timeout of a timer, relative to the last update.
+ *
+ * @param handle Pointer to handle to timer.
+ * @param timeout Pointer to timeout, in ticks.
+ *
+ * @return 0 if successful. Error code otherwise.
+ ******************************************************************************/
+static sl_status_t timer_queue_get_timeout(sl_sleeptimer_timer_handle_t *handle,
+                                           uint32_t *timeout)
+{
+  sl_sleeptimer_timer_handle_t *current = timer_head;
+
+  *timeout = handle->delta;
+
+  // Retrieve timer in list and add the deltas.
+  while (current != handle && current != NULL) {
+    *timeout += current->delta;
+    current = current->next;
+  }
+
+  if (current != handle) {
+    return SL_STATUS_NOT_READY;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/*******************************************************************************
+ * Gets the timeout of the first timer with the matching set of flags,
+ * relative to the last update.
+ *
+ * @param option_flags Option flags the timer must have, or
+ *        SL_SLEEPTIMER_ANY_FLAG.
+ * @param timeout Pointer to timeout, in ticks.
+ *
+ * @return 0 if successful. Error code otherwise.
+ ******************************************************************************/
+static sl_status_t timer_queue_get_first_timeout(uint16_t option_flags,
+                                                 uint32_t *timeout)
+{
+  sl_sleeptimer_timer_handle_t *current = timer_head;
+  uint32_t time = 0;
+
+  // parse list and retrieve first timer with option flags requirement.
+  while (current != NULL) {
+    // save time remaining for timer.
+    time += current->delta;
+    // Check if the current timer has the flags requested
+    if (OPTION_FLAGS(current) == option_flags
+        || option_flags == SL_SLEEPTIMER_ANY_FLAG) {
+      *timeout = time;
+      return SL_STATUS_OK;
+    }
+    current = current->next;
+  }
+
+  return SL_STATUS_EMPTY;
+}
+
+/*******************************************************************************
+ * Updates internal flag that indicates if next timer to expire is the power
+ * manager's one.
+ ******************************************************************************/
+static void update_next_timer_to_expire_is_power_manager(void)
+{
+  sl_sleeptimer_timer_handle_t *current = timer_head;
+  uint32_t delta_diff_with_first = 0;
+
+  next_timer_to_expire_is_power_manager = false;
+
+  while (delta_diff_with_first <= 1) {
+    if (current->option_flags & SLI_SLEEPTIMER_POWER_MANAGER_EARLY_WAKEUP_TIMER_FLAG) {
+      next_timer_to_expire_is_power_manager = true;
+      break;
+    }
+
+    current = current->next;
+    if (current == NULL) {
+      break;
+    }
+
+    delta_diff_with_first += current->delta;
+  }
+}
+#endif
+
+/*******************************************************************************
+ * Creates and start a 32 bits timer.
+ *
+ * @param handle Pointer to handle to timer.
+ * @param timeout_initial Initial timeout, in timer ticks.
+ * @param timeout_periodic Periodic timeout, in timer ticks. This timeout
  *        applies once timeoutInitial expires. Can be set to 0 for a one
  *        shot timer.
  * @param callback Callback function that will be called when
@@ -1590,11 +2566,12 @@ static sl_status_t create_timer(sl_sleeptimer_timer_handle_t *handle,
 #endif
 
   CORE_ENTER_CRITICAL();
-  update_delta_list();
-  delta_list_insert_timer(handle, timeout_initial);
+  timer_queue_update();
+  timer_queue_insert(handle, timeout_initial);
 
-  // If first timer, update timer comparator.
-  if (timer_head == handle) {
+  // If first timer, or expiring before a coalesced compare match, update timer comparator.
+  if ((timer_queue_get_first() == handle)
+      || (timeout_initial < (comparator_value - last_delta_update_count))) {
     set_comparator_for_next_timer();
   }
 
@@ -1603,32 +2580,6 @@ static sl_status_t create_timer(sl_sleeptimer_timer_handle_t *handle,
   return SL_STATUS_OK;
 }
 
-/*******************************************************************************
- * Updates internal flag that indicates if next timer to expire is the power
- * manager's one.
- ******************************************************************************/
-static void update_next_timer_to_expire_is_power_manager(void)
-{
-  sl_sleeptimer_timer_handle_t *current = timer_head;
-  uint32_t delta_diff_with_first = 0;
-
-  next_timer_to_expire_is_power_manager = false;
-
-  while (delta_diff_with_first <= 1) {
-    if (current->option_flags & SLI_SLEEPTIMER_POWER_MANAGER_EARLY_WAKEUP_TIMER_FLAG) {
-      next_timer_to_expire_is_power_manager = true;
-      break;
-    }
-
-    current = current->next;
-    if (current == NULL) {
-      break;
-    }
-
-    delta_diff_with_first += current->delta;
-  }
-}
-
 /**************************************************************************//**
  * Determines if the power manager's early wakeup expired during the last ISR
  * and it was the only timer to expire in that period.
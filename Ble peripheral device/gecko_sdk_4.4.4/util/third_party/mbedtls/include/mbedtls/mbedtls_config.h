@@ -122,6 +122,24 @@
  */
 //#define MBEDTLS_HAVE_SSE2
 
+/**
+ * \def MBEDTLS_CT_WORD_ACCESS
+ *
+ * Process whole machine words in the constant-time buffer functions
+ * mbedtls_ct_memcmp(), mbedtls_ct_memcpy_if() and mbedtls_ct_zeroize_if().
+ *
+ * Without this option mbedtls_ct_memcmp() compares byte by byte unless
+ * assembly for unaligned volatile loads is available (MBEDTLS_HAVE_ASM on
+ * Arm). With it, buffers that share the same alignment are compared through
+ * aligned word loads; whether this path is taken only depends on the
+ * addresses, never on the data. On x86-64 with MBEDTLS_HAVE_ASM the three
+ * functions use 128-bit SSE2 registers.
+ *
+ * Comment to compare byte by byte, for example to rule out the word path
+ * when checking a port for timing leaks.
+ */
+//#define MBEDTLS_CT_WORD_ACCESS
+
 /**
  * \def MBEDTLS_HAVE_TIME
  *
@@ -1402,6 +1420,29 @@
  */
 //#define MBEDTLS_PSA_CRYPTO_EXTERNAL_RNG
 
+/**
+ * \def MBEDTLS_PSA_CRYPTO_LAZY_INIT
+ *
+ * Run psa_crypto_init() on the first call that needs the PSA Crypto module,
+ * instead of returning #PSA_ERROR_BAD_STATE.
+ *
+ * This lets an application leave psa_crypto_init() out of its start-up and
+ * initialize the module later, for example once the radio is running. The
+ * calls that trigger the initialization are psa_generate_random() and every
+ * call that creates, opens or uses a key. Calls that need no key nor random
+ * data, such as psa_hash_compute(), never required the initialization.
+ *
+ * Module:  library/psa_crypto.c
+ *          library/psa_crypto_slot_management.c
+ * Requires: MBEDTLS_PSA_CRYPTO_C
+ *
+ * \note If the initialization fails, the triggering call returns
+ *       #PSA_ERROR_BAD_STATE and the next call tries again.
+ *
+ * Uncomment to initialize the PSA Crypto module on first use.
+ */
+//#define MBEDTLS_PSA_CRYPTO_LAZY_INIT
+
 /**
  * \def MBEDTLS_PSA_CRYPTO_SPM
  *
@@ -90,6 +90,26 @@ static inline uint32_t mbedtls_get_unaligned_volatile_uint32(volatile const unsi
 #endif /* defined(MBEDTLS_EFFICIENT_UNALIGNED_ACCESS) &&
           (defined(MBEDTLS_CT_ARM_ASM) || defined(MBEDTLS_CT_AARCH64_ASM)) */
 
+#if defined(MBEDTLS_CT_WORD_ACCESS)
+/*
+ * Word type for the aligned loads of MBEDTLS_CT_WORD_ACCESS. The buffers are
+ * byte arrays, so tell the compiler that the word may alias them.
+ */
+#if defined(__GNUC__)
+typedef mbedtls_ct_uint_t __attribute__((__may_alias__)) mbedtls_ct_word_t;
+#else
+typedef mbedtls_ct_uint_t mbedtls_ct_word_t;
+#endif
+
+#define MBEDTLS_CT_WORD_SIZE    sizeof(mbedtls_ct_word_t)
+
+/* On x86-64 SSE2 is always present, use it where inline assembly is allowed. */
+#if defined(MBEDTLS_CT_X86_64_ASM) && defined(__SSE2__) && defined(MBEDTLS_CT_SIZE_64)
+#define MBEDTLS_CT_SSE2
+#include <emmintrin.h>
+#endif
+#endif /* MBEDTLS_CT_WORD_ACCESS */
+
 int mbedtls_ct_memcmp(const void *a,
                       const void *b,
                       size_t n)
@@ -111,6 +131,53 @@ int mbedtls_ct_memcmp(const void *a,
         uint32_t y = mbedtls_get_unaligned_volatile_uint32(B + i);
         diff |= x ^ y;
     }
+#elif defined(MBEDTLS_CT_WORD_ACCESS)
+    /*
+     * Aligned word loads when both buffers can reach word alignment at the
+     * same offset. The choice and the number of head bytes only depend on
+     * the addresses, so the timing still does not depend on the data.
+     */
+    const uintptr_t misalign = (uintptr_t) a ^ (uintptr_t) b;
+    if ((misalign & (MBEDTLS_CT_WORD_SIZE - 1)) == 0) {
+        mbedtls_ct_uint_t wdiff = 0;
+
+        for (; i < n && ((uintptr_t) (A + i) & (MBEDTLS_CT_WORD_SIZE - 1)) != 0; i++) {
+            unsigned char x = A[i], y = B[i];
+            diff |= x ^ y;
+        }
+#if defined(MBEDTLS_CT_SSE2)
+        if ((misalign & 15) == 0) {
+            __m128i acc = _mm_setzero_si128();
+
+            for (; (i + MBEDTLS_CT_WORD_SIZE) <= n && ((uintptr_t) (A + i) & 15) != 0;
+                 i += MBEDTLS_CT_WORD_SIZE) {
+                mbedtls_ct_uint_t x = *(volatile const mbedtls_ct_word_t *) (A + i);
+                mbedtls_ct_uint_t y = *(volatile const mbedtls_ct_word_t *) (B + i);
+                wdiff |= x ^ y;
+            }
+            for (; (i + 16) <= n; i += 16) {
+                __m128i x = _mm_load_si128((const __m128i *) (uintptr_t) (A + i));
+                __m128i y = _mm_load_si128((const __m128i *) (uintptr_t) (B + i));
+                acc = _mm_or_si128(acc, _mm_xor_si128(x, y));
+                /* Hide the accumulator so that no early exit can be derived
+                 * from it, this is what the volatile accesses do elsewhere. */
+                asm volatile ("" : "+x" (acc));
+            }
+            wdiff |= (mbedtls_ct_uint_t) _mm_cvtsi128_si64(acc)
+                     | (mbedtls_ct_uint_t) _mm_cvtsi128_si64(_mm_unpackhi_epi64(acc, acc));
+        }
+#endif /* MBEDTLS_CT_SSE2 */
+        for (; (i + MBEDTLS_CT_WORD_SIZE) <= n; i += MBEDTLS_CT_WORD_SIZE) {
+            mbedtls_ct_uint_t x = *(volatile const mbedtls_ct_word_t *) (A + i);
+            mbedtls_ct_uint_t y = *(volatile const mbedtls_ct_word_t *) (B + i);
+            wdiff |= x ^ y;
+        }
+#if defined(MBEDTLS_CT_SIZE_64)
+        diff |= (uint32_t) wdiff | (uint32_t) (wdiff >> 32);
+#else
+        diff |= (uint32_t) wdiff;
+#endif
+    }
 #endif
 
     for (; i < n; i++) {
@@ -218,6 +285,15 @@ void mbedtls_ct_memcpy_if(mbedtls_ct_condition_t condition,
     /* dest[i] = c1 == c2 ? src[i] : dest[i] */
     size_t i = 0;
 #if defined(MBEDTLS_EFFICIENT_UNALIGNED_ACCESS)
+#if defined(MBEDTLS_CT_SSE2)
+    const __m128i mask128     = _mm_set1_epi64x((long long) mask);
+    const __m128i not_mask128 = _mm_set1_epi64x((long long) not_mask);
+    for (; (i + 16) <= len; i += 16) {
+        __m128i a = _mm_and_si128(_mm_loadu_si128((const __m128i *) (src1 + i)), mask128);
+        __m128i b = _mm_and_si128(_mm_loadu_si128((const __m128i *) (src2 + i)), not_mask128);
+        _mm_storeu_si128((__m128i *) (dest + i), _mm_or_si128(a, b));
+    }
+#endif /* MBEDTLS_CT_SSE2 */
 #if defined(MBEDTLS_CT_SIZE_64)
     for (; (i + 8) <= len; i += 8) {
         uint64_t a = mbedtls_get_unaligned_uint64(src1 + i) & mask;
@@ -260,6 +336,19 @@ void mbedtls_ct_zeroize_if(mbedtls_ct_condition_t condition, void *buf, size_t l
     uint8_t *p = (uint8_t *) buf;
     size_t i = 0;
 #if defined(MBEDTLS_EFFICIENT_UNALIGNED_ACCESS)
+#if defined(MBEDTLS_CT_SSE2)
+    const __m128i mask128 = _mm_set1_epi64x((long long) ~condition);
+    for (; (i + 16) <= len; i += 16) {
+        _mm_storeu_si128((__m128i *) (p + i),
+                         _mm_and_si128(_mm_loadu_si128((const __m128i *) (p + i)), mask128));
+    }
+#endif /* MBEDTLS_CT_SSE2 */
+#if defined(MBEDTLS_CT_WORD_ACCESS) && defined(MBEDTLS_CT_SIZE_64)
+    for (; (i + 8) <= len; i += 8) {
+        mbedtls_put_unaligned_uint64((void *) (p + i),
+                                     mbedtls_get_unaligned_uint64((void *) (p + i)) & ~condition);
+    }
+#endif
     for (; (i + 4) <= len; i += 4) {
         mbedtls_put_unaligned_uint32((void *) (p + i),
                                      mbedtls_get_unaligned_uint32((void *) (p + i)) & mask);
@@ -123,9 +123,16 @@ mbedtls_psa_drbg_context_t *const mbedtls_psa_random_state =
     &global_data.rng.drbg;
 #endif
 
+#if defined(MBEDTLS_PSA_CRYPTO_LAZY_INIT)
+#define GUARD_MODULE_INITIALIZED        \
+    if (global_data.initialized == 0 && \
+        psa_crypto_init() != PSA_SUCCESS) \
+    return PSA_ERROR_BAD_STATE;
+#else
 #define GUARD_MODULE_INITIALIZED        \
     if (global_data.initialized == 0)  \
     return PSA_ERROR_BAD_STATE;
+#endif
 
 #if defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_DH_KEY_PAIR_IMPORT) ||       \
     defined(MBEDTLS_PSA_BUILTIN_KEY_TYPE_DH_PUBLIC_KEY) ||     \
@@ -1192,6 +1199,7 @@ psa_status_t psa_wipe_key_slot( psa_key_slot_t *slot )
     /* At this point, key material and other type-specific content has
      * been wiped. Clear remaining metadata. We can call memset and not
      * zeroize because the metadata is not particularly sensitive. */
+    psa_key_slot_index_remove(slot);
     memset(slot, 0, sizeof(*slot));
     return status;
 }
@@ -1795,6 +1803,15 @@ static psa_status_t psa_start_key_creation(
         return status;
     }
 
+#if defined(MBEDTLS_PSA_CRYPTO_LAZY_INIT)
+    /* Initialize on first use before taking the slot mutex, which a failed
+     * psa_crypto_init() takes to wipe the slots. On failure the empty slot
+     * lookup returns PSA_ERROR_BAD_STATE. */
+    if (global_data.initialized == 0) {
+        (void) psa_crypto_init();
+    }
+#endif
+
     MBEDTLS_MUTEX_LOCK_CHECK( &mbedtls_psa_slots_mutex );
     status = psa_get_empty_key_slot( &volatile_key_id, p_slot );
     if( status != PSA_SUCCESS )
@@ -1820,6 +1837,7 @@ static psa_status_t psa_start_key_creation(
         slot->attr.id.key_id = volatile_key_id;
 #endif
     }
+    psa_key_slot_index_add(slot);
 
     /* Erase external-only flags from the internal copy. To access
      * external-only flags, query `attributes`. Thanks to the check
@@ -152,6 +152,32 @@ psa_status_t psa_get_empty_key_slot(psa_key_id_t *volatile_key_id,
  */
 psa_status_t psa_unlock_key_slot(psa_key_slot_t *slot);
 
+/** Add a key slot to the index of non-volatile keys in memory.
+ *
+ * Call this function once the identifier of a persistent or built-in key
+ * has been set in a slot, so that the key is found without walking the key
+ * slots. It does nothing for volatile keys, which are found directly from
+ * their identifier.
+ *
+ * Please note that, if MBEDTLS_THREADING_C is enabled, this function should
+ * be called with locked mbedtls_psa_slots_mutex.
+ *
+ * \param[in] slot  The key slot.
+ */
+void psa_key_slot_index_add(psa_key_slot_t *slot);
+
+/** Remove a key slot from the index of non-volatile keys in memory.
+ *
+ * Call this function before the key slot is cleared. It does nothing if the
+ * slot is not in the index.
+ *
+ * Please note that, if MBEDTLS_THREADING_C is enabled, this function should
+ * be called with locked mbedtls_psa_slots_mutex.
+ *
+ * \param[in] slot  The key slot.
+ */
+void psa_key_slot_index_remove(psa_key_slot_t *slot);
+
 /** Test whether a lifetime designates a key in an external cryptoprocessor.
  *
  * \param lifetime      The lifetime to test.
@@ -0,0 +1,299 @@
+/***************************************************************************//**
+ * @file
+ * @brief Authenticated encryption of application payloads carried in ATT values.
+ *******************************************************************************
+ * # License
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ ******************************************************************************/
+// psa_crypto_driver_wrappers.h accesses private struct members
+#define MBEDTLS_ALLOW_PRIVATE_ACCESS
+
+#include <string.h>
+#include "mbedtls/platform_util.h"
+#include "psa_crypto_core.h"
+#include "psa_crypto_driver_wrappers.h"
+#include "secure_payload.h"
+
+#define SECURE_PAYLOAD_ALG \
+  PSA_ALG_AEAD_WITH_SHORTENED_TAG(PSA_ALG_CCM, SECURE_PAYLOAD_TAG_SIZE)
+
+// Counter of a context as stored in NVM3
+typedef struct {
+  uint8_t id[SECURE_PAYLOAD_ID_SIZE];
+  uint32_t counter;
+} counter_record_t;
+
+static void put_counter(uint8_t *p, uint32_t counter);
+static uint32_t get_counter(const uint8_t *p);
+static sl_status_t save_counter(secure_payload_context_t *context, uint32_t counter);
+
+/***************************************************************************//**
+ * Load the provisioned key of a link and restore its counter from NVM3.
+ ******************************************************************************/
+sl_status_t secure_payload_init(secure_payload_context_t *context,
+                                nvm3_ObjectKey_t key_object,
+                                const uint8_t id[SECURE_PAYLOAD_ID_SIZE],
+                                bool sender,
+                                nvm3_ObjectKey_t nvm3_key)
+{
+  counter_record_t record;
+  uint32_t type;
+  size_t length;
+
+  if (context == NULL || id == NULL) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  memset(context, 0, sizeof(*context));
+  if (nvm3_getObjectInfo(nvm3_defaultHandle, key_object, &type, &length) != ECODE_NVM3_OK
+      || type != NVM3_OBJECTTYPE_DATA || length != SECURE_PAYLOAD_KEY_SIZE
+      || nvm3_readData(nvm3_defaultHandle, key_object, context->key, SECURE_PAYLOAD_KEY_SIZE) != ECODE_NVM3_OK) {
+    mbedtls_platform_zeroize(context->key, sizeof(context->key));
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  context->attributes = psa_key_attributes_init();
+  psa_set_key_type(&context->attributes, PSA_KEY_TYPE_AES);
+  psa_set_key_bits(&context->attributes, SECURE_PAYLOAD_KEY_SIZE * 8);
+  psa_set_key_usage_flags(&context->attributes, sender ? PSA_KEY_USAGE_ENCRYPT : PSA_KEY_USAGE_DECRYPT);
+  psa_set_key_algorithm(&context->attributes, SECURE_PAYLOAD_ALG);
+  memcpy(context->nonce, id, SECURE_PAYLOAD_ID_SIZE);
+  context->nvm3_key = nvm3_key;
+  context->sender = sender;
+  context->keyed = true;
+
+  if (nvm3_readData(nvm3_defaultHandle, nvm3_key, &record, sizeof(record)) == ECODE_NVM3_OK
+      && memcmp(record.id, id, SECURE_PAYLOAD_ID_SIZE) == 0) {
+    // A sender starts at the end of its last reserved block
+    context->counter = record.counter;
+    context->saved = record.counter;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Find the NVM3 key of the counter of an id among a range of keys.
+ ******************************************************************************/
+sl_status_t secure_payload_find_counter(const uint8_t id[SECURE_PAYLOAD_ID_SIZE],
+                                        nvm3_ObjectKey_t first,
+                                        size_t count,
+                                        const secure_payload_context_t *contexts,
+                                        size_t context_count,
+                                        nvm3_ObjectKey_t *nvm3_key)
+{
+  counter_record_t record;
+  bool found_free = false;
+  bool found_lowest = false;
+  nvm3_ObjectKey_t free_key = 0;
+  nvm3_ObjectKey_t lowest_key = 0;
+  uint32_t lowest = UINT32_MAX;
+
+  if (id == NULL || nvm3_key == NULL || (contexts == NULL && context_count > 0)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    nvm3_ObjectKey_t key = first + i;
+    bool held = false;
+
+    for (size_t c = 0; c < context_count; c++) {
+      if (contexts[c].keyed && contexts[c].nvm3_key == key) {
+        held = true;
+      }
+    }
+    if (held) {
+      continue;
+    }
+    if (nvm3_readData(nvm3_defaultHandle, key, &record, sizeof(record)) != ECODE_NVM3_OK) {
+      if (!found_free) {
+        found_free = true;
+        free_key = key;
+      }
+    } else if (memcmp(record.id, id, SECURE_PAYLOAD_ID_SIZE) == 0) {
+      *nvm3_key = key;
+      return SL_STATUS_OK;
+    } else if (!found_lowest || record.counter < lowest) {
+      found_lowest = true;
+      lowest_key = key;
+      lowest = record.counter;
+    }
+  }
+
+  if (found_free) {
+    *nvm3_key = free_key;
+  } else if (found_lowest) {
+    *nvm3_key = lowest_key;
+  } else {
+    return SL_STATUS_FULL;
+  }
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Save the counter of a receiving context and wipe the key.
+ ******************************************************************************/
+void secure_payload_deinit(secure_payload_context_t *context)
+{
+  if (context->keyed && !context->sender && context->counter != context->saved) {
+    save_counter(context, context->counter);
+  }
+  mbedtls_platform_zeroize(context->key, sizeof(context->key));
+  context->keyed = false;
+}
+
+/***************************************************************************//**
+ * Encrypt a payload in place and add the counter and the tag around it.
+ ******************************************************************************/
+sl_status_t secure_payload_seal(secure_payload_context_t *context,
+                                const uint8_t *ad,
+                                size_t ad_length,
+                                uint8_t *packet,
+                                size_t payload_length,
+                                size_t packet_size,
+                                size_t *packet_length)
+{
+  psa_status_t status;
+  size_t length;
+
+  if (context == NULL || !context->sender || packet == NULL || packet_length == NULL
+      || (ad == NULL && ad_length > 0)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  if (!context->keyed) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+  if (packet_size < SECURE_PAYLOAD_OVERHEAD
+      || payload_length > packet_size - SECURE_PAYLOAD_OVERHEAD) {
+    return SL_STATUS_WOULD_OVERFLOW;
+  }
+  if (context->counter == UINT32_MAX) {
+    return SL_STATUS_FULL;
+  }
+  if (context->counter >= context->saved) {
+    // Reserve the next block before its first counter goes out
+    uint32_t limit = (context->counter > UINT32_MAX - SECURE_PAYLOAD_COUNTER_BLOCK)
+                     ? UINT32_MAX : context->counter + SECURE_PAYLOAD_COUNTER_BLOCK;
+    sl_status_t sc = save_counter(context, limit);
+    if (sc != SL_STATUS_OK) {
+      return sc;
+    }
+  }
+
+  put_counter(&context->nonce[SECURE_PAYLOAD_ID_SIZE], context->counter);
+  put_counter(packet, context->counter);
+  status = psa_driver_wrapper_aead_encrypt(&context->attributes,
+                                           context->key, sizeof(context->key),
+                                           SECURE_PAYLOAD_ALG,
+                                           context->nonce, sizeof(context->nonce),
+                                           ad, ad_length,
+                                           &packet[SECURE_PAYLOAD_HEADER_SIZE], payload_length,
+                                           // output == input for in-place encryption
+                                           &packet[SECURE_PAYLOAD_HEADER_SIZE],
+                                           payload_length + SECURE_PAYLOAD_TAG_SIZE,
+                                           &length);
+  if (status != PSA_SUCCESS) {
+    return SL_STATUS_FAIL;
+  }
+
+  context->counter++;
+  context->stats.sealed++;
+  *packet_length = SECURE_PAYLOAD_HEADER_SIZE + length;
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Authenticate and decrypt a packet in place.
+ ******************************************************************************/
+sl_status_t secure_payload_open(secure_payload_context_t *context,
+                                const uint8_t *ad,
+                                size_t ad_length,
+                                uint8_t *packet,
+                                size_t packet_length,
+                                size_t *payload_length)
+{
+  psa_status_t status;
+  uint32_t counter;
+  size_t length;
+
+  if (context == NULL || context->sender || packet == NULL || payload_length == NULL
+      || (ad == NULL && ad_length > 0) || packet_length < SECURE_PAYLOAD_OVERHEAD) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  if (!context->keyed) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  // Senders never use the last counter, see secure_payload_seal()
+  counter = get_counter(packet);
+  if (counter < context->counter || counter == UINT32_MAX) {
+    context->stats.replayed++;
+    return SL_STATUS_ALREADY_EXISTS;
+  }
+
+  put_counter(&context->nonce[SECURE_PAYLOAD_ID_SIZE], counter);
+  length = packet_length - SECURE_PAYLOAD_HEADER_SIZE;
+  status = psa_driver_wrapper_aead_decrypt(&context->attributes,
+                                           context->key, sizeof(context->key),
+                                           SECURE_PAYLOAD_ALG,
+                                           context->nonce, sizeof(context->nonce),
+                                           ad, ad_length,
+                                           &packet[SECURE_PAYLOAD_HEADER_SIZE], length,
+                                           &packet[SECURE_PAYLOAD_HEADER_SIZE], length,
+                                           &length);
+  if (status != PSA_SUCCESS) {
+    mbedtls_platform_zeroize(&packet[SECURE_PAYLOAD_HEADER_SIZE],
+                             packet_length - SECURE_PAYLOAD_HEADER_SIZE);
+    if (status == PSA_ERROR_INVALID_SIGNATURE) {
+      context->stats.forged++;
+      return SL_STATUS_SECURITY_DECRYPT_ERROR;
+    }
+    return SL_STATUS_FAIL;
+  }
+
+  context->counter = counter + 1;
+  context->stats.opened++;
+  if (context->counter - context->saved >= SECURE_PAYLOAD_COUNTER_BLOCK) {
+    // The payload is valid whether or not the save succeeds
+    save_counter(context, context->counter);
+  }
+  *payload_length = length;
+
+  return SL_STATUS_OK;
+}
+
+static void put_counter(uint8_t *p, uint32_t counter)
+{
+  p[0] = (uint8_t)(counter >> 24);
+  p[1] = (uint8_t)(counter >> 16);
+  p[2] = (uint8_t)(counter >> 8);
+  p[3] = (uint8_t)counter;
+}
+
+static uint32_t get_counter(const uint8_t *p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/***************************************************************************//**
+ * Store the counter of a context along with its id.
+ ******************************************************************************/
+static sl_status_t save_counter(secure_payload_context_t *context, uint32_t counter)
+{
+  counter_record_t record;
+
+  memset(&record, 0, sizeof(record));
+  memcpy(record.id, context->nonce, SECURE_PAYLOAD_ID_SIZE);
+  record.counter = counter;
+  if (nvm3_writeData(nvm3_defaultHandle, context->nvm3_key, &record, sizeof(record)) != ECODE_NVM3_OK) {
+    return SL_STATUS_FLASH_PROGRAM_FAILED;
+  }
+  context->saved = counter;
+  context->stats.nvm3_writes++;
+
+  return SL_STATUS_OK;
+}